@@ -0,0 +1,20 @@
+// bench_util.hpp
+// Timing helper shared by the benchmarks in this directory.
+#pragma once
+
+#include <chrono>
+
+// Average microseconds per call of f over enough iterations to run ~0.2 s.
+template <typename F>
+double time_us(F&& f) {
+   using Clock = std::chrono::steady_clock;
+   int iterations = 0;
+   const auto start = Clock::now();
+   auto elapsed = Clock::duration{};
+   do {
+      f();
+      ++iterations;
+      elapsed = Clock::now() - start;
+   } while (elapsed < std::chrono::milliseconds{200});
+   return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
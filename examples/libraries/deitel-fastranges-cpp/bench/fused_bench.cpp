@@ -0,0 +1,173 @@
+// fused_bench.cpp
+// Compares fused filter/transform/reduce pipelines with std::accumulate
+// over the equivalent std::views chains from fig06_13.cpp, and checks
+// that both give identical results.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O2 -march=native -Iinclude bench/fused_bench.cpp -o fused_bench
+// Run (optional largest element count, default 100000000):
+//   ./fused_bench 100000000
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <string>
+#include <vector>
+#include "fastranges/fastranges.hpp"
+#include "bench_util.hpp"
+
+namespace fr = deitel::fastranges;
+
+// std::accumulate over a lazy view, as in fig06_13.cpp
+template <typename View, typename T, typename Op = std::plus<>>
+T lazy_accumulate(View view, T init, Op op = {}) {
+   return std::accumulate(std::ranges::begin(view), std::ranges::end(view),
+      init, op);
+}
+
+template <typename T>
+bool check(const char* name, const T& fused, const T& lazy) {
+   if (fused != lazy) {
+      std::cerr << name << " mismatch\n";
+      return false;
+   }
+   return true;
+}
+
+int main(int argc, char* argv[]) {
+   const std::size_t max_count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+
+   auto is_even{[](const auto& x) {return x % 2 == 0;}};
+   auto square{[](const auto& x) {return x * x;}};
+   auto square_ll{[](std::int32_t x) {return std::int64_t{x} * x;}};
+
+   // the pipelines of fig06_13.cpp
+   bool ok = true;
+   auto values1{std::views::iota(1, 11)};
+   auto fused4{values1 | fr::filter(is_even) | fr::transform(square)};
+   ok &= check("iota", fused4 | fr::reduce(0, std::plus{}),
+      lazy_accumulate(fused4.view(), 0));
+   ok &= check("iota value", fused4 | fr::reduce(0, std::plus{}), 220);
+
+   constexpr std::array numbers{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+   auto fused5{numbers | fr::filter(is_even) | fr::transform(square)};
+   ok &= check("array", fused5 | fr::reduce(0, std::plus{}),
+      lazy_accumulate(fused5.view(), 0));
+
+   // other sources, stage orders and reductions
+   std::vector<std::int32_t> data(100'003);
+   for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<std::int32_t>((i * 7919) % 20011) - 10000;
+   }
+   const std::span<const std::int32_t> span{data};
+   auto odd{[](auto x) {return x % 2 != 0;}};
+   auto chain{span | fr::transform([](auto x) {return x / 3;}) | fr::filter(odd)
+      | fr::transform(square_ll) | fr::filter([](auto x) {return x > 100;})};
+   ok &= check("span chain", chain | fr::reduce(std::int64_t{0}, std::plus{}),
+      lazy_accumulate(chain.view(), std::int64_t{0}));
+   ok &= check("xor", chain | fr::reduce(std::int64_t{0}, std::bit_xor{}),
+      lazy_accumulate(chain.view(), std::int64_t{0}, std::bit_xor{}));
+   ok &= check("mixed types", data | fr::filter(is_even)
+      | fr::reduce(std::int64_t{0}, std::plus{}),
+      lazy_accumulate(data | std::views::filter(is_even), std::int64_t{0}));
+
+   auto scaled{data | fr::filter(is_even)
+      | fr::transform([](auto x) {return x * 0.1;})};
+   ok &= check("double", scaled | fr::reduce(0.0, std::plus{}),
+      lazy_accumulate(scaled.view(), 0.0));
+
+   const std::vector<std::string> words{"to", "be", "or", "not", "to", "be"};
+   auto joined{words | fr::filter([](const std::string& w) {return w != "or";})};
+   ok &= check("string", joined | fr::reduce(std::string{}, std::plus{}),
+      lazy_accumulate(joined.view(), std::string{}));
+
+   // partial operations are not called for filtered-out elements
+   const std::vector<int> divisors{0, 2, 0, 5, 0};
+   auto nonzero{divisors | fr::filter([](int x) {return x != 0;})};
+   ok &= check("divides", nonzero | fr::reduce(1000, std::divides{}),
+      lazy_accumulate(nonzero.view(), 1000, std::divides{}));
+
+   // transforms guarded by a filter only run on the elements it keeps,
+   // like the lazy views, outside the vectorized integral reductions
+   auto guarded{divisors | fr::filter([](int x) {return x != 0;})
+      | fr::transform([](int x) {return 100 / x;})};
+   ok &= check("guarded", guarded | fr::reduce(std::int64_t{0}, std::plus{}),
+      lazy_accumulate(guarded.view(), std::int64_t{0}));
+   ok &= check("guarded take", guarded | fr::take(1) | fr::reduce(0, std::plus{}),
+      50);
+   ok &= check("guarded double", guarded
+      | fr::transform([](int x) {return x * 0.5;}) | fr::reduce(0.0, std::plus{}),
+      35.0);
+   int calls{0};
+   auto counted{data | fr::filter(is_even) | fr::transform([&calls](auto x) {
+      ++calls;
+      return x * 0.5;
+   })};
+   const double counted_sum{counted | fr::reduce(0.0, std::plus{})};
+   const int fused_calls{calls};
+   calls = 0;
+   ok &= check("counted", counted_sum, lazy_accumulate(counted.view(), 0.0));
+   ok &= check("transform calls", fused_calls, calls);
+
+   // per-lane partial sums would overflow int; the result does not
+   std::vector<int> extremes(1000, 1);
+   extremes[0] = std::numeric_limits<int>::max();
+   extremes[150] = std::numeric_limits<int>::min();
+   auto all{extremes | fr::filter([](int) {return true;})};
+   ok &= check("int lanes", all | fr::reduce(-200, std::plus{}),
+      lazy_accumulate(all.view(), -200));
+   if (!ok) {
+      return 1;
+   }
+
+   std::printf("%12s %12s %12s %9s %12s %12s %9s\n", "elements",
+      "vector lazy", "vector fused", "speedup", "iota lazy", "iota fused",
+      "speedup");
+
+   for (std::size_t count = 1000; count <= max_count; count *= 10) {
+      data.resize(count);
+      for (std::size_t i = 0; i < count; ++i) {
+         data[i] = static_cast<std::int32_t>((i * 7919) % 20011) - 10000;
+      }
+      const auto last{static_cast<std::int32_t>(count)};
+
+      auto vec{data | fr::filter(is_even) | fr::transform(square_ll)};
+      auto iota{std::views::iota(0, last) | fr::filter(is_even)
+         | fr::transform(square_ll)};
+      std::int64_t sink{0};
+
+      if (!check("vector", vec | fr::reduce(std::int64_t{0}),
+             lazy_accumulate(vec.view(), std::int64_t{0})) ||
+          !check("iota", iota | fr::reduce(std::int64_t{0}),
+             lazy_accumulate(iota.view(), std::int64_t{0}))) {
+         return 1;
+      }
+
+      const double vec_lazy = time_us([&] {
+         sink += lazy_accumulate(vec.view(), std::int64_t{0});
+      });
+      const double vec_fused = time_us([&] {
+         sink += vec | fr::reduce(std::int64_t{0});
+      });
+      const double iota_lazy = time_us([&] {
+         sink += lazy_accumulate(iota.view(), std::int64_t{0});
+      });
+      const double iota_fused = time_us([&] {
+         sink += iota | fr::reduce(std::int64_t{0});
+      });
+
+      std::printf("%12zu %10.1fus %10.1fus %8.1fx %10.1fus %10.1fus %8.1fx\n",
+         count, vec_lazy, vec_fused, vec_lazy / vec_fused, iota_lazy,
+         iota_fused, iota_lazy / iota_fused);
+      if (sink == 42) {
+         std::puts("");
+      }
+   }
+}
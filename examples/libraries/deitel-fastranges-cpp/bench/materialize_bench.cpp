@@ -0,0 +1,132 @@
+// materialize_bench.cpp
+// Compares fr::to<std::vector>() with materializing the equivalent lazy
+// views by push_back, as std::ranges::to does for ranges that are not
+// sized (e.g. the cpp23.cpp iota | filter | take example), and checks
+// that both give identical results.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O2 -march=native -pthread -Iinclude bench/materialize_bench.cpp -o materialize_bench
+// Run (optional largest element count, default 100000000):
+//   ./materialize_bench 100000000
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <ranges>
+#include <vector>
+#include "fastranges/fastranges.hpp"
+#include "bench_util.hpp"
+
+namespace fr = deitel::fastranges;
+
+// std::ranges::to<std::vector> where the standard library has it,
+// else the same push_back loop it uses for ranges that are not sized
+template <typename View>
+auto lazy_to_vector(View view) {
+#if defined(__cpp_lib_ranges_to_container)
+   return std::ranges::to<std::vector>(std::move(view));
+#else
+   std::vector<std::ranges::range_value_t<View>> out;
+   if constexpr (std::ranges::sized_range<View>) {
+      out.reserve(std::ranges::size(view));
+   }
+   for (auto&& value : view) {
+      out.push_back(value);
+   }
+   return out;
+#endif
+}
+
+template <typename T>
+bool check(const char* name, const T& fast, const T& lazy) {
+   if (fast != lazy) {
+      std::cerr << name << " mismatch\n";
+      return false;
+   }
+   return true;
+}
+
+int main(int argc, char* argv[]) {
+   const std::size_t max_count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+
+   auto isEven{[](int x) {return x % 2 == 0;}};
+   auto square{[](int x) {return std::int64_t{x} * x;}};
+   auto byThree{[](std::int64_t x) {return x % 3 == 0;}};
+
+   std::printf("%-28s %12s %12s %12s %9s\n", "pipeline", "elements",
+      "lazy to", "fr::to", "speedup");
+   auto row{[](const char* name, std::size_t count, double lazy, double fast) {
+      std::printf("%-28s %12zu %10.1fus %10.1fus %8.1fx\n", name, count, lazy,
+         fast, lazy / fast);
+   }};
+
+   // a small take needs only the first elements of a huge source
+   auto fiveEvens{std::views::iota(0L, 2'000'000'000L)
+      | fr::filter([](long x) {return x % 2 == 0;}) | fr::take(5)};
+   if (!check("small take", fiveEvens | fr::to<std::vector>(),
+          lazy_to_vector(fiveEvens.view()))) {
+      return 1;
+   }
+
+   for (std::size_t count = 1'000; count <= max_count; count *= 10) {
+      std::vector<int> data(count);
+      for (std::size_t i = 0; i < count; ++i) {
+         data[i] = static_cast<int>((i * 7919) % 20011) - 10000;
+      }
+      std::size_t sink{0};
+
+      // cpp23.cpp: the take fixes the size exactly
+      auto evens{std::views::iota(0) | fr::filter(isEven) | fr::take(count)};
+      if (!check("iota take", evens | fr::to<std::vector>(),
+             lazy_to_vector(evens.view()))) {
+         return 1;
+      }
+      row("iota|filter|take", count,
+         time_us([&] {sink += lazy_to_vector(evens.view()).size();}),
+         time_us([&] {sink += (evens | fr::to<std::vector>()).size();}));
+
+      // filters before transforms: counted first
+      auto squares{data | fr::filter(isEven) | fr::transform(square)};
+      if (!check("counted", squares | fr::to<std::vector>(),
+             lazy_to_vector(squares.view()))) {
+         return 1;
+      }
+      row("vector|filter|transform", count,
+         time_us([&] {sink += lazy_to_vector(squares.view()).size();}),
+         time_us([&] {sink += (squares | fr::to<std::vector>()).size();}));
+
+      // a take over a large sized source: collected without counting
+      auto firstEvens{data | fr::filter(isEven) | fr::take(count / 100)};
+      if (!check("sized take", firstEvens | fr::to<std::vector>(),
+             lazy_to_vector(firstEvens.view()))) {
+         return 1;
+      }
+      row("vector|filter|take(n/100)", count,
+         time_us([&] {sink += lazy_to_vector(firstEvens.view()).size();}),
+         time_us([&] {sink += (firstEvens | fr::to<std::vector>()).size();}));
+
+      // a filter after a transform: chunks
+      auto thirds{data | fr::transform(square) | fr::filter(byThree)};
+      if (!check("chunked", thirds | fr::to<std::vector>(),
+             lazy_to_vector(thirds.view()))) {
+         return 1;
+      }
+      row("vector|transform|filter", count,
+         time_us([&] {sink += lazy_to_vector(thirds.view()).size();}),
+         time_us([&] {sink += (thirds | fr::to<std::vector>()).size();}));
+
+      // std::views input: chunks
+      auto view{data | std::views::filter(isEven)};
+      if (!check("views", view | fr::to<std::vector>(), lazy_to_vector(view))) {
+         return 1;
+      }
+      row("vector|views::filter", count,
+         time_us([&] {sink += lazy_to_vector(view).size();}),
+         time_us([&] {sink += (view | fr::to<std::vector>()).size();}));
+
+      if (sink == 42) {
+         std::puts("");
+      }
+   }
+}
@@ -0,0 +1,179 @@
+// parallel_bench.cpp
+// Compares fr::par_reduce and fr::par_to with single-threaded lazy views
+// and fused pipelines, and checks that they give identical results,
+// including take-style early termination over unbounded iota as in the
+// cpp23.cpp std::ranges::to example.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O2 -march=native -pthread -Iinclude bench/parallel_bench.cpp -o parallel_bench
+// Run (optional largest element count, default 100000000):
+//   ./parallel_bench 100000000
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+#include "fastranges/fastranges.hpp"
+#include "bench_util.hpp"
+
+namespace fr = deitel::fastranges;
+
+// std::accumulate over a lazy view; take views need common iterators
+template <typename View, typename T, typename Op = std::plus<>>
+T lazy_accumulate(View view, T init, Op op = {}) {
+   auto common{std::views::common(std::move(view))};
+   return std::accumulate(std::ranges::begin(common), std::ranges::end(common),
+      init, op);
+}
+
+// std::ranges::to<std::vector> for C++20 standard libraries
+template <typename View>
+auto lazy_to_vector(View view) {
+   std::vector<std::ranges::range_value_t<View>> out;
+   for (auto&& value : view) {
+      out.push_back(value);
+   }
+   return out;
+}
+
+template <typename T>
+bool check(const char* name, const T& parallel, const T& lazy) {
+   if (parallel != lazy) {
+      std::cerr << name << " mismatch\n";
+      return false;
+   }
+   return true;
+}
+
+bool check_pool(fr::thread_pool& pool) {
+   bool ok = true;
+   auto isEven{[](int x) {return x % 2 == 0;}};
+   auto square{[](int x) {return std::int64_t{x} * x;}};
+
+   // the cpp23.cpp pipeline, and takes that span several waves
+   ok &= check("first 5 even integers",
+      std::views::iota(0) | fr::filter(isEven) | fr::take(5)
+         | fr::par_to<std::vector>(pool),
+      std::vector{0, 2, 4, 6, 8});
+   for (std::size_t count : {0, 1, 4095, 4096, 100'000, 1'000'000}) {
+      auto rare{[](int x) {return x % 7 == 3;}};
+      auto p{std::views::iota(10) | fr::filter(rare) | fr::transform(square)
+         | fr::take(count)};
+      ok &= check("take to", p | fr::par_to<std::vector>(pool),
+         lazy_to_vector(p.view()));
+      ok &= check("take reduce",
+         p | fr::par_reduce(std::int64_t{1}, std::bit_xor{}, pool),
+         lazy_accumulate(p.view(), std::int64_t{1}, std::bit_xor{}));
+   }
+
+   // a bounded source shorter than the take
+   auto short_iota{std::views::iota(0, 50'000) | fr::filter(isEven)
+      | fr::take(1'000'000)};
+   ok &= check("short take", short_iota | fr::par_to<std::vector>(pool),
+      lazy_to_vector(short_iota.view()));
+
+   // sized sources, with and without a known identity
+   std::vector<int> data(1'000'003);
+   for (std::size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<int>((i * 7919) % 20011) - 10000;
+   }
+   auto p{data | fr::filter(isEven) | fr::transform(square)};
+   ok &= check("reduce", p | fr::par_reduce(std::int64_t{5}, std::plus{}, pool),
+      lazy_accumulate(p.view(), std::int64_t{5}));
+   auto max_op{[](std::int64_t a, std::int64_t b) {return a < b ? b : a;}};
+   ok &= check("reduce max", p | fr::par_reduce(std::int64_t{0}, max_op, pool),
+      lazy_accumulate(p.view(), std::int64_t{0}, max_op));
+   ok &= check("to", p | fr::par_to<std::vector>(pool),
+      lazy_to_vector(p.view()));
+
+   // std views: random access ones are split, others run sequentially
+   auto halves{data | std::views::transform([](int x) {return x / 2;})};
+   ok &= check("transform view", halves | fr::par_to<std::vector>(pool),
+      lazy_to_vector(halves));
+   auto evens{data | std::views::filter(isEven) | std::views::take(10)};
+   ok &= check("filter view", evens | fr::par_reduce(0, std::plus{}, pool),
+      lazy_accumulate(evens, 0));
+
+   // floating point: equal up to rounding
+   auto scaled{data | fr::transform([](int x) {return x * 0.001;})};
+   const double sum = scaled | fr::par_reduce(0.0, std::plus{}, pool);
+   ok &= std::abs(sum - lazy_accumulate(scaled.view(), 0.0)) < 1e-6;
+
+   // nested parallel calls and exceptions
+   std::vector<std::int64_t> sums(8);
+   pool.parallel_for(sums.size(), [&](std::size_t i) {
+      sums[i] = std::views::iota(0, 100'000 * static_cast<int>(i + 1))
+         | fr::par_reduce(std::int64_t{0}, std::plus{}, pool);
+   });
+   for (std::size_t i = 0; i < sums.size(); ++i) {
+      const std::int64_t n = 100'000 * static_cast<std::int64_t>(i + 1);
+      ok &= check("nested", sums[i], n * (n - 1) / 2);
+   }
+   try {
+      pool.parallel_for(100, [](std::size_t i) {
+         if (i == 42) {
+            throw std::runtime_error{"42"};
+         }
+      });
+      ok = false;
+   }
+   catch (const std::runtime_error&) {
+   }
+   return ok;
+}
+
+int main(int argc, char* argv[]) {
+   const std::size_t max_count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+
+   for (std::size_t workers : {0, 1, 3, 7}) {
+      fr::thread_pool pool{workers};
+      if (!check_pool(pool)) {
+         std::cerr << "with " << workers << " workers\n";
+         return 1;
+      }
+   }
+
+   fr::thread_pool& pool{fr::default_pool()};
+   std::printf("%zu worker threads + caller\n", pool.size());
+   std::printf("%12s %12s %12s %12s %9s %12s %12s %9s\n", "elements",
+      "lazy", "fused", "par_reduce", "speedup", "lazy to", "par_to", "speedup");
+
+   // a transform with enough work per element to be compute bound
+   auto work{[](std::int64_t x) {
+      return std::sqrt(static_cast<double>(x)) * std::log1p(static_cast<double>(x));
+   }};
+   for (std::size_t count = 1'000'000; count <= max_count; count *= 10) {
+      auto p{std::views::iota(std::int64_t{0}, static_cast<std::int64_t>(count))
+         | fr::transform(work)};
+      double sink{0};
+
+      const double lazy = time_us([&] {
+         sink += lazy_accumulate(p.view(), 0.0);
+      });
+      const double fused = time_us([&] {
+         sink += p | fr::reduce(0.0, std::plus{});
+      });
+      const double parallel = time_us([&] {
+         sink += p | fr::par_reduce(0.0, std::plus{});
+      });
+      const double lazy_to = time_us([&] {
+         sink += static_cast<double>(lazy_to_vector(p.view()).size());
+      });
+      const double par_to = time_us([&] {
+         sink += static_cast<double>((p | fr::par_to<std::vector>()).size());
+      });
+
+      std::printf("%12zu %10.1fus %10.1fus %10.1fus %8.1fx %10.1fus %10.1fus %8.1fx\n",
+         count, lazy, fused, parallel, lazy / parallel, lazy_to, par_to,
+         lazy_to / par_to);
+      if (sink == 42) {
+         std::puts("");
+      }
+   }
+}
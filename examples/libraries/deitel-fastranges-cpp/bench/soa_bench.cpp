@@ -0,0 +1,265 @@
+// soa_bench.cpp
+// Compares field-wise scans over a fr::soa_vector with the same scans over
+// a std::vector of structs, as fig20_13.cpp stores its Employee objects.
+// Each kernel runs over the array of structs, over the soa_vector's
+// zip-style proxy iteration and over its per-field std::spans, and the
+// three results are checked to be identical.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O3 -march=native -Iinclude bench/soa_bench.cpp -o soa_bench
+// (-O3: at -O2, GCC 12 vectorizes only loops with a known trip count)
+// Run (optional largest employee count, default 10000000):
+//   ./soa_bench 10000000
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "fastranges/fastranges.hpp"
+#include "bench_util.hpp"
+
+namespace fr = deitel::fastranges;
+
+// field whose copy throws for the value 2 once failing is set
+struct Fragile {
+   static inline bool failing{false};
+   int value;
+
+   Fragile(int v) : value{v} {}
+
+   Fragile(const Fragile& other) : value{other.value} {
+      if (failing && value == 2) {
+         throw std::runtime_error{"copy"};
+      }
+   }
+};
+
+// array of structs: one Employee per element
+struct Employee {
+   std::string name;
+   double salary;
+   double grossSales;
+   double commissionRate;
+};
+
+// structure of arrays: name, salary, grossSales, commissionRate
+using Employees = fr::soa_vector<std::string, double, double, double>;
+
+enum Field : std::size_t {Name, Salary, GrossSales, CommissionRate};
+
+// the same employees in both layouts; names fit in the small string buffer
+void fill(std::size_t count, std::vector<Employee>& aos, Employees& soa) {
+   aos.clear();
+   soa.clear();
+   aos.reserve(count);
+   soa.reserve(count);
+   for (std::size_t i = 0; i < count; ++i) {
+      std::string name{"emp" + std::to_string(i % 100'000)};
+      const double salary = static_cast<double>(20'000 + (i * 7919) % 60'000);
+      const double sales = static_cast<double>((i * 104'729) % 500'000);
+      const double rate = static_cast<double>(i % 10) / 100.0;
+      aos.push_back({name, salary, sales, rate});
+      soa.push_back(std::move(name), salary, sales, rate);
+   }
+}
+
+// kernel 1: give everyone a fixed raise (reads and writes one field)
+void raise_aos(std::vector<Employee>& aos) {
+   for (Employee& e : aos) {
+      e.salary += 1.0;
+   }
+}
+
+void raise_zip(Employees& soa) {
+   for (auto [name, salary, sales, rate] : soa) {
+      salary += 1.0;
+   }
+}
+
+void raise_span(Employees& soa) {
+   for (double& salary : soa.field<Salary>()) {
+      salary += 1.0;
+   }
+}
+
+// kernel 2: count employees earning more than a threshold (three fields)
+std::int64_t high_earners_aos(const std::vector<Employee>& aos, double threshold) {
+   std::int64_t count = 0;
+   for (const Employee& e : aos) {
+      count += e.salary + e.grossSales * e.commissionRate > threshold;
+   }
+   return count;
+}
+
+std::int64_t high_earners_zip(const Employees& soa, double threshold) {
+   std::int64_t count = 0;
+   for (const auto& [name, salary, sales, rate] : soa) {
+      count += salary + sales * rate > threshold;
+   }
+   return count;
+}
+
+std::int64_t high_earners_span(const Employees& soa, double threshold) {
+   std::span salary{soa.field<Salary>()};
+   std::span sales{soa.field<GrossSales>()};
+   std::span rate{soa.field<CommissionRate>()};
+   std::int64_t count = 0;
+   for (std::size_t i = 0; i < salary.size(); ++i) {
+      count += salary[i] + sales[i] * rate[i] > threshold;
+   }
+   return count;
+}
+
+// kernel 3: total payroll, summed in order (three fields)
+double payroll_aos(const std::vector<Employee>& aos) {
+   double total = 0.0;
+   for (const Employee& e : aos) {
+      total += e.salary + e.grossSales * e.commissionRate;
+   }
+   return total;
+}
+
+double payroll_zip(const Employees& soa) {
+   double total = 0.0;
+   for (const auto& [name, salary, sales, rate] : soa) {
+      total += salary + sales * rate;
+   }
+   return total;
+}
+
+double payroll_span(const Employees& soa) {
+   std::span salary{soa.field<Salary>()};
+   std::span sales{soa.field<GrossSales>()};
+   std::span rate{soa.field<CommissionRate>()};
+   double total = 0.0;
+   for (std::size_t i = 0; i < salary.size(); ++i) {
+      total += salary[i] + sales[i] * rate[i];
+   }
+   return total;
+}
+
+bool check(std::size_t count) {
+   std::vector<Employee> aos;
+   Employees soa;
+   fill(count, aos, soa);
+   bool ok = true;
+
+   const double threshold{50'000.0};
+   const auto earners = high_earners_aos(aos, threshold);
+   ok &= high_earners_zip(soa, threshold) == earners;
+   ok &= high_earners_span(soa, threshold) == earners;
+   const double payroll = payroll_aos(aos);
+   ok &= payroll_zip(soa) == payroll;
+   ok &= payroll_span(soa) == payroll;
+
+   raise_aos(aos);
+   raise_zip(soa);
+   raise_span(soa);
+   raise_aos(aos);
+   std::size_t i = 0;
+   for (const auto& [name, salary, sales, rate] : soa) {
+      ok &= name == aos[i].name && salary == aos[i].salary;
+      ++i;
+   }
+
+   // each field array starts on a cache line
+   auto aligned{[](const void* p) {
+      return reinterpret_cast<std::uintptr_t>(p) % 64 == 0;
+   }};
+   ok &= aligned(soa.field<Name>().data()) && aligned(soa.field<Salary>().data())
+      && aligned(soa.field<CommissionRate>().data());
+   return ok;
+}
+
+int main(int argc, char* argv[]) {
+   const std::size_t max_count =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+   for (std::size_t count : {0, 1, 7, 1000, 100'003}) {
+      if (!check(count)) {
+         std::cerr << "mismatch with " << count << " employees\n";
+         return 1;
+      }
+   }
+
+   // bool fields are plain bool arrays, not bit-packed std::vector<bool>
+   fr::soa_vector<std::string, bool> flags;
+   flags.push_back(std::string{"full-time"}, true);
+   flags.resize(3);
+   const auto copy{flags};
+   const std::span<const bool> set{copy.field<1>()};
+   if (set.size() != 3 || !set[0] || set[1] || set[2]
+       || std::get<0>(copy[0]) != "full-time") {
+      std::cerr << "bool field mismatch\n";
+      return 1;
+   }
+
+   // std::ranges::sort swaps whole rows through the proxy references
+   fr::soa_vector<int, std::string> keyed;
+   for (int key : {3, 1, 2, 5, 4}) {
+      keyed.push_back(key, std::to_string(key));
+   }
+   std::ranges::sort(keyed, {}, [](const auto& r) {return std::get<0>(r);});
+   for (const auto& [key, text] : keyed) {
+      if (text != std::to_string(key) || (&key != keyed.field<0>().data()
+          && *(&key - 1) >= key)) {
+         std::cerr << "sort mismatch\n";
+         return 1;
+      }
+   }
+
+   // a copy that throws part way leaves the source intact
+   fr::soa_vector<Fragile, int> fragile;
+   for (int value : {1, 2, 3}) {
+      fragile.push_back(Fragile{value}, value);
+   }
+   bool thrown{false};
+   Fragile::failing = true;
+   try {
+      const auto fragile_copy{fragile};
+   }
+   catch (const std::runtime_error&) {
+      thrown = true;
+   }
+   if (!thrown || fragile.size() != 3 || fragile.field<0>()[2].value != 3) {
+      std::cerr << "throwing copy mismatch\n";
+      return 1;
+   }
+
+   std::printf("sizeof(Employee) = %zu bytes\n", sizeof(Employee));
+   std::printf("%10s %-12s %12s %12s %12s %9s\n", "employees", "kernel",
+      "AoS", "SoA zip", "SoA span", "speedup");
+
+   for (std::size_t count = 1'000; count <= max_count; count *= 10) {
+      std::vector<Employee> aos;
+      Employees soa;
+      fill(count, aos, soa);
+      double sink{0};
+
+      auto row{[&](const char* kernel, double aos_us, double zip_us, double span_us) {
+         std::printf("%10zu %-12s %10.1fus %10.1fus %10.1fus %8.1fx\n", count,
+            kernel, aos_us, zip_us, span_us, aos_us / span_us);
+      }};
+
+      row("raise",
+         time_us([&] {raise_aos(aos);}),
+         time_us([&] {raise_zip(soa);}),
+         time_us([&] {raise_span(soa);}));
+      row("high earners",
+         time_us([&] {sink += static_cast<double>(high_earners_aos(aos, 5e4));}),
+         time_us([&] {sink += static_cast<double>(high_earners_zip(soa, 5e4));}),
+         time_us([&] {sink += static_cast<double>(high_earners_span(soa, 5e4));}));
+      row("payroll",
+         time_us([&] {sink += payroll_aos(aos);}),
+         time_us([&] {sink += payroll_zip(soa);}),
+         time_us([&] {sink += payroll_span(soa);}));
+      if (sink == 42) {
+         std::puts("");
+      }
+   }
+}
@@ -0,0 +1,10 @@
+#pragma once
+/**
+ * @file fastranges.hpp
+ * @brief Single header to include for the fastranges pipeline utilities.
+ */
+
+#include "fused.hpp"
+#include "materialize.hpp"
+#include "parallel.hpp"
+#include "soa_vector.hpp"
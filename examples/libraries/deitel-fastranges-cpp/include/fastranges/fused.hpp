@@ -0,0 +1,590 @@
+#pragma once
+/**
+ * @file fused.hpp
+ * @brief Fused filter/transform/reduce pipelines over contiguous sources.
+ *
+ * A lazy chain such as
+ *
+ *   values | std::views::filter(is_even) | std::views::transform(square)
+ *
+ * summed with std::accumulate walks the filter view's bidirectional
+ * iterators one element at a time, with a branch per element, so the
+ * compiler does not vectorize it. The same chain written with the
+ * adaptors in this header
+ *
+ *   values | fr::filter(is_even) | fr::transform(square)
+ *          | fr::reduce(0, std::plus{})
+ *
+ * is evaluated as one loop over the source. For integral reductions with
+ * a known identity over std::array, std::vector, std::span and other
+ * contiguous ranges, and over bounded integral std::views::iota, that
+ * loop indexes the source directly and vectorizes: every element goes
+ * through every stage, filters produce a keep flag instead of a branch,
+ * and the reduction selects between the transformed value and the
+ * operation's identity.
+ *
+ * Results are identical to std::accumulate over the equivalent views
+ * (pipeline::view() builds them):
+ *   - integral reductions with a known identity (plus, multiplies,
+ *     bit_and, bit_or, bit_xor) keep one accumulator per SIMD lane in
+ *     the corresponding unsigned type and combine them at the end, which
+ *     is exact whenever the in-order reduction does not overflow;
+ *   - every other reduction (floating point, user operations,
+ *     std::divides, ...) keeps a single accumulator in source order, and
+ *     like the lazy views only runs the stages after a filter on the
+ *     elements that pass it.
+ *
+ * Because the vectorized integral loop runs every stage on every
+ * element, the filter predicates and transform functions of those
+ * pipelines must be side-effect free and defined for all source
+ * elements, not just the ones that pass earlier filters.
+ *
+ * fr::take(count) limits the output like std::views::take, also over
+ * unbounded sources; pipelines with a take stage stop at the limit and
+ * so are evaluated with a plain in-order loop.
+ */
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace deitel::fastranges {
+
+/// Pipeline stage keeping the elements for which pred returns true.
+template <typename Pred>
+struct filter_stage {
+   Pred pred;
+};
+
+/// Pipeline stage replacing each element by fun(element).
+template <typename Fun>
+struct transform_stage {
+   Fun fun;
+};
+
+/// Pipeline stage keeping at most the first count elements. Only
+/// transforms may follow it, so it limits the pipeline's output.
+struct take_stage {
+   std::size_t count;
+};
+
+/// Terminal stage folding the elements into init with op.
+template <typename T, typename Op>
+struct reduce_stage {
+   T init;
+   Op op;
+};
+
+/// Create a filter stage, the fused counterpart of std::views::filter.
+template <typename Pred>
+constexpr filter_stage<std::decay_t<Pred>> filter(Pred&& pred)
+{
+   return {std::forward<Pred>(pred)};
+}
+
+/// Create a transform stage, the fused counterpart of
+/// std::views::transform.
+template <typename Fun>
+constexpr transform_stage<std::decay_t<Fun>> transform(Fun&& fun)
+{
+   return {std::forward<Fun>(fun)};
+}
+
+/// Create a take stage, the fused counterpart of std::views::take. With
+/// a take stage the source may be unbounded, e.g. std::views::iota(0).
+constexpr take_stage take(std::size_t count)
+{
+   return {count};
+}
+
+/// Create a terminal reduce stage, the fused counterpart of
+/// std::accumulate(first, last, init, op).
+template <typename T, typename Op = std::plus<>>
+constexpr reduce_stage<T, std::decay_t<Op>> reduce(T init, Op&& op = {})
+{
+   return {std::move(init), std::forward<Op>(op)};
+}
+
+namespace fused_detail {
+
+template <typename T>
+inline constexpr bool is_filter = false;
+
+template <typename Pred>
+inline constexpr bool is_filter<filter_stage<Pred>> = true;
+
+template <typename T>
+inline constexpr bool is_take = std::same_as<T, take_stage>;
+
+template <typename R>
+inline constexpr bool is_integral_iota = false;
+
+template <std::integral W>
+inline constexpr bool is_integral_iota<std::ranges::iota_view<W, W>> = true;
+
+/// Identity element of op for T, for the operations where one is known.
+/// wrapping_op is the same operation on unsigned operands, which wrap
+/// instead of overflowing.
+template <typename Op, typename T>
+struct identity {
+   static constexpr bool known = false;
+};
+
+template <typename T, typename U>
+   requires std::same_as<U, T> || std::same_as<U, void>
+struct identity<std::plus<U>, T> {
+   static constexpr bool known = true;
+   static constexpr T value = T(0);
+   using wrapping_op = std::plus<>;
+};
+
+template <typename T, typename U>
+   requires std::same_as<U, T> || std::same_as<U, void>
+struct identity<std::multiplies<U>, T> {
+   static constexpr bool known = true;
+   static constexpr T value = T(1);
+   using wrapping_op = std::multiplies<>;
+};
+
+template <typename T, typename U>
+   requires std::same_as<U, T> || std::same_as<U, void>
+struct identity<std::bit_or<U>, T> {
+   static constexpr bool known = true;
+   static constexpr T value = T(0);
+   using wrapping_op = std::bit_or<>;
+};
+
+template <typename T, typename U>
+   requires std::same_as<U, T> || std::same_as<U, void>
+struct identity<std::bit_xor<U>, T> {
+   static constexpr bool known = true;
+   static constexpr T value = T(0);
+   using wrapping_op = std::bit_xor<>;
+};
+
+template <typename T, typename U>
+   requires std::same_as<U, T> || std::same_as<U, void>
+struct identity<std::bit_and<U>, T> {
+   static constexpr bool known = true;
+   static constexpr T value = static_cast<T>(~T(0));
+   using wrapping_op = std::bit_and<>;
+};
+
+/// Access to the i-th source element without going through iterators
+/// that the optimizer cannot see through. from(i) rebases the indexer
+/// so that blocks can be walked with a small index.
+template <typename R>
+class indexer {
+public:
+   explicit constexpr indexer(R& r) : first_{std::ranges::begin(r)} {}
+
+   constexpr decltype(auto) operator[](std::size_t i) const
+   {
+      return first_[static_cast<std::ranges::range_difference_t<R>>(i)];
+   }
+
+   constexpr indexer from(std::size_t i) const
+   {
+      indexer result{*this};
+      result.first_ += static_cast<std::ranges::range_difference_t<R>>(i);
+      return result;
+   }
+
+private:
+   std::ranges::iterator_t<R> first_;
+};
+
+template <std::ranges::contiguous_range R>
+class indexer<R> {
+public:
+   explicit constexpr indexer(R& r) : data_{std::ranges::data(r)} {}
+
+   constexpr decltype(auto) operator[](std::size_t i) const
+   {
+      return data_[i];
+   }
+
+   constexpr indexer from(std::size_t i) const
+   {
+      indexer result{*this};
+      result.data_ += i;
+      return result;
+   }
+
+private:
+   decltype(std::ranges::data(std::declval<R&>())) data_;
+};
+
+template <typename R>
+   requires is_integral_iota<std::remove_const_t<R>>
+class indexer<R> {
+public:
+   using value_type = std::ranges::range_value_t<R>;
+
+   explicit constexpr indexer(R& r) : first_{*std::ranges::begin(r)} {}
+
+   constexpr value_type operator[](std::size_t i) const
+   {
+      return static_cast<value_type>(first_ + static_cast<value_type>(i));
+   }
+
+   constexpr indexer from(std::size_t i) const
+   {
+      indexer result{*this};
+      result.first_ = (*this)[i];
+      return result;
+   }
+
+private:
+   value_type first_;
+};
+
+/// Call f(element) for the elements of source until f returns false.
+/// Views that are not const-iterable (e.g. filter_view) are copied.
+template <typename V, typename F>
+constexpr void for_each_element(const V& source, F&& f)
+{
+   auto run = [&](auto& range) {
+      for (auto&& element : range) {
+         if (!f(std::forward<decltype(element)>(element))) {
+            return;
+         }
+      }
+   };
+   if constexpr (std::ranges::input_range<const V>) {
+      run(source);
+   }
+   else {
+      V copy{source};
+      run(copy);
+   }
+}
+
+} // namespace fused_detail
+
+/**
+ * @brief A source range followed by filter, transform and take stages,
+ *        built by piping a range into fr::filter(), fr::transform() or
+ *        fr::take().
+ *
+ * Piping a pipeline into fr::reduce() evaluates it in one fused loop;
+ * view() returns the equivalent lazy std::views chain. apply() runs
+ * every stage on a value for the masked loops, apply_kept() stops at
+ * the first filter that rejects it, as the lazy views do.
+ */
+template <std::ranges::view V, typename... Stages>
+class pipeline {
+public:
+   /// Whether a take stage limits the output.
+   static constexpr bool has_take = (fused_detail::is_take<Stages> || ...);
+
+   constexpr pipeline(V source, std::tuple<Stages...> stages)
+      : source_{std::move(source)}, stages_{std::move(stages)}
+   {
+   }
+
+   /// The source view.
+   constexpr const V& source() const& { return source_; }
+   constexpr V source() && { return std::move(source_); }
+
+   /// The stages, in order.
+   constexpr const std::tuple<Stages...>& stages() const& { return stages_; }
+   constexpr std::tuple<Stages...> stages() && { return std::move(stages_); }
+
+   /// Maximum number of elements produced, from the take stages.
+   constexpr std::size_t limit() const
+   {
+      std::size_t result = static_cast<std::size_t>(-1);
+      std::apply([&](const auto&... stage) {
+         ((result = take_count(stage, result)), ...);
+      }, stages_);
+      return result;
+   }
+
+   /// The equivalent lazy std::views::filter / transform chain.
+   constexpr auto view() const { return make_view<0>(source_); }
+
+   /**
+    * @brief Pass value through all stages.
+    *
+    * @param keep set to 0, without branching, by any filter that rejects
+    *        the value (the remaining stages still run). An unsigned rather
+    *        than a bool, which GCC does not vectorize through a reference.
+    * @return the value after all transforms.
+    */
+   template <std::size_t I = 0, typename T>
+   constexpr auto apply(T&& value, unsigned& keep) const
+   {
+      if constexpr (I == sizeof...(Stages)) {
+         return std::forward<T>(value);
+      }
+      else {
+         const auto& stage = std::get<I>(stages_);
+         if constexpr (fused_detail::is_filter<
+                          std::remove_cvref_t<decltype(stage)>>) {
+            keep &= static_cast<unsigned>(
+               static_cast<bool>(std::invoke(stage.pred, value)));
+            return apply<I + 1>(std::forward<T>(value), keep);
+         }
+         else if constexpr (fused_detail::is_take<
+                               std::remove_cvref_t<decltype(stage)>>) {
+            // counted by the evaluation loops through limit()
+            return apply<I + 1>(std::forward<T>(value), keep);
+         }
+         else {
+            return apply<I + 1>(std::invoke(stage.fun, std::forward<T>(value)),
+                                keep);
+         }
+      }
+   }
+
+   /**
+    * @brief Pass value through the stages, stopping at the first filter
+    *        that rejects it.
+    *
+    * @param f called with the value after all transforms, only if every
+    *        filter keeps it.
+    */
+   template <std::size_t I = 0, typename T, typename F>
+   constexpr void apply_kept(T&& value, F&& f) const
+   {
+      if constexpr (I == sizeof...(Stages)) {
+         std::invoke(std::forward<F>(f), std::forward<T>(value));
+      }
+      else {
+         const auto& stage = std::get<I>(stages_);
+         if constexpr (fused_detail::is_filter<
+                          std::remove_cvref_t<decltype(stage)>>) {
+            if (std::invoke(stage.pred, value)) {
+               apply_kept<I + 1>(std::forward<T>(value), std::forward<F>(f));
+            }
+         }
+         else if constexpr (fused_detail::is_take<
+                               std::remove_cvref_t<decltype(stage)>>) {
+            // counted by the evaluation loops through limit()
+            apply_kept<I + 1>(std::forward<T>(value), std::forward<F>(f));
+         }
+         else {
+            apply_kept<I + 1>(std::invoke(stage.fun, std::forward<T>(value)),
+                              std::forward<F>(f));
+         }
+      }
+   }
+
+private:
+   template <typename Stage>
+   static constexpr std::size_t take_count(const Stage& stage, std::size_t count)
+   {
+      if constexpr (fused_detail::is_take<Stage>) {
+         return stage.count < count ? stage.count : count;
+      }
+      else {
+         return count;
+      }
+   }
+
+   template <std::size_t I, typename W>
+   constexpr auto make_view(W w) const
+   {
+      if constexpr (I == sizeof...(Stages)) {
+         return w;
+      }
+      else {
+         const auto& stage = std::get<I>(stages_);
+         if constexpr (fused_detail::is_filter<
+                          std::remove_cvref_t<decltype(stage)>>) {
+            return make_view<I + 1>(std::move(w) |
+                                    std::views::filter(stage.pred));
+         }
+         else if constexpr (fused_detail::is_take<
+                               std::remove_cvref_t<decltype(stage)>>) {
+            using difference_t = std::ranges::range_difference_t<W>;
+            return make_view<I + 1>(
+               std::move(w) |
+               std::views::take(static_cast<difference_t>(stage.count)));
+         }
+         else {
+            return make_view<I + 1>(std::move(w) |
+                                    std::views::transform(stage.fun));
+         }
+      }
+   }
+
+   V source_;
+   std::tuple<Stages...> stages_;
+};
+
+/// Element type produced by a pipeline.
+template <typename P>
+using pipeline_value_t = std::remove_cvref_t<decltype(std::declval<const P&>().apply(
+   std::declval<std::ranges::range_reference_t<std::remove_cvref_t<
+      decltype(std::declval<const P&>().source())>>>(),
+   std::declval<unsigned&>()))>;
+
+/**
+ * @brief Evaluate a pipeline and fold the kept elements, the fused
+ *        equivalent of std::accumulate over p.view().
+ */
+template <typename V, typename... Stages, typename T, typename Op>
+constexpr T evaluate(const pipeline<V, Stages...>& p,
+                     const reduce_stage<T, Op>& r)
+{
+   using value_t = pipeline_value_t<pipeline<V, Stages...>>;
+   const V& source = p.source();
+   T acc = r.init;
+
+   if constexpr (pipeline<V, Stages...>::has_take) {
+      // stop after limit() kept elements, which rules out the masked loop
+      std::size_t remaining = p.limit();
+      if (remaining == 0) {
+         return acc;
+      }
+      fused_detail::for_each_element(source, [&](auto&& element) {
+         bool more = true;
+         p.apply_kept(std::forward<decltype(element)>(element), [&](auto&& value) {
+            acc = std::invoke(r.op, std::move(acc),
+                              std::forward<decltype(value)>(value));
+            more = --remaining != 0;
+         });
+         return more;
+      });
+   }
+   else if constexpr (std::ranges::random_access_range<const V> &&
+                      std::ranges::sized_range<const V>) {
+      const fused_detail::indexer<const V> at{source};
+      const std::size_t n = static_cast<std::size_t>(std::ranges::size(source));
+      std::size_t i = 0;
+
+      using id = fused_detail::identity<Op, T>;
+      if constexpr (std::integral<T> && !std::same_as<T, bool> &&
+                    std::same_as<value_t, T> && id::known) {
+         // integer reductions are associative and commutative, so the
+         // compiler may split this into one accumulator per SIMD lane and
+         // combine them at the end. The lanes accumulate in an unsigned
+         // type, whose arithmetic wraps modulo 2^N: partial sums may
+         // overflow T even when the in-order result does not, and the
+         // wrapped result converts back to exactly that result. Fixed
+         // size blocks need no vector epilogue, which -O2 cost models
+         // require.
+         using lane_t = std::make_unsigned_t<std::common_type_t<T, unsigned>>;
+         const typename id::wrapping_op op{};
+         constexpr std::size_t block = 64;
+         lane_t folded = static_cast<lane_t>(id::value);
+         for (; i + block <= n; i += block) {
+            const auto part = at.from(i);
+            for (std::size_t j = 0; j < block; ++j) {
+               unsigned keep = 1;
+               const T value = p.apply(part[j], keep);
+               folded = static_cast<lane_t>(
+                  op(folded, static_cast<lane_t>(keep ? value : id::value)));
+            }
+         }
+         for (; i < n; ++i) {
+            unsigned keep = 1;
+            const T value = p.apply(at[i], keep);
+            folded = static_cast<lane_t>(
+               op(folded, static_cast<lane_t>(keep ? value : id::value)));
+         }
+         acc = static_cast<T>(op(static_cast<lane_t>(acc), folded));
+      }
+
+      for (; i < n; ++i) {
+         p.apply_kept(at[i], [&](auto&& value) {
+            acc = std::invoke(r.op, std::move(acc),
+                              std::forward<decltype(value)>(value));
+         });
+      }
+   }
+   else {
+      fused_detail::for_each_element(source, [&](auto&& element) {
+         p.apply_kept(std::forward<decltype(element)>(element), [&](auto&& value) {
+            acc = std::invoke(r.op, std::move(acc),
+                              std::forward<decltype(value)>(value));
+         });
+         return true;
+      });
+   }
+
+   return acc;
+}
+
+/// range | fr::filter(pred) starts a pipeline.
+template <std::ranges::viewable_range R, typename Pred>
+constexpr auto operator|(R&& r, filter_stage<Pred> stage)
+{
+   using V = std::views::all_t<R>;
+   return pipeline<V, filter_stage<Pred>>{std::views::all(std::forward<R>(r)),
+                                          std::tuple{std::move(stage)}};
+}
+
+/// range | fr::transform(fun) starts a pipeline.
+template <std::ranges::viewable_range R, typename Fun>
+constexpr auto operator|(R&& r, transform_stage<Fun> stage)
+{
+   using V = std::views::all_t<R>;
+   return pipeline<V, transform_stage<Fun>>{std::views::all(std::forward<R>(r)),
+                                            std::tuple{std::move(stage)}};
+}
+
+/// range | fr::reduce(init, op) folds a range without stages.
+template <std::ranges::viewable_range R, typename T, typename Op>
+constexpr T operator|(R&& r, const reduce_stage<T, Op>& stage)
+{
+   using V = std::views::all_t<R>;
+   return evaluate(pipeline<V>{std::views::all(std::forward<R>(r)), std::tuple{}},
+                   stage);
+}
+
+/// range | fr::take(count) starts a pipeline.
+template <std::ranges::viewable_range R>
+constexpr auto operator|(R&& r, take_stage stage)
+{
+   using V = std::views::all_t<R>;
+   return pipeline<V, take_stage>{std::views::all(std::forward<R>(r)),
+                                  std::tuple{stage}};
+}
+
+/// pipeline | fr::filter(pred) appends a filter stage.
+template <typename V, typename... Stages, typename Pred>
+constexpr auto operator|(pipeline<V, Stages...> p, filter_stage<Pred> stage)
+{
+   static_assert(!pipeline<V, Stages...>::has_take,
+                 "fr::filter cannot follow fr::take");
+   return pipeline<V, Stages..., filter_stage<Pred>>{
+      std::move(p).source(),
+      std::tuple_cat(std::move(p).stages(), std::tuple{std::move(stage)})};
+}
+
+/// pipeline | fr::transform(fun) appends a transform stage.
+template <typename V, typename... Stages, typename Fun>
+constexpr auto operator|(pipeline<V, Stages...> p, transform_stage<Fun> stage)
+{
+   return pipeline<V, Stages..., transform_stage<Fun>>{
+      std::move(p).source(),
+      std::tuple_cat(std::move(p).stages(), std::tuple{std::move(stage)})};
+}
+
+/// pipeline | fr::take(count) appends a take stage.
+template <typename V, typename... Stages>
+constexpr auto operator|(pipeline<V, Stages...> p, take_stage stage)
+{
+   return pipeline<V, Stages..., take_stage>{
+      std::move(p).source(),
+      std::tuple_cat(std::move(p).stages(), std::tuple{stage})};
+}
+
+/// pipeline | fr::reduce(init, op) evaluates the pipeline.
+template <typename V, typename... Stages, typename T, typename Op>
+constexpr T operator|(const pipeline<V, Stages...>& p,
+                      const reduce_stage<T, Op>& stage)
+{
+   return evaluate(p, stage);
+}
+
+} // namespace deitel::fastranges
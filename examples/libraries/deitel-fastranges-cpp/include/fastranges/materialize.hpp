@@ -0,0 +1,265 @@
+#pragma once
+/**
+ * @file materialize.hpp
+ * @brief Materialize ranges and fused pipelines with one allocation.
+ *
+ * std::ranges::to<std::vector>() reserves only for sized ranges. The
+ * cpp23.cpp pipeline
+ *
+ *   std::views::iota(0) | std::views::filter(isEven) | std::views::take(5)
+ *      | std::ranges::to<std::vector>()
+ *
+ * is not sized, so the vector grows by push_back, reallocating and
+ * moving its elements about log2(n) times. fr::to<C>() sizes the
+ * container before filling it:
+ *
+ *   - sized ranges, and pipelines without filters over sized sources,
+ *     reserve their exact size; so do pipelines with fr::take over
+ *     unbounded iota, which produce exactly count elements;
+ *   - fr::to<C>(size_hint) reserves a caller-provided estimate;
+ *   - filtered pipelines whose take limit or source size is at most
+ *     first_chunk elements reserve that bound;
+ *   - pipelines without a take stage whose filters all precede their
+ *     transforms, over random-access sized sources, first count the kept
+ *     elements with the filters alone (a vectorized fused count, see
+ *     fused.hpp), then reserve that count; the transforms run once;
+ *   - everything else is collected into chunks of doubling size, which
+ *     are never reallocated, and moved into one allocation at the end.
+ *
+ * Results are identical to std::ranges::to over the equivalent views.
+ * Containers without reserve() (std::deque, std::list) are filled
+ * directly.
+ */
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "fused.hpp"
+#include "parallel.hpp"
+
+namespace deitel::fastranges {
+
+/// Terminal stage collecting elements into a C<value type>, allocating
+/// its storage up front.
+template <template <typename...> typename C>
+struct to_stage {
+   std::size_t size_hint;
+};
+
+/// Create a materialization stage, the counterpart of std::ranges::to<C>().
+/// A nonzero size_hint is reserved as is, without counting.
+template <template <typename...> typename C>
+constexpr to_stage<C> to(std::size_t size_hint = 0)
+{
+   return {size_hint};
+}
+
+namespace materialize_detail {
+
+/// Unknown size or limit.
+inline constexpr std::size_t unknown = static_cast<std::size_t>(-1);
+
+/// Length of the first chunk when collecting elements of unknown count.
+inline constexpr std::size_t first_chunk = 1024;
+
+template <typename C>
+concept reservable = requires(C& c, std::size_t n) { c.reserve(n); };
+
+template <typename C, typename T>
+void append(C& out, T&& value)
+{
+   if constexpr (requires { out.push_back(std::forward<T>(value)); }) {
+      out.push_back(std::forward<T>(value));
+   }
+   else {
+      out.insert(out.end(), std::forward<T>(value));
+   }
+}
+
+/// Number of source elements, or unknown if the source is not sized.
+template <typename V>
+std::size_t source_size(const V& source)
+{
+   if constexpr (std::ranges::sized_range<const V>) {
+      return static_cast<std::size_t>(std::ranges::size(source));
+   }
+   else {
+      return unknown;
+   }
+}
+
+/// One past the index of the last filter stage (0 if there is none).
+template <typename... Stages>
+constexpr std::size_t filter_prefix()
+{
+   std::size_t end = 0;
+   std::size_t i = 0;
+   ((++i, end = fused_detail::is_filter<Stages> ? i : end), ...);
+   return end;
+}
+
+/// Whether counting the kept elements needs no transform: every stage
+/// before the last filter is itself a filter.
+template <typename... Stages>
+constexpr bool filters_first()
+{
+   constexpr std::size_t end = filter_prefix<Stages...>();
+   std::size_t i = 0;
+   bool result = true;
+   ((result = result && (i++ >= end || fused_detail::is_filter<Stages>)), ...);
+   return result;
+}
+
+/// Number of elements of p's source kept by its filters, evaluated as a
+/// fused count over the filter stages only.
+template <typename V, typename... Stages>
+std::size_t count_kept(const pipeline<V, Stages...>& p)
+{
+   constexpr std::size_t end = filter_prefix<Stages...>();
+   return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      // the source may be a move-only owning_view
+      auto source = [&] {
+         if constexpr (std::copyable<V>) {
+            return p.source();
+         }
+         else {
+            return std::ranges::ref_view{p.source()};
+         }
+      }();
+      using counter = pipeline<decltype(source),
+                               std::tuple_element_t<I, std::tuple<Stages...>>...>;
+      return counter{std::move(source), std::tuple{std::get<I>(p.stages())...}}
+         | transform([](const auto&) { return std::size_t{1}; })
+         | reduce(std::size_t{0});
+   }(std::make_index_sequence<end>{});
+}
+
+/// Append the first limit kept elements of p to out, in order.
+template <typename P, typename C>
+void fill(const P& p, C& out, std::size_t limit)
+{
+   if (limit == 0) {
+      return;
+   }
+   fused_detail::for_each_element(p.source(), [&](auto&& element) {
+      bool more = true;
+      p.apply_kept(std::forward<decltype(element)>(element), [&](auto&& value) {
+         append(out, std::forward<decltype(value)>(value));
+         more = --limit != 0;
+      });
+      return more;
+   });
+}
+
+/// The first limit kept elements of p, in chunks of doubling length.
+template <typename P>
+std::vector<std::vector<pipeline_value_t<P>>> collect_chunks(const P& p,
+                                                             std::size_t limit)
+{
+   std::vector<std::vector<pipeline_value_t<P>>> parts;
+   if (limit == 0) {
+      return parts;
+   }
+   std::size_t chunk = first_chunk;
+   fused_detail::for_each_element(p.source(), [&](auto&& element) {
+      bool more = true;
+      p.apply_kept(std::forward<decltype(element)>(element), [&](auto&& value) {
+         if (parts.empty() || parts.back().size() == chunk) {
+            if (!parts.empty()) {
+               chunk *= 2;
+            }
+            parts.emplace_back().reserve(std::min(chunk, limit));
+         }
+         parts.back().push_back(std::forward<decltype(value)>(value));
+         more = --limit != 0;
+      });
+      return more;
+   });
+   return parts;
+}
+
+} // namespace materialize_detail
+
+/**
+ * @brief Collect the elements of p into a C, reserving its storage from
+ *        the size hint, the source size and take limit, or a counting
+ *        pass, or else stitching chunks into one allocation.
+ */
+template <typename V, typename... Stages, template <typename...> typename C>
+auto evaluate(const pipeline<V, Stages...>& p, const to_stage<C>& r)
+{
+   using value_t = pipeline_value_t<pipeline<V, Stages...>>;
+   using P = pipeline<V, Stages...>;
+   static_assert(!parallel_detail::is_unbounded_iota<V> || P::has_take,
+                 "an unbounded source needs fr::take");
+   constexpr bool filtered = (fused_detail::is_filter<Stages> || ...);
+
+   C<value_t> out;
+   const std::size_t limit = p.limit();
+   if constexpr (!materialize_detail::reservable<C<value_t>>) {
+      materialize_detail::fill(p, out, limit);
+      return out;
+   }
+   else {
+      const std::size_t bound =
+         std::min(limit, materialize_detail::source_size(p.source()));
+
+      if (r.size_hint != 0) {
+         out.reserve(std::min(r.size_hint, bound));
+      }
+      else if (bound != materialize_detail::unknown &&
+               (!filtered || parallel_detail::is_unbounded_iota<V>)) {
+         // every source element is kept, or an unbounded source fills
+         // the take exactly
+         out.reserve(bound);
+      }
+      else if (bound <= materialize_detail::first_chunk) {
+         // a small take, or a small source: reserving the bound costs
+         // less than finding out how many elements pass the filters
+         out.reserve(bound);
+      }
+      else if constexpr (materialize_detail::filters_first<Stages...>() &&
+                         std::ranges::random_access_range<const V> &&
+                         std::ranges::sized_range<const V>) {
+         if (limit == materialize_detail::unknown) {
+            out.reserve(materialize_detail::count_kept(p));
+         }
+         else {
+            // a take may stop long before the end of the source, which
+            // a counting pass would walk in full
+            auto parts = materialize_detail::collect_chunks(p, limit);
+            return parallel_detail::concatenate<C>(parts);
+         }
+      }
+      else {
+         auto parts = materialize_detail::collect_chunks(p, limit);
+         return parallel_detail::concatenate<C>(parts);
+      }
+      materialize_detail::fill(p, out, limit);
+      return out;
+   }
+}
+
+/// pipeline | fr::to<C>() collects the pipeline.
+template <typename V, typename... Stages, template <typename...> typename C>
+auto operator|(const pipeline<V, Stages...>& p, const to_stage<C>& stage)
+{
+   return evaluate(p, stage);
+}
+
+/// range | fr::to<C>() collects a range.
+template <std::ranges::viewable_range R, template <typename...> typename C>
+auto operator|(R&& r, const to_stage<C>& stage)
+{
+   using V = std::views::all_t<R>;
+   return evaluate(pipeline<V>{std::views::all(std::forward<R>(r)), std::tuple{}},
+                   stage);
+}
+
+} // namespace deitel::fastranges
@@ -0,0 +1,570 @@
+#pragma once
+/**
+ * @file parallel.hpp
+ * @brief Parallel evaluation of ranges and fused pipelines.
+ *
+ * std::execution::par works on iterator pairs, not views, so a pipeline
+ * such as the cpp23.cpp example
+ *
+ *   std::views::iota(0) | std::views::filter(isEven) | std::views::take(5)
+ *      | std::ranges::to<std::vector>()
+ *
+ * always runs on one thread. The terminal adaptors in this header
+ *
+ *   fr::par_reduce(init, op)    parallel std::accumulate
+ *   fr::par_to<std::vector>()   parallel std::ranges::to
+ *
+ * split the source of a random-access range or fused pipeline (see
+ * fused.hpp) into chunks, evaluate the chunks on a work-stealing
+ * thread_pool and merge the chunk results in source order:
+ *
+ *   std::views::iota(0) | fr::filter(isEven) | fr::take(5)
+ *      | fr::par_to<std::vector>()
+ *
+ * With a take stage the chunks are scheduled in waves of growing size,
+ * and evaluation stops after the first wave that completes the first
+ * count elements, so unbounded iota sources terminate and give exactly
+ * the same elements as the lazy views. Ranges that cannot be split
+ * (e.g. a std::views::filter chain) are evaluated on the calling thread.
+ *
+ * par_reduce combines chunk results in order, so op must be associative
+ * (as for std::reduce, though not commutative). Floating-point sums can
+ * differ in the last bits from std::accumulate; integer results match.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fused.hpp"
+
+namespace deitel::fastranges {
+
+/**
+ * @brief A pool of worker threads with one task deque per worker.
+ *
+ * Workers take their newest task first and, when their own deque is
+ * empty, steal the oldest task of another worker. Threads waiting in
+ * parallel_for() run queued tasks too, so nested parallel calls cannot
+ * deadlock, and a pool with no workers runs everything on the caller.
+ */
+class thread_pool {
+public:
+   /// Create a pool with the given number of worker threads.
+   explicit thread_pool(std::size_t workers = default_workers())
+      : queues_(std::max<std::size_t>(workers, 1))
+   {
+      for (auto& queue : queues_) {
+         queue = std::make_unique<task_queue>();
+      }
+      threads_.reserve(workers);
+      for (std::size_t i = 0; i < workers; ++i) {
+         threads_.emplace_back([this, i] { worker_loop(i); });
+      }
+   }
+
+   thread_pool(const thread_pool&) = delete;
+   thread_pool& operator=(const thread_pool&) = delete;
+
+   ~thread_pool()
+   {
+      {
+         std::lock_guard lock{sleep_mutex_};
+         stop_ = true;
+      }
+      wake_.notify_all();
+      for (auto& thread : threads_) {
+         thread.join();
+      }
+   }
+
+   /// One worker per hardware thread, less the calling thread.
+   static std::size_t default_workers()
+   {
+      const unsigned hardware = std::thread::hardware_concurrency();
+      return hardware > 1 ? hardware - 1 : 0;
+   }
+
+   /// Number of worker threads.
+   std::size_t size() const { return threads_.size(); }
+
+   /// Queue a task, on the current worker's own deque if called from one.
+   void submit(std::function<void()> task)
+   {
+      const std::size_t index = current_pool_ == this
+         ? current_index_
+         : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+      {
+         std::lock_guard lock{queues_[index]->mutex};
+         queues_[index]->tasks.push_back(std::move(task));
+      }
+      queued_.fetch_add(1);
+      {
+         // pairs with the predicate check in worker_loop(), so the
+         // notification cannot fall between check and wait
+         std::lock_guard lock{sleep_mutex_};
+      }
+      wake_.notify_one();
+   }
+
+   /// Run one queued task on the calling thread. Returns false if there
+   /// was none.
+   bool try_run_one()
+   {
+      std::function<void()> task;
+      const std::size_t index = current_pool_ == this
+         ? current_index_
+         : next_.load(std::memory_order_relaxed) % queues_.size();
+      if (!pop(index, task)) {
+         return false;
+      }
+      task();
+      return true;
+   }
+
+   /// Call body(i) for i in [0, count) as separate tasks and wait for
+   /// them, running queued tasks meanwhile. Rethrows the first exception.
+   template <typename F>
+   void parallel_for(std::size_t count, F&& body)
+   {
+      struct state {
+         std::mutex mutex;
+         std::condition_variable done;
+         std::size_t remaining;
+         std::exception_ptr error;
+      } shared{{}, {}, count, {}};
+
+      for (std::size_t i = 0; i < count; ++i) {
+         submit([&shared, &body, i] {
+            std::exception_ptr error;
+            try {
+               body(i);
+            }
+            catch (...) {
+               error = std::current_exception();
+            }
+            // notify under the lock: the waiter may destroy shared as
+            // soon as it can see remaining == 0
+            std::lock_guard lock{shared.mutex};
+            if (error && !shared.error) {
+               shared.error = error;
+            }
+            if (--shared.remaining == 0) {
+               shared.done.notify_all();
+            }
+         });
+      }
+
+      while (true) {
+         if (try_run_one()) {
+            continue;
+         }
+         std::unique_lock lock{shared.mutex};
+         if (shared.remaining == 0) {
+            break;
+         }
+         // tasks queued later by nested calls are picked up on wake-up
+         shared.done.wait_for(lock, std::chrono::milliseconds{1});
+      }
+
+      if (shared.error) {
+         std::rethrow_exception(shared.error);
+      }
+   }
+
+private:
+   struct task_queue {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+   };
+
+   /// Pop the newest task of queue index, or steal the oldest of another.
+   bool pop(std::size_t index, std::function<void()>& task)
+   {
+      for (std::size_t k = 0; k < queues_.size(); ++k) {
+         task_queue& queue = *queues_[(index + k) % queues_.size()];
+         std::lock_guard lock{queue.mutex};
+         if (!queue.tasks.empty()) {
+            if (k == 0) {
+               task = std::move(queue.tasks.back());
+               queue.tasks.pop_back();
+            }
+            else {
+               task = std::move(queue.tasks.front());
+               queue.tasks.pop_front();
+            }
+            queued_.fetch_sub(1);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void worker_loop(std::size_t index)
+   {
+      current_pool_ = this;
+      current_index_ = index;
+      while (true) {
+         std::function<void()> task;
+         if (pop(index, task)) {
+            task();
+            continue;
+         }
+         std::unique_lock lock{sleep_mutex_};
+         wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+         if (stop_ && queued_.load() == 0) {
+            return;
+         }
+      }
+   }
+
+   static inline thread_local thread_pool* current_pool_{nullptr};
+   static inline thread_local std::size_t current_index_{0};
+
+   std::vector<std::unique_ptr<task_queue>> queues_;
+   std::vector<std::thread> threads_;
+   std::atomic<std::size_t> next_{0};
+   std::atomic<std::size_t> queued_{0};
+   std::mutex sleep_mutex_;
+   std::condition_variable wake_;
+   bool stop_{false};
+};
+
+/// The pool used by the parallel adaptors unless one is passed.
+inline thread_pool& default_pool()
+{
+   static thread_pool pool;
+   return pool;
+}
+
+/// Terminal stage folding elements into init with op, in parallel.
+template <typename T, typename Op>
+struct par_reduce_stage {
+   T init;
+   Op op;
+   thread_pool* pool;
+};
+
+/// Terminal stage collecting elements into a C<value type>, in parallel.
+template <template <typename...> typename C>
+struct par_to_stage {
+   thread_pool* pool;
+};
+
+/// Create a parallel reduce stage, the counterpart of std::accumulate
+/// for associative operations.
+template <typename T, typename Op = std::plus<>>
+par_reduce_stage<T, std::decay_t<Op>>
+par_reduce(T init, Op&& op = {}, thread_pool& pool = default_pool())
+{
+   return {std::move(init), std::forward<Op>(op), &pool};
+}
+
+/// Create a parallel materialization stage, the counterpart of
+/// std::ranges::to<C>().
+template <template <typename...> typename C>
+par_to_stage<C> par_to(thread_pool& pool = default_pool())
+{
+   return {&pool};
+}
+
+namespace parallel_detail {
+
+template <typename V>
+inline constexpr bool is_unbounded_iota = false;
+
+template <std::integral W>
+inline constexpr bool
+   is_unbounded_iota<std::ranges::iota_view<W, std::unreachable_sentinel_t>> = true;
+
+template <typename V>
+inline constexpr bool is_iota =
+   fused_detail::is_integral_iota<V> || is_unbounded_iota<V>;
+
+/// Sources whose elements can be sliced by index.
+template <typename V>
+concept splittable = is_iota<V> || (std::ranges::random_access_range<const V> &&
+                                    std::ranges::sized_range<const V>);
+
+/// Smallest chunk worth a task.
+inline constexpr std::size_t grain = 4096;
+
+/// Largest chunk of a take wave.
+inline constexpr std::size_t max_wave_chunk = std::size_t{1} << 20;
+
+template <typename V>
+std::size_t source_size(const V& source)
+{
+   if constexpr (is_unbounded_iota<V>) {
+      return static_cast<std::size_t>(-1);
+   }
+   else {
+      return static_cast<std::size_t>(std::ranges::size(source));
+   }
+}
+
+/// Elements [first, first + count) of a splittable source, as a view that
+/// fused evaluation indexes directly.
+template <typename V>
+auto slice(const V& source, std::size_t first, std::size_t count)
+{
+   if constexpr (is_iota<V>) {
+      using W = std::ranges::range_value_t<V>;
+      const W start = static_cast<W>(*std::ranges::begin(source) +
+                                     static_cast<W>(first));
+      return std::ranges::iota_view<W, W>{start,
+                                          static_cast<W>(start + static_cast<W>(count))};
+   }
+   else {
+      using difference_t = std::ranges::range_difference_t<const V>;
+      return std::views::counted(
+         std::ranges::begin(source) + static_cast<difference_t>(first),
+         static_cast<difference_t>(count));
+   }
+}
+
+/// Pipeline p with its source replaced by elements [first, first + count).
+template <typename V, typename... Stages>
+auto sub_pipeline(const pipeline<V, Stages...>& p, std::size_t first,
+                  std::size_t count)
+{
+   auto part = slice(p.source(), first, count);
+   return pipeline<decltype(part), Stages...>{std::move(part), p.stages()};
+}
+
+/// The first limit kept elements of p, in order.
+template <typename P>
+std::vector<pipeline_value_t<P>> collect(const P& p, std::size_t limit)
+{
+   std::vector<pipeline_value_t<P>> out;
+   if (limit == 0) {
+      return out;
+   }
+   fused_detail::for_each_element(p.source(), [&](auto&& element) {
+      bool more = true;
+      p.apply_kept(std::forward<decltype(element)>(element), [&](auto&& value) {
+         out.push_back(std::forward<decltype(value)>(value));
+         more = out.size() < limit;
+      });
+      return more;
+   });
+   return out;
+}
+
+/**
+ * @brief The first p.limit() kept elements of p, in order, evaluating
+ *        waves of chunks until the limit is reached or the source ends.
+ */
+template <typename V, typename... Stages>
+std::vector<pipeline_value_t<pipeline<V, Stages...>>>
+collect_limited(const pipeline<V, Stages...>& p, thread_pool& pool)
+{
+   using value_t = pipeline_value_t<pipeline<V, Stages...>>;
+   const std::size_t limit = p.limit();
+   const std::size_t size = source_size(p.source());
+   const std::size_t tasks = pool.size() + 1;
+
+   std::vector<value_t> out;
+   std::size_t next = 0;
+   std::size_t chunk = grain;
+   while (out.size() < limit && next < size) {
+      std::vector<std::vector<value_t>> parts(tasks);
+      const std::size_t needed = limit - out.size();
+      const std::size_t wave_first = next;
+      pool.parallel_for(tasks, [&](std::size_t t) {
+         const std::size_t first = wave_first + t * chunk;
+         if (first >= size || first < wave_first) {
+            return;
+         }
+         const std::size_t count = std::min(chunk, size - first);
+         // no chunk can contribute more than needed elements
+         parts[t] = collect(sub_pipeline(p, first, count), needed);
+      });
+
+      for (auto& part : parts) {
+         const std::size_t take = std::min(part.size(), limit - out.size());
+         out.insert(out.end(), std::make_move_iterator(part.begin()),
+                    std::make_move_iterator(part.begin() + static_cast<std::ptrdiff_t>(take)));
+      }
+
+      const std::size_t advance = tasks * chunk;
+      next = size - next <= advance ? size : next + advance;
+      chunk = std::min(chunk * 2, max_wave_chunk);
+   }
+   return out;
+}
+
+/// Number of chunks for size elements on pool, and the chunk length.
+inline std::pair<std::size_t, std::size_t>
+chunking(std::size_t size, const thread_pool& pool)
+{
+   // a few chunks per thread, so faster threads can steal the rest
+   const std::size_t target = (pool.size() + 1) * 4;
+   const std::size_t chunk = std::max(grain, (size + target - 1) / target);
+   return {(size + chunk - 1) / chunk, chunk};
+}
+
+/// Move the elements of parts, in order, into one C.
+template <template <typename...> typename C, typename T>
+C<T> concatenate(std::vector<std::vector<T>>& parts)
+{
+   C<T> out;
+   if constexpr (requires(C<T>& c, std::size_t n) { c.reserve(n); }) {
+      std::size_t total = 0;
+      for (const auto& part : parts) {
+         total += part.size();
+      }
+      out.reserve(total);
+   }
+   for (auto& part : parts) {
+      out.insert(out.end(), std::make_move_iterator(part.begin()),
+                 std::make_move_iterator(part.end()));
+   }
+   return out;
+}
+
+} // namespace parallel_detail
+
+/**
+ * @brief Fold the elements of p into r.init with r.op, evaluating chunks
+ *        of p's source in parallel and combining them in order.
+ */
+template <typename V, typename... Stages, typename T, typename Op>
+T evaluate(const pipeline<V, Stages...>& p, const par_reduce_stage<T, Op>& r)
+{
+   using value_t = pipeline_value_t<pipeline<V, Stages...>>;
+   static_assert(!parallel_detail::is_unbounded_iota<V> ||
+                 pipeline<V, Stages...>::has_take,
+                 "an unbounded source needs fr::take");
+
+   if constexpr (!parallel_detail::splittable<V>) {
+      return evaluate(p, reduce(r.init, r.op));
+   }
+   else if constexpr (pipeline<V, Stages...>::has_take) {
+      T acc = r.init;
+      for (auto& value : parallel_detail::collect_limited(p, *r.pool)) {
+         acc = std::invoke(r.op, std::move(acc), std::move(value));
+      }
+      return acc;
+   }
+   else {
+      const std::size_t size = parallel_detail::source_size(p.source());
+      const auto [count, chunk] = parallel_detail::chunking(size, *r.pool);
+      using id = fused_detail::identity<Op, T>;
+
+      // each chunk folds from the op's identity if known (so the fused
+      // masked loop applies), else from its own first element
+      std::vector<std::optional<T>> partials(count);
+      r.pool->parallel_for(count, [&](std::size_t i) {
+         const auto part = parallel_detail::sub_pipeline(
+            p, i * chunk, std::min(chunk, size - i * chunk));
+         if constexpr (id::known && std::same_as<value_t, T>) {
+            partials[i] = evaluate(part, reduce(id::value, r.op));
+         }
+         else {
+            std::optional<T>& partial = partials[i];
+            fused_detail::for_each_element(part.source(), [&](auto&& element) {
+               part.apply_kept(std::forward<decltype(element)>(element), [&](auto&& value) {
+                  if (partial) {
+                     *partial = std::invoke(r.op, std::move(*partial),
+                                            std::forward<decltype(value)>(value));
+                  }
+                  else {
+                     partial.emplace(std::forward<decltype(value)>(value));
+                  }
+               });
+               return true;
+            });
+         }
+      });
+
+      T acc = r.init;
+      for (auto& partial : partials) {
+         if (partial) {
+            acc = std::invoke(r.op, std::move(acc), std::move(*partial));
+         }
+      }
+      return acc;
+   }
+}
+
+/**
+ * @brief Collect the elements of p into a C, evaluating chunks of p's
+ *        source in parallel and concatenating them in order.
+ */
+template <typename V, typename... Stages, template <typename...> typename C>
+auto evaluate(const pipeline<V, Stages...>& p, const par_to_stage<C>& r)
+{
+   using value_t = pipeline_value_t<pipeline<V, Stages...>>;
+   static_assert(!parallel_detail::is_unbounded_iota<V> ||
+                 pipeline<V, Stages...>::has_take,
+                 "an unbounded source needs fr::take");
+
+   std::vector<std::vector<value_t>> parts;
+   if constexpr (!parallel_detail::splittable<V>) {
+      parts.push_back(parallel_detail::collect(p, p.limit()));
+   }
+   else if constexpr (pipeline<V, Stages...>::has_take) {
+      parts.push_back(parallel_detail::collect_limited(p, *r.pool));
+   }
+   else {
+      const std::size_t size = parallel_detail::source_size(p.source());
+      const auto [count, chunk] = parallel_detail::chunking(size, *r.pool);
+      parts.resize(count);
+      r.pool->parallel_for(count, [&](std::size_t i) {
+         parts[i] = parallel_detail::collect(
+            parallel_detail::sub_pipeline(p, i * chunk,
+                                          std::min(chunk, size - i * chunk)),
+            static_cast<std::size_t>(-1));
+      });
+   }
+   return parallel_detail::concatenate<C>(parts);
+}
+
+/// pipeline | fr::par_reduce(init, op) evaluates the pipeline in parallel.
+template <typename V, typename... Stages, typename T, typename Op>
+T operator|(const pipeline<V, Stages...>& p, const par_reduce_stage<T, Op>& stage)
+{
+   return evaluate(p, stage);
+}
+
+/// range | fr::par_reduce(init, op) folds a range in parallel.
+template <std::ranges::viewable_range R, typename T, typename Op>
+T operator|(R&& r, const par_reduce_stage<T, Op>& stage)
+{
+   using V = std::views::all_t<R>;
+   return evaluate(pipeline<V>{std::views::all(std::forward<R>(r)), std::tuple{}},
+                   stage);
+}
+
+/// pipeline | fr::par_to<C>() collects the pipeline in parallel.
+template <typename V, typename... Stages, template <typename...> typename C>
+auto operator|(const pipeline<V, Stages...>& p, const par_to_stage<C>& stage)
+{
+   return evaluate(p, stage);
+}
+
+/// range | fr::par_to<C>() collects a range in parallel.
+template <std::ranges::viewable_range R, template <typename...> typename C>
+auto operator|(R&& r, const par_to_stage<C>& stage)
+{
+   using V = std::views::all_t<R>;
+   return evaluate(pipeline<V>{std::views::all(std::forward<R>(r)), std::tuple{}},
+                   stage);
+}
+
+} // namespace deitel::fastranges
@@ -0,0 +1,540 @@
+#pragma once
+/**
+ * @file soa_vector.hpp
+ * @brief A structure-of-arrays container with zip-style iteration.
+ *
+ * cpp23.cpp keeps names and averages in two vectors and walks them with
+ * std::views::zip, while fig20_13.cpp keeps whole Employee objects in one
+ * vector. soa_vector<Fields...> combines the two: each field lives in
+ * its own contiguous, 64-byte aligned array, rows are added and visited
+ * as a whole,
+ *
+ *   fr::soa_vector<std::string, double> students;
+ *   students.push_back("Meriem"s, 3.9);
+ *   for (auto [name, gpa] : students) { ... }   // references, like zip
+ *
+ * and kernels that need only some fields scan just those arrays through
+ * std::span, which the compiler vectorizes:
+ *
+ *   for (double& gpa : students.field<1>()) { gpa = std::min(gpa, 4.0); }
+ *
+ * Iterators are random access and yield soa_ref proxies: tuples of
+ * references that convert to and assign from std::tuple<Fields...>.
+ */
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace deitel::fastranges {
+
+/// Allocator returning storage aligned to Align bytes (e.g. a cache line
+/// or the widest vector register).
+template <typename T, std::size_t Align = 64>
+struct aligned_allocator {
+   using value_type = T;
+
+   template <typename U>
+   struct rebind {
+      using other = aligned_allocator<U, Align>;
+   };
+
+   aligned_allocator() = default;
+
+   template <typename U>
+   constexpr aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+   T* allocate(std::size_t n)
+   {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+   }
+
+   void deallocate(T* p, std::size_t) noexcept
+   {
+      ::operator delete(p, std::align_val_t{Align});
+   }
+
+   template <typename U>
+   bool operator==(const aligned_allocator<U, Align>&) const noexcept
+   {
+      return true;
+   }
+};
+
+namespace soa_detail {
+
+/**
+ * @brief A growable array of T in storage aligned to Align bytes, the
+ *        field arrays of a soa_vector.
+ *
+ * Unlike std::vector it has no bool specialization, so every field type,
+ * bool included, is stored as an array of T with a T* data pointer.
+ */
+template <typename T, std::size_t Align>
+class column {
+public:
+   using size_type = std::size_t;
+
+   column() = default;
+
+   /// Delegates to the default constructor, so that the destructor frees
+   /// the storage if copying an element throws.
+   column(const column& other) : column{}
+   {
+      reserve(other.size_);
+      std::uninitialized_copy_n(other.data_, other.size_, data_);
+      size_ = other.size_;
+   }
+
+   column(column&& other) noexcept
+      : data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)},
+        capacity_{std::exchange(other.capacity_, 0)}
+   {
+   }
+
+   column& operator=(column other) noexcept
+   {
+      swap(other);
+      return *this;
+   }
+
+   ~column()
+   {
+      clear();
+      allocator{}.deallocate(data_, capacity_);
+   }
+
+   void swap(column& other) noexcept
+   {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+   }
+
+   T* data() noexcept { return data_; }
+   const T* data() const noexcept { return data_; }
+   size_type size() const noexcept { return size_; }
+   size_type capacity() const noexcept { return capacity_; }
+
+   T& operator[](size_type i) { return data_[i]; }
+   const T& operator[](size_type i) const { return data_[i]; }
+
+   /// Move (or, if moving may throw, copy) the elements into storage for
+   /// at least count elements.
+   void reserve(size_type count)
+   {
+      if (count <= capacity_) {
+         return;
+      }
+      T* storage{allocator{}.allocate(count)};
+      try {
+         if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                       !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(data_, size_, storage);
+         }
+         else {
+            std::uninitialized_copy_n(data_, size_, storage);
+         }
+      }
+      catch (...) {
+         allocator{}.deallocate(storage, count);
+         throw;
+      }
+      std::destroy_n(data_, size_);
+      allocator{}.deallocate(data_, capacity_);
+      data_ = storage;
+      capacity_ = count;
+   }
+
+   /// Grow or shrink to count elements; new elements are
+   /// value-initialized.
+   void resize(size_type count)
+   {
+      if (count <= size_) {
+         truncate(count);
+         return;
+      }
+      reserve(std::max(count, 2 * size_));
+      std::uninitialized_value_construct_n(data_ + size_, count - size_);
+      size_ = count;
+   }
+
+   /// Destroy the elements from index count on.
+   void truncate(size_type count) noexcept
+   {
+      if (count < size_) {
+         std::destroy(data_ + count, data_ + size_);
+         size_ = count;
+      }
+   }
+
+   void clear() noexcept { truncate(0); }
+
+   template <typename... Args>
+   void emplace_back(Args&&... args)
+   {
+      if (size_ == capacity_) {
+         reserve(size_ == 0 ? 8 : 2 * size_);
+      }
+      std::construct_at(data_ + size_, std::forward<Args>(args)...);
+      ++size_;
+   }
+
+   void pop_back() noexcept { std::destroy_at(data_ + --size_); }
+
+private:
+   using allocator = aligned_allocator<T, Align>;
+
+   T* data_{nullptr};
+   size_type size_{0};
+   size_type capacity_{0};
+};
+
+} // namespace soa_detail
+
+/**
+ * @brief Proxy reference to one row of a soa_vector: a std::tuple of
+ *        references to the row's fields.
+ *
+ * Structured bindings and std::get work as for std::tuple. Assignment
+ * writes through to the fields, also on a const proxy, as for the
+ * references yielded by std::views::zip.
+ */
+template <typename... Ts>
+class soa_ref : public std::tuple<Ts&...> {
+public:
+   using base = std::tuple<Ts&...>;
+   using base::base;
+
+   constexpr soa_ref(const base& refs) : base{refs} {}
+
+   /// Conversion from a proxy with less const fields.
+   template <typename... Us>
+      requires(sizeof...(Us) == sizeof...(Ts) &&
+               (std::convertible_to<Us&, Ts&> && ...))
+   constexpr soa_ref(const soa_ref<Us...>& other)
+      : base{static_cast<const std::tuple<Us&...>&>(other)}
+   {
+   }
+
+   constexpr soa_ref(const soa_ref&) = default;
+
+   /// Copy the fields out.
+   constexpr operator std::tuple<std::remove_const_t<Ts>...>() const
+   {
+      return std::apply([](const auto&... fields) {
+         return std::tuple<std::remove_const_t<Ts>...>{fields...};
+      }, static_cast<const base&>(*this));
+   }
+
+   /// Assign the fields of a row value or another proxy.
+   template <typename Tuple>
+      requires(!std::is_const_v<Ts> && ...)
+   constexpr const soa_ref& operator=(Tuple&& values) const
+   {
+      assign(std::forward<Tuple>(values), std::index_sequence_for<Ts...>{});
+      return *this;
+   }
+
+   constexpr const soa_ref& operator=(const soa_ref& other) const
+      requires(!std::is_const_v<Ts> && ...)
+   {
+      assign(static_cast<const base&>(other), std::index_sequence_for<Ts...>{});
+      return *this;
+   }
+
+   /// Swap the fields of two rows (used by std::ranges::sort and friends
+   /// through std::ranges::iter_swap).
+   friend constexpr void swap(const soa_ref& a, const soa_ref& b)
+      requires(!std::is_const_v<Ts> && ...)
+   {
+      [&]<std::size_t... I>(std::index_sequence<I...>) {
+         using std::swap;
+         (swap(a.template get<I>(), b.template get<I>()), ...);
+      }(std::index_sequence_for<Ts...>{});
+   }
+
+   /// Field I, for member-style access in generic code.
+   template <std::size_t I>
+   constexpr auto& get() const
+   {
+      return std::get<I>(static_cast<const base&>(*this));
+   }
+
+private:
+   template <typename Tuple, std::size_t... I>
+   constexpr void assign(Tuple&& values, std::index_sequence<I...>) const
+   {
+      ((std::get<I>(static_cast<const base&>(*this)) =
+           std::get<I>(std::forward<Tuple>(values))), ...);
+   }
+};
+
+/**
+ * @brief A sequence of rows of Fields..., each field stored in its own
+ *        contiguous, aligned array.
+ */
+template <typename... Fields>
+class soa_vector {
+   static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+public:
+   using value_type = std::tuple<Fields...>;
+   using reference = soa_ref<Fields...>;
+   using const_reference = soa_ref<const Fields...>;
+   using size_type = std::size_t;
+   using difference_type = std::ptrdiff_t;
+
+   template <std::size_t I>
+   using field_type = std::tuple_element_t<I, value_type>;
+
+   /// Alignment in bytes of each field array.
+   static constexpr std::size_t alignment{64};
+
+   template <bool Const>
+   class basic_iterator;
+   using iterator = basic_iterator<false>;
+   using const_iterator = basic_iterator<true>;
+
+   soa_vector() = default;
+
+   /// A soa_vector of count value-initialized rows (arithmetic fields
+   /// are zero).
+   explicit soa_vector(size_type count) { resize(count); }
+
+   size_type size() const { return std::get<0>(columns_).size(); }
+   bool empty() const { return size() == 0; }
+   size_type capacity() const { return std::get<0>(columns_).capacity(); }
+
+   /// Reserve room for count rows in every field array.
+   void reserve(size_type count)
+   {
+      std::apply([&](auto&... column) { (column.reserve(count), ...); }, columns_);
+   }
+
+   /// Grow or shrink to count rows; new rows are value-initialized.
+   void resize(size_type count)
+   {
+      std::apply([&](auto&... column) { (column.resize(count), ...); }, columns_);
+   }
+
+   void clear()
+   {
+      std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+   }
+
+   /// Append a row, one argument per field.
+   template <typename... Args>
+      requires(sizeof...(Args) == sizeof...(Fields) &&
+               (std::constructible_from<Fields, Args&&> && ...))
+   void push_back(Args&&... values)
+   {
+      emplace(std::index_sequence_for<Fields...>{}, std::forward<Args>(values)...);
+   }
+
+   /// Append a row given as a tuple.
+   void push_back(const value_type& row)
+   {
+      std::apply([this](const auto&... values) { push_back(values...); }, row);
+   }
+
+   void pop_back()
+   {
+      std::apply([](auto&... column) { (column.pop_back(), ...); }, columns_);
+   }
+
+   /// Field I of every row, as one contiguous span. The data pointer is
+   /// marked as aligned, so vectorized loops need no peeling.
+   template <std::size_t I>
+   std::span<field_type<I>> field()
+   {
+      auto& column{std::get<I>(columns_)};
+      return {std::assume_aligned<alignment>(column.data()), column.size()};
+   }
+
+   template <std::size_t I>
+   std::span<const field_type<I>> field() const
+   {
+      const auto& column{std::get<I>(columns_)};
+      return {std::assume_aligned<alignment>(column.data()), column.size()};
+   }
+
+   reference operator[](size_type row)
+   {
+      return std::apply([row](auto&... column) {
+         return reference{column[row]...};
+      }, columns_);
+   }
+
+   const_reference operator[](size_type row) const
+   {
+      return std::apply([row](const auto&... column) {
+         return const_reference{column[row]...};
+      }, columns_);
+   }
+
+   iterator begin() { return iterator{data(), 0}; }
+   iterator end() { return iterator{data(), static_cast<difference_type>(size())}; }
+   const_iterator begin() const { return const_iterator{data(), 0}; }
+   const_iterator end() const
+   {
+      return const_iterator{data(), static_cast<difference_type>(size())};
+   }
+
+   /// Random access iterator yielding soa_ref proxies for each row.
+   template <bool Const>
+   class basic_iterator {
+   public:
+      using iterator_concept = std::random_access_iterator_tag;
+      // the proxy reference is not a value_type&, so for the classic
+      // algorithms (e.g. std::sort) these are only input iterators
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::tuple<Fields...>;
+      using difference_type = std::ptrdiff_t;
+      using reference = std::conditional_t<Const, soa_ref<const Fields...>,
+                                           soa_ref<Fields...>>;
+      using pointers =
+         std::conditional_t<Const, std::tuple<const Fields*...>, std::tuple<Fields*...>>;
+
+      basic_iterator() = default;
+
+      basic_iterator(pointers bases, difference_type row) : bases_{bases}, row_{row} {}
+
+      /// Conversion from iterator to const_iterator.
+      template <bool OtherConst>
+         requires(Const && !OtherConst)
+      basic_iterator(const basic_iterator<OtherConst>& other)
+         : bases_{other.bases_}, row_{other.row_}
+      {
+      }
+
+      reference operator*() const { return (*this)[0]; }
+
+      reference operator[](difference_type offset) const
+      {
+         return std::apply([this, offset](auto*... base) {
+            return reference{base[row_ + offset]...};
+         }, bases_);
+      }
+
+      basic_iterator& operator++() { ++row_; return *this; }
+      basic_iterator operator++(int) { auto copy{*this}; ++row_; return copy; }
+      basic_iterator& operator--() { --row_; return *this; }
+      basic_iterator operator--(int) { auto copy{*this}; --row_; return copy; }
+      basic_iterator& operator+=(difference_type n) { row_ += n; return *this; }
+      basic_iterator& operator-=(difference_type n) { row_ -= n; return *this; }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n)
+      {
+         return it += n;
+      }
+
+      friend basic_iterator operator+(difference_type n, basic_iterator it)
+      {
+         return it += n;
+      }
+
+      friend basic_iterator operator-(basic_iterator it, difference_type n)
+      {
+         return it -= n;
+      }
+
+      friend difference_type operator-(const basic_iterator& a, const basic_iterator& b)
+      {
+         return a.row_ - b.row_;
+      }
+
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b)
+      {
+         return a.row_ == b.row_;
+      }
+
+      friend auto operator<=>(const basic_iterator& a, const basic_iterator& b)
+      {
+         return a.row_ <=> b.row_;
+      }
+
+   private:
+      template <bool>
+      friend class basic_iterator;
+
+      pointers bases_{};
+      difference_type row_{0};
+   };
+
+private:
+   template <typename T>
+   using column = soa_detail::column<T, alignment>;
+
+   std::tuple<Fields*...> data()
+   {
+      return std::apply([](auto&... column) {
+         return std::tuple<Fields*...>{column.data()...};
+      }, columns_);
+   }
+
+   std::tuple<const Fields*...> data() const
+   {
+      return std::apply([](const auto&... column) {
+         return std::tuple<const Fields*...>{column.data()...};
+      }, columns_);
+   }
+
+   template <std::size_t... I, typename... Args>
+   void emplace(std::index_sequence<I...>, Args&&... values)
+   {
+      const size_type rows{size()};
+      if (rows == capacity()) {
+         reserve(rows == 0 ? 8 : 2 * rows);
+      }
+      try {
+         (std::get<I>(columns_).emplace_back(std::forward<Args>(values)), ...);
+      }
+      catch (...) {
+         // keep the field arrays the same length if a constructor throws
+         std::apply([rows](auto&... column) { (column.truncate(rows), ...); },
+                    columns_);
+         throw;
+      }
+   }
+
+   std::tuple<column<Fields>...> columns_;
+};
+
+} // namespace deitel::fastranges
+
+/// Structured bindings for soa_ref, as for std::tuple.
+template <typename... Ts>
+struct std::tuple_size<deitel::fastranges::soa_ref<Ts...>>
+   : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct std::tuple_element<I, deitel::fastranges::soa_ref<Ts...>> {
+   using type = std::tuple_element_t<I, std::tuple<Ts&...>>;
+};
+
+/// Common references between row proxies and row values, so soa_vector
+/// iterators model std::random_access_iterator.
+template <typename... Ts, typename... Us, template <typename> typename TQual,
+          template <typename> typename UQual>
+   requires(sizeof...(Ts) == sizeof...(Us))
+struct std::basic_common_reference<deitel::fastranges::soa_ref<Ts...>,
+                                   std::tuple<Us...>, TQual, UQual> {
+   using type = deitel::fastranges::soa_ref<const std::remove_const_t<Ts>...>;
+};
+
+template <typename... Ts, typename... Us, template <typename> typename TQual,
+          template <typename> typename UQual>
+   requires(sizeof...(Ts) == sizeof...(Us))
+struct std::basic_common_reference<std::tuple<Us...>,
+                                   deitel::fastranges::soa_ref<Ts...>, TQual, UQual> {
+   using type = deitel::fastranges::soa_ref<const std::remove_const_t<Ts>...>;
+};
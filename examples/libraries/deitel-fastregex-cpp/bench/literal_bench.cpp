@@ -0,0 +1,130 @@
+// literal_bench.cpp
+// Searches Romeo and Juliet for sets of literals, once with a
+// std::regex_search loop per literal (as fig08_18.cpp does for
+// "Programming", "fun" and "fn") and once with one fx::literal_set, and
+// checks that both find the same occurrences.
+//
+// Build (from the library root; -march=native enables the SIMD prefilter):
+//   g++ -std=c++20 -O2 -march=native -Iinclude bench/literal_bench.cpp -o literal_bench
+// Run (optional text file and largest keyword count, default 1000):
+//   ./literal_bench ../../openai/resources/1513-0_RomeoAndJulietOriginalDownload.txt 1000
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "fastregex/fastregex.hpp"
+#include "bench_util.hpp"
+
+namespace fx = deitel::fastregex;
+
+// count distinct words of at least 4 letters, spread over the alphabet
+std::vector<std::string> keywords(const std::string& text, std::size_t count) {
+   std::vector<std::string> words;
+   std::string word;
+   for (const char c : text) {
+      if (std::isalpha(static_cast<unsigned char>(c))) {
+         word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+      }
+      else {
+         if (word.size() >= 4) {
+            words.push_back(word);
+         }
+         word.clear();
+      }
+   }
+   std::sort(words.begin(), words.end());
+   words.erase(std::unique(words.begin(), words.end()), words.end());
+   std::vector<std::string> result;
+   for (std::size_t i = 0; i < count && i < words.size(); ++i) {
+      result.push_back(words[i * words.size() / std::min(count, words.size())]);
+   }
+   return result;
+}
+
+// Non-overlapping occurrences of each literal, as a regex_search loop
+// finds them.
+std::vector<std::size_t> std_counts(const std::vector<std::regex>& regexes,
+                                    const std::string& text) {
+   std::vector<std::size_t> counts;
+   for (const auto& regex : regexes) {
+      counts.push_back(static_cast<std::size_t>(std::distance(
+         std::sregex_iterator{text.begin(), text.end(), regex}, std::sregex_iterator{})));
+   }
+   return counts;
+}
+
+std::vector<std::size_t> fx_counts(const fx::literal_set& set, std::string_view text) {
+   std::vector<std::size_t> counts(set.size());
+   std::vector<std::size_t> ends(set.size());
+   for (const auto& m : set.find_all(text)) {
+      if (m.position >= ends[m.pattern]) { // skip overlaps, as regex_search
+         ++counts[m.pattern];
+         ends[m.pattern] = m.end();
+      }
+   }
+   return counts;
+}
+
+void run(const char* name, const std::string& text,
+         const std::vector<std::string>& literals, bool icase) {
+   std::vector<std::regex> regexes;
+   for (const auto& literal : literals) {
+      regexes.emplace_back(literal, icase ? std::regex::ECMAScript | std::regex::icase
+                                          : std::regex::ECMAScript);
+   }
+   const fx::literal_set set{literals, icase ? fx::syntax_option::icase
+                                             : fx::syntax_option::none};
+
+   const auto expected{std_counts(regexes, text)};
+   if (fx_counts(set, text) != expected) {
+      std::cerr << "mismatch for " << name << '\n';
+      std::exit(1);
+   }
+   std::size_t hits = 0;
+   for (const std::size_t count : expected) {
+      hits += count;
+   }
+
+   std::size_t sink = 0;
+   const double std_us = time_us([&] {sink += std_counts(regexes, text).size();});
+   const double fx_us = time_us([&] {sink += fx_counts(set, text).size();});
+   std::printf("%-18s %6zu %7zu %5s %12.3f ms %12.3f ms %9.1fx\n", name,
+      literals.size(), hits, set.prefiltered() ? "yes" : "no", std_us / 1000,
+      fx_us / 1000, std_us / fx_us);
+   if (sink == 42) {
+      std::puts("");
+   }
+}
+
+int main(int argc, char* argv[]) {
+   const char* path = argc > 1 ? argv[1]
+      : "../../openai/resources/1513-0_RomeoAndJulietOriginalDownload.txt";
+   const std::size_t max_keywords = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+   std::ifstream in{path, std::ios::binary};
+   if (!in) {
+      std::cerr << "cannot open " << path << '\n';
+      return 1;
+   }
+   std::ostringstream buffer;
+   buffer << in.rdbuf();
+   const std::string text{buffer.str()};
+
+   std::printf("%zu bytes\n\n%-18s %6s %7s %5s %15s %15s %10s\n", text.size(),
+      "literals", "count", "hits", "simd", "regex_search", "literal_set", "speedup");
+   run("fig08_18 words", text, {"Programming", "fun", "fn"}, false);
+   run("names, icase", text, {"Romeo", "Juliet", "Tybalt", "Mercutio", "Benvolio",
+      "Capulet", "Montague", "Nurse", "Friar", "Paris"}, true);
+   for (std::size_t count = 10; count <= max_keywords; count *= 10) {
+      const std::string name{"keywords, icase"};
+      run(name.c_str(), text, keywords(text, count), true);
+   }
+}
@@ -0,0 +1,175 @@
+// regex_bench.cpp
+// Compares fx::static_regex and fx::regex with std::regex on the
+// operations of fig08_16.cpp (regex_match), fig08_17.cpp (regex_replace)
+// and fig08_18.cpp (regex_search, icase), over generated contact lists,
+// and checks that all three give identical results.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O2 -Iinclude bench/regex_bench.cpp -o regex_bench
+// Run (optional input size in MB, default 8):
+//   ./regex_bench 8
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "fastregex/fastregex.hpp"
+#include "bench_util.hpp"
+
+namespace fx = deitel::fastregex;
+
+// Tab-separated contacts like the fig08_18.cpp one, with ZIP codes.
+std::string make_contacts(std::size_t bytes) {
+   const char* first[]{"Sue", "Pierre", "Meriem", "Dale", "Paul", "Harvey"};
+   const char* last[]{"Green", "Deitel", "Red", "SUE", "Blue", "Lopez"};
+   std::string text;
+   unsigned seed = 12345;
+   auto next{[&] {return seed = seed * 1103515245 + 12345, seed >> 8;}};
+   char digits[16];
+   while (text.size() < bytes) {
+      text += first[next() % 6];
+      text += ' ';
+      text += last[next() % 6];
+      text += "\tHome: ";
+      std::snprintf(digits, sizeof digits, "%03u-%03u-%04u", next() % 1000,
+         next() % 1000, next() % 10000);
+      text += digits;
+      text += "\tWork: ";
+      std::snprintf(digits, sizeof digits, "%03u-%03u-%04u", next() % 1000,
+         next() % 1000, next() % 10000);
+      text += digits;
+      std::snprintf(digits, sizeof digits, "\t%05u\n", next() % 100000);
+      text += digits;
+   }
+   return text;
+}
+
+// Words of the text, to match one by one as fig08_16.cpp does.
+std::vector<std::string> make_words(std::string_view text, std::size_t count) {
+   std::vector<std::string> words;
+   std::size_t start = 0;
+   while (words.size() < count && start < text.size()) {
+      const std::size_t end = text.find_first_of(" \t\n", start);
+      words.emplace_back(text.substr(start, end - start));
+      start = end + 1;
+   }
+   return words;
+}
+
+template <typename Regex>
+std::vector<std::size_t> fx_positions(const Regex& regex, std::string_view text) {
+   std::vector<std::size_t> out;
+   for (const auto& m : regex.find_all(text)) {
+      out.push_back(m.position);
+      out.push_back(m.length);
+   }
+   return out;
+}
+
+std::vector<std::size_t> std_positions(const std::regex& regex, const std::string& text) {
+   std::vector<std::size_t> out;
+   for (std::sregex_iterator it{text.begin(), text.end(), regex}, end; it != end; ++it) {
+      out.push_back(static_cast<std::size_t>(it->position(0)));
+      out.push_back(static_cast<std::size_t>(it->length(0)));
+   }
+   return out;
+}
+
+void row(const char* name, double bytes, double std_us, double static_us,
+         double dynamic_us) {
+   auto mbs{[&](double us) {return bytes / us;}}; // bytes per us = MB/s
+   std::printf("%-22s %9.1f MB/s %9.1f MB/s %9.1f MB/s %8.1fx %8.1fx\n", name,
+      mbs(std_us), mbs(static_us), mbs(dynamic_us), std_us / static_us,
+      std_us / dynamic_us);
+}
+
+int main(int argc, char* argv[]) {
+   const std::size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8;
+   const std::string text{make_contacts(megabytes << 20)};
+   const auto words{make_words(text, 1'000'000)};
+   std::size_t word_bytes = 0;
+   for (const auto& word : words) {
+      word_bytes += word.size();
+   }
+
+   // the patterns of fig08_16.cpp, fig08_17.cpp and fig08_18.cpp
+   const std::regex std_zip{R"(\d{5})"};
+   constexpr fx::static_regex<R"(\d{5})"> static_zip;
+   const fx::regex zip{R"(\d{5})"};
+   const std::regex std_tab{"\t"};
+   constexpr fx::static_regex<"\t"> static_tab;
+   const fx::regex tab{"\t"};
+   const std::regex std_phone{R"(\d{3}-\d{3}-\d{4})"};
+   constexpr fx::static_regex<R"(\d{3}-\d{3}-\d{4})"> static_phone;
+   const fx::regex phone{R"(\d{3}-\d{3}-\d{4})"};
+   const std::regex std_sue{"Sue", std::regex_constants::icase};
+   constexpr fx::static_regex<"Sue", fx::syntax_option::icase> static_sue;
+   const fx::regex sue{"Sue", fx::syntax_option::icase};
+
+   // identical results
+   std::size_t std_matches = 0;
+   std::size_t static_matches = 0;
+   std::size_t matches = 0;
+   for (const auto& word : words) {
+      std_matches += std::regex_match(word, std_zip);
+      static_matches += static_zip.match(word);
+      matches += zip.match(word);
+   }
+   const std::string replaced{std::regex_replace(text, std_tab, ",")};
+   const auto phones{std_positions(std_phone, text)};
+   const auto sues{std_positions(std_sue, text)};
+   if (static_matches != std_matches || matches != std_matches ||
+       static_tab.replace(text, ",") != replaced || tab.replace(text, ",") != replaced ||
+       fx_positions(static_phone, text) != phones || fx_positions(phone, text) != phones ||
+       fx_positions(static_sue, text) != sues || fx_positions(sue, text) != sues) {
+      std::cerr << "mismatch\n";
+      return 1;
+   }
+   std::printf("%zu MB of contacts: %zu phone numbers, %zu Sue/SUE, "
+      "%zu of %zu words are ZIP codes\n\n", megabytes, phones.size() / 2,
+      sues.size() / 2, std_matches, words.size());
+
+   std::printf("%-22s %14s %14s %14s %9s %9s\n", "operation", "std::regex",
+      "static_regex", "regex", "static", "regex");
+   std::size_t sink = 0;
+
+   row("match \\d{5} per word", static_cast<double>(word_bytes),
+      time_us([&] {
+         for (const auto& word : words) {
+            sink += std::regex_match(word, std_zip);
+         }
+      }),
+      time_us([&] {
+         for (const auto& word : words) {
+            sink += static_zip.match(word);
+         }
+      }),
+      time_us([&] {
+         for (const auto& word : words) {
+            sink += zip.match(word);
+         }
+      }));
+
+   const double bytes = static_cast<double>(text.size());
+   row("replace \\t with ,", bytes,
+      time_us([&] {sink += std::regex_replace(text, std_tab, ",").size();}),
+      time_us([&] {sink += static_tab.replace(text, ",").size();}),
+      time_us([&] {sink += tab.replace(text, ",").size();}));
+
+   row("find all phones", bytes,
+      time_us([&] {sink += std_positions(std_phone, text).size();}),
+      time_us([&] {sink += fx_positions(static_phone, text).size();}),
+      time_us([&] {sink += fx_positions(phone, text).size();}));
+
+   row("find all Sue, icase", bytes,
+      time_us([&] {sink += std_positions(std_sue, text).size();}),
+      time_us([&] {sink += fx_positions(static_sue, text).size();}),
+      time_us([&] {sink += fx_positions(sue, text).size();}));
+
+   if (sink == 42) {
+      std::puts("");
+   }
+}
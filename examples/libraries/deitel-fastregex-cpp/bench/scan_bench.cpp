@@ -0,0 +1,147 @@
+// scan_bench.cpp
+// Finds all phone numbers in generated server logs, as fig08_18.cpp does
+// in a contact string: with fig08_18.cpp's regex_search/suffix() loop,
+// with std::sregex_iterator, and with fx::static_regex::find_all over a
+// std::string, a mapped_file and a std::ifstream read in chunks. All
+// must report the same matches.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O2 -Iinclude bench/scan_bench.cpp -o scan_bench
+// Run (optional largest log size in MB, default 64):
+//   ./scan_bench 64
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <string_view>
+#include "fastregex/fastregex.hpp"
+#include "bench_util.hpp"
+
+namespace fx = deitel::fastregex;
+
+// Log lines; about one in 40 mentions a phone number.
+std::string make_log(std::size_t bytes) {
+   std::string text;
+   unsigned seed = 2026;
+   auto next{[&] {return seed = seed * 1103515245 + 12345, seed >> 8;}};
+   char line[128];
+   while (text.size() < bytes) {
+      const unsigned r = next();
+      if (r % 40 == 0) {
+         std::snprintf(line, sizeof line,
+            "08:%02u:%02u WARN  worker-%u callback requested at %03u-%03u-%04u\n",
+            r % 60, next() % 60, next() % 16, next() % 1000, next() % 1000,
+            next() % 10000);
+      }
+      else {
+         std::snprintf(line, sizeof line,
+            "08:%02u:%02u INFO  worker-%u request %u served in %u ms\n",
+            r % 60, next() % 60, next() % 16, next() % 100000, next() % 500);
+      }
+      text += line;
+   }
+   return text;
+}
+
+// Count and sum of positions of the matches, to compare the scans.
+struct checksum {
+   std::size_t count{0};
+   std::size_t positions{0};
+
+   void add(std::size_t position) {
+      ++count;
+      positions += position;
+   }
+
+   bool operator==(const checksum&) const = default;
+};
+
+int main(int argc, char* argv[]) {
+   const std::size_t max_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+   const auto path{std::filesystem::temp_directory_path() / "scan_bench.log"};
+
+   const std::regex std_phone{R"(\d{3}-\d{3}-\d{4})"};
+   constexpr fx::static_regex<R"(\d{3}-\d{3}-\d{4})"> phone;
+
+   // fig08_18.cpp: search, then continue in a copy of the suffix
+   auto suffix_loop{[&](std::string contact) {
+      checksum sum;
+      std::size_t offset = 0;
+      std::smatch match;
+      while (std::regex_search(contact, match, std_phone)) {
+         sum.add(offset + static_cast<std::size_t>(match.position(0)));
+         offset += static_cast<std::size_t>(match.position(0) + match.length(0));
+         contact = match.suffix();
+      }
+      return sum;
+   }};
+   auto iterator{[&](const std::string& text) {
+      checksum sum;
+      for (std::sregex_iterator it{text.begin(), text.end(), std_phone}, end;
+           it != end; ++it) {
+         sum.add(static_cast<std::size_t>(it->position(0)));
+      }
+      return sum;
+   }};
+   auto find_all{[&](std::string_view text) {
+      checksum sum;
+      for (const auto& m : phone.find_all(text)) {
+         sum.add(m.position);
+      }
+      return sum;
+   }};
+   auto mapped{[&] {
+      const fx::mapped_file file{path};
+      return find_all(file.view());
+   }};
+   auto streamed{[&] {
+      std::ifstream in{path, std::ios::binary};
+      checksum sum;
+      for (const auto& m : phone.find_all(in)) {
+         sum.add(m.position);
+      }
+      return sum;
+   }};
+
+   std::printf("%8s %9s %12s %12s %12s %12s %12s %12s\n", "size", "matches",
+      "count '\\n'", "suffix loop", "sregex_iter", "find_all", "mapped", "stream");
+   for (std::size_t mb = 1; mb <= max_mb; mb *= 4) {
+      const std::string text{make_log(mb << 20)};
+      std::ofstream{path, std::ios::binary} << text;
+
+      // the suffix loop is quadratic: only run it on small logs
+      const bool quadratic = mb <= 4;
+      const checksum expected{find_all(text)};
+      if (iterator(text) != expected || mapped() != expected ||
+          streamed() != expected || (quadratic && suffix_loop(text) != expected)) {
+         std::cerr << "mismatch at " << mb << " MB\n";
+         return 1;
+      }
+
+      const double bytes = static_cast<double>(text.size());
+      std::size_t sink = 0;
+      auto mbs{[&](double us) {return bytes / us;}}; // bytes per us = MB/s
+      std::printf("%5zu MB %9zu %7.0f MB/s", mb, expected.count,
+         mbs(time_us([&] {sink += std::count(text.begin(), text.end(), '\n');})));
+      if (quadratic) {
+         std::printf(" %7.1f MB/s", mbs(time_us([&] {sink += suffix_loop(text).count;})));
+      }
+      else {
+         std::printf(" %12s", "-");
+      }
+      std::printf(" %7.1f MB/s %7.0f MB/s %7.0f MB/s %7.0f MB/s\n",
+         mbs(time_us([&] {sink += iterator(text).count;})),
+         mbs(time_us([&] {sink += find_all(text).count;})),
+         mbs(time_us([&] {sink += mapped().count;})),
+         mbs(time_us([&] {sink += streamed().count;})));
+      if (sink == 42) {
+         std::puts("");
+      }
+   }
+   std::filesystem::remove(path);
+}
@@ -0,0 +1,636 @@
+#pragma once
+/**
+ * @file automaton.hpp
+ * @brief Compiling syntax trees to NFA programs and determinizing them.
+ *
+ * A syntax tree is compiled to a Thompson NFA program (set, split, jump
+ * and match instructions, as in a Pike VM). Subset construction turns
+ * the program into a DFA whose states are *ordered* lists of NFA
+ * threads, highest priority first. In leftmost-first mode a thread that
+ * reaches match cuts off all lower-priority threads, so the DFA reports
+ * the same match end as a backtracking ECMAScript matcher such as
+ * std::regex, without backtracking. In longest mode nothing is cut.
+ *
+ * Input bytes are grouped into equivalence classes (bytes no
+ * instruction distinguishes share a class), so a DFA row has one column
+ * per class plus two for the bot/eot pseudo symbols fed at the
+ * beginning and end of the input, which the ^ and $ anchors consume.
+ *
+ * dfa_builder is constexpr: static_regex determinizes its whole DFA
+ * during compilation, and lazy_dfa builds states on demand at run time.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "syntax.hpp"
+
+namespace deitel::fastregex::automaton_detail {
+
+using syntax_detail::charset;
+using syntax_detail::node;
+using syntax_detail::syntax_tree;
+
+/// One NFA instruction. mark is never executed: dfa_builder appends one
+/// to its program and puts its pc in front of the states the bot symbol
+/// leads to, which are still at the beginning of the input.
+struct inst {
+   enum op_t { set, bot, eot, split, jump, match, mark };
+
+   op_t op{match};
+   int x{0};         ///< split: preferred target; jump: target
+   int y{0};         ///< split: other target
+   charset chars{};  ///< set: the bytes consumed
+};
+
+/// An NFA program starting at instruction 0.
+struct program {
+   std::vector<inst> code;
+   int pattern{0}; ///< first instruction after the unanchored prefix
+};
+
+/// Largest program accepted, to bound the cost of {n,m} expansion.
+inline constexpr std::size_t max_program = 20000;
+
+/**
+ * @brief Compile a syntax tree to a program.
+ *
+ * @param reverse compile the reversed language, for matching backward;
+ *        the ^ and $ anchors then consume eot and bot.
+ * @param unanchored prefix the program with a lazy loop over any byte,
+ *        so one forward pass finds the leftmost match.
+ */
+constexpr program compile(const syntax_tree& tree, bool reverse, bool unanchored)
+{
+   struct compiler {
+      const syntax_tree& tree;
+      bool reverse;
+      program result{};
+
+      constexpr int emit(inst i)
+      {
+         if (result.code.size() == max_program) {
+            throw regex_error{"fastregex: pattern too large"};
+         }
+         result.code.push_back(i);
+         return static_cast<int>(result.code.size() - 1);
+      }
+
+      constexpr int here() const { return static_cast<int>(result.code.size()); }
+
+      constexpr void node_at(int index)
+      {
+         const node& n = tree.nodes[static_cast<std::size_t>(index)];
+         switch (n.kind) {
+            case node::empty:
+               break;
+            case node::set:
+               emit({inst::set, 0, 0, n.chars});
+               break;
+            case node::bot:
+               emit({reverse ? inst::eot : inst::bot});
+               break;
+            case node::eot:
+               emit({reverse ? inst::bot : inst::eot});
+               break;
+            case node::concat:
+               if (reverse) {
+                  for (auto child = n.children.rbegin(); child != n.children.rend(); ++child) {
+                     node_at(*child);
+                  }
+               }
+               else {
+                  for (int child : n.children) {
+                     node_at(child);
+                  }
+               }
+               break;
+            case node::alternate: {
+               // split L1, next; L1: a; jump end; next: split L2, ...
+               std::vector<int> jumps;
+               for (std::size_t i = 0; i < n.children.size(); ++i) {
+                  if (i + 1 < n.children.size()) {
+                     const int fork = emit({inst::split});
+                     result.code[static_cast<std::size_t>(fork)].x = fork + 1;
+                     node_at(n.children[i]);
+                     jumps.push_back(emit({inst::jump}));
+                     result.code[static_cast<std::size_t>(fork)].y = here();
+                  }
+                  else {
+                     node_at(n.children[i]);
+                  }
+               }
+               for (int jump : jumps) {
+                  result.code[static_cast<std::size_t>(jump)].x = here();
+               }
+               break;
+            }
+            case node::repeat: {
+               const int body = n.children.front();
+               for (int i = 0; i < n.min; ++i) {
+                  node_at(body);
+               }
+               if (n.max == -1) {
+                  // loop: split body, out; body; jump loop
+                  const int loop = emit({inst::split});
+                  node_at(body);
+                  emit({inst::jump, loop});
+                  prefer(loop, loop + 1, here(), n.greedy);
+               }
+               else {
+                  // up to max - min optional copies, each skipping to the end
+                  std::vector<int> forks;
+                  for (int i = n.min; i < n.max; ++i) {
+                     forks.push_back(emit({inst::split}));
+                     node_at(body);
+                  }
+                  for (int fork : forks) {
+                     prefer(fork, fork + 1, here(), n.greedy);
+                  }
+               }
+               break;
+            }
+         }
+      }
+
+      constexpr void prefer(int fork, int more, int out, bool greedy)
+      {
+         auto& i = result.code[static_cast<std::size_t>(fork)];
+         i.x = greedy ? more : out;
+         i.y = greedy ? out : more;
+      }
+   };
+
+   compiler c{tree, reverse};
+   if (unanchored) {
+      // 0: split 3, 1   1: any byte   2: jump 0   3: pattern
+      charset any{};
+      any.add_range(0, 255);
+      c.emit({inst::split, 3, 1});
+      c.emit({inst::set, 0, 0, any});
+      c.emit({inst::jump, 0});
+      c.result.pattern = c.here();
+   }
+   c.node_at(tree.root);
+   c.emit({inst::match});
+   return std::move(c.result);
+}
+
+/// Equivalence classes of the 256 byte values.
+struct byte_classes {
+   std::array<std::uint8_t, 256> map{};            ///< byte -> class
+   std::array<std::uint8_t, 256> representative{}; ///< class -> a byte
+   unsigned count{0};
+
+   /// Symbols of a DFA row: the classes, then bot, then eot.
+   constexpr unsigned bot() const { return count; }
+   constexpr unsigned eot() const { return count + 1; }
+   constexpr unsigned symbols() const { return count + 2; }
+};
+
+/// Split the bytes into ranges that no set instruction distinguishes.
+constexpr byte_classes classify(const program& p)
+{
+   byte_classes result{};
+   unsigned current = 0;
+   for (unsigned byte = 1; byte < 256; ++byte) {
+      for (const inst& i : p.code) {
+         if (i.op == inst::set && i.chars.contains(byte) != i.chars.contains(byte - 1)) {
+            result.representative[++current] = static_cast<std::uint8_t>(byte);
+            break;
+         }
+      }
+      result.map[byte] = static_cast<std::uint8_t>(current);
+   }
+   result.count = current + 1;
+   return result;
+}
+
+/// The bytes no set instruction consumes. For an anchored program no
+/// match contains them.
+constexpr std::array<bool, 256> barriers(const program& p)
+{
+   std::array<bool, 256> result{};
+   for (unsigned byte = 0; byte < 256; ++byte) {
+      result[byte] = true;
+      for (const inst& i : p.code) {
+         if (i.op == inst::set && i.chars.contains(byte)) {
+            result[byte] = false;
+            break;
+         }
+      }
+   }
+   return result;
+}
+
+/**
+ * @brief Subset construction over a program, one state at a time.
+ *
+ * State 0 is the dead state (no threads). States are interned, so equal
+ * thread lists get the same id.
+ *
+ * An anchor is satisfied by the pseudo symbol of its position or by an
+ * earlier one at the same position: ^ passes in the closures of the bot
+ * step, and of an eot step from a state still at the beginning (an empty
+ * input); $ passes in the closures of the eot step. So ^^a, a$$,
+ * (^|x)^a and $^ match as they do with std::regex.
+ */
+class dfa_builder {
+public:
+   constexpr dfa_builder(program p, bool leftmost_first)
+      : program_{with_mark(std::move(p))}, classes_{classify(program_)},
+        leftmost_first_{leftmost_first},
+        mark_{static_cast<int>(program_.code.size() - 1)},
+        marks_(program_.code.size(), 0)
+   {
+      reset();
+   }
+
+   constexpr const byte_classes& classes() const { return classes_; }
+   constexpr std::size_t size() const { return states_.size(); }
+   constexpr bool accepting(int state) const
+   {
+      return accepting_[static_cast<std::size_t>(state)] != 0;
+   }
+
+   /// The threads of a state, highest priority first.
+   constexpr const std::vector<int>& threads(int state) const
+   {
+      return states_[static_cast<std::size_t>(state)];
+   }
+
+   /// Drop every state but the dead one.
+   constexpr void reset()
+   {
+      states_.assign(1, {});
+      accepting_.assign(1, 0);
+      slots_.assign(64, -1);
+   }
+
+   /// The state before any input.
+   constexpr int start()
+   {
+      begin_list();
+      add_closure(0);
+      return intern(list_);
+   }
+
+   /**
+    * @brief The state before any input of a search for a non-empty match
+    *        anchored where it starts, as std::regex_search with
+    *        match_not_null | match_continuous.
+    *
+    * The threads start after the unanchored prefix and the match
+    * instruction is left out of the closures of the start state and, at
+    * the beginning of the input, of the bot step, instead of cutting off
+    * the lower-priority threads: those are the alternatives a
+    * backtracking matcher tries after rejecting the empty match.
+    *
+    * @param at_bot the search starts at the beginning of the input; the
+    *        returned state has already consumed bot.
+    */
+   constexpr int not_null_start(bool at_bot)
+   {
+      begin_list();
+      not_null_ = true;
+      add_closure(program_.pattern);
+      const int state = intern(list_);
+      return at_bot ? advance(state, classes_.bot(), true) : state;
+   }
+
+   /// The state after symbol, a byte class or classes().bot()/eot().
+   constexpr int step(int state, unsigned symbol)
+   {
+      return advance(state, symbol, false);
+   }
+
+   /// Intern a thread list, e.g. one saved before reset().
+   constexpr int intern(const std::vector<int>& threads)
+   {
+      if (threads.empty()) {
+         return 0;
+      }
+      std::size_t mask = slots_.size() - 1;
+      std::size_t slot = hash(threads) & mask;
+      while (slots_[slot] != -1) {
+         if (states_[static_cast<std::size_t>(slots_[slot])] == threads) {
+            return slots_[slot];
+         }
+         slot = (slot + 1) & mask;
+      }
+
+      const int id = static_cast<int>(states_.size());
+      bool match = false;
+      for (int pc : threads) {
+         match = match || program_.code[static_cast<std::size_t>(pc)].op == inst::match;
+      }
+      states_.push_back(threads);
+      accepting_.push_back(match ? 1 : 0);
+      slots_[slot] = id;
+
+      if (states_.size() * 2 > slots_.size()) {
+         slots_.assign(slots_.size() * 2, -1);
+         mask = slots_.size() - 1;
+         for (std::size_t s = 1; s < states_.size(); ++s) {
+            std::size_t free = hash(states_[s]) & mask;
+            while (slots_[free] != -1) {
+               free = (free + 1) & mask;
+            }
+            slots_[free] = static_cast<int>(s);
+         }
+      }
+      return id;
+   }
+
+private:
+   static constexpr program with_mark(program p)
+   {
+      p.code.push_back({inst::mark});
+      return p;
+   }
+
+   /// step(), leaving the match instruction out of the closures if
+   /// not_null.
+   constexpr int advance(int state, unsigned symbol, bool not_null)
+   {
+      begin_list();
+      not_null_ = not_null;
+      const bool byte = symbol < classes_.count;
+      const bool at_bot = symbol == classes_.bot();
+      const bool at_eot = symbol == classes_.eot();
+      const unsigned representative = byte ? classes_.representative[symbol] : 0;
+      const std::vector<int>& threads = states_[static_cast<std::size_t>(state)];
+      pass_bot_ = at_bot || (at_eot && !threads.empty() && threads.front() == mark_);
+      pass_eot_ = at_eot;
+
+      for (int pc : threads) {
+         const inst& i = program_.code[static_cast<std::size_t>(pc)];
+         switch (i.op) {
+            case inst::match:
+               // the input ends here for this thread; in leftmost-first
+               // mode the lower-priority threads are cut off
+               if (at_bot) {
+                  keep(pc);
+               }
+               if (leftmost_first_) {
+                  return finish(at_bot);
+               }
+               break;
+            case inst::set:
+               // bytes advance the thread, bot passes through it
+               if (byte && i.chars.contains(representative)) {
+                  add_closure(pc + 1);
+               }
+               else if (at_bot) {
+                  keep(pc);
+               }
+               break;
+            case inst::bot:
+               if (pass_bot_) {
+                  add_closure(pc + 1);
+               }
+               break;
+            case inst::eot:
+               if (at_eot) {
+                  add_closure(pc + 1);
+               }
+               else if (at_bot) {
+                  keep(pc);
+               }
+               break;
+            default:
+               break;
+         }
+      }
+      return finish(at_bot);
+   }
+
+   /// Intern the list built by a step; after bot, marked as still at the
+   /// beginning of the input.
+   constexpr int finish(bool at_bot)
+   {
+      if (at_bot && !list_.empty()) {
+         list_.insert(list_.begin(), mark_);
+      }
+      return intern(list_);
+   }
+
+   static constexpr std::size_t hash(const std::vector<int>& threads)
+   {
+      std::uint64_t h = 14695981039346656037ull;
+      for (int pc : threads) {
+         h = (h ^ static_cast<std::uint64_t>(pc)) * 1099511628211ull;
+      }
+      return static_cast<std::size_t>(h ^ (h >> 29));
+   }
+
+   constexpr void begin_list()
+   {
+      list_.clear();
+      cut_ = false;
+      not_null_ = false;
+      pass_bot_ = false;
+      pass_eot_ = false;
+      if (++generation_ == 0) {
+         marks_.assign(marks_.size(), 0);
+         generation_ = 1;
+      }
+   }
+
+   /// Add the thread at pc, which is already part of a closure.
+   constexpr void keep(int pc)
+   {
+      auto& mark = marks_[static_cast<std::size_t>(pc)];
+      if (mark != generation_) {
+         mark = generation_;
+         push(pc);
+      }
+   }
+
+   /// Add the threads reachable from pc without input, in priority order.
+   constexpr void add_closure(int pc)
+   {
+      stack_.push_back(pc);
+      while (!stack_.empty()) {
+         const int top = stack_.back();
+         stack_.pop_back();
+         auto& mark = marks_[static_cast<std::size_t>(top)];
+         if (mark == generation_) {
+            continue;
+         }
+         mark = generation_;
+         const inst& i = program_.code[static_cast<std::size_t>(top)];
+         if (i.op == inst::split) {
+            stack_.push_back(i.y);
+            stack_.push_back(i.x);
+         }
+         else if (i.op == inst::jump) {
+            stack_.push_back(i.x);
+         }
+         else if ((i.op == inst::bot && pass_bot_) || (i.op == inst::eot && pass_eot_)) {
+            // an anchor met again at the position that satisfied it
+            stack_.push_back(top + 1);
+         }
+         else {
+            push(top);
+         }
+      }
+   }
+
+   constexpr void push(int pc)
+   {
+      const bool match = program_.code[static_cast<std::size_t>(pc)].op == inst::match;
+      if (cut_ || (match && not_null_)) {
+         return;
+      }
+      list_.push_back(pc);
+      if (leftmost_first_ && match) {
+         cut_ = true;
+      }
+   }
+
+   program program_;
+   byte_classes classes_;
+   bool leftmost_first_;
+   int mark_;
+   std::vector<std::vector<int>> states_{};
+   std::vector<char> accepting_{};
+   std::vector<int> slots_{};
+   std::vector<unsigned> marks_;
+   unsigned generation_{0};
+   std::vector<int> list_{};
+   std::vector<int> stack_{};
+   bool cut_{false};
+   bool not_null_{false}; ///< leave match out of the list being built
+   bool pass_bot_{false}; ///< the closure being built is at the beginning
+   bool pass_eot_{false}; ///< the closure being built is at the end
+};
+
+/// A fully determinized DFA in a dense transition table.
+struct dense_dfa {
+   byte_classes classes;
+   std::vector<int> next;       ///< state * symbols + symbol -> state
+   std::vector<char> accepting;
+   int start{0};
+   std::array<int, 2> not_null_start{}; ///< by at_bot, leftmost-first only
+};
+
+/// Largest DFA static_regex builds during compilation.
+inline constexpr std::size_t max_static_states = 4096;
+
+constexpr dense_dfa determinize(program p, bool leftmost_first)
+{
+   dfa_builder builder{std::move(p), leftmost_first};
+   dense_dfa result{};
+   result.classes = builder.classes();
+   result.start = builder.start();
+   if (leftmost_first) {
+      result.not_null_start = {builder.not_null_start(false),
+                               builder.not_null_start(true)};
+   }
+   const unsigned symbols = builder.classes().symbols();
+   for (std::size_t state = 0; state < builder.size(); ++state) {
+      if (builder.size() > max_static_states) {
+         throw regex_error{"fastregex: pattern needs too many DFA states"};
+      }
+      for (unsigned symbol = 0; symbol < symbols; ++symbol) {
+         result.next.push_back(builder.step(static_cast<int>(state), symbol));
+      }
+      result.accepting.push_back(builder.accepting(static_cast<int>(state)) ? 1 : 0);
+   }
+   return result;
+}
+
+/**
+ * @brief A DFA whose states and transitions are built on first use and
+ *        cached in a dense table; when the cache holds max_states states
+ *        it is cleared and rebuilt from the current state.
+ */
+class lazy_dfa {
+public:
+   lazy_dfa(program p, bool leftmost_first, std::size_t max_states = 10000)
+      : builder_{std::move(p), leftmost_first},
+        symbols_{builder_.classes().symbols()}, max_states_{max_states}
+   {
+      table_.assign(symbols_, 0);
+      const int initial = start();
+      if (!accepting(initial)) {
+         for (unsigned byte = 0; byte < 256; ++byte) {
+            idle_[byte] = next(initial, symbol(static_cast<char>(byte))) == initial;
+         }
+      }
+   }
+
+   int start()
+   {
+      if (start_ < 0) {
+         start_ = builder_.start();
+         grow();
+      }
+      return start_;
+   }
+
+   /// See dfa_builder::not_null_start().
+   int not_null_start(bool at_bot)
+   {
+      int& state = not_null_[at_bot ? 1 : 0];
+      if (state < 0) {
+         state = builder_.not_null_start(at_bot);
+         grow();
+      }
+      return state;
+   }
+
+   int next(int state, unsigned symbol)
+   {
+      const int target = table_[static_cast<std::size_t>(state) * symbols_ + symbol];
+      return target >= 0 ? target : add(state, symbol);
+   }
+
+   bool accepting(int state) const { return builder_.accepting(state); }
+   unsigned symbol(char c) const
+   {
+      return builder_.classes().map[static_cast<unsigned char>(c)];
+   }
+   unsigned bot() const { return builder_.classes().bot(); }
+   unsigned eot() const { return builder_.classes().eot(); }
+
+   /// Whether c leaves a non-accepting start state unchanged.
+   bool idle(char c) const { return idle_[static_cast<unsigned char>(c)]; }
+
+   /// Number of cached states.
+   std::size_t size() const { return builder_.size(); }
+
+private:
+   int add(int state, unsigned symbol)
+   {
+      if (builder_.size() >= max_states_) {
+         const std::vector<int> threads{builder_.threads(state)};
+         builder_.reset();
+         table_.assign(symbols_, 0);
+         start_ = -1;
+         not_null_ = {-1, -1};
+         state = builder_.intern(threads);
+         grow();
+      }
+      const int target = builder_.step(state, symbol);
+      grow();
+      table_[static_cast<std::size_t>(state) * symbols_ + symbol] = target;
+      return target;
+   }
+
+   void grow() { table_.resize(builder_.size() * symbols_, -1); }
+
+   dfa_builder builder_;
+   std::size_t symbols_;
+   std::size_t max_states_;
+   std::vector<int> table_;
+   int start_{-1};
+   std::array<int, 2> not_null_{-1, -1};
+   std::array<bool, 256> idle_{};
+};
+
+} // namespace deitel::fastregex::automaton_detail
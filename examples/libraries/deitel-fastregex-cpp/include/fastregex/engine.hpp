@@ -0,0 +1,323 @@
+#pragma once
+/**
+ * @file engine.hpp
+ * @brief Matching, searching, iteration and replacement over DFAs.
+ *
+ * The algorithms here work with any pair of DFAs providing
+ *
+ *   start(), next(state, symbol), accepting(state),
+ *   symbol(char), bot(), eot(), idle(char)
+ *
+ * (and, for the forward DFA, not_null_start(at_bot)) with state 0 dead: the compile-time tables of static_regex and the
+ * lazily built ones of regex. A search makes two passes:
+ *
+ *   1. the forward, unanchored, leftmost-first DFA runs from the search
+ *      position until it dies, remembering the last accepting position,
+ *      which is where the leftmost-first match ends; while it is in its
+ *      start state, the idle bytes, which leave it there, are skipped in
+ *      a tight loop (for a phone number, everything but digits);
+ *   2. the reverse DFA (the reversed pattern, anchored, longest) runs
+ *      back from that end; its last accepting position is the start.
+ *
+ * Both passes look at each byte at most once, so a search is linear in
+ * the input, unlike backtracking. Matches are the ones std::regex (the
+ * ECMAScript grammar) finds.
+ */
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace deitel::fastregex {
+
+/// A match within an input, the counterpart of std::match_results.
+struct match_result {
+   static constexpr std::size_t npos = std::string_view::npos;
+
+   std::string_view input{};
+   std::size_t position{npos}; ///< npos if there was no match
+   std::size_t length{0};
+
+   constexpr explicit operator bool() const { return position != npos; }
+
+   /// One past the last matched character.
+   constexpr std::size_t end() const { return position + length; }
+
+   /// The matched characters, a view into the input.
+   constexpr std::string_view str() const { return input.substr(position, length); }
+
+   /// The input before the match.
+   constexpr std::string_view prefix() const { return input.substr(0, position); }
+
+   /// The input after the match.
+   constexpr std::string_view suffix() const { return input.substr(end()); }
+};
+
+namespace engine_detail {
+
+inline constexpr std::size_t npos = match_result::npos;
+
+/// End of the leftmost-first match at or after from, or npos.
+template <typename Forward>
+constexpr std::size_t find_end(Forward& forward, std::string_view text,
+                               std::size_t from)
+{
+   int state = forward.start();
+   if (from == 0) {
+      state = forward.next(state, forward.bot());
+   }
+   std::size_t last = forward.accepting(state) ? from : npos;
+   for (std::size_t i = from; i < text.size(); ++i) {
+      if (state == forward.start()) {
+         while (forward.idle(text[i]) && ++i < text.size()) {
+         }
+         if (i == text.size()) {
+            break;
+         }
+      }
+      state = forward.next(state, forward.symbol(text[i]));
+      if (state == 0) {
+         return last;
+      }
+      if (forward.accepting(state)) {
+         last = i + 1;
+      }
+   }
+   state = forward.next(state, forward.eot());
+   return forward.accepting(state) ? text.size() : last;
+}
+
+/// Smallest start at or after from of a match ending at end, or npos;
+/// at_begin and at_end tell whether from and end are the ends of the
+/// whole input, where the ^ and $ anchors match.
+template <typename Reverse>
+constexpr std::size_t find_start(Reverse& reverse, std::string_view text,
+                                 std::size_t from, std::size_t end,
+                                 bool at_begin, bool at_end)
+{
+   int state = reverse.start();
+   if (at_end) {
+      state = reverse.next(state, reverse.bot());
+   }
+   std::size_t first = reverse.accepting(state) ? end : npos;
+   for (std::size_t i = end; i > from; --i) {
+      state = reverse.next(state, reverse.symbol(text[i - 1]));
+      if (state == 0) {
+         return first;
+      }
+      if (reverse.accepting(state)) {
+         first = i - 1;
+      }
+   }
+   if (at_begin && reverse.accepting(reverse.next(state, reverse.eot()))) {
+      first = from;
+   }
+   return first;
+}
+
+/// Smallest start at or after from of a match ending at end, or npos.
+template <typename Reverse>
+constexpr std::size_t find_start(Reverse& reverse, std::string_view text,
+                                 std::size_t from, std::size_t end)
+{
+   return find_start(reverse, text, from, end, from == 0, end == text.size());
+}
+
+/// Whether the whole text matches.
+template <typename Reverse>
+constexpr bool full_match(Reverse& reverse, std::string_view text)
+{
+   return find_start(reverse, text, 0, text.size()) == 0;
+}
+
+/// The leftmost-first match at or after from.
+template <typename Forward, typename Reverse>
+constexpr match_result search(Forward& forward, Reverse& reverse,
+                              std::string_view text, std::size_t from)
+{
+   if (from > text.size()) {
+      return {text};
+   }
+   const std::size_t end = find_end(forward, text, from);
+   if (end == npos) {
+      return {text};
+   }
+   const std::size_t start = find_start(reverse, text, from, end);
+   return {text, start, end - start};
+}
+
+/// End of the leftmost-first non-empty match starting at from, or npos:
+/// std::regex_search with match_not_null | match_continuous.
+template <typename Forward>
+constexpr std::size_t find_not_null_end(Forward& forward, std::string_view text,
+                                        std::size_t from)
+{
+   if (from >= text.size()) {
+      return npos;
+   }
+   int state = forward.not_null_start(from == 0);
+   std::size_t last = npos;
+   for (std::size_t i = from; i < text.size(); ++i) {
+      state = forward.next(state, forward.symbol(text[i]));
+      if (state == 0) {
+         return last;
+      }
+      if (forward.accepting(state)) {
+         last = i + 1;
+      }
+   }
+   state = forward.next(state, forward.eot());
+   return forward.accepting(state) ? text.size() : last;
+}
+
+/// The match after m, as std::regex_iterator finds it: the next match
+/// from m's end, except that after an empty match a non-empty match at
+/// the same position comes first, then a search one position further.
+template <typename Forward, typename Reverse>
+constexpr match_result next_match(Forward& forward, Reverse& reverse,
+                                  const match_result& m)
+{
+   if (m.length != 0) {
+      return search(forward, reverse, m.input, m.end());
+   }
+   const std::size_t end = find_not_null_end(forward, m.input, m.position);
+   if (end != npos) {
+      return {m.input, m.position, end - m.position};
+   }
+   return search(forward, reverse, m.input, m.position + 1);
+}
+
+/// Append format with $& (the match), $` (the text since the previous
+/// match), $' (the text after the match) and $$ expanded, as in
+/// std::regex_replace.
+inline void append_format(std::string& out, std::string_view format,
+                          const match_result& m, std::size_t previous)
+{
+   for (std::size_t i = 0; i < format.size(); ++i) {
+      if (format[i] == '$' && i + 1 < format.size()) {
+         const char next = format[i + 1];
+         if (next == '&') {
+            out += m.str();
+            ++i;
+            continue;
+         }
+         if (next == '`') {
+            out += m.input.substr(previous, m.position - previous);
+            ++i;
+            continue;
+         }
+         if (next == '\'') {
+            out += m.suffix();
+            ++i;
+            continue;
+         }
+         if (next == '$') {
+            out += '$';
+            ++i;
+            continue;
+         }
+      }
+      out += format[i];
+   }
+}
+
+} // namespace engine_detail
+
+/**
+ * @brief Forward iterator over the successive matches of a regex in an
+ *        input, the counterpart of std::regex_iterator. Matches are
+ *        views into the input; nothing is copied.
+ */
+template <typename Regex>
+class match_iterator {
+public:
+   using value_type = match_result;
+   using difference_type = std::ptrdiff_t;
+   using iterator_concept = std::forward_iterator_tag;
+
+   constexpr match_iterator() = default;
+
+   constexpr match_iterator(const Regex& regex, std::string_view text)
+      : regex_{&regex}, match_{regex.search(text)}
+   {
+   }
+
+   constexpr const match_result& operator*() const { return match_; }
+   constexpr const match_result* operator->() const { return &match_; }
+
+   constexpr match_iterator& operator++()
+   {
+      match_ = engine_detail::next_match(regex_->forward_, regex_->reverse_, match_);
+      return *this;
+   }
+
+   constexpr match_iterator operator++(int)
+   {
+      auto copy{*this};
+      ++*this;
+      return copy;
+   }
+
+   constexpr bool operator==(const match_iterator& other) const
+   {
+      // an empty match and a non-empty one may start at the same position
+      return match_.position == other.match_.position &&
+             match_.length == other.match_.length;
+   }
+
+   constexpr bool operator==(std::default_sentinel_t) const { return !match_; }
+
+private:
+   const Regex* regex_{nullptr};
+   match_result match_{};
+};
+
+/// The matches of a regex in an input, as a view.
+template <typename Regex>
+class match_range : public std::ranges::view_interface<match_range<Regex>> {
+public:
+   constexpr match_range() = default;
+   constexpr match_range(const Regex& regex, std::string_view text)
+      : regex_{&regex}, text_{text}
+   {
+   }
+
+   constexpr match_iterator<Regex> begin() const { return {*regex_, text_}; }
+   constexpr std::default_sentinel_t end() const { return {}; }
+
+private:
+   const Regex* regex_{nullptr};
+   std::string_view text_{};
+};
+
+namespace engine_detail {
+
+/// Replace every match of regex in text by format, which is either a
+/// format string or a callable taking a match_result.
+template <typename Regex, typename Format>
+std::string replace(const Regex& regex, std::string_view text, Format&& format)
+{
+   std::string out;
+   out.reserve(text.size());
+   std::size_t copied = 0;
+   for (const match_result& m : match_range<Regex>{regex, text}) {
+      out.append(text, copied, m.position - copied);
+      if constexpr (std::invocable<Format&, const match_result&>) {
+         out += std::invoke(format, m);
+      }
+      else {
+         append_format(out, format, m, copied);
+      }
+      copied = m.end();
+   }
+   out.append(text, copied);
+   return out;
+}
+
+} // namespace engine_detail
+} // namespace deitel::fastregex
@@ -0,0 +1,10 @@
+#pragma once
+/**
+ * @file fastregex.hpp
+ * @brief Single header to include for the fastregex matchers.
+ */
+
+#include "literal_set.hpp"
+#include "mapped_file.hpp"
+#include "regex.hpp"
+#include "static_regex.hpp"
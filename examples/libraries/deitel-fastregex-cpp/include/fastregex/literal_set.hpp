@@ -0,0 +1,533 @@
+#pragma once
+/**
+ * @file literal_set.hpp
+ * @brief Finding many literal strings in one pass.
+ *
+ * fig08_18.cpp calls regex_search once for each of "Programming", "fun"
+ * and "fn", scanning the input once per pattern. A literal_set compiles
+ * all the strings into one Aho-Corasick automaton and reports every
+ * occurrence of every string in a single pass:
+ *
+ *   fx::literal_set words{"Programming", "fun", "fn"};
+ *   for (const auto& m : words.find_all(s1)) {
+ *      std::cout << words.literal(m.pattern) << " at " << m.position << '\n';
+ *   }
+ *
+ * The automaton is a DFA over byte classes: each input byte costs one
+ * table lookup, however many strings the set holds. While it is in its
+ * root state no occurrence is in progress, and a prefilter jumps to the
+ * next position where one may start. For up to 64 distinct 1-3 byte
+ * prefixes this is a Teddy-style SIMD search (as in Hyperscan and Rust's
+ * aho-corasick): the prefixes are spread over 8 buckets, and for each
+ * prefix byte two 16-entry tables, indexed by the low and high nibble,
+ * give the buckets containing that byte, so pshufb looks up 16 or 32
+ * positions at once and ANDs the results. Larger sets, and builds without
+ * SSSE3 or AVX2, run the automaton alone, whose loop then has no branch
+ * but the one on matches; compile with -march=native for the SIMD search.
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#include "syntax.hpp"
+
+namespace deitel::fastregex {
+
+namespace literal_detail {
+
+/// c, lowercased if icase.
+constexpr unsigned char fold(unsigned char c, bool icase)
+{
+   return icase && c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Aho-Corasick automaton with the failure links resolved into a
+ *        dense transition table; state 0 is the root.
+ */
+class automaton {
+public:
+   automaton() = default;
+
+   automaton(const std::vector<std::string>& literals, bool icase)
+   {
+      // class 0 holds the bytes no literal contains
+      for (const std::string& literal : literals) {
+         for (const char c : literal) {
+            const unsigned char byte = fold(static_cast<unsigned char>(c), icase);
+            if (map_[byte] == 0) {
+               map_[byte] = static_cast<std::uint16_t>(classes_++);
+            }
+         }
+      }
+      for (unsigned byte = 0; byte < 256; ++byte) {
+         map_[byte] = map_[fold(static_cast<unsigned char>(byte), icase)];
+      }
+
+      // the trie, with -1 for missing edges
+      std::vector<std::vector<std::size_t>> own(1);
+      next_.assign(classes_, -1);
+      for (std::size_t pattern = 0; pattern < literals.size(); ++pattern) {
+         int state = 0;
+         for (const char c : literals[pattern]) {
+            int& edge = next_[index(state, c)];
+            if (edge < 0) {
+               edge = static_cast<int>(own.size());
+               own.emplace_back();
+               next_.resize(next_.size() + classes_, -1);
+            }
+            state = next_[index(state, c)];
+         }
+         own[static_cast<std::size_t>(state)].push_back(pattern);
+      }
+
+      // breadth first, so a state's failure state is finished before it
+      std::vector<int> fail(own.size(), 0);
+      std::vector<std::vector<std::size_t>> outputs(own.size());
+      outputs[0] = own[0];
+      std::deque<int> queue;
+      for (std::size_t c = 0; c < classes_; ++c) {
+         int& edge = next_[c];
+         if (edge < 0) {
+            edge = 0;
+         }
+         else {
+            queue.push_back(edge);
+         }
+      }
+      while (!queue.empty()) {
+         const int state = queue.front();
+         queue.pop_front();
+         const auto s = static_cast<std::size_t>(state);
+         // the longest literals first, so matches ending together are
+         // reported by position
+         outputs[s] = own[s];
+         const auto& inherited = outputs[static_cast<std::size_t>(fail[s])];
+         outputs[s].insert(outputs[s].end(), inherited.begin(), inherited.end());
+         for (std::size_t c = 0; c < classes_; ++c) {
+            const int fallback = next_[static_cast<std::size_t>(fail[s]) * classes_ + c];
+            int& edge = next_[s * classes_ + c];
+            if (edge < 0) {
+               edge = fallback;
+            }
+            else {
+               fail[static_cast<std::size_t>(edge)] = fallback;
+               queue.push_back(edge);
+            }
+         }
+      }
+
+      // renumber the states, those with outputs last, so that a single
+      // comparison tells a match; a state is stored as the offset of its
+      // row, which saves a multiplication per byte
+      std::vector<std::size_t> order;
+      for (int pass = 0; pass < 2; ++pass) {
+         for (std::size_t state = 0; state < own.size(); ++state) {
+            if (outputs[state].empty() == (pass == 0)) {
+               order.push_back(state);
+            }
+         }
+         if (pass == 0) {
+            first_match_ = static_cast<int>(order.size() * classes_);
+         }
+      }
+      std::vector<int> row(own.size());
+      for (std::size_t i = 0; i < order.size(); ++i) {
+         row[order[i]] = static_cast<int>(i * classes_);
+      }
+      std::vector<int> table(next_.size());
+      offsets_.push_back(0);
+      for (std::size_t i = 0; i < order.size(); ++i) {
+         for (std::size_t c = 0; c < classes_; ++c) {
+            table[i * classes_ + c] =
+               row[static_cast<std::size_t>(next_[order[i] * classes_ + c])];
+         }
+         const auto& list = outputs[order[i]];
+         outputs_.insert(outputs_.end(), list.begin(), list.end());
+         offsets_.push_back(outputs_.size());
+      }
+      next_ = std::move(table);
+   }
+
+   /// The root state.
+   static constexpr int root = 0;
+
+   int next(int state, char c) const
+   {
+      return next_[static_cast<std::size_t>(state) + map_[static_cast<unsigned char>(c)]];
+   }
+
+   /// Whether literals end in state.
+   bool matches(int state) const { return state >= first_match_; }
+
+   /// Range [first, last) of the outputs of state.
+   std::pair<std::size_t, std::size_t> outputs(int state) const
+   {
+      const std::size_t s = static_cast<std::size_t>(state) / classes_;
+      return {offsets_[s], offsets_[s + 1]};
+   }
+
+   std::size_t output(std::size_t i) const { return outputs_[i]; }
+
+   std::size_t states() const { return offsets_.size() - 1; }
+
+private:
+   /// Entry of the trie under construction, with unnumbered states.
+   std::size_t index(int state, char c) const
+   {
+      return static_cast<std::size_t>(state) * classes_ + map_[static_cast<unsigned char>(c)];
+   }
+
+   std::array<std::uint16_t, 256> map_{}; ///< byte -> class
+   std::size_t classes_{1};
+   std::vector<int> next_;            ///< row offset -> row offsets
+   int first_match_{0};               ///< row of the first state with outputs
+   std::vector<std::size_t> offsets_; ///< state -> first output
+   std::vector<std::size_t> outputs_; ///< literal indices
+};
+
+/**
+ * @brief Teddy-style prefilter: finds the positions where the first
+ *        width bytes may be the prefix of a literal.
+ */
+class teddy {
+public:
+   static constexpr std::size_t buckets = 8;
+   static constexpr std::size_t max_prefixes = 64;
+#if defined(__AVX2__) || defined(__SSSE3__)
+   static constexpr bool simd = true;
+#else
+   static constexpr bool simd = false;
+#endif
+
+   teddy() = default;
+
+   /// Disabled (enabled() is false) without SIMD support or if there
+   /// are too many prefixes.
+   teddy(const std::vector<std::string>& literals, bool icase)
+   {
+      if (!simd || literals.empty()) {
+         return;
+      }
+      std::size_t shortest = 3;
+      for (const std::string& literal : literals) {
+         shortest = std::min(shortest, literal.size());
+      }
+      std::vector<std::string> prefixes;
+      for (const std::string& literal : literals) {
+         prefixes.push_back(literal.substr(0, shortest));
+      }
+      std::sort(prefixes.begin(), prefixes.end());
+      prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+      if (prefixes.size() > max_prefixes) {
+         return;
+      }
+
+      // similar prefixes share a bucket, which keeps the tables sparse
+      width_ = shortest;
+      for (std::size_t k = 0; k < prefixes.size(); ++k) {
+         const auto bit = static_cast<std::uint8_t>(1u << (k * buckets / prefixes.size()));
+         for (std::size_t j = 0; j < width_; ++j) {
+            const auto byte = static_cast<unsigned char>(prefixes[k][j]);
+            add(j, byte, bit);
+            if (icase && byte >= 'a' && byte <= 'z') {
+               add(j, static_cast<unsigned char>(byte - 'a' + 'A'), bit);
+            }
+         }
+      }
+   }
+
+   bool enabled() const { return width_ > 0; }
+
+   /// The first candidate position at or after from, or text.size().
+   std::size_t find(std::string_view text, std::size_t from) const
+   {
+      const std::size_t n = text.size();
+      if (n < width_) {
+         return n;
+      }
+      const std::size_t last = n - width_; // literals are at least width long
+      std::size_t i = from;
+#if defined(__AVX2__)
+      const __m256i nibble = _mm256_set1_epi8(0x0f);
+      for (; i + 31 <= last; i += 32) {
+         __m256i found = _mm256_set1_epi8(-1);
+         for (std::size_t j = 0; j < width_; ++j) {
+            const __m256i low = _mm256_broadcastsi128_si256(
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_[j].data())));
+            const __m256i high = _mm256_broadcastsi128_si256(
+               _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_[j].data())));
+            const __m256i v = _mm256_loadu_si256(
+               reinterpret_cast<const __m256i*>(text.data() + i + j));
+            found = _mm256_and_si256(found, _mm256_and_si256(
+               _mm256_shuffle_epi8(low, _mm256_and_si256(v, nibble)),
+               _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble))));
+         }
+         const auto empty = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(found, _mm256_setzero_si256())));
+         if (empty != 0xffffffffu) {
+            return i + static_cast<std::size_t>(std::countr_one(empty));
+         }
+      }
+#elif defined(__SSSE3__)
+      const __m128i nibble = _mm_set1_epi8(0x0f);
+      for (; i + 15 <= last; i += 16) {
+         __m128i found = _mm_set1_epi8(-1);
+         for (std::size_t j = 0; j < width_; ++j) {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low_[j].data()));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high_[j].data()));
+            const __m128i v = _mm_loadu_si128(
+               reinterpret_cast<const __m128i*>(text.data() + i + j));
+            found = _mm_and_si128(found, _mm_and_si128(
+               _mm_shuffle_epi8(low, _mm_and_si128(v, nibble)),
+               _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(v, 4), nibble))));
+         }
+         const auto empty = static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(found, _mm_setzero_si128())));
+         if (empty != 0xffffu) {
+            return i + static_cast<std::size_t>(std::countr_one(empty));
+         }
+      }
+#endif
+      for (; i <= last; ++i) {
+         if (candidate(text, i)) {
+            return i;
+         }
+      }
+      return n;
+   }
+
+private:
+   void add(std::size_t j, unsigned char byte, std::uint8_t bit)
+   {
+      low_[j][byte & 0x0f] |= bit;
+      high_[j][byte >> 4] |= bit;
+   }
+
+   bool candidate(std::string_view text, std::size_t i) const
+   {
+      std::uint8_t found = 0xff;
+      for (std::size_t j = 0; j < width_; ++j) {
+         const auto byte = static_cast<unsigned char>(text[i + j]);
+         found &= low_[j][byte & 0x0f] & high_[j][byte >> 4];
+      }
+      return found != 0;
+   }
+
+   std::size_t width_{0}; ///< prefix bytes compared, 1 to 3; 0 if disabled
+   std::array<std::array<std::uint8_t, 16>, 3> low_{};
+   std::array<std::array<std::uint8_t, 16>, 3> high_{};
+};
+
+/// The automaton, its prefilter and the literal lengths.
+struct matcher {
+   automaton ac;
+   teddy prefilter;
+   std::vector<std::size_t> lengths;
+};
+
+} // namespace literal_detail
+
+/// An occurrence of a literal of a literal_set.
+struct literal_match {
+   static constexpr std::size_t npos = std::string_view::npos;
+
+   std::string_view input{};
+   std::size_t pattern{0};     ///< index of the literal in the set
+   std::size_t position{npos}; ///< npos if there was no match
+   std::size_t length{0};
+
+   constexpr explicit operator bool() const { return position != npos; }
+
+   /// One past the last matched character.
+   constexpr std::size_t end() const { return position + length; }
+
+   /// The matched characters, a view into the input.
+   constexpr std::string_view str() const { return input.substr(position, length); }
+};
+
+/**
+ * @brief Forward iterator over the occurrences of the literals of a
+ *        literal_set, ordered by end and, for equal ends, by position.
+ *        Overlapping occurrences are all reported.
+ */
+class literal_iterator {
+public:
+   using value_type = literal_match;
+   using difference_type = std::ptrdiff_t;
+   using iterator_concept = std::forward_iterator_tag;
+
+   literal_iterator() = default;
+
+   literal_iterator(const literal_detail::matcher& matcher, std::string_view text)
+      : matcher_{&matcher}, match_{text}
+   {
+      scan();
+   }
+
+   const literal_match& operator*() const { return match_; }
+   const literal_match* operator->() const { return &match_; }
+
+   literal_iterator& operator++()
+   {
+      if (++output_ < last_output_) {
+         report();
+      }
+      else {
+         scan();
+      }
+      return *this;
+   }
+
+   literal_iterator operator++(int)
+   {
+      auto copy{*this};
+      ++*this;
+      return copy;
+   }
+
+   bool operator==(const literal_iterator& other) const
+   {
+      return match_.position == other.match_.position &&
+             match_.pattern == other.match_.pattern;
+   }
+
+   bool operator==(std::default_sentinel_t) const { return !match_; }
+
+private:
+   /// Feed bytes to the automaton up to the next state with outputs.
+   void scan()
+   {
+      const auto& ac = matcher_->ac;
+      const auto& prefilter = matcher_->prefilter;
+      const std::string_view text = match_.input;
+      std::size_t scanned = scanned_;
+      int state = state_;
+      while (scanned < text.size()) {
+         if (prefilter.enabled() && state == ac.root) {
+            scanned = prefilter.find(text, scanned);
+            if (scanned == text.size()) {
+               break;
+            }
+         }
+         state = ac.next(state, text[scanned++]);
+         if (ac.matches(state)) {
+            std::tie(output_, last_output_) = ac.outputs(state);
+            break;
+         }
+      }
+      scanned_ = scanned;
+      state_ = state;
+      if (output_ < last_output_) {
+         report();
+      }
+      else {
+         match_.position = literal_match::npos;
+      }
+   }
+
+   void report()
+   {
+      match_.pattern = matcher_->ac.output(output_);
+      match_.length = matcher_->lengths[match_.pattern];
+      match_.position = scanned_ - match_.length;
+   }
+
+   const literal_detail::matcher* matcher_{nullptr};
+   literal_match match_{};
+   std::size_t scanned_{0};     ///< bytes fed to the automaton
+   int state_{0};
+   std::size_t output_{0};      ///< current output of state_
+   std::size_t last_output_{0};
+};
+
+/// The occurrences of the literals of a literal_set in an input, as a view.
+class literal_range : public std::ranges::view_interface<literal_range> {
+public:
+   literal_range() = default;
+   literal_range(const literal_detail::matcher& matcher, std::string_view text)
+      : matcher_{&matcher}, text_{text}
+   {
+   }
+
+   literal_iterator begin() const { return {*matcher_, text_}; }
+   std::default_sentinel_t end() const { return {}; }
+
+private:
+   const literal_detail::matcher* matcher_{nullptr};
+   std::string_view text_{};
+};
+
+/**
+ * @brief A set of literal strings compiled once and searched for
+ *        together, e.g. keywords, names or fig08_18.cpp's search words.
+ */
+class literal_set {
+public:
+   /// Compile literals, e.g. literal_set{"fun", "fn"} or
+   /// literal_set{{"Sue", "Green"}, syntax_option::icase}; throws
+   /// regex_error if one of them is empty.
+   literal_set(std::initializer_list<std::string_view> literals,
+               syntax_option options = syntax_option::none)
+      : literal_set{std::vector<std::string_view>(literals), options}
+   {
+   }
+
+   template <std::ranges::input_range R>
+      requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+   explicit literal_set(R&& literals, syntax_option options = syntax_option::none)
+   {
+      const bool icase = has_option(options, syntax_option::icase);
+      std::vector<std::string> folded;
+      for (std::string_view literal : literals) {
+         if (literal.empty()) {
+            throw regex_error{"fastregex: empty literal"};
+         }
+         literals_.emplace_back(literal);
+         matcher_.lengths.push_back(literal.size());
+         folded.emplace_back(literal);
+         for (char& c : folded.back()) {
+            c = static_cast<char>(literal_detail::fold(static_cast<unsigned char>(c), icase));
+         }
+      }
+      matcher_.ac = literal_detail::automaton{folded, icase};
+      matcher_.prefilter = literal_detail::teddy{folded, icase};
+   }
+
+   /// Number of literals.
+   std::size_t size() const { return literals_.size(); }
+
+   /// The literal with index i.
+   const std::string& literal(std::size_t i) const { return literals_[i]; }
+
+   /// Every occurrence of every literal, in one pass over the text.
+   literal_range find_all(std::string_view text) const { return {matcher_, text}; }
+
+   /// Whether the SIMD prefilter is used (see the file comment).
+   bool prefiltered() const { return matcher_.prefilter.enabled(); }
+
+private:
+   std::vector<std::string> literals_;
+   literal_detail::matcher matcher_;
+};
+
+} // namespace deitel::fastregex
@@ -0,0 +1,135 @@
+#pragma once
+/**
+ * @file mapped_file.hpp
+ * @brief A read-only file mapped into memory, to search without reading
+ *        it into a std::string.
+ *
+ *   fx::mapped_file log{"server.log"};
+ *   for (const auto& m : phone.find_all(log.view())) { ... }
+ *
+ * The matches are views into the mapping. Pages are read by the
+ * operating system as the search reaches them, and the mapping is
+ * advised for sequential access. Where memory mapping is unavailable
+ * (no <sys/mman.h>) the file is read into memory instead.
+ */
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#define DEITEL_FASTREGEX_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace deitel::fastregex {
+
+/// A read-only view of a whole file; throws std::system_error if the
+/// file cannot be opened or mapped.
+class mapped_file {
+public:
+   explicit mapped_file(const std::filesystem::path& path)
+   {
+#ifdef DEITEL_FASTREGEX_MMAP
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+         fail(path);
+      }
+      struct stat info{};
+      if (::fstat(fd, &info) != 0) {
+         const int error = errno;
+         ::close(fd);
+         fail(path, error);
+      }
+      size_ = static_cast<std::size_t>(info.st_size);
+      if (size_ > 0) {
+         void* const address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (address == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd);
+            fail(path, error);
+         }
+         ::madvise(address, size_, MADV_SEQUENTIAL);
+         data_ = static_cast<const char*>(address);
+      }
+      ::close(fd);
+#else
+      std::ifstream in{path, std::ios::binary};
+      if (!in) {
+         throw std::system_error{std::make_error_code(std::errc::no_such_file_or_directory),
+            "cannot open " + path.string()};
+      }
+      contents_.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+      data_ = contents_.data();
+      size_ = contents_.size();
+#endif
+   }
+
+   mapped_file(mapped_file&& other) noexcept
+      : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}
+   {
+#ifndef DEITEL_FASTREGEX_MMAP
+      contents_ = std::move(other.contents_);
+      data_ = contents_.data();
+#endif
+   }
+
+   mapped_file& operator=(mapped_file&& other) noexcept
+   {
+      if (this != &other) {
+         unmap();
+         data_ = std::exchange(other.data_, nullptr);
+         size_ = std::exchange(other.size_, 0);
+#ifndef DEITEL_FASTREGEX_MMAP
+         contents_ = std::move(other.contents_);
+         data_ = contents_.data();
+#endif
+      }
+      return *this;
+   }
+
+   ~mapped_file() { unmap(); }
+
+   const char* data() const { return data_; }
+   std::size_t size() const { return size_; }
+
+   /// The file's contents, valid while the mapped_file lives.
+   std::string_view view() const { return {data_, size_}; }
+
+private:
+#ifdef DEITEL_FASTREGEX_MMAP
+   [[noreturn]] static void fail(const std::filesystem::path& path, int error = errno)
+   {
+      throw std::system_error{error, std::generic_category(), "cannot map " + path.string()};
+   }
+#endif
+
+   void unmap()
+   {
+#ifdef DEITEL_FASTREGEX_MMAP
+      if (data_ != nullptr) {
+         ::munmap(const_cast<char*>(data_), size_);
+      }
+#endif
+      data_ = nullptr;
+      size_ = 0;
+   }
+
+   const char* data_{nullptr};
+   std::size_t size_{0};
+#ifndef DEITEL_FASTREGEX_MMAP
+   std::string contents_;
+#endif
+};
+
+} // namespace deitel::fastregex
@@ -0,0 +1,107 @@
+#pragma once
+/**
+ * @file regex.hpp
+ * @brief Patterns compiled at run time to lazily built, cached DFAs.
+ *
+ *   fx::regex phone{R"(\d{3}-\d{3}-\d{4})"};
+ *   for (const auto& m : phone.find_all(contact)) { ... m.str() ... }
+ *
+ * The constructor parses the pattern and compiles its NFA programs; DFA
+ * states are built the first time a search reaches them and cached, so
+ * later searches run from the transition table alone. The cache is
+ * bounded (about 10000 states per direction) and rebuilt when full.
+ *
+ * A regex's cache is updated by its const member functions, so one
+ * regex object must not be used by several threads at once; give each
+ * thread its own copy.
+ */
+
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "automaton.hpp"
+#include "engine.hpp"
+#include "stream.hpp"
+#include "syntax.hpp"
+
+namespace deitel::fastregex {
+
+/**
+ * @brief A regular expression compiled at run time, the counterpart of
+ *        std::regex.
+ */
+class regex {
+public:
+   /// Compile pattern; throws regex_error if it is malformed.
+   explicit regex(std::string_view pattern, syntax_option options = syntax_option::none)
+      : regex{syntax_detail::parse(pattern, options)}
+   {
+   }
+
+   /// Whether the whole text matches, as std::regex_match.
+   bool match(std::string_view text) const
+   {
+      return engine_detail::full_match(reverse_, text);
+   }
+
+   /// The leftmost match at or after from, as std::regex_search.
+   match_result search(std::string_view text, std::size_t from = 0) const
+   {
+      return engine_detail::search(forward_, reverse_, text, from);
+   }
+
+   /// All non-overlapping matches, as std::sregex_iterator.
+   match_range<regex> find_all(std::string_view text) const { return {*this, text}; }
+
+   /// All matches in a stream, read chunk bytes at a time.
+   match_stream<regex> find_all(std::istream& in,
+      std::size_t chunk = match_stream<regex>::default_chunk) const
+   {
+      return {*this, in, chunk};
+   }
+
+   /// Replace every match by format ($&, $`, $' and $$ are expanded), as
+   /// std::regex_replace.
+   std::string replace(std::string_view text, std::string_view format) const
+   {
+      return engine_detail::replace(*this, text, format);
+   }
+
+   /// Replace every match m by f(m).
+   template <std::invocable<const match_result&> F>
+   std::string replace(std::string_view text, F&& f) const
+   {
+      return engine_detail::replace(*this, text, std::forward<F>(f));
+   }
+
+   /// Number of DFA states cached so far, forward and reverse.
+   std::size_t cached_states() const { return forward_.size() + reverse_.size(); }
+
+private:
+   template <typename Regex>
+   friend class match_iterator;
+   template <typename Regex>
+   friend class match_stream;
+
+   explicit regex(const syntax_detail::syntax_tree& tree)
+      : regex{automaton_detail::compile(tree, false, true),
+              automaton_detail::compile(tree, true, false)}
+   {
+   }
+
+   regex(automaton_detail::program forward, automaton_detail::program reverse)
+      : barriers_{automaton_detail::barriers(reverse)},
+        forward_{std::move(forward), true}, reverse_{std::move(reverse), false}
+   {
+   }
+
+   std::array<bool, 256> barriers_;
+   mutable automaton_detail::lazy_dfa forward_;
+   mutable automaton_detail::lazy_dfa reverse_;
+};
+
+} // namespace deitel::fastregex
@@ -0,0 +1,193 @@
+#pragma once
+/**
+ * @file static_regex.hpp
+ * @brief Patterns compiled to DFA tables during compilation.
+ *
+ * For a pattern known when the program is written, e.g. the ZIP code
+ * and phone number patterns of fig08_16.cpp and fig08_18.cpp,
+ *
+ *   constexpr fx::static_regex<R"(\d{3}-\d{3}-\d{4})"> phone;
+ *
+ * parses the pattern, builds its NFA and determinizes it entirely at
+ * compile time. The matcher is a loop over constant transition tables
+ * specialized for this one pattern, and a malformed pattern is a
+ * compile-time error. Every member function is constexpr:
+ *
+ *   static_assert(fx::static_regex<R"(\d{5})">{}.match("02215"));
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "automaton.hpp"
+#include "engine.hpp"
+#include "stream.hpp"
+#include "syntax.hpp"
+
+namespace deitel::fastregex {
+
+/// A string literal usable as a template argument.
+template <std::size_t N>
+struct fixed_string {
+   char chars[N]{};
+
+   constexpr fixed_string(const char (&literal)[N])
+   {
+      std::copy_n(literal, N, chars);
+   }
+
+   constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
+namespace static_detail {
+
+/// A DFA in constant arrays of exactly the needed size.
+template <std::size_t States, std::size_t Symbols>
+struct dfa_table {
+   using state_t = std::conditional_t<States <= 256, std::uint8_t,
+                   std::conditional_t<States <= 65536, std::uint16_t, std::uint32_t>>;
+
+   std::array<std::uint8_t, 256> classes{};
+   std::array<state_t, States * Symbols> transitions{};
+   std::array<bool, States> accepts{};
+   std::array<bool, 256> idle_bytes{};
+   int initial{0};
+   std::array<int, 2> not_null{};
+
+   constexpr int start() const { return initial; }
+   constexpr int not_null_start(bool at_bot) const { return not_null[at_bot ? 1 : 0]; }
+   constexpr int next(int state, unsigned symbol) const
+   {
+      return transitions[static_cast<std::size_t>(state) * Symbols + symbol];
+   }
+   constexpr bool accepting(int state) const
+   {
+      return accepts[static_cast<std::size_t>(state)];
+   }
+   constexpr unsigned symbol(char c) const
+   {
+      return classes[static_cast<unsigned char>(c)];
+   }
+   constexpr unsigned bot() const { return Symbols - 2; }
+   constexpr unsigned eot() const { return Symbols - 1; }
+   constexpr bool idle(char c) const
+   {
+      return idle_bytes[static_cast<unsigned char>(c)];
+   }
+};
+
+template <fixed_string Pattern, syntax_option Options, bool Reverse>
+struct compiled {
+   static constexpr automaton_detail::dense_dfa build()
+   {
+      const auto tree = syntax_detail::parse(Pattern.view(), Options);
+      // forward: unanchored, leftmost-first; reverse: anchored, longest
+      return automaton_detail::determinize(
+         automaton_detail::compile(tree, Reverse, !Reverse), !Reverse);
+   }
+
+   static constexpr std::pair<std::size_t, std::size_t> shape = [] {
+      const auto dfa = build();
+      return std::pair{dfa.accepting.size(), std::size_t{dfa.classes.symbols()}};
+   }();
+
+   static constexpr auto table = [] {
+      const auto dfa = build();
+      dfa_table<shape.first, shape.second> result{};
+      result.classes = dfa.classes.map;
+      for (std::size_t i = 0; i < dfa.next.size(); ++i) {
+         result.transitions[i] =
+            static_cast<typename decltype(result)::state_t>(dfa.next[i]);
+      }
+      for (std::size_t i = 0; i < dfa.accepting.size(); ++i) {
+         result.accepts[i] = dfa.accepting[i] != 0;
+      }
+      result.initial = dfa.start;
+      result.not_null = dfa.not_null_start;
+      if (!result.accepting(result.initial)) {
+         for (unsigned byte = 0; byte < 256; ++byte) {
+            result.idle_bytes[byte] =
+               result.next(result.initial, result.classes[byte]) == result.initial;
+         }
+      }
+      return result;
+   }();
+};
+
+/// The bytes no match of the pattern contains.
+template <fixed_string Pattern, syntax_option Options>
+inline constexpr std::array<bool, 256> barriers = automaton_detail::barriers(
+   automaton_detail::compile(syntax_detail::parse(Pattern.view(), Options), true, false));
+
+} // namespace static_detail
+
+/**
+ * @brief A regular expression compiled during compilation, with the
+ *        interface of regex.
+ */
+template <fixed_string Pattern, syntax_option Options = syntax_option::none>
+class static_regex {
+public:
+   /// The pattern text.
+   static constexpr std::string_view pattern() { return Pattern.view(); }
+
+   /// Whether the whole text matches, as std::regex_match.
+   constexpr bool match(std::string_view text) const
+   {
+      return engine_detail::full_match(reverse_, text);
+   }
+
+   /// The leftmost match at or after from, as std::regex_search.
+   constexpr match_result search(std::string_view text, std::size_t from = 0) const
+   {
+      return engine_detail::search(forward_, reverse_, text, from);
+   }
+
+   /// All non-overlapping matches, as std::sregex_iterator.
+   constexpr match_range<static_regex> find_all(std::string_view text) const
+   {
+      return {*this, text};
+   }
+
+   /// All matches in a stream, read chunk bytes at a time.
+   match_stream<static_regex> find_all(std::istream& in,
+      std::size_t chunk = match_stream<static_regex>::default_chunk) const
+   {
+      return {*this, in, chunk};
+   }
+
+   /// Replace every match by format ($&, $`, $' and $$ are expanded), as
+   /// std::regex_replace.
+   std::string replace(std::string_view text, std::string_view format) const
+   {
+      return engine_detail::replace(*this, text, format);
+   }
+
+   /// Replace every match m by f(m).
+   template <std::invocable<const match_result&> F>
+   std::string replace(std::string_view text, F&& f) const
+   {
+      return engine_detail::replace(*this, text, std::forward<F>(f));
+   }
+
+private:
+   template <typename Regex>
+   friend class match_iterator;
+   template <typename Regex>
+   friend class match_stream;
+
+   static constexpr const auto& barriers_ = static_detail::barriers<Pattern, Options>;
+   static constexpr const auto& forward_ =
+      static_detail::compiled<Pattern, Options, false>::table;
+   static constexpr const auto& reverse_ =
+      static_detail::compiled<Pattern, Options, true>::table;
+};
+
+} // namespace deitel::fastregex
@@ -0,0 +1,257 @@
+#pragma once
+/**
+ * @file stream.hpp
+ * @brief Finding all matches in a stream read in chunks.
+ *
+ * fig08_18.cpp searches a string with
+ *
+ *   while (std::regex_search(contact, match, phone)) {
+ *      ...
+ *      contact = match.suffix();
+ *   }
+ *
+ * which copies the rest of the string after every match. find_all over a
+ * string_view (a std::string or a mapped_file) never copies; for input
+ * too large to hold, find_all(std::istream&) reads it in chunks:
+ *
+ *   std::ifstream log{"server.log", std::ios::binary};
+ *   for (const auto& m : phone.find_all(log)) {
+ *      std::cout << m.position << ": " << m.str() << '\n';
+ *   }
+ *
+ * The forward DFA's state is carried from one chunk into the next, so
+ * a match spanning a chunk boundary is found as if the input were one
+ * string. Before the next chunk is read, the buffer drops the bytes up
+ * to the current search position or the last byte the pattern cannot
+ * consume (e.g. a newline for a pattern without \n, \s or [^...]),
+ * whichever is later. Memory thus stays near the chunk size unless a
+ * match, or a stretch of input free of such bytes, is longer.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "engine.hpp"
+
+namespace deitel::fastregex {
+
+/// A match in a stream.
+struct stream_match {
+   static constexpr std::size_t npos = match_result::npos;
+
+   std::size_t position{npos}; ///< offset in the stream; npos if no match
+   std::size_t length{0};
+   std::string_view chars{};   ///< valid until the stream advances
+
+   constexpr explicit operator bool() const { return position != npos; }
+
+   /// One past the last matched character.
+   constexpr std::size_t end() const { return position + length; }
+
+   /// The matched characters.
+   constexpr std::string_view str() const { return chars; }
+};
+
+/**
+ * @brief The matches of a regex in a std::istream, as an input range.
+ *        Each match is reported once the bytes after it show that it
+ *        cannot grow, as with find_all over the whole input.
+ */
+template <typename Regex>
+class match_stream {
+public:
+   static constexpr std::size_t default_chunk = std::size_t{1} << 20;
+
+   match_stream(const Regex& regex, std::istream& in, std::size_t chunk = default_chunk)
+      : regex_{&regex}, in_{&in}, chunk_{std::max<std::size_t>(chunk, 1)}
+   {
+   }
+
+   class iterator {
+   public:
+      using value_type = stream_match;
+      using difference_type = std::ptrdiff_t;
+      using iterator_concept = std::input_iterator_tag;
+
+      iterator() = default;
+      explicit iterator(match_stream& stream) : stream_{&stream} {}
+
+      const stream_match& operator*() const { return stream_->match_; }
+      const stream_match* operator->() const { return &stream_->match_; }
+
+      iterator& operator++()
+      {
+         stream_->advance();
+         return *this;
+      }
+
+      void operator++(int) { ++*this; }
+
+      bool operator==(std::default_sentinel_t) const { return !stream_->match_; }
+
+   private:
+      match_stream* stream_{nullptr};
+   };
+
+   /// Read up to the first match; a match_stream is iterated once.
+   iterator begin()
+   {
+      if (!started_) {
+         started_ = true;
+         restart(0);
+         advance();
+      }
+      return iterator{*this};
+   }
+
+   std::default_sentinel_t end() const { return {}; }
+
+private:
+   static constexpr std::size_t npos = stream_match::npos;
+
+   /// Find the next match, or set match_ to no match at the end.
+   void advance()
+   {
+      auto& forward = regex_->forward_;
+      if (finished_) {
+         match_ = {};
+         return;
+      }
+      do {
+         const char* const bytes = buffer_.data();
+         const std::size_t stop = base_ + size_;
+         for (; scan_ < stop; ++scan_) {
+            if (state_ == forward.start()) {
+               while (forward.idle(bytes[scan_ - base_]) && ++scan_ < stop) {
+               }
+               if (scan_ == stop) {
+                  break;
+               }
+            }
+            state_ = forward.next(state_, forward.symbol(bytes[scan_ - base_]));
+            if (state_ == 0) {
+               return report();
+            }
+            if (forward.accepting(state_)) {
+               last_ = scan_ + 1;
+            }
+         }
+      } while (fill());
+      // a retry only accepts matches of at least one byte
+      if ((retry_ == npos || scan_ > retry_) &&
+          forward.accepting(forward.next(state_, forward.eot()))) {
+         last_ = scan_;
+      }
+      report();
+   }
+
+   /// Set match_ to the match ending at last_ and restart after it.
+   void report()
+   {
+      if (last_ == npos) {
+         if (retry_ != npos) {
+            // no non-empty match where the empty one was: search on from
+            // the next position, as std::regex_iterator does
+            restart(retry_ + 1);
+            return advance();
+         }
+         finished_ = true;
+         match_ = {};
+         return;
+      }
+      const std::string_view window{buffer_.data(), size_};
+      const std::size_t start = retry_ != npos ? retry_
+         : base_ + engine_detail::find_start(regex_->reverse_, window, keep_ - base_,
+              last_ - base_, keep_ == 0, eof_ && last_ == base_ + size_);
+      match_ = {start, last_ - start, window.substr(start - base_, last_ - start)};
+      if (match_.length == 0) {
+         retry(last_);
+      }
+      else {
+         restart(last_);
+      }
+   }
+
+   /// Start a search for a non-empty match at from, after an empty match
+   /// there (engine_detail::next_match).
+   void retry(std::size_t from)
+   {
+      state_ = regex_->forward_.not_null_start(from == 0);
+      last_ = npos;
+      keep_ = from;
+      checked_ = from;
+      scan_ = from;
+      retry_ = from;
+   }
+
+   /// Start a search at from.
+   void restart(std::size_t from)
+   {
+      auto& forward = regex_->forward_;
+      if (eof_ && from > base_ + size_) {
+         finished_ = true;
+         return;
+      }
+      state_ = forward.start();
+      if (from == 0) {
+         state_ = forward.next(state_, forward.bot());
+      }
+      last_ = forward.accepting(state_) ? from : npos;
+      keep_ = from;
+      checked_ = from;
+      scan_ = from;
+      retry_ = npos;
+   }
+
+   /// Drop the bytes no match can need and read a chunk; false at the end.
+   bool fill()
+   {
+      if (eof_) {
+         return false;
+      }
+      // no match contains a barrier byte, so none starts before the last
+      for (std::size_t i = scan_; i > checked_; --i) {
+         if (regex_->barriers_[static_cast<unsigned char>(buffer_[i - 1 - base_])]) {
+            keep_ = std::max(keep_, i);
+            break;
+         }
+      }
+      checked_ = scan_;
+      const std::size_t drop = keep_ - base_;
+      std::copy(buffer_.begin() + static_cast<std::ptrdiff_t>(drop),
+         buffer_.begin() + static_cast<std::ptrdiff_t>(size_), buffer_.begin());
+      base_ += drop;
+      size_ -= drop;
+      if (buffer_.size() < size_ + chunk_) {
+         buffer_.resize(size_ + chunk_);
+      }
+      in_->read(buffer_.data() + size_, static_cast<std::streamsize>(chunk_));
+      const auto count = static_cast<std::size_t>(in_->gcount());
+      size_ += count;
+      eof_ = !*in_;
+      return count > 0;
+   }
+
+   const Regex* regex_;
+   std::istream* in_;
+   std::size_t chunk_;
+   std::vector<char> buffer_;
+   std::size_t size_{0};   ///< bytes in buffer_
+   std::size_t base_{0};   ///< stream offset of buffer_[0]
+   std::size_t scan_{0};   ///< stream offset of the next byte to scan
+   std::size_t keep_{0};   ///< no match starts before this offset
+   std::size_t checked_{0}; ///< bytes before scanned for barriers
+   std::size_t last_{npos}; ///< end of the match found so far, if any
+   std::size_t retry_{npos}; ///< start of a non-empty match being sought
+   int state_{0};
+   bool started_{false};
+   bool eof_{false};
+   bool finished_{false};
+   stream_match match_{};
+};
+
+} // namespace deitel::fastregex
@@ -0,0 +1,495 @@
+#pragma once
+/**
+ * @file syntax.hpp
+ * @brief Parsing regular expression patterns into syntax trees.
+ *
+ * The supported syntax is the ECMAScript subset that a DFA can match:
+ *
+ *   literals and escapes    a  \.  \\  \t \n \r \f \v \0  \xHH
+ *   character classes       .  \d \D \w \W \s \S  [a-z_]  [^,\t]
+ *   grouping, alternation   (...)  (?:...)  a|b
+ *   quantifiers             *  +  ?  {n}  {n,}  {n,m}, lazy with a trailing ?
+ *   anchors                 ^  $ (beginning and end of the input)
+ *
+ * Groups do not capture. Backreferences, lookaround and \b are rejected.
+ * Everything is constexpr, so patterns can be parsed during compilation.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace deitel::fastregex {
+
+/// Error in a pattern. fx::regex throws it; for fx::static_regex the
+/// throw makes the pattern a compile-time error.
+class regex_error : public std::runtime_error {
+public:
+   using std::runtime_error::runtime_error;
+};
+
+/// Pattern options, mirroring std::regex_constants::syntax_option_type.
+enum class syntax_option : unsigned {
+   none = 0,
+   icase = 1, ///< case-insensitive ASCII letters, as regex_constants::icase
+};
+
+constexpr syntax_option operator|(syntax_option a, syntax_option b)
+{
+   return static_cast<syntax_option>(static_cast<unsigned>(a) |
+                                     static_cast<unsigned>(b));
+}
+
+constexpr bool has_option(syntax_option options, syntax_option option)
+{
+   return (static_cast<unsigned>(options) & static_cast<unsigned>(option)) != 0;
+}
+
+namespace syntax_detail {
+
+/**
+ * @brief Set of input symbols: the 256 byte values, plus the pseudo
+ *        symbols bot and eot marking the beginning and end of the input.
+ */
+class charset {
+public:
+   static constexpr unsigned bot = 256;
+   static constexpr unsigned eot = 257;
+
+   constexpr void add(unsigned symbol)
+   {
+      bits_[symbol / 64] |= std::uint64_t{1} << (symbol % 64);
+   }
+
+   constexpr void add_range(unsigned first, unsigned last)
+   {
+      for (unsigned symbol = first; symbol <= last; ++symbol) {
+         add(symbol);
+      }
+   }
+
+   constexpr void add(const charset& other)
+   {
+      for (std::size_t i = 0; i < bits_.size(); ++i) {
+         bits_[i] |= other.bits_[i];
+      }
+   }
+
+   constexpr bool contains(unsigned symbol) const
+   {
+      return (bits_[symbol / 64] >> (symbol % 64)) & 1;
+   }
+
+   /// Complement with respect to the 256 byte values.
+   constexpr void negate()
+   {
+      for (std::size_t i = 0; i < 4; ++i) {
+         bits_[i] = ~bits_[i];
+      }
+   }
+
+   /// Add the other case of every ASCII letter in the set.
+   constexpr void fold_case()
+   {
+      for (unsigned c = 'a'; c <= 'z'; ++c) {
+         if (contains(c) || contains(c - 'a' + 'A')) {
+            add(c);
+            add(c - 'a' + 'A');
+         }
+      }
+   }
+
+   constexpr bool operator==(const charset&) const = default;
+
+private:
+   std::array<std::uint64_t, 5> bits_{};
+};
+
+/// A node of the syntax tree. Children are indexes into syntax_tree::nodes.
+struct node {
+   enum kind_t { empty, set, bot, eot, concat, alternate, repeat };
+
+   kind_t kind{empty};
+   charset chars{};            ///< set: the symbols matched
+   std::vector<int> children{}; ///< concat and alternate: the operands;
+                                ///< repeat: the repeated node
+   int min{0};                 ///< repeat: minimum count
+   int max{0};                 ///< repeat: maximum count, -1 if unbounded
+   bool greedy{true};          ///< repeat: prefer more repetitions
+};
+
+struct syntax_tree {
+   std::vector<node> nodes;
+   int root{0};
+};
+
+/// Largest count accepted in {n,m}, as in RE2.
+inline constexpr int max_repeat = 1000;
+
+/// Recursive descent parser producing a syntax_tree.
+class parser {
+public:
+   constexpr parser(std::string_view pattern, syntax_option options)
+      : pattern_{pattern}, icase_{has_option(options, syntax_option::icase)}
+   {
+   }
+
+   constexpr syntax_tree parse()
+   {
+      tree_.root = alternation();
+      if (pos_ != pattern_.size()) {
+         fail("unmatched )");
+      }
+      return std::move(tree_);
+   }
+
+private:
+   [[noreturn]] static void fail(const char* message)
+   {
+      throw regex_error{std::string{"fastregex: "} + message};
+   }
+
+   constexpr bool at_end() const { return pos_ == pattern_.size(); }
+   constexpr char peek() const { return pattern_[pos_]; }
+
+   constexpr int add(node n)
+   {
+      tree_.nodes.push_back(std::move(n));
+      return static_cast<int>(tree_.nodes.size() - 1);
+   }
+
+   constexpr int add_set(charset chars)
+   {
+      if (icase_) {
+         chars.fold_case();
+      }
+      node n{};
+      n.kind = node::set;
+      n.chars = chars;
+      return add(std::move(n));
+   }
+
+   // alternation: sequence ('|' sequence)*
+   constexpr int alternation()
+   {
+      node n{};
+      n.kind = node::alternate;
+      n.children.push_back(sequence());
+      while (!at_end() && peek() == '|') {
+         ++pos_;
+         n.children.push_back(sequence());
+      }
+      return n.children.size() == 1 ? n.children.front() : add(std::move(n));
+   }
+
+   // sequence: quantified*
+   constexpr int sequence()
+   {
+      node n{};
+      n.kind = node::concat;
+      while (!at_end() && peek() != '|' && peek() != ')') {
+         n.children.push_back(quantified());
+      }
+      return n.children.size() == 1 ? n.children.front() : add(std::move(n));
+   }
+
+   // quantified: atom ('*' | '+' | '?' | '{n}' | '{n,}' | '{n,m}')* '?'?
+   constexpr int quantified()
+   {
+      int operand = atom();
+      while (!at_end()) {
+         int min = 0;
+         int max = 0;
+         const char c = peek();
+         if (c == '*') {
+            max = -1;
+         }
+         else if (c == '+') {
+            min = 1;
+            max = -1;
+         }
+         else if (c == '?') {
+            max = 1;
+         }
+         else if (c == '{') {
+            ++pos_;
+            min = number();
+            max = min;
+            if (!at_end() && peek() == ',') {
+               ++pos_;
+               max = !at_end() && peek() == '}' ? -1 : number();
+            }
+            if (at_end() || peek() != '}') {
+               fail("expected } in repetition");
+            }
+            if (max != -1 && max < min) {
+               fail("repetition {n,m} with m < n");
+            }
+         }
+         else {
+            break;
+         }
+         ++pos_;
+
+         node n{};
+         n.kind = node::repeat;
+         n.children.push_back(operand);
+         n.min = min;
+         n.max = max;
+         if (!at_end() && peek() == '?') {
+            ++pos_;
+            n.greedy = false;
+         }
+         operand = add(std::move(n));
+      }
+      return operand;
+   }
+
+   constexpr int number()
+   {
+      if (at_end() || peek() < '0' || peek() > '9') {
+         fail("expected a number in repetition");
+      }
+      int value = 0;
+      while (!at_end() && peek() >= '0' && peek() <= '9') {
+         value = value * 10 + (peek() - '0');
+         if (value > max_repeat) {
+            fail("repetition count above 1000");
+         }
+         ++pos_;
+      }
+      return value;
+   }
+
+   constexpr int atom()
+   {
+      const char c = peek();
+      ++pos_;
+      switch (c) {
+         case '(': {
+            if (!at_end() && peek() == '?') {
+               if (pos_ + 1 < pattern_.size() && pattern_[pos_ + 1] == ':') {
+                  pos_ += 2;
+               }
+               else {
+                  fail("lookaround is not supported");
+               }
+            }
+            const int inner = alternation();
+            if (at_end() || peek() != ')') {
+               fail("missing )");
+            }
+            ++pos_;
+            return inner;
+         }
+         case '[':
+            return add_set(bracket());
+         case '.': {
+            // any byte except the line terminators
+            charset chars{};
+            chars.add('\n');
+            chars.add('\r');
+            chars.negate();
+            return add_set(chars);
+         }
+         case '^': {
+            node n{};
+            n.kind = node::bot;
+            return add(std::move(n));
+         }
+         case '$': {
+            node n{};
+            n.kind = node::eot;
+            return add(std::move(n));
+         }
+         case '\\':
+            return add_set(escape(false));
+         case '*':
+         case '+':
+         case '?':
+         case '{':
+            fail("quantifier without an operand");
+         case ')':
+            fail("unmatched )");
+         default: {
+            charset chars{};
+            chars.add(static_cast<unsigned char>(c));
+            return add_set(chars);
+         }
+      }
+   }
+
+   // the characters of an escape sequence, after the backslash
+   constexpr charset escape(bool in_class)
+   {
+      if (at_end()) {
+         fail("trailing backslash");
+      }
+      const char c = peek();
+      ++pos_;
+      charset chars{};
+      switch (c) {
+         case 'd':
+         case 'D':
+            chars.add_range('0', '9');
+            break;
+         case 'w':
+         case 'W':
+            chars.add_range('0', '9');
+            chars.add_range('A', 'Z');
+            chars.add_range('a', 'z');
+            chars.add('_');
+            break;
+         case 's':
+         case 'S':
+            chars.add_range('\t', '\r');
+            chars.add(' ');
+            break;
+         case 't': chars.add('\t'); return chars;
+         case 'n': chars.add('\n'); return chars;
+         case 'r': chars.add('\r'); return chars;
+         case 'f': chars.add('\f'); return chars;
+         case 'v': chars.add('\v'); return chars;
+         case '0': chars.add('\0'); return chars;
+         case 'x': {
+            unsigned value = 0;
+            for (int i = 0; i < 2; ++i) {
+               if (at_end()) {
+                  fail("expected two hex digits after \\x");
+               }
+               const char h = peek();
+               ++pos_;
+               value *= 16;
+               if (h >= '0' && h <= '9') {
+                  value += static_cast<unsigned>(h - '0');
+               }
+               else if (h >= 'a' && h <= 'f') {
+                  value += static_cast<unsigned>(h - 'a' + 10);
+               }
+               else if (h >= 'A' && h <= 'F') {
+                  value += static_cast<unsigned>(h - 'A' + 10);
+               }
+               else {
+                  fail("expected two hex digits after \\x");
+               }
+            }
+            chars.add(value);
+            return chars;
+         }
+         case 'b':
+            if (in_class) {
+               chars.add('\b');
+               return chars;
+            }
+            fail("\\b is not supported");
+         case 'B':
+            fail("\\B is not supported");
+         default:
+            if ((c >= '1' && c <= '9')) {
+               fail("backreferences are not supported");
+            }
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+               fail("unknown escape");
+            }
+            chars.add(static_cast<unsigned char>(c));
+            return chars;
+      }
+      if (c >= 'A' && c <= 'Z') {
+         chars.negate();
+      }
+      return chars;
+   }
+
+   // a bracket expression, after the [
+   constexpr charset bracket()
+   {
+      bool negated = false;
+      if (!at_end() && peek() == '^') {
+         negated = true;
+         ++pos_;
+      }
+      charset chars{};
+      while (true) {
+         if (at_end()) {
+            fail("missing ]");
+         }
+         if (peek() == ']') {
+            ++pos_;
+            break;
+         }
+         unsigned first = 0;
+         if (peek() == '\\') {
+            ++pos_;
+            const std::size_t escape_at = pos_;
+            const charset escaped = escape(true);
+            const char e = pattern_[escape_at];
+            if (e == 'd' || e == 'D' || e == 'w' || e == 'W' || e == 's' || e == 'S') {
+               chars.add(escaped);
+               continue;
+            }
+            first = single(escaped);
+         }
+         else {
+            first = static_cast<unsigned char>(peek());
+            ++pos_;
+         }
+
+         // a range first-last, unless the - ends the bracket
+         if (pos_ + 1 < pattern_.size() && peek() == '-' && pattern_[pos_ + 1] != ']') {
+            ++pos_;
+            unsigned last = 0;
+            if (peek() == '\\') {
+               ++pos_;
+               last = single(escape(true));
+            }
+            else {
+               last = static_cast<unsigned char>(peek());
+               ++pos_;
+            }
+            if (last < first) {
+               fail("character range out of order");
+            }
+            chars.add_range(first, last);
+         }
+         else {
+            chars.add(first);
+         }
+      }
+      if (negated) {
+         if (icase_) {
+            chars.fold_case();
+         }
+         chars.negate();
+      }
+      return chars;
+   }
+
+   // the only member of a single-character escape
+   static constexpr unsigned single(const charset& chars)
+   {
+      for (unsigned c = 0; c < 256; ++c) {
+         if (chars.contains(c)) {
+            return c;
+         }
+      }
+      fail("empty character class");
+   }
+
+   std::string_view pattern_;
+   bool icase_;
+   std::size_t pos_{0};
+   syntax_tree tree_{};
+};
+
+/// Parse pattern into a syntax tree; throws regex_error.
+constexpr syntax_tree parse(std::string_view pattern, syntax_option options)
+{
+   return parser{pattern, options}.parse();
+}
+
+} // namespace syntax_detail
+} // namespace deitel::fastregex
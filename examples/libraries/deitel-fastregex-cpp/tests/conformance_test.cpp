@@ -0,0 +1,116 @@
+// conformance_test.cpp
+// Checks fx::regex, fx::static_regex and find_all over a stream against
+// std::regex (ECMAScript) on patterns with empty matches and repeated
+// anchors: the matches found, regex_replace and regex_match.
+//
+// Build (from the library root):
+//   g++ -std=c++20 -O2 -Iinclude tests/conformance_test.cpp -o conformance_test
+// Run:
+//   ./conformance_test
+#include <cstddef>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "fastregex/fastregex.hpp"
+
+namespace fx = deitel::fastregex;
+
+using matches = std::vector<std::pair<std::size_t, std::size_t>>;
+
+int failures = 0;
+
+void check(bool ok, const std::string& pattern, const std::string& text,
+           const char* what) {
+   if (!ok) {
+      std::cerr << "FAILED: " << what << " for /" << pattern << "/ on \""
+                << text << "\"\n";
+      ++failures;
+   }
+}
+
+matches std_matches(const std::regex& regex, const std::string& text) {
+   matches result;
+   for (std::sregex_iterator it{text.begin(), text.end(), regex}, end; it != end; ++it) {
+      result.emplace_back(static_cast<std::size_t>(it->position()),
+                          static_cast<std::size_t>(it->length()));
+   }
+   return result;
+}
+
+template <typename Regex>
+matches fx_matches(const Regex& regex, const std::string& text) {
+   matches result;
+   for (const auto& m : regex.find_all(text)) {
+      result.emplace_back(m.position, m.length);
+   }
+   return result;
+}
+
+template <typename Regex>
+matches stream_matches(const Regex& regex, const std::string& text, std::size_t chunk) {
+   std::istringstream in{text};
+   matches result;
+   for (const auto& m : regex.find_all(in, chunk)) {
+      check(m.str() == text.substr(m.position, m.length), "", text, "stream str()");
+      result.emplace_back(m.position, m.length);
+   }
+   return result;
+}
+
+const std::vector<std::string> texts{"", "a", "aa", "ab", "ba", "xa", "bab",
+   "aab a", "x\na", "123 ab"};
+
+template <typename Regex>
+void conform(const Regex& regex, const std::string& pattern) {
+   const std::regex expected{pattern};
+   for (const std::string& text : texts) {
+      const matches all{std_matches(expected, text)};
+      check(fx_matches(regex, text) == all, pattern, text, "find_all");
+      check(stream_matches(regex, text, 1) == all, pattern, text, "stream, chunk 1");
+      check(stream_matches(regex, text, 3) == all, pattern, text, "stream, chunk 3");
+      check(regex.replace(text, "<$&>") == std::regex_replace(text, expected, "<$&>"),
+         pattern, text, "replace");
+      check(regex.match(text) == std::regex_match(text, expected), pattern, text,
+         "match");
+      std::smatch first;
+      const bool found{std::regex_search(text, first, expected)};
+      const fx::match_result m{regex.search(text)};
+      check(static_cast<bool>(m) == found &&
+         (!found || (m.position == static_cast<std::size_t>(first.position()) &&
+                     m.length == static_cast<std::size_t>(first.length()))),
+         pattern, text, "search");
+   }
+}
+
+template <fx::fixed_string Pattern>
+void conform_static() {
+   conform(fx::static_regex<Pattern>{}, std::string{Pattern.view()});
+}
+
+int main() {
+   // empty matches: after one, a non-empty match at the same position
+   // comes before a search from the next position
+   for (const char* pattern : {"a*?", "|a", "a*", "", "a??", "b*|a", "(?:ab)*?",
+           "x*", "\\d*", "a|ab", "[ab]*?b", "(?:|a)(?:|b)"}) {
+      conform(fx::regex{pattern}, pattern);
+   }
+
+   // repeated and adjacent anchors
+   for (const char* pattern : {"^", "$", "^$", "$^", "^^a", "a$$", "^^", "$$",
+           "(^|x)^a", "a$($|x)", "(?:^|b)a", "a(?:$|b)", "^a|b$"}) {
+      conform(fx::regex{pattern}, pattern);
+   }
+
+   conform_static<"a*?">();
+   conform_static<"|a">();
+   conform_static<"^^a">();
+   conform_static<"a$$">();
+   conform_static<"(^|x)^a">();
+   conform_static<"$^">();
+
+   std::cout << (failures == 0 ? "all tests passed" : "tests failed") << '\n';
+   return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// text_utils_bench.cpp
+// Compares the regex-free util text helpers with the std::regex versions
+// they replace, on inputs built from resources/transcript.txt.
+//
+// Build (from the SDK root):
+//   g++ -std=c++20 -O2 -Iinclude -Iexternal bench/text_utils_bench.cpp -lcurl -o text_utils_bench
+// Run:
+//   ./text_utils_bench ../../openai/resources/transcript.txt
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "openai/openai.hpp"
+#include "bench_util.hpp"
+
+namespace util = deitel::openai::util;
+
+// The original implementation, kept here as the baseline.
+std::string regex_strip(const std::string& s) {
+   return std::regex_replace(
+      s, std::regex(R"(^[ \t]+)", std::regex_constants::multiline), "");
+}
+
+std::string regex_collapse(const std::string& s) {
+   const std::string out = std::regex_replace(s, std::regex(R"(\s+)"), " ");
+   const auto first = out.find_first_not_of(' ');
+   if (first == std::string::npos) {
+      return {};
+   }
+   return out.substr(first, out.find_last_not_of(' ') - first + 1);
+}
+
+// Indent each line of the transcript so there is whitespace to strip.
+std::string make_input(const std::string& text, int copies) {
+   std::string out;
+   for (int i = 0; i < copies; ++i) {
+      std::istringstream lines{text};
+      for (std::string line; std::getline(lines, line);) {
+         out += "   \t  ";
+         out += line;
+         out += "  \n";
+      }
+   }
+   return out;
+}
+
+int main(int argc, char* argv[]) {
+   const char* path =
+      argc > 1 ? argv[1] : "../../openai/resources/transcript.txt";
+   std::ifstream in{path, std::ios::binary};
+   if (!in) {
+      std::cerr << "cannot open " << path << '\n';
+      return 1;
+   }
+   const std::string text{std::istreambuf_iterator<char>{in}, {}};
+
+   // a failed render leaves the output as it was
+   std::string rendered{"kept"};
+   const util::template_vars vars{{"name", "value"}};
+   for (const char* tmpl : {"{{name}} {{missing}}", "{{ name }} {{name"}) {
+      try {
+         util::render_template(tmpl, vars, rendered);
+      }
+      catch (const std::invalid_argument&) {
+      }
+      if (rendered != "kept") {
+         std::cerr << "render_template left partial output\n";
+         return 1;
+      }
+   }
+
+   std::printf("%10s %12s %12s %9s %12s %12s %9s\n", "bytes",
+      "strip regex", "strip scan", "speedup", "coll. regex", "coll. scan", "speedup");
+
+   std::string buffer;
+   for (int copies : {1, 16, 256}) {
+      const std::string input = make_input(text, copies);
+      buffer.reserve(input.size());
+
+      buffer.clear();
+      util::strip_leading_whitespace(input, buffer);
+      if (buffer != regex_strip(input)) {
+         std::cerr << "strip_leading_whitespace mismatch\n";
+         return 1;
+      }
+      buffer.clear();
+      util::collapse_whitespace(input, buffer);
+      if (buffer != regex_collapse(input)) {
+         std::cerr << "collapse_whitespace mismatch\n";
+         return 1;
+      }
+
+      const double strip_regex = time_us([&] { (void)regex_strip(input); });
+      const double strip_scan = time_us([&] {
+         buffer.clear();
+         util::strip_leading_whitespace(input, buffer);
+      });
+      const double coll_regex = time_us([&] { (void)regex_collapse(input); });
+      const double coll_scan = time_us([&] {
+         buffer.clear();
+         util::collapse_whitespace(input, buffer);
+      });
+
+      std::printf("%10zu %10.1fus %10.1fus %8.1fx %10.1fus %10.1fus %8.1fx\n",
+         input.size(), strip_regex, strip_scan, strip_regex / strip_scan,
+         coll_regex, coll_scan, coll_regex / coll_scan);
+   }
+}
@@ -7,10 +7,19 @@
  *  - OpenAIClient: central entry point with configuration
  *  - ResponsesAPI, ImagesAPI, ModerationsAPI, AudioAPI, SpeechAPI,
  *    TranscriptionsAPI, VideosAPI
+ *  - TranscriptionStream (streamed transcripts as a range of segments)
  */
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <vector>
@@ -48,6 +57,7 @@ class VideosAPI;
  *  - AudioAPI:
  *        * client.audio().speech().create(...)
  *        * client.audio().transcriptions().create_raw/create_json(...)
+ *        * client.audio().transcriptions().create_stream(...)
  *  - VideosAPI:      client.videos().create(), .retrieve(), .download(...)
  */
 class OpenAIClient {
@@ -61,6 +71,7 @@ public:
       if (config_.api_key.empty()) {
          throw std::runtime_error("OpenAIConfig.api_key is required");
       }
+      session_ = std::make_shared<CurlSession>(config_);
    }
 
    /**
@@ -76,6 +87,7 @@ public:
             "OPENAI_API_KEY environment variable is not set");
       }
       config_.api_key = key;
+      session_ = std::make_shared<CurlSession>(config_);
    }
 
    /**
@@ -92,7 +104,7 @@ public:
     * @brief Execute an HTTP request using libcurl.
     */
    HttpResponse execute(const HttpRequest& req) const {
-      return perform_curl_request(req, config_);
+      return perform_curl_request(req, config_, session_.get());
    }
 
    /// Access the Responses API (client.responses().create(...)).
@@ -154,6 +166,10 @@ public:
 private:
    OpenAIConfig config_;
 
+   /// DNS cache and TLS sessions shared by all requests (and by copies
+   /// of this client, also across threads).
+   std::shared_ptr<CurlSession> session_;
+
    friend class ResponsesAPI;
    friend class ImagesAPI;
    friend class ModerationsAPI;
@@ -443,6 +459,265 @@ private:
    OpenAIClient& client_;
 };
 
+// =====================================================
+//  TranscriptionStream
+// =====================================================
+
+/**
+ * @brief A piece of a streamed transcript, suitable as one caption cue.
+ *
+ * The streaming transcription events carry text only, no audio
+ * timestamps. start/end are therefore the times (in seconds since the
+ * request was sent) at which the segment's first and last text deltas
+ * arrived -- the moments a live caption would appear and be completed.
+ */
+struct TranscriptSegment {
+   std::string text;    ///< Segment text (whitespace-trimmed).
+   double start{0.0};   ///< Arrival of the first delta, in seconds.
+   double end{0.0};     ///< Arrival of the last delta, in seconds.
+   bool final{false};   ///< True for the segment ending the transcript.
+};
+
+/**
+ * @brief Lazily consumed range of TranscriptSegment objects.
+ *
+ * Returned by TranscriptionsAPI::create_stream. Nothing is transferred
+ * until the range is iterated; each increment pulls just enough of the
+ * server-sent event stream to complete the next segment. Text deltas
+ * are grouped into segments ending at sentence punctuation (. ? !), or,
+ * for text longer than max_chars bytes, at the last sentence end or
+ * space before it (never inside a UTF-8 character).
+ *
+ * @code
+ * for (const auto& segment : client.audio().transcriptions().create_stream(r)) {
+ *    std::println("[{:.1f}s] {}", segment.start, segment.text);
+ * }
+ * @endcode
+ */
+class TranscriptionStream {
+public:
+   class iterator {
+   public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type       = TranscriptSegment;
+      using difference_type  = std::ptrdiff_t;
+
+      iterator() = default;
+      explicit iterator(TranscriptionStream* stream) : stream_(stream) {}
+
+      const TranscriptSegment& operator*() const { return stream_->current_; }
+      const TranscriptSegment* operator->() const { return &stream_->current_; }
+
+      iterator& operator++() {
+         stream_->advance();
+         return *this;
+      }
+
+      void operator++(int) { ++*this; }
+
+      friend bool operator==(const iterator& it, std::default_sentinel_t) {
+         return it.at_end();
+      }
+
+   private:
+      bool at_end() const {
+         return stream_ == nullptr || stream_->finished_;
+      }
+
+      TranscriptionStream* stream_{nullptr};
+   };
+
+   TranscriptionStream(std::unique_ptr<CurlStream> stream,
+                       std::size_t max_chars = 84)
+      : stream_(std::move(stream)),
+        max_chars_(max_chars),
+        started_(std::chrono::steady_clock::now())
+   {}
+
+   /// Start (or continue) iterating; the first segment is fetched here.
+   iterator begin() {
+      if (!begun_) {
+         begun_ = true;
+         advance();
+      }
+      return iterator{this};
+   }
+
+   std::default_sentinel_t end() const { return {}; }
+
+   /// Complete text received so far (the whole transcript once finished).
+   const std::string& transcript() const { return transcript_; }
+
+private:
+   double elapsed() const {
+      return std::chrono::duration<double>(
+         std::chrono::steady_clock::now() - started_).count();
+   }
+
+   static bool ends_sentence(std::string_view text) {
+      while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+         text.remove_suffix(1);
+      }
+      return !text.empty() &&
+             (text.back() == '.' || text.back() == '?' || text.back() == '!');
+   }
+
+   // Move up to `count` characters of pending_ into current_.
+   void emit(std::size_t count, bool final) {
+      std::string_view text{pending_.data(), count};
+      while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+         text.remove_prefix(1);
+      }
+      while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+         text.remove_suffix(1);
+      }
+
+      current_.text.assign(text);
+      current_.start = pending_start_;
+      current_.end = pending_end_;
+      current_.final = final;
+      pending_.erase(0, count);
+      pending_start_ = pending_end_;
+   }
+
+   static bool continuation_byte(char c) {
+      return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+   }
+
+   // Where to cut pending_ when it is longer than max_chars_: after the
+   // last sentence ending within max_chars_, else at the last space,
+   // else at the last UTF-8 character boundary.
+   std::size_t forced_cut() const {
+      const std::size_t space = pending_.rfind(' ', max_chars_);
+      if (space != std::string::npos && space > 0) {
+         for (std::size_t s = space; s != std::string::npos && s > 0;
+              s = pending_.rfind(' ', s - 1)) {
+            if (ends_sentence(std::string_view{pending_.data(), s})) {
+               return s;
+            }
+         }
+         return space;
+      }
+
+      std::size_t cut = max_chars_;
+      while (cut > 0 && continuation_byte(pending_[cut])) {
+         --cut;
+      }
+      if (cut == 0) { // max_chars_ is shorter than the first character
+         cut = 1;
+         while (cut < pending_.size() && continuation_byte(pending_[cut])) {
+            ++cut;
+         }
+      }
+      return cut;
+   }
+
+   // Try to cut a segment from pending_; true if current_ was filled.
+   bool cut_segment() {
+      if (pending_.size() > max_chars_) {
+         emit(forced_cut(), false);
+         return true;
+      }
+
+      if (ends_sentence(pending_)) {
+         emit(pending_.size(), false);
+         return true;
+      }
+
+      return false;
+   }
+
+   void check_status() {
+      const long status = stream_->status_code();
+      if (status != 0 && status / 100 != 2) {
+         std::string body = std::move(buffer_);
+         while (stream_->read(body)) {}
+         throw std::runtime_error(
+            "Audio Transcriptions API error: " + body);
+      }
+   }
+
+   void advance() {
+      SseEvent ev;
+
+      // a long delta may leave more than one segment's worth pending
+      if (!done_ && cut_segment()) {
+         return;
+      }
+
+      while (!done_) {
+         if (!next_sse_event(buffer_, ev)) {
+            if (!stream_->read(buffer_)) {
+               check_status();
+               done_ = true; // connection closed without a done event
+               break;
+            }
+            check_status();
+            continue;
+         }
+
+         if (ev.data.empty() || ev.data == "[DONE]") {
+            continue;
+         }
+
+         const json payload = json::parse(ev.data);
+         const std::string type = payload.value("type", ev.event);
+
+         if (type == "transcript.text.delta") {
+            const std::string delta = payload.value("delta", "");
+            if (pending_.empty()) {
+               pending_start_ = elapsed();
+            }
+            pending_end_ = elapsed();
+            pending_ += delta;
+            transcript_ += delta;
+            if (cut_segment()) {
+               return;
+            }
+         }
+         else if (type == "transcript.text.done") {
+            // A server that sent no deltas still sends the full text.
+            if (transcript_.empty()) {
+               transcript_ = payload.value("text", "");
+               pending_ = transcript_;
+               pending_start_ = pending_end_ = elapsed();
+            }
+            done_ = true;
+         }
+         else if (type == "error" || payload.contains("error")) {
+            throw std::runtime_error(
+               "Audio Transcriptions API error: " + ev.data);
+         }
+      }
+
+      if (pending_.size() > max_chars_) {
+         emit(forced_cut(), false);
+         return;
+      }
+
+      if (!pending_.empty()) {
+         emit(pending_.size(), true);
+         return;
+      }
+
+      finished_ = true;
+   }
+
+   std::unique_ptr<CurlStream> stream_;
+   std::size_t max_chars_;
+   std::chrono::steady_clock::time_point started_;
+
+   std::string buffer_;      // received but not yet parsed SSE bytes
+   std::string pending_;     // delta text not yet emitted as a segment
+   std::string transcript_;  // all delta text received
+   double pending_start_{0.0};
+   double pending_end_{0.0};
+   TranscriptSegment current_;
+   bool begun_{false};
+   bool done_{false};        // no more events will arrive
+   bool finished_{false};    // no more segments will be produced
+};
+
 // =====================================================
 //  TranscriptionsAPI
 // =====================================================
@@ -500,6 +775,13 @@ public:
          });
       }
 
+      if (r.stream) {
+         fields.push_back(MultipartField{
+            .name  = "stream",
+            .value = *r.stream ? "true" : "false"
+         });
+      }
+
       // Extra arbitrary fields (serialize values as JSON strings)
       for (auto it = r.extra.begin(); it != r.extra.end(); ++it) {
          fields.push_back(MultipartField{
@@ -545,6 +827,49 @@ public:
       return json::parse(create(r));
    }
 
+   /**
+    * @brief Stream a transcription as it is produced.
+    *
+    * Sets stream=true and returns a lazily consumed range of
+    * TranscriptSegment objects (see TranscriptionStream). Requires a
+    * model that supports streaming, e.g. "gpt-4o-transcribe".
+    *
+    * @param max_chars Longest segment before a forced cut (84 is two
+    *                  standard 42-character caption lines).
+    */
+   TranscriptionStream create_stream(AudioTranscriptionRequest r,
+                                     std::size_t max_chars = 84) const {
+      r.stream = true;
+      r.response_format.reset(); // streaming always uses JSON events
+      auto stream = std::make_unique<CurlStream>(
+         create_request(r), client_.config_, client_.session_.get());
+      return TranscriptionStream{std::move(stream), max_chars};
+   }
+
+   /**
+    * @brief Stream a transcription into a WebVTT caption file.
+    *
+    * Each segment is written and flushed as a cue as soon as it is
+    * complete, so the file can be followed while it grows. Cues are shown
+    * for at least @p min_cue_seconds.
+    *
+    * @return The complete transcript text.
+    */
+   std::string stream_to_vtt(const AudioTranscriptionRequest& r,
+                             const std::filesystem::path& vtt_path,
+                             double min_cue_seconds = 1.0) const {
+      util::VttWriter writer{vtt_path};
+      auto stream = create_stream(r);
+      for (const auto& segment : stream) {
+         if (!segment.text.empty()) {
+            writer.write_cue(segment.start,
+               std::max(segment.end, segment.start + min_cue_seconds),
+               segment.text);
+         }
+      }
+      return stream.transcript();
+   }
+
 private:
    OpenAIClient& client_;
 };
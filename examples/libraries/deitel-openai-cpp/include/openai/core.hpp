@@ -12,7 +12,10 @@
  *        * creating and parsing data: URLs
  *        * guessing MIME types from file extensions
  *   - Multipart/form-data helpers for file uploads
- *   - libcurl plumbing (perform_curl_request)
+ *   - Regex-free text utilities (trim, dedent, templates)
+ *   - WebVTT caption writing (VttWriter)
+ *   - libcurl plumbing (CurlSession, perform_curl_request)
+ *   - Streaming responses (CurlStream, server-sent events)
  *
  * All higher-level APIs (Responses, Images, Audio, Moderations, Videos)
  * are built on top of these primitives in apis.hpp.
@@ -31,12 +34,25 @@
 #include <algorithm>
 #include <utility>
 #include <cstdlib>
-#include <regex>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <future>
+#include <memory>
+#include <mutex>
 
 #include <curl/curl.h>
 #include <nlohmann/json.hpp>
 #include <cppcodec/base64_rfc4648.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 namespace deitel::openai {
 
 using json = nlohmann::json;
@@ -113,6 +129,16 @@ struct OpenAIConfig {
 
    /// Timeout for each HTTP request, in seconds.
    long timeout_seconds = 300;
+
+   /// Optional: resolve base_url and complete a TLS handshake with it on
+   /// a background thread when the client is constructed, so the first
+   /// request finds the address cached and can resume the TLS session.
+   bool warm_up = false;
+
+   /// Optional: file in which TLS session tickets are kept between runs,
+   /// so the next process can resume the session instead of performing
+   /// a full handshake. Empty disables the cache. Requires libcurl 8.12+.
+   std::string tls_session_cache;
 };
 
 // =====================================================
@@ -336,6 +362,17 @@ user_home()
       "deitel::openai::util::user_home: HOME/USERPROFILE not set"};
 }
 
+/**
+ * @brief Conventional location for OpenAIConfig::tls_session_cache.
+ *
+ * Returns ~/.cache/deitel-openai-cpp/tls_sessions.bin.
+ */
+inline fs::path
+default_tls_session_cache()
+{
+   return user_home() / ".cache" / "deitel-openai-cpp" / "tls_sessions.bin";
+}
+
 inline std::string
 read_text_file(const fs::path& path)
 {
@@ -531,11 +568,345 @@ inline std::string first_image_base64_output(const json& response)
       "array of strings"};
 }
 
-inline std::string 
+// =====================================================
+//  Text utilities (regex-free)
+// =====================================================
+//
+// All of these scan their input once and append to a caller-provided
+// std::string, so a caller that reuses (and reserves) its buffer does
+// not allocate. Line and character searches go through memchr, which
+// the C library vectorizes; collapse_whitespace() also has an SSE2 scan.
+
+namespace text_detail {
+
+inline constexpr bool is_blank(char c) noexcept {
+   return c == ' ' || c == '\t';
+}
+
+inline constexpr bool is_space(char c) noexcept {
+   return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/// Position of @p c in @p s at or after @p pos, or npos.
+inline std::size_t find_char(std::string_view s, std::size_t pos, char c) noexcept {
+   if (pos >= s.size()) {
+      return std::string_view::npos;
+   }
+   const void* p = std::memchr(s.data() + pos, c, s.size() - pos);
+   return p ? static_cast<std::size_t>(static_cast<const char*>(p) - s.data())
+            : std::string_view::npos;
+}
+
+/// Number of blanks (space/tab) at the start of @p s.
+inline std::size_t leading_blanks(std::string_view s) noexcept {
+   std::size_t i = 0;
+   while (i < s.size() && is_blank(s[i])) {
+      ++i;
+   }
+   return i;
+}
+
+/// Position of the first whitespace character at or after @p pos, or size().
+inline std::size_t find_space(std::string_view s, std::size_t pos) noexcept {
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   // Every whitespace byte is <= 0x20; flag those 16 at a time and let the
+   // scalar check below reject the (rare) other control characters.
+   const __m128i limit = _mm_set1_epi8(0x20);
+   while (pos + 16 <= s.size()) {
+      const __m128i v = _mm_loadu_si128(
+         reinterpret_cast<const __m128i*>(s.data() + pos));
+      // v <= 0x20 (unsigned)  <=>  min(v, 0x20) == v
+      auto mask = static_cast<unsigned>(
+         _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, limit), v)));
+      while (mask != 0) {
+         const std::size_t i = pos + static_cast<std::size_t>(std::countr_zero(mask));
+         if (is_space(s[i])) {
+            return i;
+         }
+         mask &= mask - 1;
+      }
+      pos += 16;
+   }
+#endif
+   while (pos < s.size() && !is_space(s[pos])) {
+      ++pos;
+   }
+   return pos;
+}
+
+} // namespace text_detail
+
+/**
+ * @brief Append @p in to @p out with leading spaces/tabs removed from
+ *        every line.
+ *
+ * Both '\n' and '\r' start a new line, matching the multiline regex
+ * `^[ \t]+` this replaces.
+ */
+inline void
+strip_leading_whitespace(std::string_view in, std::string& out)
+{
+   using text_detail::find_char;
+   constexpr auto npos = std::string_view::npos;
+   std::size_t pos = 0;
+   std::size_t nl = find_char(in, 0, '\n');
+   while (pos < in.size()) {
+      pos += text_detail::leading_blanks(in.substr(pos));
+      if (nl != npos && nl < pos) {
+         nl = find_char(in, pos, '\n');
+      }
+      const std::size_t cr =
+         find_char(in.substr(0, nl == npos ? in.size() : nl), pos, '\r');
+      const std::size_t end = cr != npos ? cr : nl;
+      if (end == npos) {
+         out.append(in.substr(pos));
+         return;
+      }
+      out.append(in.data() + pos, end + 1 - pos);
+      pos = end + 1;
+   }
+}
+
+/// Convenience overload returning a new string.
+inline std::string
 strip_leading_whitespace(const std::string& s) {
-   return std::regex_replace(s, std::regex(R"(^[ \t]+)", std::regex_constants::multiline), "");
+   std::string out;
+   out.reserve(s.size());
+   strip_leading_whitespace(std::string_view{s}, out);
+   return out;
+}
+
+/**
+ * @brief Append @p in to @p out with leading and trailing spaces/tabs
+ *        removed from every line.
+ *
+ * Lines end at '\n'; a '\r' right before it is kept, so CRLF input stays
+ * CRLF.
+ */
+inline void
+trim_lines(std::string_view in, std::string& out)
+{
+   std::size_t pos = 0;
+   while (pos <= in.size()) {
+      const std::size_t nl = text_detail::find_char(in, pos, '\n');
+      std::string_view line = in.substr(pos, nl == std::string_view::npos
+                                                ? std::string_view::npos
+                                                : nl - pos);
+      const bool crlf = !line.empty() && line.back() == '\r';
+      if (crlf) {
+         line.remove_suffix(1);
+      }
+      line.remove_prefix(text_detail::leading_blanks(line));
+      while (!line.empty() && text_detail::is_blank(line.back())) {
+         line.remove_suffix(1);
+      }
+      out.append(line);
+      if (nl == std::string_view::npos) {
+         if (crlf) {
+            out.push_back('\r');
+         }
+         return;
+      }
+      out.append(crlf ? "\r\n" : "\n");
+      pos = nl + 1;
+   }
 }
 
+/**
+ * @brief Append @p in to @p out with the indentation common to all
+ *        non-blank lines removed (like Python's textwrap.dedent).
+ *
+ * Lines containing only spaces/tabs are written as empty lines.
+ */
+inline void
+dedent(std::string_view in, std::string& out)
+{
+   using text_detail::find_char;
+   constexpr auto npos = std::string_view::npos;
+
+   // Pass 1: longest indentation prefix shared by every non-blank line.
+   std::string_view margin;
+   bool have_margin = false;
+   for (std::size_t pos = 0; pos < in.size();) {
+      const std::size_t nl = find_char(in, pos, '\n');
+      const std::string_view line =
+         in.substr(pos, nl == npos ? npos : nl - pos);
+      const std::size_t indent = text_detail::leading_blanks(line);
+      if (indent < line.size() && line[indent] != '\r') {
+         const std::string_view lead = line.substr(0, indent);
+         if (!have_margin) {
+            margin = lead;
+            have_margin = true;
+         }
+         else {
+            std::size_t common = 0;
+            while (common < margin.size() && common < lead.size() &&
+                   margin[common] == lead[common]) {
+               ++common;
+            }
+            margin = margin.substr(0, common);
+         }
+      }
+      if (nl == npos) {
+         break;
+      }
+      pos = nl + 1;
+   }
+
+   // Pass 2: copy each line without the margin.
+   for (std::size_t pos = 0; pos < in.size();) {
+      const std::size_t nl = find_char(in, pos, '\n');
+      std::string_view line = in.substr(pos, nl == npos ? npos : nl - pos);
+      const std::size_t indent = text_detail::leading_blanks(line);
+      if (indent == line.size() || line[indent] == '\r') {
+         line.remove_prefix(indent);           // blank line
+      }
+      else {
+         line.remove_prefix(margin.size());
+      }
+      out.append(line);
+      if (nl == npos) {
+         return;
+      }
+      out.push_back('\n');
+      pos = nl + 1;
+   }
+}
+
+/**
+ * @brief Append @p in to @p out with every run of whitespace replaced by
+ *        a single space and leading/trailing whitespace dropped.
+ */
+inline void
+collapse_whitespace(std::string_view in, std::string& out)
+{
+   std::size_t pos = 0;
+   bool first = true;
+   while (true) {
+      while (pos < in.size() && text_detail::is_space(in[pos])) {
+         ++pos;
+      }
+      if (pos == in.size()) {
+         return;
+      }
+      const std::size_t end = text_detail::find_space(in, pos);
+      if (!first) {
+         out.push_back(' ');
+      }
+      out.append(in.data() + pos, end - pos);
+      first = false;
+      pos = end;
+   }
+}
+
+/// Placeholder values for render_template(); std::less<> allows lookup
+/// by string_view without building a std::string.
+using template_vars = std::map<std::string, std::string, std::less<>>;
+
+/**
+ * @brief Append @p tmpl to @p out with every `{{name}}` placeholder
+ *        replaced by @p vars.at(name).
+ *
+ * Spaces/tabs just inside the braces are ignored, so `{{ name }}` works
+ * too.
+ *
+ * @throws std::invalid_argument for an unknown name or a `{{` without a
+ *         matching `}}`, with @p out restored to its previous contents.
+ */
+inline void
+render_template(std::string_view tmpl, const template_vars& vars,
+                std::string& out)
+{
+   const std::size_t start = out.size();
+   std::size_t pos = 0;
+   while (pos < tmpl.size()) {
+      std::size_t open = text_detail::find_char(tmpl, pos, '{');
+      while (open != std::string_view::npos &&
+             (open + 1 >= tmpl.size() || tmpl[open + 1] != '{')) {
+         open = text_detail::find_char(tmpl, open + 1, '{');
+      }
+      if (open == std::string_view::npos) {
+         break;
+      }
+      const std::size_t close = tmpl.find("}}", open + 2);
+      if (close == std::string_view::npos) {
+         out.resize(start);
+         throw std::invalid_argument{
+            "deitel::openai::util::render_template: unterminated '{{' at "
+            "offset " + std::to_string(open)};
+      }
+      std::string_view name = tmpl.substr(open + 2, close - open - 2);
+      name.remove_prefix(text_detail::leading_blanks(name));
+      while (!name.empty() && text_detail::is_blank(name.back())) {
+         name.remove_suffix(1);
+      }
+      const auto it = vars.find(name);
+      if (it == vars.end()) {
+         out.resize(start);
+         throw std::invalid_argument{
+            "deitel::openai::util::render_template: unknown placeholder '" +
+            std::string{name} + "'"};
+      }
+      out.append(tmpl.data() + pos, open - pos);
+      out.append(it->second);
+      pos = close + 2;
+   }
+   out.append(tmpl.substr(pos));
+}
+
+// =====================================================
+//  WebVTT captions
+// =====================================================
+
+/// Format seconds as a WebVTT timestamp (HH:MM:SS.mmm).
+inline std::string
+vtt_timestamp(double seconds)
+{
+   const auto ms = static_cast<long long>(std::max(0.0, seconds) * 1000.0 + 0.5);
+   char buf[32];
+   std::snprintf(buf, sizeof buf, "%02lld:%02lld:%02lld.%03lld",
+                 ms / 3'600'000, ms / 60'000 % 60, ms / 1000 % 60, ms % 1000);
+   return buf;
+}
+
+/**
+ * @brief Writes a WebVTT file one cue at a time.
+ *
+ * The "WEBVTT" header is written on construction, and every cue is
+ * flushed as soon as it is added, so a player (or `tail -f`) sees
+ * captions while they are still being produced.
+ */
+class VttWriter {
+public:
+   explicit VttWriter(const fs::path& path)
+      : out_{path, std::ios::binary | std::ios::trunc}
+   {
+      if (!out_) {
+         throw std::runtime_error{
+            "deitel::openai::util::VttWriter: unable to open " +
+            path.string()};
+      }
+      out_ << "WEBVTT\n\n";
+      out_.flush();
+   }
+
+   /// Append a cue shown from @p start to @p end seconds.
+   void write_cue(double start, double end, std::string_view text)
+   {
+      out_ << ++cue_count_ << '\n'
+           << vtt_timestamp(start) << " --> " << vtt_timestamp(end) << '\n'
+           << text << "\n\n";
+      out_.flush();
+   }
+
+   /// Number of cues written so far.
+   std::size_t cue_count() const { return cue_count_; }
+
+private:
+   std::ofstream out_;
+   std::size_t cue_count_{0};
+};
+
 } // namespace util
 
 
@@ -679,23 +1050,322 @@ struct CurlGlobal {
 /// Global instance to ensure curl_global_init is called.
 inline CurlGlobal curl_global_singleton{};
 
+/**
+ * @brief libcurl state shared by all requests of one OpenAIClient.
+ *
+ * Each request uses a fresh easy handle, so without this every call
+ * would resolve DNS and perform a full TLS handshake. A CurlSession owns
+ * a curl "share" handle through which requests reuse the DNS cache and
+ * TLS sessions. Open connections are not shared: libcurl does not
+ * support a shared connection cache used from several threads at once,
+ * and copies of an OpenAIClient may be used on different threads. It
+ * can also:
+ *   - warm up: issue a HEAD request to base_url on a background thread,
+ *     with a short timeout, so the first real request finds the address
+ *     resolved and a TLS session to resume;
+ *   - load TLS session tickets from OpenAIConfig::tls_session_cache at
+ *     construction and save them again at destruction, so the next
+ *     process can resume the session (libcurl 8.12 or later).
+ */
+class CurlSession {
+public:
+   explicit CurlSession(const OpenAIConfig& cfg)
+      : share_(curl_share_init()), cache_path_(cfg.tls_session_cache)
+   {
+      if (!share_) {
+         throw std::runtime_error("Failed to init curl share");
+      }
+
+      curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, lock_callback);
+      curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, unlock_callback);
+      curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+      curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+      if (!cache_path_.empty()) {
+         try {
+            load_tls_sessions();
+         }
+         catch (...) {
+            // an unreadable cache only costs a full handshake
+         }
+      }
+
+      if (cfg.warm_up) {
+         warm_up_ = std::async(std::launch::async,
+                               [this, url = cfg.base_url,
+                                timeout = cfg.timeout_seconds > 0
+                                   ? std::min(cfg.timeout_seconds,
+                                              warm_up_timeout_seconds)
+                                   : warm_up_timeout_seconds] {
+                                  warm_up(url, timeout);
+                               }).share();
+      }
+   }
+
+   CurlSession(const CurlSession&) = delete;
+   CurlSession& operator=(const CurlSession&) = delete;
+
+   ~CurlSession()
+   {
+      // abort a warm-up still in flight, e.g. to an unreachable host,
+      // instead of waiting for its timeout
+      cancel_warm_up_ = true;
+      wait_for_warm_up();
+
+      if (!cache_path_.empty()) {
+         try {
+            save_tls_sessions();
+         }
+         catch (...) {
+            // a missing cache only costs a full handshake next time
+         }
+      }
+
+      curl_share_cleanup(share_);
+   }
+
+   /// The share handle to attach to easy handles (CURLOPT_SHARE).
+   CURLSH* share() const { return share_; }
+
+   /// Block until a pending warm-up request has finished.
+   void wait_for_warm_up() const
+   {
+      if (warm_up_.valid()) {
+         warm_up_.wait();
+      }
+   }
+
+private:
+   static void lock_callback(CURL*, curl_lock_data data,
+                             curl_lock_access, void* userptr)
+   {
+      static_cast<CurlSession*>(userptr)->locks_.at(data).lock();
+   }
+
+   static void unlock_callback(CURL*, curl_lock_data data, void* userptr)
+   {
+      static_cast<CurlSession*>(userptr)->locks_.at(data).unlock();
+   }
+
+   /// Upper bound, in seconds, on the warm-up request, which requests
+   /// and the destructor wait for.
+   static constexpr long warm_up_timeout_seconds = 5;
+
+   // Aborts the warm-up transfer once the destructor sets cancel_warm_up_.
+   static int warm_up_progress(void* userptr, curl_off_t, curl_off_t,
+                               curl_off_t, curl_off_t)
+   {
+      return static_cast<CurlSession*>(userptr)->cancel_warm_up_ ? 1 : 0;
+   }
+
+   // The response is irrelevant (no Authorization header is sent); the
+   // request only leaves a resolved address and a TLS session behind in
+   // the share.
+   void warm_up(const std::string& url, long timeout_seconds)
+   {
+      CURL* curl = curl_easy_init();
+      if (!curl) {
+         return;
+      }
+
+      curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+      curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+      curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+      curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, timeout_seconds);
+      curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_seconds);
+      curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+      curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+      curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, warm_up_progress);
+      curl_easy_setopt(curl, CURLOPT_XFERINFODATA, this);
+      curl_easy_perform(curl);
+      curl_easy_cleanup(curl);
+   }
+
+#if LIBCURL_VERSION_NUM >= 0x080c00
+   // Cache file layout: a sequence of records, each holding
+   //    int64 valid_until, then session_key, shmac and sdata,
+   //    each written as a uint32 length followed by the bytes.
+   // The file is only useful to this SDK; it is not a libcurl format.
+   struct TlsSessionRecord {
+      std::int64_t valid_until{0};
+      std::string session_key;
+      std::string shmac;
+      std::string sdata;
+   };
+
+   static void write_blob(std::ostream& out, const std::string& blob)
+   {
+      const auto size = static_cast<std::uint32_t>(blob.size());
+      out.write(reinterpret_cast<const char*>(&size), sizeof size);
+      out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+   }
+
+   // Reads a blob from a file with `remaining` unread bytes; a length
+   // beyond them means the file is corrupt or truncated.
+   static bool read_blob(std::istream& in, std::string& blob,
+                         std::uintmax_t& remaining)
+   {
+      std::uint32_t size{0};
+      if (remaining < sizeof size ||
+          !in.read(reinterpret_cast<char*>(&size), sizeof size)) {
+         return false;
+      }
+      remaining -= sizeof size;
+      if (size > remaining) {
+         return false;
+      }
+      remaining -= size;
+      blob.resize(size);
+      return static_cast<bool>(
+         in.read(blob.data(), static_cast<std::streamsize>(size)));
+   }
+
+   static CURLcode export_callback(CURL*, void* userptr,
+      const char* session_key, const unsigned char* shmac,
+      std::size_t shmac_len, const unsigned char* sdata,
+      std::size_t sdata_len, curl_off_t valid_until, int, const char*,
+      std::size_t)
+   {
+      auto* records = static_cast<std::vector<TlsSessionRecord>*>(userptr);
+      TlsSessionRecord record;
+      record.valid_until = static_cast<std::int64_t>(valid_until);
+      if (session_key) {
+         record.session_key = session_key;
+      }
+      record.shmac.assign(reinterpret_cast<const char*>(shmac), shmac_len);
+      record.sdata.assign(reinterpret_cast<const char*>(sdata), sdata_len);
+      records->push_back(std::move(record));
+      return CURLE_OK;
+   }
+
+   // Reads the whole cache before importing anything: a record that does
+   // not fit in the file discards the cache.
+   void load_tls_sessions()
+   {
+      std::error_code ec;
+      std::uintmax_t remaining = std::filesystem::file_size(cache_path_, ec);
+      if (ec) {
+         return;
+      }
+      std::ifstream in(cache_path_, std::ios::binary);
+      if (!in) {
+         return;
+      }
+
+      const auto now = static_cast<std::int64_t>(std::time(nullptr));
+      std::vector<TlsSessionRecord> records;
+      while (remaining > 0) {
+         TlsSessionRecord record;
+         if (remaining < sizeof record.valid_until ||
+             !in.read(reinterpret_cast<char*>(&record.valid_until),
+                      sizeof record.valid_until)) {
+            return;
+         }
+         remaining -= sizeof record.valid_until;
+         if (!read_blob(in, record.session_key, remaining) ||
+             !read_blob(in, record.shmac, remaining) ||
+             !read_blob(in, record.sdata, remaining)) {
+            return;
+         }
+         if (record.valid_until > now) {
+            records.push_back(std::move(record));
+         }
+      }
+
+      CURL* curl = curl_easy_init();
+      if (!curl) {
+         return;
+      }
+      curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+      for (const auto& record : records) {
+         curl_easy_ssls_import(curl,
+            record.session_key.empty() ? nullptr : record.session_key.c_str(),
+            reinterpret_cast<const unsigned char*>(record.shmac.data()),
+            record.shmac.size(),
+            reinterpret_cast<const unsigned char*>(record.sdata.data()),
+            record.sdata.size());
+      }
+      curl_easy_cleanup(curl);
+   }
+
+   void save_tls_sessions()
+   {
+      CURL* curl = curl_easy_init();
+      if (!curl) {
+         return;
+      }
+      curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+
+      std::vector<TlsSessionRecord> records;
+      const CURLcode res =
+         curl_easy_ssls_export(curl, export_callback, &records);
+      curl_easy_cleanup(curl);
+      if (res != CURLE_OK || records.empty()) {
+         return;
+      }
+
+      // write next to the cache and rename, so a concurrently starting
+      // process never reads a half-written file
+      namespace fs = std::filesystem;
+      fs::create_directories(cache_path_.parent_path());
+      fs::path tmp_path = cache_path_;
+      tmp_path += ".tmp";
+      {
+         std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+         for (const auto& record : records) {
+            out.write(reinterpret_cast<const char*>(&record.valid_until),
+                      sizeof record.valid_until);
+            write_blob(out, record.session_key);
+            write_blob(out, record.shmac);
+            write_blob(out, record.sdata);
+         }
+         if (!out) {
+            return;
+         }
+      }
+      fs::rename(tmp_path, cache_path_);
+   }
+#else
+   // libcurl older than 8.12 cannot export TLS sessions; sessions are
+   // still shared within the process through the share handle.
+   void load_tls_sessions() {}
+   void save_tls_sessions() {}
+#endif
+
+   CURLSH* share_;
+   std::filesystem::path cache_path_;
+   std::array<std::mutex, CURL_LOCK_DATA_LAST> locks_;
+   std::atomic<bool> cancel_warm_up_{false};
+   std::shared_future<void> warm_up_;
+};
+
 /**
  * @brief Perform an HTTP request using libcurl.
  *
  * @param req The request to send.
  * @param cfg OpenAIConfig with timeout and other settings.
+ * @param session Optional CurlSession whose DNS cache and TLS sessions
+ *                the request may reuse.
  * @return HttpResponse containing status code, headers and body.
  *
  * @throws std::runtime_error if libcurl reports an error.
  */
 inline HttpResponse perform_curl_request(const HttpRequest& req,
-                                         const OpenAIConfig& cfg)
+                                         const OpenAIConfig& cfg,
+                                         const CurlSession* session = nullptr)
 {
    CURL* curl = curl_easy_init();
    if (!curl) {
       throw std::runtime_error("Failed to init curl");
    }
 
+   if (session) {
+      // joining a warm-up in flight is never slower than racing it
+      session->wait_for_warm_up();
+      curl_easy_setopt(curl, CURLOPT_SHARE, session->share());
+   }
+
    std::string response_body;
    std::vector<HttpHeader> response_headers;
 
@@ -747,6 +1417,197 @@ inline HttpResponse perform_curl_request(const HttpRequest& req,
    return out;
 }
 
+// =====================================================
+//  Streaming responses (server-sent events)
+// =====================================================
+
+/**
+ * @brief A pull-based HTTP transfer for streaming responses.
+ *
+ * perform_curl_request() returns only after the whole body arrived.
+ * CurlStream instead drives the transfer with libcurl's multi interface
+ * on the caller's thread: each read() call transfers just enough to
+ * return the bytes that arrived since the previous call. No background
+ * thread is involved; if nobody reads, nothing is transferred.
+ */
+class CurlStream {
+public:
+   CurlStream(HttpRequest req, const OpenAIConfig& cfg,
+              const CurlSession* session = nullptr)
+      : req_(std::move(req))
+   {
+      multi_ = curl_multi_init();
+      easy_  = curl_easy_init();
+      if (!multi_ || !easy_) {
+         cleanup();
+         throw std::runtime_error("Failed to init curl");
+      }
+
+      if (session) {
+         session->wait_for_warm_up();
+         curl_easy_setopt(easy_, CURLOPT_SHARE, session->share());
+      }
+
+      curl_easy_setopt(easy_, CURLOPT_URL, req_.url.c_str());
+      curl_easy_setopt(easy_, CURLOPT_CUSTOMREQUEST, req_.method.c_str());
+      curl_easy_setopt(easy_, CURLOPT_TIMEOUT, cfg.timeout_seconds);
+
+      for (const auto& h : req_.headers) {
+         std::string line = h.name + ": " + h.value;
+         header_list_ = curl_slist_append(header_list_, line.c_str());
+      }
+      curl_easy_setopt(easy_, CURLOPT_HTTPHEADER, header_list_);
+
+      if (req_.method == "POST" || req_.method == "PUT" ||
+          req_.method == "PATCH") {
+         curl_easy_setopt(easy_, CURLOPT_POSTFIELDS, req_.body.c_str());
+         curl_easy_setopt(easy_, CURLOPT_POSTFIELDSIZE, req_.body.size());
+      }
+
+      curl_easy_setopt(easy_, CURLOPT_WRITEFUNCTION, write_callback);
+      curl_easy_setopt(easy_, CURLOPT_WRITEDATA, &pending_);
+
+      curl_multi_add_handle(multi_, easy_);
+   }
+
+   CurlStream(const CurlStream&) = delete;
+   CurlStream& operator=(const CurlStream&) = delete;
+
+   ~CurlStream() { cleanup(); }
+
+   /**
+    * @brief Append the next chunk of the response body to @p out.
+    *
+    * Blocks until at least one byte arrives or the transfer ends.
+    *
+    * @return false once the transfer has finished and all data was read.
+    * @throws std::runtime_error if libcurl reports an error.
+    */
+   bool read(std::string& out)
+   {
+      while (pending_.empty() && !done_) {
+         int running = 0;
+         curl_multi_perform(multi_, &running);
+
+         int queued = 0;
+         while (CURLMsg* msg = curl_multi_info_read(multi_, &queued)) {
+            if (msg->msg == CURLMSG_DONE) {
+               done_ = true;
+               if (msg->data.result != CURLE_OK) {
+                  throw std::runtime_error(
+                     std::string("curl error: ") +
+                     curl_easy_strerror(msg->data.result));
+               }
+            }
+         }
+
+         if (pending_.empty() && !done_) {
+            curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+         }
+      }
+
+      if (pending_.empty()) {
+         return false;
+      }
+
+      out.append(pending_);
+      pending_.clear();
+      return true;
+   }
+
+   /// HTTP status code (0 until the response headers arrived).
+   long status_code() const
+   {
+      long status = 0;
+      curl_easy_getinfo(easy_, CURLINFO_RESPONSE_CODE, &status);
+      return status;
+   }
+
+private:
+   void cleanup()
+   {
+      if (multi_ && easy_) {
+         curl_multi_remove_handle(multi_, easy_);
+      }
+      if (easy_) curl_easy_cleanup(easy_);
+      if (multi_) curl_multi_cleanup(multi_);
+      curl_slist_free_all(header_list_);
+      easy_ = nullptr;
+      multi_ = nullptr;
+      header_list_ = nullptr;
+   }
+
+   HttpRequest req_;   // POSTFIELDS is not copied by libcurl
+   CURLM* multi_{nullptr};
+   CURL* easy_{nullptr};
+   curl_slist* header_list_{nullptr};
+   std::string pending_;
+   bool done_{false};
+};
+
+/**
+ * @brief One server-sent event (the "event:" name and joined "data:" lines).
+ */
+struct SseEvent {
+   std::string event;
+   std::string data;
+};
+
+/**
+ * @brief Extract the next complete server-sent event from @p buffer.
+ *
+ * Consumed bytes are erased from @p buffer; an incomplete trailing event
+ * stays there until more data arrives.
+ *
+ * @return true if @p ev was filled with a complete event.
+ */
+inline bool next_sse_event(std::string& buffer, SseEvent& ev)
+{
+   ev = SseEvent{};
+   std::size_t pos = 0;
+
+   while (true) {
+      const std::size_t eol = buffer.find('\n', pos);
+      if (eol == std::string::npos) {
+         return false;
+      }
+
+      std::string_view line{buffer.data() + pos, eol - pos};
+      pos = eol + 1;
+      if (!line.empty() && line.back() == '\r') {
+         line.remove_suffix(1);
+      }
+
+      if (line.empty()) {
+         if (ev.data.empty() && ev.event.empty()) {
+            continue; // stray blank line between events
+         }
+         buffer.erase(0, pos);
+         return true;
+      }
+
+      const std::size_t colon = line.find(':');
+      std::string_view field = line.substr(0, colon);
+      std::string_view value =
+         colon == std::string_view::npos ? std::string_view{}
+                                         : line.substr(colon + 1);
+      if (!value.empty() && value.front() == ' ') {
+         value.remove_prefix(1);
+      }
+
+      if (field == "data") {
+         if (!ev.data.empty()) {
+            ev.data += '\n';
+         }
+         ev.data += value;
+      }
+      else if (field == "event") {
+         ev.event = value;
+      }
+      // "id", "retry" and ":" comments are not used by the OpenAI API
+   }
+}
+
 
 // Find the first tool-related output item for a given tool name.
 //
@@ -288,6 +288,11 @@ struct AudioTranscriptionRequest {
    /// Temperature for sampling; see OpenAI docs for defaults.
    std::optional<double> temperature;
 
+   /// Stream transcript deltas as they are produced. Supported by
+   /// "gpt-4o-transcribe" and "gpt-4o-mini-transcribe", not "whisper-1".
+   /// Set automatically by TranscriptionsAPI::create_stream.
+   std::optional<bool> stream;
+
    /// Arbitrary extra fields not modeled explicitly.
    json extra = json::object();
 };
@@ -0,0 +1,125 @@
+// transcription_stream_test.cpp
+// Checks how TranscriptionStream groups transcript deltas into segments.
+// The server-sent events are written to a temporary file and read back
+// through a file:// URL, so no network access or API key is needed.
+//
+// Build (from the SDK root):
+//   g++ -std=c++20 -O2 -Iinclude -Iexternal tests/transcription_stream_test.cpp -lcurl -o transcription_stream_test
+// Run:
+//   ./transcription_stream_test
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "openai/openai.hpp"
+
+namespace openai = deitel::openai;
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+   if (!ok) {
+      std::cerr << "FAILED: " << what << '\n';
+      ++failures;
+   }
+}
+
+// SSE body with one delta event per string, then a done event with text.
+std::string events(const std::vector<std::string>& deltas, const std::string& text) {
+   std::string body;
+   for (const auto& delta : deltas) {
+      body += "data: " + json{{"type", "transcript.text.delta"}, {"delta", delta}}.dump() + "\n\n";
+   }
+   body += "data: " + json{{"type", "transcript.text.done"}, {"text", text}}.dump() + "\n\n";
+   return body;
+}
+
+std::vector<openai::TranscriptSegment> segments(const std::string& body, std::size_t max_chars) {
+   const fs::path path{fs::temp_directory_path() / "transcription_stream_test.sse"};
+   std::ofstream{path, std::ios::binary} << body;
+
+   openai::HttpRequest req;
+   req.method = "GET";
+   req.url = "file://" + path.string();
+   openai::OpenAIConfig cfg;
+   openai::TranscriptionStream stream{std::make_unique<openai::CurlStream>(req, cfg), max_chars};
+   std::vector<openai::TranscriptSegment> result;
+   for (const auto& segment : stream) {
+      result.push_back(segment);
+   }
+   fs::remove(path);
+   return result;
+}
+
+bool valid_utf8(const std::string& s) {
+   for (std::size_t i = 0; i < s.size();) {
+      const auto lead = static_cast<unsigned char>(s[i]);
+      const std::size_t length = lead < 0x80 ? 1 : lead >> 5 == 0x6 ? 2
+                               : lead >> 4 == 0xE ? 3 : lead >> 3 == 0x1E ? 4 : 0;
+      if (length == 0 || i + length > s.size()) {
+         return false;
+      }
+      for (std::size_t k = 1; k < length; ++k) {
+         if ((static_cast<unsigned char>(s[i + k]) & 0xC0) != 0x80) {
+            return false;
+         }
+      }
+      i += length;
+   }
+   return true;
+}
+
+int main() {
+   // deltas cut at sentence punctuation; the last segment is final
+   {
+      const auto result = segments(events({"Hello", " there.", " How are", " you?", " Fine"}, ""), 84);
+      check(result.size() == 3, "sentences: segment count");
+      if (result.size() == 3) {
+         check(result[0].text == "Hello there.", "sentences: first");
+         check(result[1].text == "How are you?", "sentences: second");
+         check(result[2].text == "Fine" && result[2].final, "sentences: final");
+         check(!result[0].final && !result[1].final, "sentences: not final");
+      }
+   }
+
+   // no spaces (CJK text): forced cuts fall on character boundaries
+   {
+      std::string text;
+      for (int i = 0; i < 40; ++i) {
+         text += "\xE6\x97\xA5\xE6\x9C\xAC"; // two 3-byte characters
+      }
+      const auto result = segments(events({text.substr(0, 99), text.substr(99)}, ""), 10);
+      std::string joined;
+      for (const auto& segment : result) {
+         check(valid_utf8(segment.text), "CJK: valid UTF-8");
+         check(segment.text.size() <= 10, "CJK: max_chars");
+         joined += segment.text;
+      }
+      check(joined == text, "CJK: no text lost");
+   }
+
+   // a done event without deltas is still split at max_chars, preferring
+   // sentence ends
+   {
+      const std::string text{"One two three. Four five six seven. Eight nine ten eleven twelve."};
+      const auto result = segments(events({}, text), 20);
+      check(result.size() == 5, "done only: segment count");
+      if (result.size() == 5) {
+         check(result[0].text == "One two three.", "done only: sentence end");
+         check(result[1].text == "Four five six", "done only: word boundary");
+         check(result[2].text == "seven.", "done only: sentence end");
+         check(result[4].text == "eleven twelve." && result[4].final, "done only: final");
+      }
+      for (const auto& segment : result) {
+         check(segment.text.size() <= 20, "done only: max_chars");
+      }
+   }
+
+   std::cout << (failures == 0 ? "all tests passed" : "tests failed") << '\n';
+   return failures == 0 ? 0 : 1;
+}
@@ -15,18 +15,32 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #ifdef HAS_CODECVT
 #include <codecvt>
 #include <locale>
 #endif
+#include <exception>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
 #if defined(_MSC_VER)
@@ -34,6 +48,72 @@
 typedef SSIZE_T ssize_t;
 #endif
 
+#if defined(_MSVC_LANG)
+#if _MSVC_LANG >= 201703L
+#define RAPIDCSV_HAS_CXX17
+#endif
+#elif __cplusplus >= 201703L
+#define RAPIDCSV_HAS_CXX17
+#endif
+
+#if defined(_MSVC_LANG)
+#if _MSVC_LANG >= 202002L
+#define RAPIDCSV_HAS_CXX20
+#endif
+#elif __cplusplus >= 202002L
+#define RAPIDCSV_HAS_CXX20
+#endif
+
+#if !defined(RAPIDCSV_NO_SIMD)
+#if defined(__AVX2__)
+#define RAPIDCSV_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#define RAPIDCSV_SSE42
+#include <nmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define RAPIDCSV_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef RAPIDCSV_HAS_CXX17
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#endif
+
+#ifdef RAPIDCSV_HAS_CXX20
+#include <span>
+#endif
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 namespace rapidcsv
 {
 #if defined(_MSC_VER)
@@ -124,6 +204,29 @@ namespace rapidcsv
      */
     void ToStr(const T& pVal, std::string& pStr) const
     {
+#ifdef RAPIDCSV_HAS_CXX17
+      if constexpr (std::is_same<T, char>::value)
+      {
+        pStr.assign(1, pVal);
+      }
+      else if constexpr (std::is_integral<T>::value && IsNumeric())
+      {
+        char buf[24];
+        const std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), pVal);
+        pStr.assign(buf, result.ptr);
+      }
+#if defined(__cpp_lib_to_chars)
+      else if constexpr (std::is_floating_point<T>::value && IsNumeric())
+      {
+        // general format with precision 6 gives the same output as std::ostream defaults
+        char buf[64];
+        const std::to_chars_result result =
+          std::to_chars(buf, buf + sizeof(buf), pVal, std::chars_format::general, 6);
+        pStr.assign(buf, result.ptr);
+      }
+#endif
+      else
+#endif
       if (typeid(T) == typeid(int) ||
           typeid(T) == typeid(long) ||
           typeid(T) == typeid(long long) ||
@@ -152,6 +255,16 @@ namespace rapidcsv
      */
     void ToVal(const std::string& pStr, T& pVal) const
     {
+#ifdef RAPIDCSV_HAS_CXX17
+      if constexpr (IsNumeric())
+      {
+        ViewToVal(pStr, pVal);
+      }
+      else
+      {
+        throw no_converter();
+      }
+#else
       try
       {
         if (typeid(T) == typeid(int))
@@ -238,9 +351,181 @@ namespace rapidcsv
       {
         throw no_converter();
       }
+#endif
+    }
+
+#ifdef RAPIDCSV_HAS_CXX17
+    /**
+     * @brief   Converts a string view holding a numerical value to numerical datatype
+     *          representation like ToVal, without copying it into a std::string. Other datatypes
+     *          are converted by ToVal from a copy. MappedDocument and PooledDocument convert cells
+     *          with this function, so custom conversions for them specialize it.
+     * @param   pStr                  string view
+     * @param   pVal                  numerical value
+     */
+    void ViewToVal(const std::string_view pStr, T& pVal) const
+    {
+      if constexpr (IsNumeric())
+      {
+        const std::errc err = TryToVal(pStr, pVal);
+        if (err == std::errc())
+        {
+          return;
+        }
+        else if (mConverterParams.mHasDefaultConverter)
+        {
+          if constexpr (std::is_integral<T>::value)
+          {
+            pVal = static_cast<T>(mConverterParams.mDefaultInteger);
+          }
+          else
+          {
+            pVal = static_cast<T>(mConverterParams.mDefaultFloat);
+          }
+        }
+        else if (err == std::errc::result_out_of_range)
+        {
+          throw std::out_of_range("value out of range: " + std::string(pStr));
+        }
+        else
+        {
+          throw std::invalid_argument("invalid value: " + std::string(pStr));
+        }
+      }
+      else
+      {
+        ToVal(std::string(pStr), pVal);
+      }
+    }
+
+    /**
+     * @brief   Converts string holding a numerical value to numerical datatype representation,
+     *          without exceptions. Numbers are parsed with std::from_chars directly from the
+     *          string view, other input (e.g. leading whitespace, plus sign or trailing
+     *          characters) falls back to the same parsing as std::stoi / std::stod.
+     * @param   pStr                  string
+     * @param   pVal                  numerical value, unchanged on failure
+     * @returns std::errc() on success, std::errc::invalid_argument if no number could be
+     *          parsed, or std::errc::result_out_of_range if it does not fit the datatype.
+     */
+    std::errc TryToVal(const std::string_view pStr, T& pVal) const
+    {
+      if constexpr (std::is_same<T, char>::value)
+      {
+        pVal = pStr.empty() ? '\0' : pStr[0];
+        return std::errc();
+      }
+      else if constexpr (std::is_integral<T>::value)
+      {
+        const char* end = pStr.data() + pStr.size();
+        T val;
+        const std::from_chars_result result = std::from_chars(pStr.data(), end, val);
+        if ((result.ec == std::errc()) && (result.ptr == end))
+        {
+          pVal = val;
+          return std::errc();
+        }
+
+        return StrToVal(std::string(pStr), pVal);
+      }
+      else if constexpr (std::is_floating_point<T>::value)
+      {
+#if defined(__cpp_lib_to_chars)
+        const char* end = pStr.data() + pStr.size();
+        T val;
+        const std::from_chars_result result = std::from_chars(pStr.data(), end, val);
+        // subnormal values are out of range for std::stod
+        if ((result.ec == std::errc()) && (result.ptr == end) && (std::fpclassify(val) != FP_SUBNORMAL))
+        {
+          pVal = val;
+          return std::errc();
+        }
+#endif
+
+        return StrToVal(std::string(pStr), pVal);
+      }
+      else
+      {
+        return std::errc::invalid_argument;
+      }
     }
+#endif
 
   private:
+#ifdef RAPIDCSV_HAS_CXX17
+    static constexpr bool IsNumeric()
+    {
+      return std::is_same<T, int>::value || std::is_same<T, long>::value ||
+             std::is_same<T, long long>::value || std::is_same<T, unsigned>::value ||
+             std::is_same<T, unsigned long>::value || std::is_same<T, unsigned long long>::value ||
+             std::is_same<T, float>::value || std::is_same<T, double>::value ||
+             std::is_same<T, long double>::value || std::is_same<T, char>::value;
+    }
+
+    static std::errc StrToVal(const std::string& pStr, T& pVal)
+    {
+      const char* str = pStr.c_str();
+      char* end = nullptr;
+      const int savedErrno = errno;
+      errno = 0;
+      T val;
+      bool inRange = true;
+      if constexpr (std::is_same<T, int>::value)
+      {
+        const long lval = std::strtol(str, &end, 10);
+        inRange = (lval >= std::numeric_limits<int>::min()) && (lval <= std::numeric_limits<int>::max());
+        val = static_cast<T>(lval);
+      }
+      else if constexpr (std::is_same<T, long>::value)
+      {
+        val = std::strtol(str, &end, 10);
+      }
+      else if constexpr (std::is_same<T, long long>::value)
+      {
+        val = std::strtoll(str, &end, 10);
+      }
+      else if constexpr (std::is_same<T, unsigned>::value || std::is_same<T, unsigned long>::value)
+      {
+        val = static_cast<T>(std::strtoul(str, &end, 10));
+      }
+      else if constexpr (std::is_same<T, unsigned long long>::value)
+      {
+        val = std::strtoull(str, &end, 10);
+      }
+      else if constexpr (std::is_same<T, float>::value)
+      {
+        val = std::strtof(str, &end);
+      }
+      else if constexpr (std::is_same<T, double>::value)
+      {
+        val = std::strtod(str, &end);
+      }
+      else if constexpr (std::is_same<T, long double>::value)
+      {
+        val = std::strtold(str, &end);
+      }
+      else
+      {
+        errno = savedErrno;
+        return std::errc::invalid_argument;
+      }
+
+      const bool outOfRange = (errno == ERANGE) || !inRange;
+      errno = savedErrno;
+      if (end == str)
+      {
+        return std::errc::invalid_argument;
+      }
+      else if (outOfRange)
+      {
+        return std::errc::result_out_of_range;
+      }
+
+      pVal = val;
+      return std::errc();
+    }
+#endif
+
     const ConverterParams& mConverterParams;
   };
 
@@ -266,6 +551,19 @@ namespace rapidcsv
     pVal = pStr;
   }
 
+#ifdef RAPIDCSV_HAS_CXX17
+  /**
+   * @brief     Specialized implementation handling string view to string conversion.
+   * @param     pStr                  string view
+   * @param     pVal                  string
+   */
+  template<>
+  inline void Converter<std::string>::ViewToVal(const std::string_view pStr, std::string& pVal) const
+  {
+    pVal.assign(pStr.data(), pStr.size());
+  }
+#endif
+
   template<typename T>
   using ConvFunc = std::function<void (const std::string & pStr, T & pVal)>;
 
@@ -395,705 +693,6434 @@ namespace rapidcsv
   };
 
   /**
-   * @brief     Class representing a CSV document.
+   * @brief     Datastructure holding parameters controlling how many threads are used to parse
+   *            CSV data.
    */
-  class Document
+  struct ParallelParams
   {
-  public:
     /**
      * @brief   Constructor
-     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
-     *                                data with.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pThreadCount          specifies the maximum number of threads to parse with, setting
+     *                                it to 0 uses the number of hardware threads. Default: 1
+     * @param   pMinChunkSize         specifies the minimum number of bytes to parse per thread,
+     *                                smaller inputs are parsed with fewer threads. Default: 1 MiB
      */
-    explicit Document(const std::string& pPath = std::string(),
-                      const LabelParams& pLabelParams = LabelParams(),
-                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
-                      const ConverterParams& pConverterParams = ConverterParams(),
-                      const LineReaderParams& pLineReaderParams = LineReaderParams())
-      : mPath(pPath)
-      , mLabelParams(pLabelParams)
-      , mSeparatorParams(pSeparatorParams)
-      , mConverterParams(pConverterParams)
-      , mLineReaderParams(pLineReaderParams)
+    explicit ParallelParams(const size_t pThreadCount = 1, const size_t pMinChunkSize = 1024 * 1024)
+      : mThreadCount(pThreadCount)
+      , mMinChunkSize(pMinChunkSize)
     {
-      if (!mPath.empty())
-      {
-        ReadCsv();
-      }
     }
 
+    /**
+     * @brief   specifies the maximum number of threads to parse with.
+     */
+    size_t mThreadCount;
+
+    /**
+     * @brief   specifies the minimum number of bytes to parse per thread.
+     */
+    size_t mMinChunkSize;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters selecting which columns and rows are kept when
+   *            loading CSV data. Cells of other columns are not unquoted, trimmed or stored, and
+   *            rows rejected by the filter are not stored.
+   */
+  struct FilterParams
+  {
     /**
      * @brief   Constructor
-     * @param   pStream               specifies an input stream to read CSV data from.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pColumnNames          specifies the names of the columns to keep, in addition to the
+     *                                row name column, requires a column name row. Columns are kept
+     *                                in file order. Default: keep all columns
+     * @param   pRowFilter            specifies a function called with each data row (i.e. rows
+     *                                following the column name row) after column selection, in the
+     *                                same column layout as the loaded document. Rows for which it
+     *                                returns false are skipped. When loading with more than one
+     *                                thread (ParallelParams), it is called concurrently from the
+     *                                parsing threads, in no particular row order, and must be
+     *                                thread-safe. Default: keep all rows
      */
-    explicit Document(std::istream& pStream,
-                      const LabelParams& pLabelParams = LabelParams(),
-                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
-                      const ConverterParams& pConverterParams = ConverterParams(),
-                      const LineReaderParams& pLineReaderParams = LineReaderParams())
-      : mPath()
-      , mLabelParams(pLabelParams)
-      , mSeparatorParams(pSeparatorParams)
-      , mConverterParams(pConverterParams)
-      , mLineReaderParams(pLineReaderParams)
+    explicit FilterParams(const std::vector<std::string>& pColumnNames = std::vector<std::string>(),
+                          const std::function<bool(const std::vector<std::string>&)>& pRowFilter =
+                            std::function<bool(const std::vector<std::string>&)>())
+      : mColumnNames(pColumnNames)
+      , mRowFilter(pRowFilter)
     {
-      ReadCsv(pStream);
     }
 
     /**
-     * @brief   Read Document data from file.
-     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
-     *                                data with.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   specifies the names of the columns to keep.
      */
-    void Load(const std::string& pPath,
-              const LabelParams& pLabelParams = LabelParams(),
-              const SeparatorParams& pSeparatorParams = SeparatorParams(),
-              const ConverterParams& pConverterParams = ConverterParams(),
-              const LineReaderParams& pLineReaderParams = LineReaderParams())
-    {
-      mPath = pPath;
-      mLabelParams = pLabelParams;
-      mSeparatorParams = pSeparatorParams;
-      mConverterParams = pConverterParams;
-      mLineReaderParams = pLineReaderParams;
-      ReadCsv();
-    }
+    std::vector<std::string> mColumnNames;
 
     /**
-     * @brief   Read Document data from stream.
-     * @param   pStream               specifies an input stream to read CSV data from.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   specifies a function deciding whether to keep a data row, which must be
+     *          thread-safe when loading with more than one thread.
      */
-    void Load(std::istream& pStream,
-              const LabelParams& pLabelParams = LabelParams(),
-              const SeparatorParams& pSeparatorParams = SeparatorParams(),
-              const ConverterParams& pConverterParams = ConverterParams(),
-              const LineReaderParams& pLineReaderParams = LineReaderParams())
+    std::function<bool(const std::vector<std::string>&)> mRowFilter;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling use of a binary sidecar file caching
+   *            the parsed contents of a CSV file.
+   */
+  struct SidecarParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pUseSidecar           specifies whether to load from a valid sidecar file instead of
+     *                                parsing the CSV file, and to write one after parsing. Default: false
+     * @param   pSidecarPath          specifies the path of the sidecar file. Default: CSV file path
+     *                                with ".rcsv" appended
+     */
+    explicit SidecarParams(const bool pUseSidecar = false, const std::string& pSidecarPath = std::string())
+      : mUseSidecar(pUseSidecar)
+      , mSidecarPath(pSidecarPath)
     {
-      mPath = "";
-      mLabelParams = pLabelParams;
-      mSeparatorParams = pSeparatorParams;
-      mConverterParams = pConverterParams;
-      mLineReaderParams = pLineReaderParams;
-      ReadCsv(pStream);
     }
 
     /**
-     * @brief   Write Document data to file.
-     * @param   pPath                 optionally specifies the path where the CSV-file will be created
-     *                                (if not specified, the original path provided when creating or
-     *                                loading the Document data will be used).
+     * @brief   specifies whether to use a sidecar file.
      */
-    void Save(const std::string& pPath = std::string())
+    bool mUseSidecar;
+
+    /**
+     * @brief   specifies the path of the sidecar file, empty for the default.
+     */
+    std::string mSidecarPath;
+  };
+
+  /**
+   * @brief     Aggregate functions computed per group by Document::GroupBy.
+   */
+  enum class AggregateOp
+  {
+    Count,
+    Sum,
+    Min,
+    Max,
+    Mean
+  };
+
+  /**
+   * @brief     Datastructure describing an aggregate computed per group by Document::GroupBy.
+   */
+  struct Aggregate
+  {
+    /**
+     * @brief   Constructor
+     * @param   pOp                   specifies the aggregate function.
+     * @param   pColumnName           specifies the name of the column to aggregate, not used for
+     *                                AggregateOp::Count. Default: none
+     */
+    explicit Aggregate(const AggregateOp pOp, const std::string& pColumnName = std::string())
+      : mOp(pOp)
+      , mColumnName(pColumnName)
+      , mColumnIdx(-1)
     {
-      if (!pPath.empty())
-      {
-        mPath = pPath;
-      }
-      WriteCsv();
     }
 
     /**
-     * @brief   Write Document data to stream.
-     * @param   pStream               specifies an output stream to write the data to.
+     * @brief   Constructor
+     * @param   pOp                   specifies the aggregate function.
+     * @param   pColumnIdx            specifies the zero-based index of the column to aggregate.
      */
-    void Save(std::ostream& pStream)
+    Aggregate(const AggregateOp pOp, const size_t pColumnIdx)
+      : mOp(pOp)
+      , mColumnIdx(static_cast<ssize_t>(pColumnIdx))
     {
-      WriteCsv(pStream);
     }
 
     /**
-     * @brief   Clears loaded Document data.
-     *
+     * @brief   specifies the aggregate function.
      */
-    void Clear()
+    AggregateOp mOp;
+
+    /**
+     * @brief   specifies the name of the column to aggregate, if not specified by index.
+     */
+    std::string mColumnName;
+
+    /**
+     * @brief   specifies the index of the column to aggregate, -1 if specified by name.
+     */
+    ssize_t mColumnIdx;
+  };
+
+  /**
+   * @brief     Datastructure holding the result of Document::GroupBy, one entry per group in
+   *            order of the first row of each group.
+   */
+  template<typename T>
+  struct GroupByResult
+  {
+    /**
+     * @brief   Get number of groups.
+     * @returns group count.
+     */
+    size_t GetGroupCount() const
     {
-      mData.clear();
-      mColumnNames.clear();
-      mRowNames.clear();
-#ifdef HAS_CODECVT
-      mIsUtf16 = false;
-      mIsLE = false;
-#endif
+      return mKeys.size();
     }
 
     /**
-     * @brief   Get column index by name.
-     * @param   pColumnName           column label name.
-     * @returns zero-based column index.
+     * @brief   key cells per group, one per key column.
      */
-    ssize_t GetColumnIdx(const std::string& pColumnName) const
+    std::vector<std::vector<std::string>> mKeys;
+
+    /**
+     * @brief   aggregate values per group, one per requested aggregate.
+     */
+    std::vector<std::vector<T>> mValues;
+  };
+
+  /**
+   * @brief     Bitmasks of the structural characters in a block of up to 64 bytes, bit i
+   *            corresponding to byte i. Only intended for rapidcsv internal usage.
+   */
+  struct StructuralMasks
+  {
+    uint64_t mQuote;
+    uint64_t mSeparator;
+    uint64_t mLinebreak;
+  };
+
+  /**
+   * @brief     Class locating quotes, separators and line breaks 64 bytes at a time (AVX2, SSE4.2
+   *            or SSE2 depending on compiler target flags, with a scalar fallback), and feeding the
+   *            bytes between them to a parser in bulk. Only intended for rapidcsv internal usage.
+   *
+   * Whether a quote opens a quoted cell depends on the cell contents before it, so quote state
+   * cannot be derived from the quote mask alone (as a prefix XOR would). Instead the parser's
+   * current state selects which of the masks are structural: separators inside quotes, and line
+   * breaks inside quotes when quoted line breaks are enabled, are plain cell content.
+   */
+  class StructuralScanner
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     */
+    explicit StructuralScanner(const SeparatorParams& pSeparatorParams)
+      : mSeparator(pSeparatorParams.mSeparator)
+      , mQuotedLinebreaks(pSeparatorParams.mQuotedLinebreaks)
     {
-      if (mLabelParams.mColumnNameIdx >= 0)
+    }
+
+    /**
+     * @brief   Compute masks for a block.
+     * @param   pData                 start of block.
+     * @param   pLength               block length, at most 64. Bits at and above pLength are zero.
+     * @returns structural character masks.
+     */
+    StructuralMasks Scan(const char* pData, const size_t pLength) const
+    {
+      StructuralMasks masks = { 0, 0, 0 };
+#if defined(RAPIDCSV_AVX2)
+      if (pLength == 64)
       {
-        if (mColumnNames.find(pColumnName) != mColumnNames.end())
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i separator = _mm256_set1_epi8(mSeparator);
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        for (size_t i = 0; i < 64; i += 32)
         {
-          return mColumnNames.at(pColumnName) - (mLabelParams.mRowNameIdx + 1);
+          const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+          masks.mQuote |= MoveMask(_mm256_cmpeq_epi8(v, quote)) << i;
+          masks.mSeparator |= MoveMask(_mm256_cmpeq_epi8(v, separator)) << i;
+          masks.mLinebreak |= MoveMask(_mm256_or_si256(_mm256_cmpeq_epi8(v, cr),
+                                                       _mm256_cmpeq_epi8(v, lf))) << i;
         }
+        return masks;
       }
-      return -1;
+#elif defined(RAPIDCSV_SSE42) || defined(RAPIDCSV_SSE2)
+      if (pLength == 64)
+      {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i separator = _mm_set1_epi8(mSeparator);
+#if defined(RAPIDCSV_SSE42)
+        const __m128i linebreaks = _mm_setr_epi8('\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+#else
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i lf = _mm_set1_epi8('\n');
+#endif
+        for (size_t i = 0; i < 64; i += 16)
+        {
+          const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+          masks.mQuote |= MoveMask(_mm_cmpeq_epi8(v, quote)) << i;
+          masks.mSeparator |= MoveMask(_mm_cmpeq_epi8(v, separator)) << i;
+#if defined(RAPIDCSV_SSE42)
+          // any-of match against the two line break characters in a single instruction
+          const __m128i lb = _mm_cmpestrm(linebreaks, 2, v, 16,
+                                          _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK);
+          masks.mLinebreak |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_cvtsi128_si32(lb))) << i;
+#else
+          masks.mLinebreak |= MoveMask(_mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf))) << i;
+#endif
+        }
+        return masks;
+      }
+#endif
+      for (size_t i = 0; i < pLength; ++i)
+      {
+        const uint64_t bit = static_cast<uint64_t>(1) << i;
+        const char ch = pData[i];
+        masks.mQuote |= (ch == '"') ? bit : 0;
+        masks.mSeparator |= (ch == mSeparator) ? bit : 0;
+        masks.mLinebreak |= ((ch == '\r') || (ch == '\n')) ? bit : 0;
+      }
+      return masks;
     }
 
     /**
-     * @brief   Get column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @returns vector of column data.
+     * @brief   Feed data to a parser. Runs of plain cell content are passed to
+     *          pParser.Append(begin, end) and each structural character to pParser.Structural(ptr),
+     *          with pParser.IsQuoted() consulted after each structural character.
+     * @param   pData                 start of data.
+     * @param   pLength               data length.
+     * @param   pParser               parser receiving the data.
      */
     template<typename T>
-    std::vector<T> GetColumn(const size_t pColumnIdx) const
+    void Parse(const char* pData, const size_t pLength, T& pParser) const
     {
-      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      std::vector<T> column;
-      Converter<T> converter(mConverterParams);
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      for (size_t offset = 0; offset < pLength; offset += 64)
       {
-        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
+        const char* block = pData + offset;
+        const size_t length = std::min<size_t>(64, pLength - offset);
+        const StructuralMasks masks = Scan(block, length);
+        const uint64_t unquoted = masks.mQuote | masks.mSeparator | masks.mLinebreak;
+        const uint64_t quoted = mQuotedLinebreaks ? masks.mQuote : (masks.mQuote | masks.mLinebreak);
+
+        size_t pos = 0;
+        while (pos < length)
         {
-          if (columnIdx < static_cast<ssize_t>(itRow->size()))
+          const uint64_t structural = (pParser.IsQuoted() ? quoted : unquoted) &
+                                      (~static_cast<uint64_t>(0) << pos);
+          if (structural == 0)
           {
-            T val;
-            converter.ToVal(itRow->at(columnIdx), val);
-            column.push_back(val);
+            pParser.Append(block + pos, block + length);
+            break;
           }
-          else
+
+          const size_t next = CountTrailingZeros(structural);
+          if (next > pos)
           {
-            const std::string errStr = "requested column index " +
-              std::to_string(columnIdx - (mLabelParams.mRowNameIdx + 1)) + " >= " +
-              std::to_string(itRow->size() - (mLabelParams.mRowNameIdx + 1)) +
-              " (number of columns on row index " +
-              std::to_string(std::distance(mData.begin(), itRow) -
-                             (mLabelParams.mColumnNameIdx + 1)) + ")";
-            throw std::out_of_range(errStr);
+            pParser.Append(block + pos, block + next);
           }
+          pParser.Structural(block + next);
+          pos = next + 1;
         }
       }
-      return column;
     }
 
-    /**
-     * @brief   Get column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pToVal                conversion function.
-     * @returns vector of column data.
-     */
-    template<typename T>
-    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+  private:
+#if defined(RAPIDCSV_AVX2)
+    static uint64_t MoveMask(const __m256i pVal)
     {
-      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      std::vector<T> column;
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      return static_cast<uint32_t>(_mm256_movemask_epi8(pVal));
+    }
+#elif defined(RAPIDCSV_SSE42) || defined(RAPIDCSV_SSE2)
+    static uint64_t MoveMask(const __m128i pVal)
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(pVal));
+    }
+#endif
+
+    static size_t CountTrailingZeros(const uint64_t pVal)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+      unsigned long idx = 0;
+      _BitScanForward64(&idx, pVal);
+      return idx;
+#elif defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctzll(pVal));
+#else
+      size_t idx = 0;
+      while (((pVal >> idx) & 1) == 0)
       {
-        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
-        {
-          T val;
-          pToVal(itRow->at(columnIdx), val);
-          column.push_back(val);
-        }
+        ++idx;
       }
-      return column;
+      return idx;
+#endif
     }
 
+  private:
+    char mSeparator;
+    bool mQuotedLinebreaks;
+  };
+
+  /**
+   * @brief     Class applying FilterParams while parsing. Column names are resolved against the
+   *            column name row, which with all rows before it is parsed in full. Only intended
+   *            for rapidcsv internal usage.
+   */
+  class RowSelector
+  {
+  public:
     /**
-     * @brief   Get column by name.
-     * @param   pColumnName           column label name.
-     * @returns vector of column data.
+     * @brief   Constructor
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pFilterParams         specifies which columns and rows should be kept.
      */
-    template<typename T>
-    std::vector<T> GetColumn(const std::string& pColumnName) const
+    RowSelector(const LabelParams& pLabelParams, const FilterParams& pFilterParams)
+      : mLabelParams(pLabelParams)
+      , mFilterParams(pFilterParams)
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      if (!mFilterParams.mColumnNames.empty() && (mLabelParams.mColumnNameIdx < 0))
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        throw std::out_of_range("column not found: " + mFilterParams.mColumnNames.front());
       }
-      return GetColumn<T>(columnIdx);
     }
 
     /**
-     * @brief   Get column by name.
-     * @param   pColumnName           column label name.
-     * @param   pToVal                conversion function.
-     * @returns vector of column data.
+     * @brief   Get whether any columns or rows are filtered.
+     * @returns true if filtering is enabled.
      */
-    template<typename T>
-    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
+    bool IsActive() const
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-      return GetColumn<T>(columnIdx, pToVal);
+      return !mFilterParams.mColumnNames.empty() || mFilterParams.mRowFilter;
     }
 
     /**
-     * @brief   Set column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumn               vector of column data.
+     * @brief   Get number of rows, from the first row to the column name row, that are parsed in
+     *          full and not filtered.
+     * @returns row count.
      */
-    template<typename T>
-    void SetColumn(const size_t pColumnIdx, const std::vector<T>& pColumn)
+    size_t GetLabelRowCount() const
     {
-      const size_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      return static_cast<size_t>(mLabelParams.mColumnNameIdx + 1);
+    }
 
-      while (pColumn.size() + (mLabelParams.mColumnNameIdx + 1) > GetDataRowCount())
+    /**
+     * @brief   Get whether column names have been resolved.
+     * @returns true if resolved.
+     */
+    bool IsResolved() const
+    {
+      return mResolved;
+    }
+
+    /**
+     * @brief   Resolve the selected column names to indices.
+     * @param   pColumnNameRow        column name row, not yet projected.
+     */
+    template<typename Row>
+    void Resolve(const Row& pColumnNameRow)
+    {
+      if (mFilterParams.mColumnNames.empty())
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        mResolved = true;
+        return;
       }
 
-      if ((columnIdx + 1) > GetDataColumnCount())
+      mKeepColumns.assign(pColumnNameRow.size(), false);
+      for (ssize_t i = 0; (i <= mLabelParams.mRowNameIdx) && (i < static_cast<ssize_t>(mKeepColumns.size())); ++i)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-        {
-          itRow->resize(columnIdx + 1 + (mLabelParams.mRowNameIdx + 1));
-        }
+        mKeepColumns[i] = true;
       }
 
-      Converter<T> converter(mConverterParams);
-      for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+      for (const auto& columnName : mFilterParams.mColumnNames)
       {
-        std::string str;
-        converter.ToStr(*itRow, str);
-        mData.at(std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1)).at(columnIdx) = str;
+        const auto it = std::find_if(pColumnNameRow.begin(), pColumnNameRow.end(),
+                                     [&columnName](const typename Row::value_type& pName)
+        {
+          return (pName.size() == columnName.size()) && std::equal(pName.begin(), pName.end(), columnName.begin());
+        });
+        if (it == pColumnNameRow.end())
+        {
+          throw std::out_of_range("column not found: " + columnName);
+        }
+
+        mKeepColumns[static_cast<size_t>(it - pColumnNameRow.begin())] = true;
       }
+
+      mResolved = true;
     }
 
     /**
-     * @brief   Set column by name.
-     * @param   pColumnName           column label name.
-     * @param   pColumn               vector of column data.
+     * @brief   Get resolved columns to keep.
+     * @returns per column in the CSV data whether it is kept, empty if not resolved or no
+     *          columns are selected.
      */
-    template<typename T>
-    void SetColumn(const std::string& pColumnName, const std::vector<T>& pColumn)
+    const std::vector<bool>& GetKeepColumns() const
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-      SetColumn<T>(columnIdx, pColumn);
+      return mKeepColumns;
     }
 
     /**
-     * @brief   Remove column by index.
-     * @param   pColumnIdx            zero-based column index.
+     * @brief   Set columns to keep as resolved earlier, for parsing data after the label rows.
+     * @param   pKeepColumns          per column in the CSV data whether it is kept.
      */
-    void RemoveColumn(const size_t pColumnIdx)
+    void SetKeepColumns(const std::vector<bool>& pKeepColumns)
     {
-      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-      {
-        itRow->erase(itRow->begin() + columnIdx);
-      }
+      mKeepColumns = pKeepColumns;
+      mResolved = true;
     }
 
     /**
-     * @brief   Remove column by name.
-     * @param   pColumnName           column label name.
+     * @brief   Get whether a column is kept.
+     * @param   pColumnIdx            zero-based column index in the CSV data.
+     * @returns true if kept.
      */
-    void RemoveColumn(const std::string& pColumnName)
+    bool IsColumnKept(const size_t pColumnIdx) const
     {
-      ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-
-      RemoveColumn(columnIdx);
+      return !mResolved || mFilterParams.mColumnNames.empty() ||
+             ((pColumnIdx < mKeepColumns.size()) && mKeepColumns[pColumnIdx]);
     }
 
     /**
-     * @brief   Insert column at specified index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumn               vector of column data (optional argument).
-     * @param   pColumnName           column label name (optional argument).
+     * @brief   Remove columns which are not kept from a fully parsed row.
+     * @param   pRow                  row to project.
      */
-    template<typename T>
-    void InsertColumn(const size_t pColumnIdx, const std::vector<T>& pColumn = std::vector<T>(),
-                      const std::string& pColumnName = std::string())
+    template<typename Row>
+    void Project(Row& pRow) const
     {
-      const size_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-
-      std::vector<std::string> column;
-      if (pColumn.empty())
-      {
-        column.resize(GetDataRowCount());
-      }
-      else
+      size_t keptCount = 0;
+      for (size_t i = 0; i < pRow.size(); ++i)
       {
-        column.resize(pColumn.size() + (mLabelParams.mColumnNameIdx + 1));
-        Converter<T> converter(mConverterParams);
-        for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+        if (IsColumnKept(i))
         {
-          std::string str;
-          converter.ToStr(*itRow, str);
-          const size_t rowIdx = std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1);
-          column.at(rowIdx) = str;
+          if (keptCount != i)
+          {
+            pRow[keptCount] = std::move(pRow[i]);
+          }
+          ++keptCount;
         }
       }
+      pRow.resize(keptCount);
+    }
 
-      while (column.size() > GetDataRowCount())
-      {
-        std::vector<std::string> row;
-        const size_t columnCount = std::max(static_cast<size_t>(mLabelParams.mColumnNameIdx + 1),
-                                            GetDataColumnCount());
-        row.resize(columnCount);
-        mData.push_back(row);
-      }
+    /**
+     * @brief   Apply row filter.
+     * @param   pRow                  projected data row.
+     * @returns true if the row is kept.
+     */
+    bool IsRowKept(const std::vector<std::string>& pRow) const
+    {
+      return !mFilterParams.mRowFilter || mFilterParams.mRowFilter(pRow);
+    }
 
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+    /**
+     * @brief   Apply row filter to a row with other string or allocator types.
+     * @param   pRow                  projected data row.
+     * @returns true if the row is kept.
+     */
+    template<typename Row>
+    bool IsRowKept(const Row& pRow) const
+    {
+      if (!mFilterParams.mRowFilter)
       {
-        const size_t rowIdx = std::distance(mData.begin(), itRow);
-        itRow->insert(itRow->begin() + columnIdx, column.at(rowIdx));
+        return true;
       }
 
-      if (!pColumnName.empty())
+      std::vector<std::string> row;
+      row.reserve(pRow.size());
+      for (const auto& cell : pRow)
       {
-        SetColumnName(pColumnIdx, pColumnName);
+        row.emplace_back(cell.data(), cell.size());
       }
+      return mFilterParams.mRowFilter(row);
     }
 
-    /**
-     * @brief   Get number of data columns (excluding label columns).
-     * @returns column count.
-     */
-    size_t GetColumnCount() const
-    {
-      const ssize_t count = static_cast<ssize_t>((mData.size() > 0) ? mData.at(0).size() : 0) -
-        (mLabelParams.mRowNameIdx + 1);
-      return (count >= 0) ? count : 0;
-    }
+  private:
+    const LabelParams& mLabelParams;
+    const FilterParams& mFilterParams;
+    std::vector<bool> mKeepColumns;
+    bool mResolved = false;
+  };
 
+  /**
+   * @brief     Class splitting CSV data into rows of unquoted, optionally trimmed, cells. Data may
+   *            be fed in any number of pieces. Rows is a vector of vectors of strings, possibly
+   *            with custom allocators. Only intended for rapidcsv internal usage.
+   */
+  template<typename Rows>
+  class BasicRowParser
+  {
+  public:
     /**
-     * @brief   Get row index by name.
-     * @param   pRowName              row label name.
-     * @returns zero-based row index.
+     * @brief   Constructor
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pRows                 destination for completed rows.
+     * @param   pRowSelector          optionally specifies columns and rows to keep.
+     * @param   pAtStart              specifies whether the data parsed starts at the beginning of
+     *                                the CSV data, i.e. with the label rows.
      */
-    ssize_t GetRowIdx(const std::string& pRowName) const
+    BasicRowParser(const SeparatorParams& pSeparatorParams, const LineReaderParams& pLineReaderParams,
+                   Rows& pRows, RowSelector* pRowSelector = nullptr, const bool pAtStart = true)
+      : mSeparatorParams(pSeparatorParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mScanner(pSeparatorParams)
+      , mRows(pRows)
+      , mRowSelector(((pRowSelector != nullptr) && pRowSelector->IsActive()) ? pRowSelector : nullptr)
+      , mLabelRowCount(((mRowSelector != nullptr) && pAtStart) ? mRowSelector->GetLabelRowCount() : 0)
+      , mRow(pRows.get_allocator())
     {
-      if (mLabelParams.mRowNameIdx >= 0)
-      {
-        if (mRowNames.find(pRowName) != mRowNames.end())
-        {
-          return mRowNames.at(pRowName) - (mLabelParams.mColumnNameIdx + 1);
-        }
-      }
-      return -1;
+      mSkipCell = IsCellSkipped();
     }
 
     /**
-     * @brief   Get row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @returns vector of row data.
+     * @brief   Parse a piece of data, appending the rows completed by it.
+     * @param   pData                 start of data.
+     * @param   pLength               data length.
      */
-    template<typename T>
-    std::vector<T> GetRow(const size_t pRowIdx) const
+    void Parse(const char* pData, const size_t pLength)
     {
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-      std::vector<T> row;
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = mData.at(rowIdx).begin(); itCol != mData.at(rowIdx).end(); ++itCol)
-      {
-        if (std::distance(mData.at(rowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
-        {
-          T val;
-          converter.ToVal(*itCol, val);
-          row.push_back(val);
-        }
-      }
-      return row;
+      mChunk = pData;
+      mScanner.Parse(pData, pLength, *this);
+      mParsedLength += pLength;
     }
 
     /**
-     * @brief   Get row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns vector of row data.
+     * @brief   Complete parsing, appending the last row if it had no line break.
      */
-    template<typename T>
-    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    void Finish()
     {
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-      std::vector<T> row;
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = mData.at(rowIdx).begin(); itCol != mData.at(rowIdx).end(); ++itCol)
+      // Handle last line without linebreak
+      if (!mCell.empty() || (mColumnIdx > 0))
       {
-        if (std::distance(mData.at(rowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
+        EndCell();
+        if (SelectRow())
         {
-          T val;
-          pToVal(*itCol, val);
-          row.push_back(val);
+          mRows.push_back(std::move(mRow));
         }
+        StartRow();
       }
-      return row;
     }
 
     /**
-     * @brief   Get row by name.
-     * @param   pRowName              row label name.
-     * @returns vector of row data.
+     * @brief   Get number of CR line break characters parsed outside of cells.
+     * @returns CR count.
      */
-    template<typename T>
-    std::vector<T> GetRow(const std::string& pRowName) const
+    int GetCRCount() const
     {
-      ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return GetRow<T>(rowIdx);
+      return mCR;
     }
 
     /**
-     * @brief   Get row by name.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns vector of row data.
+     * @brief   Get number of LF line break characters parsed outside of cells.
+     * @returns LF count.
      */
-    template<typename T>
-    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    int GetLFCount() const
     {
-      ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return GetRow<T>(rowIdx, pToVal);
+      return mLF;
     }
 
     /**
-     * @brief   Set row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRow                  vector of row data.
+     * @brief   Get number of bytes parsed up to and including the line break ending the last
+     *          completed (or skipped) row.
+     * @returns byte count.
      */
-    template<typename T>
-    void SetRow(const size_t pRowIdx, const std::vector<T>& pRow)
+    size_t GetRowEndOffset() const
     {
-      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-
-      while ((rowIdx + 1) > GetDataRowCount())
-      {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
-      }
-
-      if (pRow.size() > GetDataColumnCount())
-      {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-        {
-          itRow->resize(pRow.size() + (mLabelParams.mRowNameIdx + 1));
-        }
-      }
-
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
-      {
-        std::string str;
-        converter.ToStr(*itCol, str);
-        mData.at(rowIdx).at(std::distance(pRow.begin(), itCol) + (mLabelParams.mRowNameIdx + 1)) = str;
-      }
+      return mRowEndOffset;
     }
 
     /**
-     * @brief   Set row by name.
-     * @param   pRowName              row label name.
-     * @param   pRow                  vector of row data.
+     * @brief   Get whether the parser is at the start of a row, i.e. in the same state as a newly
+     *          constructed parser.
+     * @returns row start state.
      */
-    template<typename T>
-    void SetRow(const std::string& pRowName, const std::vector<T>& pRow)
+    bool IsRowStart() const
     {
-      ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return SetRow<T>(rowIdx, pRow);
+      return !mQuoted && mCell.empty() && (mColumnIdx == 0);
     }
 
     /**
-     * @brief   Remove row by index.
-     * @param   pRowIdx               zero-based row index.
+     * @brief   Get whether the parser is inside a quoted cell.
+     * @returns quoted state.
      */
-    void RemoveRow(const size_t pRowIdx)
+    bool IsQuoted() const
     {
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-      mData.erase(mData.begin() + rowIdx);
+      return mQuoted;
     }
 
     /**
-     * @brief   Remove row by name.
-     * @param   pRowName              row label name.
+     * @brief   Append plain cell content.
+     * @param   pBegin                start of content.
+     * @param   pEnd                  end of content.
      */
-    void RemoveRow(const std::string& pRowName)
+    void Append(const char* pBegin, const char* pEnd)
     {
-      ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      if (!mSkipCell)
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        mCell.append(pBegin, pEnd);
+      }
+      else if (mCell.empty())
+      {
+        // only the first character of a skipped cell is needed, to track quoting
+        mCell.assign(pBegin, 1);
       }
-
-      RemoveRow(rowIdx);
     }
 
     /**
-     * @brief   Insert row at specified index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRow                  vector of row data (optional argument).
-     * @param   pRowName              row label name (optional argument).
+     * @brief   Handle a quote, separator or line break.
+     * @param   pPos                  position of character.
      */
-    template<typename T>
-    void InsertRow(const size_t pRowIdx, const std::vector<T>& pRow = std::vector<T>(),
-                   const std::string& pRowName = std::string())
+    void Structural(const char* pPos)
     {
-      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-
-      std::vector<std::string> row;
-      if (pRow.empty())
+      const char ch = *pPos;
+      if (ch == '"')
       {
-        row.resize(GetDataColumnCount());
+        if (mCell.empty() || mCell[0] == '"')
+        {
+          mQuoted = !mQuoted;
+        }
+        AppendChar(ch);
       }
-      else
+      else if (ch == mSeparatorParams.mSeparator)
       {
-        row.resize(pRow.size() + (mLabelParams.mRowNameIdx + 1));
-        Converter<T> converter(mConverterParams);
-        for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+        if (!mQuoted)
         {
-          std::string str;
-          converter.ToStr(*itCol, str);
-          row.at(std::distance(pRow.begin(), itCol) + (mLabelParams.mRowNameIdx + 1)) = str;
+          EndCell();
+        }
+        else
+        {
+          AppendChar(ch);
         }
       }
-
-      while (rowIdx > GetDataRowCount())
+      else if (ch == '\r')
       {
-        std::vector<std::string> tempRow;
-        tempRow.resize(GetDataColumnCount());
-        mData.push_back(tempRow);
+        if (mSeparatorParams.mQuotedLinebreaks && mQuoted)
+        {
+          AppendChar(ch);
+        }
+        else
+        {
+          ++mCR;
+        }
       }
+      else if (ch == '\n')
+      {
+        if (mSeparatorParams.mQuotedLinebreaks && mQuoted)
+        {
+          AppendChar(ch);
+        }
+        else
+        {
+          ++mLF;
+          if (mLineReaderParams.mSkipEmptyLines && (mColumnIdx == 0) && mCell.empty())
+          {
+            // skip empty line
+          }
+          else
+          {
+            EndCell();
 
-      mData.insert(mData.begin() + rowIdx, row);
+            if (mLineReaderParams.mSkipCommentLines && !mRow.at(0).empty() &&
+                (mRow.at(0)[0] == mLineReaderParams.mCommentPrefix))
+            {
+              // skip comment line
+            }
+            else if (SelectRow())
+            {
+              mRows.push_back(std::move(mRow));
+            }
 
-      if (!pRowName.empty())
+            StartRow();
+            mQuoted = false;
+          }
+          mRowEndOffset = mParsedLength + static_cast<size_t>(pPos - mChunk) + 1;
+        }
+      }
+      else
       {
-        SetRowName(pRowIdx, pRowName);
+        AppendChar(ch);
       }
     }
 
     /**
-     * @brief   Get number of data rows (excluding label rows).
-     * @returns row count.
+     * @brief   Trim cell in place, if enabled.
+     * @param   pStr                  cell contents.
      */
-    size_t GetRowCount() const
+    void Trim(std::string& pStr) const
     {
-      const ssize_t count = static_cast<ssize_t>(mData.size()) - (mLabelParams.mColumnNameIdx + 1);
-      return (count >= 0) ? count : 0;
+      if (mSeparatorParams.mTrim)
+      {
+        // rtrim
+        pStr.erase(std::find_if(pStr.rbegin(), pStr.rend(), [](int ch) { return !isspace(ch); }).base(), pStr.end());
+
+        // ltrim
+        pStr.erase(pStr.begin(), std::find_if(pStr.begin(), pStr.end(), [](int ch) { return !isspace(ch); }));
+      }
     }
 
     /**
-     * @brief   Get cell by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowIdx               zero-based row index.
-     * @returns cell data.
+     * @brief   Unquote cell in place, if enabled.
+     * @param   pStr                  cell contents.
      */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
+    void Unquote(std::string& pStr) const
     {
-      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      if (mSeparatorParams.mAutoQuote && (pStr.size() >= 2) && (pStr.front() == '"') && (pStr.back() == '"'))
+      {
+        // remove start/end quotes and unescape quotes in string
+        const size_t end = pStr.size() - 1;
+        size_t len = 0;
+        for (size_t pos = 1; pos < end; ++pos)
+        {
+          pStr[len++] = pStr[pos];
+          if ((pStr[pos] == '"') && ((pos + 1) < end) && (pStr[pos + 1] == '"'))
+          {
+            ++pos;
+          }
+        }
 
-      T val;
-      Converter<T> converter(mConverterParams);
-      converter.ToVal(mData.at(rowIdx).at(columnIdx), val);
-      return val;
+        pStr.resize(len);
+      }
     }
 
-    /**
-     * @brief   Get cell by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
-    {
-      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+  private:
+    typedef typename Rows::value_type Row;
 
-      T val;
-      pToVal(mData.at(rowIdx).at(columnIdx), val);
-      return val;
+    void AppendChar(const char pCh)
+    {
+      if (!mSkipCell || mCell.empty())
+      {
+        mCell += pCh;
+      }
     }
 
-    /**
-     * @brief   Get cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    void EndCell()
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      if (!mSkipCell)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        Trim(mCell);
+        Unquote(mCell);
+        PushCell(mRow);
       }
+      mCell.clear();
+      ++mColumnIdx;
+      mSkipCell = IsCellSkipped();
+    }
 
-      const ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+    void PushCell(std::vector<std::string>& pRow)
+    {
+      pRow.push_back(std::move(mCell));
+    }
+
+    template<typename R>
+    void PushCell(R& pRow)
+    {
+      // cells with other allocators are copied once, leaving the work buffer for the next cell
+      pRow.emplace_back(mCell.data(), mCell.size());
+    }
+
+    void StartRow()
+    {
+      // a moved row has lost its capacity, so size it for a row like the previous one
+      mRow.clear();
+      mRow.reserve(mColumnIdx);
+      mColumnIdx = 0;
+      mSkipCell = IsCellSkipped();
+    }
+
+    bool IsCellSkipped() const
+    {
+      // the first cell is needed to detect comment lines
+      return (mRowSelector != nullptr) && (mRowCount >= mLabelRowCount) &&
+             !mRowSelector->IsColumnKept(mColumnIdx) &&
+             !((mColumnIdx == 0) && mLineReaderParams.mSkipCommentLines);
+    }
+
+    bool SelectRow()
+    {
+      if (mRowSelector == nullptr)
+      {
+        return true;
+      }
+
+      ++mRowCount;
+      if (mRowCount <= mLabelRowCount)
+      {
+        if (mRowCount == mLabelRowCount)
+        {
+          // column name row completed, project it and the rows before it
+          if (!mRowSelector->IsResolved())
+          {
+            mRowSelector->Resolve(mRow);
+          }
+
+          for (auto& row : mRows)
+          {
+            mRowSelector->Project(row);
+          }
+          mRowSelector->Project(mRow);
+        }
+
+        return true;
+      }
+
+      if (mLineReaderParams.mSkipCommentLines && !mRowSelector->IsColumnKept(0))
+      {
+        mRow.erase(mRow.begin());
+      }
+
+      return mRowSelector->IsRowKept(mRow);
+    }
+
+  private:
+    const SeparatorParams& mSeparatorParams;
+    const LineReaderParams& mLineReaderParams;
+    StructuralScanner mScanner;
+    Rows& mRows;
+    RowSelector* mRowSelector;
+    size_t mLabelRowCount;
+    Row mRow;
+    std::string mCell;
+    const char* mChunk = nullptr;
+    size_t mParsedLength = 0;
+    size_t mRowEndOffset = 0;
+    size_t mColumnIdx = 0;
+    size_t mRowCount = 0;
+    bool mSkipCell = false;
+    bool mQuoted = false;
+    int mCR = 0;
+    int mLF = 0;
+  };
+
+  typedef BasicRowParser<std::vector<std::vector<std::string>>> RowParser;
+
+  /**
+   * @brief     Row of cells that keeps its strings, and their capacity, when cleared, so that
+   *            parsing into it again does not allocate once it has grown to the longest row.
+   *            Only intended for rapidcsv internal usage.
+   */
+  class ReusedRow
+  {
+  public:
+    typedef std::string value_type;
+    typedef std::vector<std::string>::iterator iterator;
+    typedef std::vector<std::string>::const_iterator const_iterator;
+
+    ReusedRow() = default;
+
+    explicit ReusedRow(const std::allocator<std::string>&)
+    {
+    }
+
+    size_t size() const
+    {
+      return mSize;
+    }
+
+    bool empty() const
+    {
+      return mSize == 0;
+    }
+
+    void clear()
+    {
+      mSize = 0;
+    }
+
+    void reserve(const size_t pSize)
+    {
+      mCells.reserve(pSize);
+    }
+
+    void resize(const size_t pSize)
+    {
+      if (mCells.size() < pSize)
+      {
+        mCells.resize(pSize);
+      }
+      for (size_t i = mSize; i < pSize; ++i)
+      {
+        mCells[i].clear();
+      }
+      mSize = pSize;
+    }
+
+    void emplace_back(const char* pData, const size_t pLength)
+    {
+      if (mSize == mCells.size())
+      {
+        mCells.emplace_back();
+      }
+      mCells[mSize++].assign(pData, pLength);
+    }
+
+    iterator erase(iterator pPos)
+    {
+      // rotate the erased cell past the end, keeping its capacity
+      std::rotate(pPos, pPos + 1, end());
+      --mSize;
+      return pPos;
+    }
+
+    std::string& operator[](const size_t pIdx)
+    {
+      return mCells[pIdx];
+    }
+
+    const std::string& operator[](const size_t pIdx) const
+    {
+      return mCells[pIdx];
+    }
+
+    std::string& at(const size_t pIdx)
+    {
+      if (pIdx >= mSize)
+      {
+        throw std::out_of_range("cell index " + std::to_string(pIdx) + " >= " + std::to_string(mSize));
+      }
+      return mCells[pIdx];
+    }
+
+    iterator begin()
+    {
+      return mCells.begin();
+    }
+
+    iterator end()
+    {
+      return mCells.begin() + static_cast<std::ptrdiff_t>(mSize);
+    }
+
+    const_iterator begin() const
+    {
+      return mCells.begin();
+    }
+
+    const_iterator end() const
+    {
+      return mCells.begin() + static_cast<std::ptrdiff_t>(mSize);
+    }
+
+    void swap(ReusedRow& pOther)
+    {
+      mCells.swap(pOther.mCells);
+      std::swap(mSize, pOther.mSize);
+    }
+
+  private:
+    std::vector<std::string> mCells;
+    size_t mSize = 0;
+  };
+
+  /**
+   * @brief     Queue of parsed rows that keeps its rows when cleared. A row pushed by the parser
+   *            is swapped with a consumed one, so row and cell buffers circulate between the
+   *            parser and the reader instead of being allocated per row. Only intended for
+   *            rapidcsv internal usage.
+   */
+  class ReusedRows
+  {
+  public:
+    typedef ReusedRow value_type;
+    typedef std::vector<ReusedRow>::iterator iterator;
+
+    std::allocator<std::string> get_allocator() const
+    {
+      return std::allocator<std::string>();
+    }
+
+    size_t size() const
+    {
+      return mSize;
+    }
+
+    void clear()
+    {
+      mSize = 0;
+    }
+
+    void push_back(ReusedRow&& pRow)
+    {
+      if (mSize == mRows.size())
+      {
+        mRows.emplace_back();
+      }
+      mRows[mSize++].swap(pRow);
+    }
+
+    ReusedRow& operator[](const size_t pIdx)
+    {
+      return mRows[pIdx];
+    }
+
+    iterator begin()
+    {
+      return mRows.begin();
+    }
+
+    iterator end()
+    {
+      return mRows.begin() + static_cast<std::ptrdiff_t>(mSize);
+    }
+
+  private:
+    std::vector<ReusedRow> mRows;
+    size_t mSize = 0;
+  };
+
+  /**
+   * @brief     Class formatting rows of cells into a reusable buffer that is written to a stream
+   *            in large chunks. Only intended for rapidcsv internal usage.
+   */
+  class RowFormatter
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pStream               specifies the stream to write to.
+     */
+    RowFormatter(const SeparatorParams& pSeparatorParams, std::ostream& pStream)
+      : mSeparatorParams(pSeparatorParams)
+      , mStream(pStream)
+    {
+      mBuffer.reserve(sBufferSize + 1024);
+    }
+
+    /**
+     * @brief   Append a cell to the current row, quoting it if needed.
+     * @param   pData                 cell data.
+     * @param   pLength               cell data length.
+     */
+    void Cell(const char* pData, const size_t pLength)
+    {
+      if (!mRowStart)
+      {
+        mBuffer += mSeparatorParams.mSeparator;
+      }
+      mRowStart = false;
+
+      if (mSeparatorParams.mAutoQuote && NeedsQuotes(pData, pLength))
+      {
+        // escape quotes in string
+        mBuffer += '"';
+        const char* end = pData + pLength;
+        const char* pos = pData;
+        const char* quote = nullptr;
+        while ((quote = static_cast<const char*>(std::memchr(pos, '"', static_cast<size_t>(end - pos)))) != nullptr)
+        {
+          mBuffer.append(pos, static_cast<size_t>(quote + 1 - pos));
+          mBuffer += '"';
+          pos = quote + 1;
+        }
+        mBuffer.append(pos, static_cast<size_t>(end - pos));
+        mBuffer += '"';
+      }
+      else
+      {
+        mBuffer.append(pData, pLength);
+      }
+    }
+
+    /**
+     * @brief   End the current row, and write the buffer to the stream when it is full.
+     */
+    void EndRow()
+    {
+      if (mSeparatorParams.mHasCR)
+      {
+        mBuffer += '\r';
+      }
+      mBuffer += '\n';
+      mRowStart = true;
+
+      if (mBuffer.size() >= sBufferSize)
+      {
+        Flush();
+      }
+    }
+
+    /**
+     * @brief   Write buffered data to the stream.
+     */
+    void Flush()
+    {
+      if (!mBuffer.empty())
+      {
+        mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+        mBuffer.clear();
+      }
+    }
+
+  private:
+    bool NeedsQuotes(const char* pData, const size_t pLength) const
+    {
+      size_t i = 0;
+#if defined(RAPIDCSV_AVX2) || defined(RAPIDCSV_SSE42) || defined(RAPIDCSV_SSE2)
+      const __m128i separator = _mm_set1_epi8(mSeparatorParams.mSeparator);
+      const __m128i space = _mm_set1_epi8(' ');
+      for (; (i + 16) <= pLength; i += 16)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, separator), _mm_cmpeq_epi8(v, space))) != 0)
+        {
+          return true;
+        }
+      }
+#endif
+      for (; i < pLength; ++i)
+      {
+        if ((pData[i] == mSeparatorParams.mSeparator) || (pData[i] == ' '))
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+  private:
+    static const size_t sBufferSize = 1024 * 1024;
+    const SeparatorParams& mSeparatorParams;
+    std::ostream& mStream;
+    std::string mBuffer;
+    bool mRowStart = true;
+  };
+
+  /**
+   * @brief     Class transcoding UTF-16LE or UTF-16BE input to UTF-8 chunk by chunk, carrying
+   *            split code units and surrogate pairs over to the next chunk. Runs of ASCII are
+   *            converted eight code units at a time using SSE2 when available. Unpaired surrogates
+   *            and a trailing odd byte are replaced by U+FFFD. Only intended for rapidcsv internal
+   *            usage.
+   */
+  class Utf16Transcoder
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pIsLE                 specifies whether input is little endian (otherwise big endian).
+     */
+    explicit Utf16Transcoder(const bool pIsLE)
+      : mIsLE(pIsLE)
+    {
+    }
+
+    /**
+     * @brief   Transcode a chunk of UTF-16 input, appending the UTF-8 result.
+     * @param   pData                 chunk data, without byte order mark.
+     * @param   pLength               chunk length in bytes, may be odd.
+     * @param   pOut                  string to append UTF-8 output to.
+     */
+    void Transcode(const char* pData, const size_t pLength, std::string& pOut)
+    {
+      // each two input bytes yield at most three output bytes, plus carried over state
+      const size_t outBegin = pOut.size();
+      pOut.resize(outBegin + ((pLength / 2) + 2) * 3);
+      char* out = &pOut[outBegin];
+      const unsigned char* in = reinterpret_cast<const unsigned char*>(pData);
+      size_t i = 0;
+
+      if (mHasPendingByte && (pLength > 0))
+      {
+        out = Put(mIsLE ? static_cast<uint16_t>(mPendingByte | (in[0] << 8))
+                        : static_cast<uint16_t>((mPendingByte << 8) | in[0]), out);
+        mHasPendingByte = false;
+        i = 1;
+      }
+
+#if defined(RAPIDCSV_AVX2) || defined(RAPIDCSV_SSE42) || defined(RAPIDCSV_SSE2)
+      // after a failed probe, e.g. in CJK text, stay scalar until the next 16 unit boundary or
+      // until an ASCII unit has been seen
+      size_t probeFrom = 0;
+      bool afterAscii = false;
+#endif
+      while ((i + 2) <= pLength)
+      {
+#if defined(RAPIDCSV_AVX2) || defined(RAPIDCSV_SSE42) || defined(RAPIDCSV_SSE2)
+        if ((mHighSurrogate == 0) && ((i >= probeFrom) || afterAscii))
+        {
+          const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xff80));
+          const __m128i zero = _mm_setzero_si128();
+          for (; (i + 16) <= pLength; i += 16)
+          {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            if (!mIsLE)
+            {
+              v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            }
+
+            const int ascii = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonAscii), zero));
+            if (ascii != 0xffff)
+            {
+              // keep the ASCII units before the first other one, which the scalar code handles
+              size_t asciiUnits = 0;
+              while (((ascii >> (2 * asciiUnits)) & 1) != 0)
+              {
+                ++asciiUnits;
+              }
+
+              _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(v, v));
+              out += asciiUnits;
+              i += 2 * asciiUnits;
+              probeFrom = (i | 31) + 1;
+              afterAscii = false;
+              break;
+            }
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(v, v));
+            out += 8;
+          }
+
+          if ((i + 2) > pLength)
+          {
+            break;
+          }
+        }
+#endif
+        const uint16_t unit = mIsLE ? static_cast<uint16_t>(in[i] | (in[i + 1] << 8))
+                                    : static_cast<uint16_t>((in[i] << 8) | in[i + 1]);
+        out = Put(unit, out);
+        i += 2;
+#if defined(RAPIDCSV_AVX2) || defined(RAPIDCSV_SSE42) || defined(RAPIDCSV_SSE2)
+        afterAscii = (unit < 0x80);
+#endif
+      }
+
+      if (i < pLength)
+      {
+        mPendingByte = in[i];
+        mHasPendingByte = true;
+      }
+
+      pOut.resize(static_cast<size_t>(out - pOut.data()));
+    }
+
+    /**
+     * @brief   Flush state carried over at end of input, appending the UTF-8 result.
+     * @param   pOut                  string to append UTF-8 output to.
+     */
+    void Finish(std::string& pOut)
+    {
+      char buf[6];
+      char* end = buf;
+      if (mHighSurrogate != 0)
+      {
+        end = PutCodePoint(sReplacement, end);
+        mHighSurrogate = 0;
+      }
+
+      if (mHasPendingByte)
+      {
+        end = PutCodePoint(sReplacement, end);
+        mHasPendingByte = false;
+      }
+
+      pOut.append(buf, static_cast<size_t>(end - buf));
+    }
+
+    /**
+     * @brief   Convert UTF-8 text to UTF-16. Invalid UTF-8 sequences are replaced by U+FFFD.
+     * @param   pStr                  UTF-8 text.
+     * @param   pIsLE                 specifies whether output is little endian (otherwise big endian).
+     * @returns UTF-16 bytes, without byte order mark.
+     */
+    static std::string FromUtf8(const std::string& pStr, const bool pIsLE)
+    {
+      std::string out;
+      out.reserve(pStr.size() * 2);
+      const auto put = [&out, pIsLE](const uint32_t pUnit)
+      {
+        const char low = static_cast<char>(pUnit & 0xff);
+        const char high = static_cast<char>(pUnit >> 8);
+        out += pIsLE ? low : high;
+        out += pIsLE ? high : low;
+      };
+
+      for (size_t i = 0; i < pStr.size();)
+      {
+        const unsigned char lead = static_cast<unsigned char>(pStr[i]);
+        const size_t length = (lead < 0x80) ? 1 : ((lead >> 5) == 0x6) ? 2 : ((lead >> 4) == 0xe) ? 3 :
+                              ((lead >> 3) == 0x1e) ? 4 : 0;
+        static const uint32_t minCodePoints[] = { 0, 0, 0x80, 0x800, 0x10000 };
+        uint32_t codePoint = (length > 1) ? (lead & (0x7f >> length)) : lead;
+        size_t consumed = 1;
+        while ((length > 1) && (consumed < length) && ((i + consumed) < pStr.size()) &&
+               ((static_cast<unsigned char>(pStr[i + consumed]) & 0xc0) == 0x80))
+        {
+          codePoint = (codePoint << 6) | (static_cast<unsigned char>(pStr[i + consumed]) & 0x3f);
+          ++consumed;
+        }
+
+        if ((length == 0) || (consumed < length) || (codePoint < minCodePoints[length]) ||
+            (codePoint > 0x10ffff) || ((codePoint >= 0xd800) && (codePoint <= 0xdfff)))
+        {
+          codePoint = sReplacement;
+        }
+
+        if (codePoint >= 0x10000)
+        {
+          put(0xd800 | ((codePoint - 0x10000) >> 10));
+          put(0xdc00 | ((codePoint - 0x10000) & 0x3ff));
+        }
+        else
+        {
+          put(codePoint);
+        }
+        i += consumed;
+      }
+
+      return out;
+    }
+
+  private:
+    char* Put(const uint16_t pUnit, char* pOut)
+    {
+      if (mHighSurrogate != 0)
+      {
+        if ((pUnit >= 0xdc00) && (pUnit <= 0xdfff))
+        {
+          const uint32_t codePoint = 0x10000 + ((static_cast<uint32_t>(mHighSurrogate - 0xd800) << 10) |
+                                                static_cast<uint32_t>(pUnit - 0xdc00));
+          mHighSurrogate = 0;
+          return PutCodePoint(codePoint, pOut);
+        }
+
+        pOut = PutCodePoint(sReplacement, pOut);
+        mHighSurrogate = 0;
+      }
+
+      if ((pUnit >= 0xd800) && (pUnit <= 0xdbff))
+      {
+        mHighSurrogate = pUnit;
+        return pOut;
+      }
+
+      return PutCodePoint(((pUnit >= 0xdc00) && (pUnit <= 0xdfff)) ? sReplacement : pUnit, pOut);
+    }
+
+    static char* PutCodePoint(const uint32_t pCodePoint, char* pOut)
+    {
+      if (pCodePoint < 0x80)
+      {
+        *pOut++ = static_cast<char>(pCodePoint);
+      }
+      else if (pCodePoint < 0x800)
+      {
+        *pOut++ = static_cast<char>(0xc0 | (pCodePoint >> 6));
+        *pOut++ = static_cast<char>(0x80 | (pCodePoint & 0x3f));
+      }
+      else if (pCodePoint < 0x10000)
+      {
+        *pOut++ = static_cast<char>(0xe0 | (pCodePoint >> 12));
+        *pOut++ = static_cast<char>(0x80 | ((pCodePoint >> 6) & 0x3f));
+        *pOut++ = static_cast<char>(0x80 | (pCodePoint & 0x3f));
+      }
+      else
+      {
+        *pOut++ = static_cast<char>(0xf0 | (pCodePoint >> 18));
+        *pOut++ = static_cast<char>(0x80 | ((pCodePoint >> 12) & 0x3f));
+        *pOut++ = static_cast<char>(0x80 | ((pCodePoint >> 6) & 0x3f));
+        *pOut++ = static_cast<char>(0x80 | (pCodePoint & 0x3f));
+      }
+
+      return pOut;
+    }
+
+  private:
+    static const uint32_t sReplacement = 0xfffd;
+    const bool mIsLE;
+    uint16_t mHighSurrogate = 0;
+    unsigned char mPendingByte = 0;
+    bool mHasPendingByte = false;
+  };
+
+  /**
+   * @brief     Random access to the input of a parallel load by byte offset, reading a range into
+   *            a caller buffer or parsing a range with a given parser. Only intended for rapidcsv
+   *            internal usage.
+   */
+  struct ChunkInput
+  {
+    typedef std::function<size_t(size_t, char*, size_t)> ReadFunc;
+    typedef std::function<void(RowParser&, size_t, size_t)> ParseFunc;
+
+    ReadFunc mRead;
+    ParseFunc mParse;
+  };
+
+  class Document;
+
+  /**
+   * @brief     Datastructure holding typed column data converted from a Document, keyed by column
+   *            index and type. Copies share the converted data, which is only modified in place
+   *            when rows are appended while it is not shared. Only intended for rapidcsv internal
+   *            usage.
+   */
+  struct ColumnCache
+  {
+    typedef std::function<bool(const Document&, size_t, std::shared_ptr<const void>&, size_t)> ExtendFunc;
+
+    struct Entry
+    {
+      std::shared_ptr<const void> mColumn;
+      ExtendFunc mExtend;
+    };
+
+    typedef std::map<size_t, std::map<std::type_index, Entry>> Columns;
+
+    ColumnCache()
+    {
+    }
+
+    ColumnCache(const ColumnCache& pOther)
+      : mColumns(pOther.GetColumns())
+    {
+    }
+
+    ColumnCache& operator=(const ColumnCache& pOther)
+    {
+      Columns columns = pOther.GetColumns();
+      std::lock_guard<std::mutex> lock(mMutex);
+      mColumns.swap(columns);
+      return *this;
+    }
+
+    Columns GetColumns() const
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      return mColumns;
+    }
+
+    mutable std::mutex mMutex;
+    Columns mColumns;
+  };
+
+  /**
+   * @brief     Open addressing hash table with linear probing, mapping key hashes to key indices.
+   *            Keys are stored by the caller and compared by a caller provided function, so the
+   *            table only stores hashes and indices. Only intended for rapidcsv internal usage.
+   */
+  class FlatHashTable
+  {
+  public:
+    FlatHashTable()
+      : mSlots(16)
+    {
+    }
+
+    /**
+     * @brief   Hash bytes with FNV-1a.
+     * @param   pData                 start of data.
+     * @param   pLength               data length.
+     * @param   pHash                 hash of preceding data, to hash several pieces as one.
+     * @returns hash, to be passed through Mix before use as table hash.
+     */
+    static uint64_t HashBytes(const char* pData, const size_t pLength, uint64_t pHash = 14695981039346656037ULL)
+    {
+      for (size_t i = 0; i < pLength; ++i)
+      {
+        pHash = (pHash ^ static_cast<unsigned char>(pData[i])) * 1099511628211ULL;
+      }
+      return pHash;
+    }
+
+    /**
+     * @brief   Finalize a hash, as FNV-1a mixes poorly into the low bits used for table positions.
+     * @param   pHash                 hash.
+     * @returns mixed hash.
+     */
+    static uint64_t Mix(uint64_t pHash)
+    {
+      pHash ^= pHash >> 32;
+      pHash *= 0x9e3779b97f4a7c15ULL;
+      pHash ^= pHash >> 29;
+      return pHash;
+    }
+
+    /**
+     * @brief   Find the key index with an equal key.
+     * @param   pHash                 key hash.
+     * @param   pIsEqual              function returning whether the key equals the key of a key index.
+     * @returns key index, or sNotFound.
+     */
+    template<typename IsEqual>
+    size_t Find(const uint64_t pHash, IsEqual pIsEqual) const
+    {
+      const size_t mask = mSlots.size() - 1;
+      for (size_t pos = static_cast<size_t>(pHash) & mask; ; pos = (pos + 1) & mask)
+      {
+        const Slot& slot = mSlots[pos];
+        if (slot.mIdx == sNotFound)
+        {
+          return sNotFound;
+        }
+
+        if ((slot.mHash == pHash) && pIsEqual(slot.mIdx))
+        {
+          return slot.mIdx;
+        }
+      }
+    }
+
+    /**
+     * @brief   Find the key index with an equal key, or insert a new key index.
+     * @param   pHash                 key hash.
+     * @param   pNewIdx               key index inserted if no key is equal.
+     * @param   pIsEqual              function returning whether the key equals the key of a key index.
+     * @returns key index.
+     */
+    template<typename IsEqual>
+    size_t FindOrInsert(const uint64_t pHash, const size_t pNewIdx, IsEqual pIsEqual)
+    {
+      // keep the load factor at most 3/4
+      if (((mCount + 1) * 4) > (mSlots.size() * 3))
+      {
+        Grow();
+      }
+
+      const size_t mask = mSlots.size() - 1;
+      for (size_t pos = static_cast<size_t>(pHash) & mask; ; pos = (pos + 1) & mask)
+      {
+        Slot& slot = mSlots[pos];
+        if (slot.mIdx == sNotFound)
+        {
+          slot.mHash = pHash;
+          slot.mIdx = pNewIdx;
+          ++mCount;
+          return pNewIdx;
+        }
+
+        if ((slot.mHash == pHash) && pIsEqual(slot.mIdx))
+        {
+          return slot.mIdx;
+        }
+      }
+    }
+
+    /**
+     * @brief   Remove a key index.
+     * @param   pHash                 key hash.
+     * @param   pIdx                  key index, which must be present.
+     */
+    void Erase(const uint64_t pHash, const size_t pIdx)
+    {
+      const size_t mask = mSlots.size() - 1;
+      size_t pos = FindSlot(pHash, pIdx);
+      mSlots[pos] = Slot();
+      --mCount;
+
+      // move back later slots of the probe sequence, so that lookups do not stop at the gap
+      for (size_t next = (pos + 1) & mask; mSlots[next].mIdx != sNotFound; next = (next + 1) & mask)
+      {
+        const size_t home = static_cast<size_t>(mSlots[next].mHash) & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask))
+        {
+          mSlots[pos] = mSlots[next];
+          mSlots[next] = Slot();
+          pos = next;
+        }
+      }
+    }
+
+    /**
+     * @brief   Change a key index, e.g. after moving the key.
+     * @param   pHash                 key hash.
+     * @param   pIdx                  key index, which must be present.
+     * @param   pNewIdx               new key index.
+     */
+    void Replace(const uint64_t pHash, const size_t pIdx, const size_t pNewIdx)
+    {
+      mSlots[FindSlot(pHash, pIdx)].mIdx = pNewIdx;
+    }
+
+    static const size_t sNotFound = ~static_cast<size_t>(0);
+
+  private:
+    struct Slot
+    {
+      uint64_t mHash = 0;
+      size_t mIdx = sNotFound;
+    };
+
+    size_t FindSlot(const uint64_t pHash, const size_t pIdx) const
+    {
+      const size_t mask = mSlots.size() - 1;
+      size_t pos = static_cast<size_t>(pHash) & mask;
+      while (mSlots[pos].mIdx != pIdx)
+      {
+        pos = (pos + 1) & mask;
+      }
+      return pos;
+    }
+
+    void Grow()
+    {
+      std::vector<Slot> slots(mSlots.size() * 2);
+      const size_t mask = slots.size() - 1;
+      for (const Slot& slot : mSlots)
+      {
+        if (slot.mIdx != sNotFound)
+        {
+          size_t pos = static_cast<size_t>(slot.mHash) & mask;
+          while (slots[pos].mIdx != sNotFound)
+          {
+            pos = (pos + 1) & mask;
+          }
+          slots[pos] = slot;
+        }
+      }
+      mSlots.swap(slots);
+    }
+
+    std::vector<Slot> mSlots;
+    size_t mCount = 0;
+  };
+
+  /**
+   * @brief     Datastructure holding the groups and partial aggregates of one range of rows, for
+   *            Document::GroupBy. Only intended for rapidcsv internal usage.
+   */
+  template<typename T>
+  struct GroupPartial
+  {
+    struct State
+    {
+      T mSum;
+      T mMin;
+      T mMax;
+    };
+
+    FlatHashTable mTable;
+    std::vector<size_t> mFirstRows;
+    std::vector<uint64_t> mHashes;
+    std::vector<size_t> mCounts;
+    std::vector<State> mStates;
+  };
+
+  /**
+   * @brief     Datastructure holding a hash index of one column, mapping each distinct cell to the
+   *            zero-based indices of the data rows holding it, in ascending order, and each data row
+   *            to the key of its cell. Only intended for rapidcsv internal usage.
+   */
+  struct HashIndex
+  {
+    static uint64_t Hash(const std::string& pKey)
+    {
+      return FlatHashTable::Mix(FlatHashTable::HashBytes(pKey.data(), pKey.size()));
+    }
+
+    const std::vector<size_t>* Find(const std::string& pKey) const
+    {
+      const size_t keyIdx = mTable.Find(Hash(pKey), [&](const size_t pKeyIdx)
+      {
+        return mKeys[pKeyIdx] == pKey;
+      });
+      return (keyIdx == FlatHashTable::sNotFound) ? nullptr : &mRows[keyIdx];
+    }
+
+    // Key of rows without a key in mRowKeys
+    static size_t NoKey()
+    {
+      return FlatHashTable::sNotFound;
+    }
+
+    size_t InsertKey(const std::string& pKey, const uint64_t pHash)
+    {
+      const size_t keyIdx = mTable.FindOrInsert(pHash, mKeys.size(), [&](const size_t pKeyIdx)
+      {
+        return mKeys[pKeyIdx] == pKey;
+      });
+      if (keyIdx == mKeys.size())
+      {
+        mKeys.push_back(pKey);
+        mHashes.push_back(pHash);
+        mRows.emplace_back();
+      }
+      return keyIdx;
+    }
+
+    std::vector<size_t>& Insert(const std::string& pKey, const uint64_t pHash)
+    {
+      return mRows[InsertKey(pKey, pHash)];
+    }
+
+    // Fill the row to key table, once all keys are inserted
+    void IndexRows(const size_t pRowCount)
+    {
+      mRowKeys.assign(pRowCount, NoKey());
+      for (size_t keyIdx = 0; keyIdx < mRows.size(); ++keyIdx)
+      {
+        for (const size_t rowIdx : mRows[keyIdx])
+        {
+          mRowKeys[rowIdx] = keyIdx;
+        }
+      }
+    }
+
+    void AddRow(const std::string& pKey, const size_t pRowIdx)
+    {
+      const size_t keyIdx = InsertKey(pKey, Hash(pKey));
+      std::vector<size_t>& rows = mRows[keyIdx];
+      rows.insert(std::upper_bound(rows.begin(), rows.end(), pRowIdx), pRowIdx);
+      if (pRowIdx >= mRowKeys.size())
+      {
+        mRowKeys.resize(pRowIdx + 1, NoKey());
+      }
+      mRowKeys[pRowIdx] = keyIdx;
+    }
+
+    void RemoveRow(const std::string& pKey, const size_t pRowIdx)
+    {
+      const size_t keyIdx = mTable.Find(Hash(pKey), [&](const size_t pKeyIdx)
+      {
+        return mKeys[pKeyIdx] == pKey;
+      });
+      if (keyIdx == FlatHashTable::sNotFound)
+      {
+        return;
+      }
+
+      std::vector<size_t>& rows = mRows[keyIdx];
+      const auto it = std::lower_bound(rows.begin(), rows.end(), pRowIdx);
+      if ((it != rows.end()) && (*it == pRowIdx))
+      {
+        rows.erase(it);
+        mRowKeys[pRowIdx] = NoKey();
+      }
+
+      if (rows.empty())
+      {
+        RemoveKey(keyIdx);
+      }
+    }
+
+    // Renumber the rows from pRowIdx on by pShift, for rows inserted (pShift > 0) or removed
+    // (pShift < 0) at pRowIdx. Removed rows must not hold a key. Only the rows after the change
+    // are visited. Rows past the end of mRowKeys hold no key, so it may be longer or shorter
+    // than the document.
+    void ShiftRows(const size_t pRowIdx, const ssize_t pShift)
+    {
+      if (pRowIdx >= mRowKeys.size())
+      {
+        return;
+      }
+
+      if (pShift > 0)
+      {
+        mRowKeys.insert(mRowKeys.begin() + pRowIdx, static_cast<size_t>(pShift), NoKey());
+
+        // descending, so that no row is moved onto one not yet moved
+        for (size_t rowIdx = mRowKeys.size(); rowIdx-- > (pRowIdx + static_cast<size_t>(pShift)); )
+        {
+          MoveRow(mRowKeys[rowIdx], rowIdx - static_cast<size_t>(pShift), rowIdx);
+        }
+      }
+      else if (pShift < 0)
+      {
+        const size_t removeEnd = std::min(mRowKeys.size(), pRowIdx + static_cast<size_t>(-pShift));
+        mRowKeys.erase(mRowKeys.begin() + pRowIdx, mRowKeys.begin() + removeEnd);
+        for (size_t rowIdx = pRowIdx; rowIdx < mRowKeys.size(); ++rowIdx)
+        {
+          MoveRow(mRowKeys[rowIdx], rowIdx + static_cast<size_t>(-pShift), rowIdx);
+        }
+      }
+    }
+
+    void MoveRow(const size_t pKeyIdx, const size_t pOldRowIdx, const size_t pNewRowIdx)
+    {
+      if (pKeyIdx != NoKey())
+      {
+        std::vector<size_t>& rows = mRows[pKeyIdx];
+        *std::lower_bound(rows.begin(), rows.end(), pOldRowIdx) = pNewRowIdx;
+      }
+    }
+
+    void RemoveKey(const size_t pKeyIdx)
+    {
+      // fill the gap with the last key
+      const size_t lastIdx = mKeys.size() - 1;
+      mTable.Erase(mHashes[pKeyIdx], pKeyIdx);
+      if (pKeyIdx != lastIdx)
+      {
+        mTable.Replace(mHashes[lastIdx], lastIdx, pKeyIdx);
+        mKeys[pKeyIdx].swap(mKeys[lastIdx]);
+        mHashes[pKeyIdx] = mHashes[lastIdx];
+        mRows[pKeyIdx].swap(mRows[lastIdx]);
+        for (const size_t rowIdx : mRows[pKeyIdx])
+        {
+          mRowKeys[rowIdx] = pKeyIdx;
+        }
+      }
+
+      mKeys.pop_back();
+      mHashes.pop_back();
+      mRows.pop_back();
+    }
+
+    FlatHashTable mTable;
+    std::vector<std::string> mKeys;
+    std::vector<uint64_t> mHashes;
+    std::vector<std::vector<size_t>> mRows;
+    std::vector<size_t> mRowKeys;
+  };
+
+  /**
+   * @brief     Datastructure holding the secondary indexes of a Document, keyed by column index
+   *            and, for sorted indexes, value type. Row and cell modifications update indexes in
+   *            place, other modifications invalidate them; invalidated indexes are kept as empty
+   *            pointers and rebuilt on next use. Copies share built indexes, which are invalidated
+   *            rather than updated while shared. Only intended for rapidcsv internal usage.
+   */
+  struct IndexCache
+  {
+    typedef std::function<std::shared_ptr<const void>(const Document&, size_t)> BuildFunc;
+    typedef std::function<bool(const Document&, void*, size_t, const std::string*, const std::string*,
+                               ssize_t)> UpdateFunc;
+    typedef std::function<bool(const Document&, void*, size_t, size_t)> AppendFunc;
+
+    struct SortedEntry
+    {
+      BuildFunc mBuild;
+      UpdateFunc mUpdate;
+      AppendFunc mAppend;
+      std::shared_ptr<const void> mIndex;
+    };
+
+    typedef std::map<size_t, std::shared_ptr<HashIndex>> HashIndexes;
+    typedef std::map<size_t, std::map<std::type_index, SortedEntry>> SortedIndexes;
+
+    IndexCache()
+    {
+    }
+
+    IndexCache(const IndexCache& pOther)
+    {
+      std::lock_guard<std::mutex> lock(pOther.mMutex);
+      mHashIndexes = pOther.mHashIndexes;
+      mSortedIndexes = pOther.mSortedIndexes;
+    }
+
+    IndexCache& operator=(const IndexCache& pOther)
+    {
+      HashIndexes hashIndexes;
+      SortedIndexes sortedIndexes;
+      {
+        std::lock_guard<std::mutex> lock(pOther.mMutex);
+        hashIndexes = pOther.mHashIndexes;
+        sortedIndexes = pOther.mSortedIndexes;
+      }
+      std::lock_guard<std::mutex> lock(mMutex);
+      mHashIndexes.swap(hashIndexes);
+      mSortedIndexes.swap(sortedIndexes);
+      return *this;
+    }
+
+    mutable std::mutex mMutex;
+    HashIndexes mHashIndexes;
+    SortedIndexes mSortedIndexes;
+  };
+
+  /**
+   * @brief     Class representing a CSV document.
+   */
+  class Document
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
+     *                                data with.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pParallelParams       specifies how many threads should be used to parse the data.
+     * @param   pFilterParams         specifies which columns and rows should be kept.
+     * @param   pSidecarParams        specifies whether a binary sidecar file caches the parsed data.
+     */
+    explicit Document(const std::string& pPath = std::string(),
+                      const LabelParams& pLabelParams = LabelParams(),
+                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                      const ParallelParams& pParallelParams = ParallelParams(),
+                      const FilterParams& pFilterParams = FilterParams(),
+                      const SidecarParams& pSidecarParams = SidecarParams())
+      : mPath(pPath)
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mParallelParams(pParallelParams)
+      , mFilterParams(pFilterParams)
+      , mSidecarParams(pSidecarParams)
+    {
+      if (!mPath.empty())
+      {
+        ReadCsv();
+      }
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies an input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pParallelParams       specifies how many threads should be used to parse the data.
+     * @param   pFilterParams         specifies which columns and rows should be kept.
+     */
+    explicit Document(std::istream& pStream,
+                      const LabelParams& pLabelParams = LabelParams(),
+                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                      const ParallelParams& pParallelParams = ParallelParams(),
+                      const FilterParams& pFilterParams = FilterParams())
+      : mPath()
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mParallelParams(pParallelParams)
+      , mFilterParams(pFilterParams)
+    {
+      ReadCsv(pStream);
+    }
+
+    /**
+     * @brief   Read Document data from file.
+     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
+     *                                data with.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pParallelParams       specifies how many threads should be used to parse the data.
+     * @param   pFilterParams         specifies which columns and rows should be kept.
+     * @param   pSidecarParams        specifies whether a binary sidecar file caches the parsed data.
+     */
+    void Load(const std::string& pPath,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams(),
+              const ParallelParams& pParallelParams = ParallelParams(),
+              const FilterParams& pFilterParams = FilterParams(),
+              const SidecarParams& pSidecarParams = SidecarParams())
+    {
+      mPath = pPath;
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mLineReaderParams = pLineReaderParams;
+      mParallelParams = pParallelParams;
+      mFilterParams = pFilterParams;
+      mSidecarParams = pSidecarParams;
+      ReadCsv();
+      BuildIndexes();
+    }
+
+    /**
+     * @brief   Read Document data from stream.
+     * @param   pStream               specifies an input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pParallelParams       specifies how many threads should be used to parse the data.
+     * @param   pFilterParams         specifies which columns and rows should be kept.
+     */
+    void Load(std::istream& pStream,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams(),
+              const ParallelParams& pParallelParams = ParallelParams(),
+              const FilterParams& pFilterParams = FilterParams())
+    {
+      mPath = "";
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mLineReaderParams = pLineReaderParams;
+      mParallelParams = pParallelParams;
+      mFilterParams = pFilterParams;
+      mSidecarParams = SidecarParams();
+      ReadCsv(pStream);
+      BuildIndexes();
+    }
+
+    /**
+     * @brief   Parse rows appended to the file since it was loaded or last refreshed, and add them
+     *          to the Document. Parsing resumes after the last complete row, and a last row that
+     *          had no line break yet is parsed again. The file is reloaded in full if it shrank,
+     *          or if the label rows were not complete. Throws std::logic_error if the Document was
+     *          modified since it was loaded or saved, as parsing again would discard the changes.
+     * @returns number of rows parsed.
+     */
+    size_t Refresh()
+    {
+      if (mPath.empty())
+      {
+        throw std::invalid_argument("document has no path to refresh from");
+      }
+
+      if (mModified)
+      {
+        throw std::logic_error("document was modified since it was loaded or saved: " + mPath);
+      }
+
+      uint64_t size = 0;
+      if (!GetFileSize(mPath, size))
+      {
+        throw std::runtime_error("cannot access file: " + mPath);
+      }
+
+      if (!mRefreshValid || (size < mRefreshSize) ||
+          (static_cast<ssize_t>(mData.size() - mRefreshTailRows) <= mLabelParams.mColumnNameIdx))
+      {
+        ReadCsv();
+        BuildIndexes();
+        return GetRowCount();
+      }
+
+      if (size == mRefreshSize)
+      {
+        return 0;
+      }
+
+      // drop rows of an incomplete last line, they are parsed again with the appended data
+      std::vector<std::string> droppedRowNames;
+      for (; mRefreshTailRows > 0; --mRefreshTailRows)
+      {
+        std::vector<std::string>& row = mData.back();
+        UpdateRowIndexes(GetRowCount() - 1, &row, nullptr, -1);
+        if ((mLabelParams.mRowNameIdx >= 0) && (static_cast<ssize_t>(row.size()) > mLabelParams.mRowNameIdx))
+        {
+          droppedRowNames.push_back(std::move(row[mLabelParams.mRowNameIdx]));
+          --mRowNameCount;
+        }
+        mData.pop_back();
+      }
+
+      for (const std::string& rowName : droppedRowNames)
+      {
+        RestoreRowName(rowName);
+      }
+
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(mPath, std::ios::binary);
+      stream.seekg(static_cast<std::streamoff>(mRefreshOffset), std::ios::beg);
+
+      RowSelector rowSelector(mLabelParams, mFilterParams);
+      if (!mKeepColumns.empty())
+      {
+        rowSelector.SetKeepColumns(mKeepColumns);
+      }
+
+      const size_t firstRowIdx = mData.size();
+      RowParser parser(mSeparatorParams, mLineReaderParams, mData, &rowSelector, false);
+      ParseStream(stream, static_cast<std::streamsize>(size - mRefreshOffset), parser, nullptr);
+      const size_t rowEnd = parser.GetRowEndOffset();
+      const size_t rowCount = mData.size();
+      parser.Finish();
+
+      mRefreshOffset += rowEnd;
+      mRefreshTailRows = mData.size() - rowCount;
+      mRefreshSize = size;
+
+      // only the parsed rows are converted for cached columns and added to indexes
+      const size_t keepRowCount = firstRowIdx - static_cast<size_t>(mLabelParams.mColumnNameIdx + 1);
+      SetupRowNames(firstRowIdx);
+      ExtendCachedColumns(keepRowCount);
+      AppendRowIndexes(keepRowCount);
+      return mData.size() - firstRowIdx;
+    }
+
+    /**
+     * @brief   Wait until the size of the file differs from the size last parsed, e.g. when rows
+     *          have been appended, or until a timeout expires. Uses inotify on Linux, and
+     *          otherwise polls the file size.
+     * @param   pTimeoutMs            maximum time to wait in milliseconds.
+     * @returns true if the file size changed.
+     */
+    bool WaitForChange(const int pTimeoutMs) const
+    {
+      const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(pTimeoutMs);
+      auto remainingMs = [&deadline]()
+      {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+      };
+
+#if defined(__linux__)
+      const int fd = inotify_init1(IN_CLOEXEC);
+      if (fd >= 0)
+      {
+        // watch before checking the size, so an append in between still wakes the poll
+        if (inotify_add_watch(fd, mPath.c_str(), IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE |
+                              IN_MOVE_SELF | IN_DELETE_SELF) >= 0)
+        {
+          while (!IsFileSizeChanged() && (remainingMs() > 0))
+          {
+            pollfd pfd = { fd, POLLIN, 0 };
+            if (poll(&pfd, 1, static_cast<int>(remainingMs())) > 0)
+            {
+              char events[4096];
+              (void) read(fd, events, sizeof(events));
+            }
+          }
+
+          close(fd);
+          return IsFileSizeChanged();
+        }
+
+        close(fd);
+      }
+#endif
+
+      while (!IsFileSizeChanged() && (remainingMs() > 0))
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min<long long>(remainingMs(), 10)));
+      }
+
+      return IsFileSizeChanged();
+    }
+
+    /**
+     * @brief   Write Document data to file.
+     * @param   pPath                 optionally specifies the path where the CSV-file will be created
+     *                                (if not specified, the original path provided when creating or
+     *                                loading the Document data will be used).
+     */
+    void Save(const std::string& pPath = std::string())
+    {
+      if (!pPath.empty())
+      {
+        mPath = pPath;
+      }
+      WriteCsv();
+
+      // the file now holds the Document data, but not at the offsets of the last parse
+      mModified = false;
+      mRefreshValid = false;
+    }
+
+    /**
+     * @brief   Write Document data to stream.
+     * @param   pStream               specifies an output stream to write the data to.
+     */
+    void Save(std::ostream& pStream)
+    {
+      WriteCsv(pStream);
+    }
+
+    /**
+     * @brief   Clears loaded Document data.
+     *
+     */
+    void Clear()
+    {
+      mData.clear();
+      mColumnNames.clear();
+      mRowNames.clear();
+      InvalidateColumns();
+      mRefreshValid = false;
+      mModified = false;
+      mIsUtf16 = false;
+      mIsLE = false;
+    }
+
+    /**
+     * @brief   Get column index by name.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index.
+     */
+    ssize_t GetColumnIdx(const std::string& pColumnName) const
+    {
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        if (mColumnNames.find(pColumnName) != mColumnNames.end())
+        {
+          return mColumnNames.at(pColumnName) - (mLabelParams.mRowNameIdx + 1);
+        }
+      }
+      return -1;
+    }
+
+    /**
+     * @brief   Get column by index. Columns of arithmetic types are converted once and cached,
+     *          other types (e.g. std::string) are converted on each call.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx) const
+    {
+      if (IsCachedColumnType<T>())
+      {
+        return *GetCachedColumn<T>(pColumnIdx);
+      }
+
+      std::vector<T> column;
+      ConvertColumn<T>(pColumnIdx, column);
+      return column;
+    }
+
+    /**
+     * @brief   Convert column by index into a caller provided vector, reusing its storage. Unlike
+     *          GetColumn the result is not cached.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector receiving column data, resized to the number of rows.
+     */
+    template<typename T>
+    void ConvertColumn(const size_t pColumnIdx, std::vector<T>& pColumn) const
+    {
+      ConvertColumnRows<T>(pColumnIdx, 0, pColumn);
+    }
+
+    // Convert the data rows from pFirstDataRowIdx into pColumn, keeping the values before it.
+    template<typename T>
+    void ConvertColumnRows(const size_t pColumnIdx, const size_t pFirstDataRowIdx, std::vector<T>& pColumn) const
+    {
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      pColumn.resize(mData.size() - firstRowIdx);
+      Converter<T> converter(mConverterParams);
+      for (size_t rowIdx = firstRowIdx + pFirstDataRowIdx; rowIdx < mData.size(); ++rowIdx)
+      {
+        const std::vector<std::string>& row = mData[rowIdx];
+        if (columnIdx < static_cast<ssize_t>(row.size()))
+        {
+          T val;
+          converter.ToVal(row[columnIdx], val);
+          pColumn[rowIdx - firstRowIdx] = val;
+        }
+        else
+        {
+          const std::string errStr = "requested column index " +
+            std::to_string(columnIdx - (mLabelParams.mRowNameIdx + 1)) + " >= " +
+            std::to_string(row.size() - (mLabelParams.mRowNameIdx + 1)) +
+            " (number of columns on row index " +
+            std::to_string(rowIdx - (mLabelParams.mColumnNameIdx + 1)) + ")";
+          throw std::out_of_range(errStr);
+        }
+      }
+    }
+
+    /**
+     * @brief   Convert column by name into a caller provided vector, reusing its storage. Unlike
+     *          GetColumn the result is not cached.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector receiving column data, resized to the number of rows.
+     */
+    template<typename T>
+    void ConvertColumn(const std::string& pColumnName, std::vector<T>& pColumn) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      ConvertColumn<T>(columnIdx, pColumn);
+    }
+
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+    {
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      std::vector<T> column;
+      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      {
+        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
+        {
+          T val;
+          pToVal(itRow->at(columnIdx), val);
+          column.push_back(val);
+        }
+      }
+      return column;
+    }
+
+    /**
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(columnIdx);
+    }
+
+    /**
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(columnIdx, pToVal);
+    }
+
+#ifdef RAPIDCSV_HAS_CXX20
+    /**
+     * @brief   Get column by index without copying. The view remains valid until the Document
+     *          is modified or loaded.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns view of column data.
+     */
+    template<typename T>
+    std::span<const T> GetColumnSpan(const size_t pColumnIdx) const
+    {
+      static_assert(!std::is_same<T, bool>::value, "std::vector<bool> cannot be viewed as a span");
+      static_assert(std::is_arithmetic<T>::value, "only columns of arithmetic types are cached");
+      return std::span<const T>(*GetCachedColumn<T>(pColumnIdx));
+    }
+
+    /**
+     * @brief   Get column by name without copying. The view remains valid until the Document
+     *          is modified or loaded.
+     * @param   pColumnName           column label name.
+     * @returns view of column data.
+     */
+    template<typename T>
+    std::span<const T> GetColumnSpan(const std::string& pColumnName) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumnSpan<T>(columnIdx);
+    }
+#endif
+
+    /**
+     * @brief   Group rows by the cells of key columns, and compute aggregates of typed column
+     *          data per group. Rows are split between threads, each accumulating partial
+     *          aggregates in its own hash table, and the partial results are merged at the end.
+     *          Cached columns of type T are used as is, other columns are converted per thread.
+     * @param   pKeyColumnIdxs        zero-based indices of the key columns, none for a single
+     *                                group of all rows.
+     * @param   pAggregates           aggregates to compute per group.
+     * @param   pThreadCount          maximum number of threads, 0 for the number of hardware
+     *                                threads.
+     * @returns key cells and aggregate values per group.
+     */
+    template<typename T = double>
+    GroupByResult<T> GroupBy(const std::vector<size_t>& pKeyColumnIdxs, const std::vector<Aggregate>& pAggregates,
+                             const size_t pThreadCount = 0) const
+    {
+      static_assert(!std::is_same<T, bool>::value, "bool cannot be aggregated");
+
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      const size_t rowCount = mData.size() - firstRowIdx;
+
+      std::vector<size_t> keyColumnIdxs;
+      for (const size_t keyColumnIdx : pKeyColumnIdxs)
+      {
+        keyColumnIdxs.push_back(keyColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1));
+      }
+
+      // Aggregated columns, using cached typed data where available
+      std::vector<size_t> valueColumnIdxs;
+      std::vector<std::shared_ptr<const std::vector<T>>> cachedColumns;
+      std::vector<size_t> valueIdxs;
+      for (const Aggregate& aggregate : pAggregates)
+      {
+        if (aggregate.mOp == AggregateOp::Count)
+        {
+          valueIdxs.push_back(0);
+          continue;
+        }
+
+        const ssize_t columnIdx = (aggregate.mColumnIdx >= 0) ? aggregate.mColumnIdx : GetColumnIdx(aggregate.mColumnName);
+        if (columnIdx < 0)
+        {
+          throw std::out_of_range("column not found: " + aggregate.mColumnName);
+        }
+
+        const auto it = std::find(valueColumnIdxs.begin(), valueColumnIdxs.end(), static_cast<size_t>(columnIdx));
+        valueIdxs.push_back(static_cast<size_t>(it - valueColumnIdxs.begin()));
+        if (it == valueColumnIdxs.end())
+        {
+          valueColumnIdxs.push_back(static_cast<size_t>(columnIdx));
+          cachedColumns.push_back(FindCachedColumn<T>(static_cast<size_t>(columnIdx)));
+        }
+      }
+
+      // Accumulate each range of rows separately
+      const size_t rangeCount = GetRowRangeCount(rowCount, pThreadCount);
+      std::vector<GroupPartial<T>> partials(rangeCount);
+      ForEachRowRange(firstRowIdx, mData.size(), rangeCount,
+                      [&](const size_t pRangeIdx, const size_t pBegin, const size_t pEnd)
+      {
+        GroupRows<T>(pBegin, pEnd, firstRowIdx, keyColumnIdxs, valueColumnIdxs, cachedColumns, partials[pRangeIdx]);
+      });
+
+      // Merge in range order, which keeps groups ordered by their first row
+      GroupPartial<T>& merged = partials[0];
+      const size_t valueCount = valueColumnIdxs.size();
+      for (size_t i = 1; i < rangeCount; ++i)
+      {
+        const GroupPartial<T>& partial = partials[i];
+        for (size_t groupIdx = 0; groupIdx < partial.mFirstRows.size(); ++groupIdx)
+        {
+          const std::vector<std::string>& row = mData[partial.mFirstRows[groupIdx]];
+          const size_t mergedIdx = merged.mTable.FindOrInsert(partial.mHashes[groupIdx], merged.mFirstRows.size(),
+                                                              [&](const size_t pGroupIdx)
+          {
+            return IsKeyEqual(row, mData[merged.mFirstRows[pGroupIdx]], keyColumnIdxs);
+          });
+
+          if (mergedIdx == merged.mFirstRows.size())
+          {
+            merged.mFirstRows.push_back(partial.mFirstRows[groupIdx]);
+            merged.mHashes.push_back(partial.mHashes[groupIdx]);
+            merged.mCounts.push_back(partial.mCounts[groupIdx]);
+            merged.mStates.insert(merged.mStates.end(), partial.mStates.begin() + (groupIdx * valueCount),
+                                  partial.mStates.begin() + ((groupIdx + 1) * valueCount));
+            continue;
+          }
+
+          merged.mCounts[mergedIdx] += partial.mCounts[groupIdx];
+          for (size_t valueIdx = 0; valueIdx < valueCount; ++valueIdx)
+          {
+            const typename GroupPartial<T>::State& state = partial.mStates[(groupIdx * valueCount) + valueIdx];
+            typename GroupPartial<T>::State& mergedState = merged.mStates[(mergedIdx * valueCount) + valueIdx];
+            mergedState.mSum += state.mSum;
+            mergedState.mMin = std::min(mergedState.mMin, state.mMin);
+            mergedState.mMax = std::max(mergedState.mMax, state.mMax);
+          }
+        }
+      }
+
+      GroupByResult<T> result;
+      const size_t groupCount = merged.mFirstRows.size();
+      result.mKeys.resize(groupCount);
+      result.mValues.resize(groupCount);
+      for (size_t groupIdx = 0; groupIdx < groupCount; ++groupIdx)
+      {
+        const std::vector<std::string>& row = mData[merged.mFirstRows[groupIdx]];
+        for (const size_t keyColumnIdx : keyColumnIdxs)
+        {
+          result.mKeys[groupIdx].push_back(row[keyColumnIdx]);
+        }
+
+        const size_t count = merged.mCounts[groupIdx];
+        for (size_t i = 0; i < pAggregates.size(); ++i)
+        {
+          // counts come from the group's rows, other aggregates have a state per value column
+          if (pAggregates[i].mOp == AggregateOp::Count)
+          {
+            result.mValues[groupIdx].push_back(static_cast<T>(count));
+            continue;
+          }
+
+          const typename GroupPartial<T>::State& state = merged.mStates[(groupIdx * valueCount) + valueIdxs[i]];
+          switch (pAggregates[i].mOp)
+          {
+            case AggregateOp::Sum:
+              result.mValues[groupIdx].push_back(state.mSum);
+              break;
+            case AggregateOp::Min:
+              result.mValues[groupIdx].push_back(state.mMin);
+              break;
+            case AggregateOp::Max:
+              result.mValues[groupIdx].push_back(state.mMax);
+              break;
+            case AggregateOp::Mean:
+            default:
+              result.mValues[groupIdx].push_back(state.mSum / static_cast<T>(count));
+              break;
+          }
+        }
+      }
+
+      return result;
+    }
+
+    /**
+     * @brief   Group rows by the cells of key columns, and compute aggregates of typed column
+     *          data per group.
+     * @param   pKeyColumnNames       names of the key columns, none for a single group of all rows.
+     * @param   pAggregates           aggregates to compute per group.
+     * @param   pThreadCount          maximum number of threads, 0 for the number of hardware
+     *                                threads.
+     * @returns key cells and aggregate values per group.
+     */
+    template<typename T = double>
+    GroupByResult<T> GroupBy(const std::vector<std::string>& pKeyColumnNames,
+                             const std::vector<Aggregate>& pAggregates, const size_t pThreadCount = 0) const
+    {
+      std::vector<size_t> keyColumnIdxs;
+      for (const std::string& keyColumnName : pKeyColumnNames)
+      {
+        const ssize_t columnIdx = GetColumnIdx(keyColumnName);
+        if (columnIdx < 0)
+        {
+          throw std::out_of_range("column not found: " + keyColumnName);
+        }
+        keyColumnIdxs.push_back(static_cast<size_t>(columnIdx));
+      }
+      return GroupBy<T>(keyColumnIdxs, pAggregates, pThreadCount);
+    }
+
+    /**
+     * @brief   Create a hash index on a column, for FindRows lookups of cells. The index is built
+     *          now and after each Load, with the threads of the Document ParallelParams, extended
+     *          with the rows added by Refresh, updated in place by SetCell, SetRow, InsertRow and
+     *          RemoveRow, and rebuilt on next use after column modifications.
+     * @param   pColumnIdx            zero-based column index.
+     */
+    void CreateHashIndex(const size_t pColumnIdx)
+    {
+      std::shared_ptr<HashIndex> index = BuildHashIndex(pColumnIdx);
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      mIndexCache.mHashIndexes[pColumnIdx] = index;
+    }
+
+    /**
+     * @brief   Create a hash index on a column, for FindRows lookups of cells.
+     * @param   pColumnName           column label name.
+     */
+    void CreateHashIndex(const std::string& pColumnName)
+    {
+      CreateHashIndex(GetIndexColumnIdx(pColumnName));
+    }
+
+    /**
+     * @brief   Create a sorted index on a column, ordering rows by their values converted to type
+     *          T, for FindRowRange scans. The index is built now and after each Load, with the
+     *          threads of the Document ParallelParams, extended with the rows added by Refresh,
+     *          updated in place by SetCell, SetRow, InsertRow and RemoveRow, and rebuilt on next use
+     *          after column modifications.
+     * @param   pColumnIdx            zero-based column index.
+     */
+    template<typename T = std::string>
+    void CreateSortedIndex(const size_t pColumnIdx)
+    {
+      IndexCache::SortedEntry entry;
+      entry.mBuild = [](const Document& pDocument, const size_t pIdx) -> std::shared_ptr<const void>
+      {
+        return pDocument.BuildSortedIndex<T>(pIdx);
+      };
+      entry.mUpdate = [](const Document& pDocument, void* pIndex, const size_t pRowIdx, const std::string* pOldCell,
+                         const std::string* pNewCell, const ssize_t pShift)
+      {
+        return pDocument.UpdateSortedIndex<T>(pIndex, pRowIdx, pOldCell, pNewCell, pShift);
+      };
+      entry.mAppend = [](const Document& pDocument, void* pIndex, const size_t pIdx, const size_t pFirstRowIdx)
+      {
+        return pDocument.AppendSortedIndex<T>(pIndex, pIdx, pFirstRowIdx);
+      };
+      entry.mIndex = entry.mBuild(*this, pColumnIdx);
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      mIndexCache.mSortedIndexes[pColumnIdx][std::type_index(typeid(T))] = entry;
+    }
+
+    /**
+     * @brief   Create a sorted index on a column, ordering rows by their values converted to type
+     *          T, for FindRowRange scans.
+     * @param   pColumnName           column label name.
+     */
+    template<typename T = std::string>
+    void CreateSortedIndex(const std::string& pColumnName)
+    {
+      CreateSortedIndex<T>(GetIndexColumnIdx(pColumnName));
+    }
+
+    /**
+     * @brief   Remove all indexes of a column.
+     * @param   pColumnIdx            zero-based column index.
+     */
+    void DropIndexes(const size_t pColumnIdx)
+    {
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      mIndexCache.mHashIndexes.erase(pColumnIdx);
+      mIndexCache.mSortedIndexes.erase(pColumnIdx);
+    }
+
+    /**
+     * @brief   Remove all indexes of a column.
+     * @param   pColumnName           column label name.
+     */
+    void DropIndexes(const std::string& pColumnName)
+    {
+      DropIndexes(GetIndexColumnIdx(pColumnName));
+    }
+
+    /**
+     * @brief   Find rows with a cell equal to a value. Uses a hash index of the column if created,
+     *          otherwise a sorted index of std::string, otherwise scans the column.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pCell                 cell data to find.
+     * @returns zero-based indices of the matching rows, in ascending order.
+     */
+    std::vector<size_t> FindRows(const size_t pColumnIdx, const std::string& pCell) const
+    {
+      std::shared_ptr<const HashIndex> hashIndex = GetHashIndex(pColumnIdx);
+      if (hashIndex)
+      {
+        const std::vector<size_t>* rows = hashIndex->Find(pCell);
+        return (rows != nullptr) ? *rows : std::vector<size_t>();
+      }
+
+      std::vector<size_t> rows;
+      std::shared_ptr<const std::vector<std::pair<std::string, size_t>>> sortedIndex =
+        GetSortedIndex<std::string>(pColumnIdx);
+      if (sortedIndex)
+      {
+        const auto range = std::equal_range(sortedIndex->begin(), sortedIndex->end(),
+                                            std::make_pair(pCell, static_cast<size_t>(0)), CompareSortedValue<std::string>);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          rows.push_back(it->second);
+        }
+        return rows;
+      }
+
+      const size_t columnIdx = pColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      for (size_t rowIdx = firstRowIdx; rowIdx < mData.size(); ++rowIdx)
+      {
+        if ((columnIdx < mData[rowIdx].size()) && (mData[rowIdx][columnIdx] == pCell))
+        {
+          rows.push_back(rowIdx - firstRowIdx);
+        }
+      }
+      return rows;
+    }
+
+    /**
+     * @brief   Find rows with a cell equal to a value.
+     * @param   pColumnName           column label name.
+     * @param   pCell                 cell data to find.
+     * @returns zero-based indices of the matching rows, in ascending order.
+     */
+    std::vector<size_t> FindRows(const std::string& pColumnName, const std::string& pCell) const
+    {
+      return FindRows(GetIndexColumnIdx(pColumnName), pCell);
+    }
+
+    /**
+     * @brief   Find rows with a value, converted to type T, in an inclusive range. Uses a sorted
+     *          index of type T on the column if created, otherwise scans the column.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pFirst                lowest value to find.
+     * @param   pLast                 highest value to find.
+     * @returns zero-based indices of the matching rows, ordered by value and then row index.
+     */
+    template<typename T>
+    std::vector<size_t> FindRowRange(const size_t pColumnIdx, const T& pFirst, const T& pLast) const
+    {
+      std::shared_ptr<const std::vector<std::pair<T, size_t>>> sortedIndex = GetSortedIndex<T>(pColumnIdx);
+      if (!sortedIndex)
+      {
+        std::vector<std::pair<T, size_t>> entries;
+        const size_t columnIdx = pColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+        const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+        Converter<T> converter(mConverterParams);
+        for (size_t rowIdx = firstRowIdx; rowIdx < mData.size(); ++rowIdx)
+        {
+          if (columnIdx < mData[rowIdx].size())
+          {
+            T val;
+            converter.ToVal(mData[rowIdx][columnIdx], val);
+            if (!(val < pFirst) && !(pLast < val))
+            {
+              entries.emplace_back(val, rowIdx - firstRowIdx);
+            }
+          }
+        }
+
+        std::sort(entries.begin(), entries.end());
+        sortedIndex = std::make_shared<const std::vector<std::pair<T, size_t>>>(std::move(entries));
+      }
+
+      const auto first = std::lower_bound(sortedIndex->begin(), sortedIndex->end(),
+                                          std::make_pair(pFirst, static_cast<size_t>(0)), CompareSortedValue<T>);
+      const auto last = std::upper_bound(first, sortedIndex->end(),
+                                         std::make_pair(pLast, static_cast<size_t>(0)), CompareSortedValue<T>);
+      std::vector<size_t> rows;
+      rows.reserve(static_cast<size_t>(last - first));
+      for (auto it = first; it != last; ++it)
+      {
+        rows.push_back(it->second);
+      }
+      return rows;
+    }
+
+    /**
+     * @brief   Find rows with a value, converted to type T, in an inclusive range.
+     * @param   pColumnName           column label name.
+     * @param   pFirst                lowest value to find.
+     * @param   pLast                 highest value to find.
+     * @returns zero-based indices of the matching rows, ordered by value and then row index.
+     */
+    template<typename T>
+    std::vector<size_t> FindRowRange(const std::string& pColumnName, const T& pFirst, const T& pLast) const
+    {
+      return FindRowRange<T>(GetIndexColumnIdx(pColumnName), pFirst, pLast);
+    }
+
+    /**
+     * @brief   Set column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const size_t pColumnIdx, const std::vector<T>& pColumn)
+    {
+      mModified = true;
+      const size_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      InvalidateColumn(pColumnIdx);
+
+      while (pColumn.size() + (mLabelParams.mColumnNameIdx + 1) > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(GetDataColumnCount());
+        mData.push_back(row);
+        InvalidateColumns();
+      }
+
+      if ((columnIdx + 1) > GetDataColumnCount())
+      {
+        InvalidateColumns();
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          itRow->resize(columnIdx + 1 + (mLabelParams.mRowNameIdx + 1));
+        }
+      }
+
+      Converter<T> converter(mConverterParams);
+      for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+      {
+        std::string str;
+        converter.ToStr(*itRow, str);
+        mData.at(std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1)).at(columnIdx) = str;
+      }
+    }
+
+    /**
+     * @brief   Set column by name.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const std::string& pColumnName, const std::vector<T>& pColumn)
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      SetColumn<T>(columnIdx, pColumn);
+    }
+
+    /**
+     * @brief   Remove column by index.
+     * @param   pColumnIdx            zero-based column index.
+     */
+    void RemoveColumn(const size_t pColumnIdx)
+    {
+      mModified = true;
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      InvalidateColumns();
+      ShiftIndexes(pColumnIdx, false);
+      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      {
+        itRow->erase(itRow->begin() + columnIdx);
+      }
+    }
+
+    /**
+     * @brief   Remove column by name.
+     * @param   pColumnName           column label name.
+     */
+    void RemoveColumn(const std::string& pColumnName)
+    {
+      ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      RemoveColumn(columnIdx);
+    }
+
+    /**
+     * @brief   Insert column at specified index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data (optional argument).
+     * @param   pColumnName           column label name (optional argument).
+     */
+    template<typename T>
+    void InsertColumn(const size_t pColumnIdx, const std::vector<T>& pColumn = std::vector<T>(),
+                      const std::string& pColumnName = std::string())
+    {
+      mModified = true;
+      const size_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      InvalidateColumns();
+      ShiftIndexes(pColumnIdx, true);
+
+      std::vector<std::string> column;
+      if (pColumn.empty())
+      {
+        column.resize(GetDataRowCount());
+      }
+      else
+      {
+        column.resize(pColumn.size() + (mLabelParams.mColumnNameIdx + 1));
+        Converter<T> converter(mConverterParams);
+        for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
+        {
+          std::string str;
+          converter.ToStr(*itRow, str);
+          const size_t rowIdx = std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1);
+          column.at(rowIdx) = str;
+        }
+      }
+
+      while (column.size() > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        const size_t columnCount = std::max(static_cast<size_t>(mLabelParams.mColumnNameIdx + 1),
+                                            GetDataColumnCount());
+        row.resize(columnCount);
+        mData.push_back(row);
+      }
+
+      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      {
+        const size_t rowIdx = std::distance(mData.begin(), itRow);
+        itRow->insert(itRow->begin() + columnIdx, column.at(rowIdx));
+      }
+
+      if (!pColumnName.empty())
+      {
+        SetColumnName(pColumnIdx, pColumnName);
+      }
+    }
+
+    /**
+     * @brief   Get number of data columns (excluding label columns).
+     * @returns column count.
+     */
+    size_t GetColumnCount() const
+    {
+      const ssize_t count = static_cast<ssize_t>((mData.size() > 0) ? mData.at(0).size() : 0) -
+        (mLabelParams.mRowNameIdx + 1);
+      return (count >= 0) ? count : 0;
+    }
+
+    /**
+     * @brief   Get row index by name.
+     * @param   pRowName              row label name.
+     * @returns zero-based row index.
+     */
+    ssize_t GetRowIdx(const std::string& pRowName) const
+    {
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        if (mRowNames.find(pRowName) != mRowNames.end())
+        {
+          return mRowNames.at(pRowName) - (mLabelParams.mColumnNameIdx + 1);
+        }
+      }
+      return -1;
+    }
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx) const
+    {
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      std::vector<T> row;
+      Converter<T> converter(mConverterParams);
+      for (auto itCol = mData.at(rowIdx).begin(); itCol != mData.at(rowIdx).end(); ++itCol)
+      {
+        if (std::distance(mData.at(rowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
+        {
+          T val;
+          converter.ToVal(*itCol, val);
+          row.push_back(val);
+        }
+      }
+      return row;
+    }
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      std::vector<T> row;
+      Converter<T> converter(mConverterParams);
+      for (auto itCol = mData.at(rowIdx).begin(); itCol != mData.at(rowIdx).end(); ++itCol)
+      {
+        if (std::distance(mData.at(rowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
+        {
+          T val;
+          pToVal(*itCol, val);
+          row.push_back(val);
+        }
+      }
+      return row;
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName) const
+    {
+      ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(rowIdx);
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(rowIdx, pToVal);
+    }
+
+    /**
+     * @brief   Set row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const size_t pRowIdx, const std::vector<T>& pRow)
+    {
+      mModified = true;
+      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      if (((rowIdx + 1) > GetDataRowCount()) || (pRow.size() > GetDataColumnCount()))
+      {
+        // added rows and columns are not indexed
+        InvalidateColumns();
+      }
+      else
+      {
+        InvalidateColumnCache();
+      }
+
+      while ((rowIdx + 1) > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(GetDataColumnCount());
+        mData.push_back(row);
+      }
+
+      if (pRow.size() > GetDataColumnCount())
+      {
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          itRow->resize(pRow.size() + (mLabelParams.mRowNameIdx + 1));
+        }
+      }
+
+      Converter<T> converter(mConverterParams);
+      for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+      {
+        std::string str;
+        converter.ToStr(*itCol, str);
+        const size_t columnIdx = static_cast<size_t>(std::distance(pRow.begin(), itCol));
+        std::string& cell = mData.at(rowIdx).at(columnIdx + (mLabelParams.mRowNameIdx + 1));
+        UpdateIndexes(columnIdx, pRowIdx, &cell, &str, 0);
+        cell = str;
+      }
+    }
+
+    /**
+     * @brief   Set row by name.
+     * @param   pRowName              row label name.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const std::string& pRowName, const std::vector<T>& pRow)
+    {
+      ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return SetRow<T>(rowIdx, pRow);
+    }
+
+    /**
+     * @brief   Remove row by index.
+     * @param   pRowIdx               zero-based row index.
+     */
+    void RemoveRow(const size_t pRowIdx)
+    {
+      mModified = true;
+      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      InvalidateColumnCache();
+      UpdateRowIndexes(pRowIdx, &mData.at(rowIdx), nullptr, -1);
+      mData.erase(mData.begin() + static_cast<ssize_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Remove row by name.
+     * @param   pRowName              row label name.
+     */
+    void RemoveRow(const std::string& pRowName)
+    {
+      ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      RemoveRow(rowIdx);
+    }
+
+    /**
+     * @brief   Insert row at specified index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data (optional argument).
+     * @param   pRowName              row label name (optional argument).
+     */
+    template<typename T>
+    void InsertRow(const size_t pRowIdx, const std::vector<T>& pRow = std::vector<T>(),
+                   const std::string& pRowName = std::string())
+    {
+      mModified = true;
+      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      if (rowIdx > GetDataRowCount())
+      {
+        // added rows are not indexed
+        InvalidateColumns();
+      }
+      else
+      {
+        InvalidateColumnCache();
+      }
+
+      std::vector<std::string> row;
+      if (pRow.empty())
+      {
+        row.resize(GetDataColumnCount());
+      }
+      else
+      {
+        row.resize(pRow.size() + (mLabelParams.mRowNameIdx + 1));
+        Converter<T> converter(mConverterParams);
+        for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+        {
+          std::string str;
+          converter.ToStr(*itCol, str);
+          row.at(std::distance(pRow.begin(), itCol) + (mLabelParams.mRowNameIdx + 1)) = str;
+        }
+      }
+
+      while (rowIdx > GetDataRowCount())
+      {
+        std::vector<std::string> tempRow;
+        tempRow.resize(GetDataColumnCount());
+        mData.push_back(tempRow);
+      }
+
+      mData.insert(mData.begin() + rowIdx, row);
+      UpdateRowIndexes(pRowIdx, nullptr, &mData[rowIdx], 1);
+
+      if (!pRowName.empty())
+      {
+        SetRowName(pRowIdx, pRowName);
+      }
+    }
+
+    /**
+     * @brief   Get number of data rows (excluding label rows).
+     * @returns row count.
+     */
+    size_t GetRowCount() const
+    {
+      const ssize_t count = static_cast<ssize_t>(mData.size()) - (mLabelParams.mColumnNameIdx + 1);
+      return (count >= 0) ? count : 0;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
+    {
+      const std::shared_ptr<const std::vector<T>> column = FindCachedColumn<T>(pColumnIdx);
+      if (column && (pRowIdx < column->size()))
+      {
+        return (*column)[pRowIdx];
+      }
+
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+
+      T val;
+      Converter<T> converter(mConverterParams);
+      converter.ToVal(mData.at(rowIdx).at(columnIdx), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+
+      T val;
+      pToVal(mData.at(rowIdx).at(columnIdx), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(columnIdx, rowIdx);
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(columnIdx, rowIdx, pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetCell<T>(columnIdx, pRowIdx);
+    }
+
+    /**
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetCell<T>(columnIdx, pRowIdx, pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const std::string& pRowName) const
+    {
+      const ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(pColumnIdx, rowIdx);
+    }
+
+    /**
+     * @brief   Get cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(pColumnIdx, rowIdx, pToVal);
+    }
+
+    /**
+     * @brief   Set cell by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const size_t pColumnIdx, const size_t pRowIdx, const T& pCell)
+    {
+      mModified = true;
+      const size_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      InvalidateColumn(pColumnIdx, true);
+
+      while ((rowIdx + 1) > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(GetDataColumnCount());
+        mData.push_back(row);
+        InvalidateColumns();
+      }
+
+      if ((columnIdx + 1) > GetDataColumnCount())
+      {
+        InvalidateColumns();
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          itRow->resize(columnIdx + 1);
+        }
+      }
+
+      std::string str;
+      Converter<T> converter(mConverterParams);
+      converter.ToStr(pCell, str);
+      std::string& cell = mData.at(rowIdx).at(columnIdx);
+      UpdateIndexes(pColumnIdx, pRowIdx, &cell, &str, 0);
+      cell = str;
+    }
+
+    /**
+     * @brief   Set cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const std::string& pColumnName, const std::string& pRowName, const T& pCell)
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const ssize_t rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      SetCell<T>(columnIdx, rowIdx, pCell);
+    }
+
+    /**
+     * @brief   Get column name
+     * @param   pColumnIdx            zero-based column index.
+     * @returns column name.
+     */
+    std::string GetColumnName(const ssize_t pColumnIdx)
+    {
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      if (mLabelParams.mColumnNameIdx < 0)
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      return mData.at(mLabelParams.mColumnNameIdx).at(columnIdx);
+    }
+
+    /**
+     * @brief   Set column name
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumnName           column name.
+     */
+    void SetColumnName(size_t pColumnIdx, const std::string& pColumnName)
+    {
+      mModified = true;
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      mColumnNames[pColumnName] = columnIdx;
+      if (mLabelParams.mColumnNameIdx < 0)
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      // increase table size if necessary:
+      const int rowIdx = mLabelParams.mColumnNameIdx;
+      if (rowIdx >= static_cast<int>(mData.size()))
+      {
+        mData.resize(rowIdx + 1);
+      }
+      auto& row = mData[rowIdx];
+      if (columnIdx >= static_cast<int>(row.size()))
+      {
+        row.resize(columnIdx + 1);
+      }
+
+      mData.at(mLabelParams.mColumnNameIdx).at(columnIdx) = pColumnName;
+    }
+
+    /**
+     * @brief   Get column names
+     * @returns vector of column names.
+     */
+    std::vector<std::string> GetColumnNames()
+    {
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        return std::vector<std::string>(mData.at(mLabelParams.mColumnNameIdx).begin() +
+                                        (mLabelParams.mRowNameIdx + 1),
+                                        mData.at(mLabelParams.mColumnNameIdx).end());
+      }
+
+      return std::vector<std::string>();
+    }
+
+    /**
+     * @brief   Get row name
+     * @param   pRowIdx               zero-based column index.
+     * @returns row name.
+     */
+    std::string GetRowName(const ssize_t pRowIdx)
+    {
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      return mData.at(rowIdx).at(mLabelParams.mRowNameIdx);
+    }
+
+    /**
+     * @brief   Set row name
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRowName              row name.
+     */
+    void SetRowName(size_t pRowIdx, const std::string& pRowName)
+    {
+      mModified = true;
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      mRowNames[pRowName] = rowIdx;
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      // increase table size if necessary:
+      if (rowIdx >= static_cast<int>(mData.size()))
+      {
+        InvalidateColumns();
+        mData.resize(rowIdx + 1);
+      }
+      auto& row = mData[rowIdx];
+      if (mLabelParams.mRowNameIdx >= static_cast<int>(row.size()))
+      {
+        row.resize(mLabelParams.mRowNameIdx + 1);
+      }
+
+      mData.at(rowIdx).at(mLabelParams.mRowNameIdx) = pRowName;
+    }
+
+    /**
+     * @brief   Get row names
+     * @returns vector of row names.
+     */
+    std::vector<std::string> GetRowNames()
+    {
+      std::vector<std::string> rownames;
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
+          {
+            rownames.push_back(itRow->at(mLabelParams.mRowNameIdx));
+          }
+        }
+      }
+      return rownames;
+    }
+
+  private:
+    void ReadCsv()
+    {
+      // sidecar data does not reflect column and row filters
+      const bool useSidecar = mSidecarParams.mUseSidecar &&
+                              mFilterParams.mColumnNames.empty() && !mFilterParams.mRowFilter;
+      if (useSidecar && ReadSidecar())
+      {
+        // the sidecar does not hold the parser state, so the first refresh reloads in full
+        mRefreshValid = false;
+        GetFileSize(mPath, mRefreshSize);
+        return;
+      }
+
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(mPath, std::ios::binary);
+      ReadCsv(stream);
+
+      if (mIsUtf16)
+      {
+        return;
+      }
+
+      if (useSidecar)
+      {
+        WriteSidecar();
+      }
+    }
+
+    void ReadCsv(std::istream& pStream)
+    {
+      Clear();
+      pStream.seekg(0, std::ios::end);
+      std::streamsize length = pStream.tellg();
+      pStream.seekg(0, std::ios::beg);
+
+      std::vector<char> bom2b(2, '\0');
+      if (length >= 2)
+      {
+        pStream.read(bom2b.data(), 2);
+        pStream.seekg(0, std::ios::beg);
+      }
+
+      static const std::vector<char> bomU16le = { '\xff', '\xfe' };
+      static const std::vector<char> bomU16be = { '\xfe', '\xff' };
+      if ((bom2b == bomU16le) || (bom2b == bomU16be))
+      {
+        mIsUtf16 = true;
+        mIsLE = (bom2b == bomU16le);
+
+        // skip the byte order mark and transcode to UTF-8 while parsing
+        pStream.seekg(2, std::ios::beg);
+        Utf16Transcoder transcoder(mIsLE);
+        ParseCsv(pStream, length - 2, &transcoder);
+      }
+      else
+      {
+        // check for UTF-8 Byte order mark and skip it when found
+        if (length >= 3)
+        {
+          std::vector<char> bom3b(3, '\0');
+          pStream.read(bom3b.data(), 3);
+          static const std::vector<char> bomU8 = { '\xef', '\xbb', '\xbf' };
+          if (bom3b != bomU8)
+          {
+            // file does not start with a UTF-8 Byte order mark
+            pStream.seekg(0, std::ios::beg);
+          }
+          else
+          {
+            // file did start with a UTF-8 Byte order mark, simply skip it
+            length -= 3;
+          }
+        }
+
+        ParseCsv(pStream, length);
+      }
+    }
+
+    void ParseCsv(std::istream& pStream, std::streamsize p_FileLength,
+                  Utf16Transcoder* pTranscoder = nullptr)
+    {
+      int cr = 0;
+      int lf = 0;
+      size_t rowEnd = 0;
+      size_t tailRows = 0;
+      const std::streamoff begin = pStream.tellg();
+      RowSelector rowSelector(mLabelParams, mFilterParams);
+      const size_t chunkCount = (pTranscoder == nullptr) ? GetChunkCount(static_cast<size_t>(p_FileLength)) : 1;
+      if ((chunkCount > 1) && !mPath.empty())
+      {
+        // the stream reads mPath, so each chunk is parsed from its own stream of the file rather
+        // than from a copy of the whole file in memory
+        const std::string path = mPath;
+        ChunkInput input;
+        input.mRead = [path, begin](const size_t pOffset, char* pBuf, const size_t pLength)
+        {
+          std::ifstream stream;
+          stream.open(path, std::ios::binary);
+          stream.seekg(begin + static_cast<std::streamoff>(pOffset), std::ios::beg);
+          stream.read(pBuf, static_cast<std::streamsize>(pLength));
+          return static_cast<size_t>(stream.gcount());
+        };
+        input.mParse = [path, begin](RowParser& pParser, const size_t pBegin, const size_t pEnd)
+        {
+          std::ifstream stream;
+          stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+          stream.open(path, std::ios::binary);
+          stream.seekg(begin + static_cast<std::streamoff>(pBegin), std::ios::beg);
+          ParseStream(stream, static_cast<std::streamsize>(pEnd - pBegin), pParser, nullptr);
+        };
+        ParseChunks(input, static_cast<size_t>(p_FileLength), chunkCount, rowSelector, cr, lf, rowEnd, tailRows);
+      }
+      else if (chunkCount > 1)
+      {
+        std::vector<char> buffer(static_cast<size_t>(p_FileLength));
+        pStream.read(buffer.data(), p_FileLength);
+        const char* data = buffer.data();
+        ChunkInput input;
+        input.mRead = [data, &buffer](const size_t pOffset, char* pBuf, const size_t pLength)
+        {
+          const size_t length = std::min(pLength, buffer.size() - std::min(pOffset, buffer.size()));
+          std::copy(data + pOffset, data + pOffset + length, pBuf);
+          return length;
+        };
+        input.mParse = [data](RowParser& pParser, const size_t pBegin, const size_t pEnd)
+        {
+          pParser.Parse(data + pBegin, pEnd - pBegin);
+        };
+        ParseChunks(input, buffer.size(), chunkCount, rowSelector, cr, lf, rowEnd, tailRows);
+      }
+      else
+      {
+        RowParser parser(mSeparatorParams, mLineReaderParams, mData, &rowSelector);
+        ParseStream(pStream, p_FileLength, parser, pTranscoder);
+        rowEnd = parser.GetRowEndOffset();
+        const size_t rowCount = mData.size();
+        parser.Finish();
+        tailRows = mData.size() - rowCount;
+        cr = parser.GetCRCount();
+        lf = parser.GetLFCount();
+      }
+
+      // Assume CR/LF if at least half the linebreaks have CR
+      mSeparatorParams.mHasCR = (cr > (lf / 2));
+
+      SetupLabels();
+
+      // Offsets into transcoded data do not map to file offsets, so refresh reloads UTF-16 files
+      mRefreshValid = (pTranscoder == nullptr) && (begin >= 0);
+      mRefreshOffset = static_cast<size_t>(begin) + rowEnd;
+      mRefreshTailRows = tailRows;
+      mRefreshSize = static_cast<uint64_t>(begin + p_FileLength);
+      mKeepColumns = rowSelector.GetKeepColumns();
+    }
+
+    static void ParseStream(std::istream& pStream, std::streamsize pLength, RowParser& pParser,
+                            Utf16Transcoder* pTranscoder)
+    {
+      const std::streamsize bufLength = 64 * 1024;
+      std::vector<char> buffer(static_cast<size_t>(std::min<std::streamsize>(pLength, bufLength)));
+      std::string utf8;
+      while (pLength > 0)
+      {
+        std::streamsize readLength = std::min<std::streamsize>(pLength, bufLength);
+        pStream.read(buffer.data(), readLength);
+        if (pTranscoder != nullptr)
+        {
+          utf8.clear();
+          pTranscoder->Transcode(buffer.data(), static_cast<size_t>(readLength), utf8);
+          pParser.Parse(utf8.data(), utf8.size());
+        }
+        else
+        {
+          pParser.Parse(buffer.data(), static_cast<size_t>(readLength));
+        }
+        pLength -= readLength;
+      }
+
+      if (pTranscoder != nullptr)
+      {
+        utf8.clear();
+        pTranscoder->Finish(utf8);
+        pParser.Parse(utf8.data(), utf8.size());
+      }
+    }
+
+    void SetupLabels()
+    {
+      // Set up column labels
+      if ((mLabelParams.mColumnNameIdx >= 0) &&
+          (static_cast<ssize_t>(mData.size()) > mLabelParams.mColumnNameIdx))
+      {
+        int i = 0;
+        for (auto& columnName : mData[mLabelParams.mColumnNameIdx])
+        {
+          mColumnNames[columnName] = i++;
+        }
+      }
+
+      // Set up row labels
+      mRowNameCount = 0;
+      SetupRowNames(0);
+    }
+
+    void SetupRowNames(const size_t pFirstRowIdx)
+    {
+      if ((mLabelParams.mRowNameIdx >= 0) &&
+          (static_cast<ssize_t>(mData.size()) >
+           (mLabelParams.mColumnNameIdx + 1)))
+      {
+        // rows before the first data row were not indexed yet if there were no data rows
+        for (size_t rowIdx = (mRowNameCount > 0) ? pFirstRowIdx : 0; rowIdx < mData.size(); ++rowIdx)
+        {
+          const std::vector<std::string>& dataRow = mData[rowIdx];
+          if (static_cast<ssize_t>(dataRow.size()) > mLabelParams.mRowNameIdx)
+          {
+            mRowNames[dataRow[mLabelParams.mRowNameIdx]] = mRowNameCount++;
+          }
+        }
+      }
+    }
+
+    void RestoreRowName(const std::string& pRowName)
+    {
+      // the name of a removed last row may have shadowed the same name of an earlier row
+      const auto it = mRowNames.find(pRowName);
+      if ((it == mRowNames.end()) || (it->second < mRowNameCount))
+      {
+        return;
+      }
+
+      size_t rowNameIdx = mRowNameCount;
+      for (size_t rowIdx = mData.size(); (rowIdx > 0) && (rowNameIdx > 0); --rowIdx)
+      {
+        const std::vector<std::string>& dataRow = mData[rowIdx - 1];
+        if (static_cast<ssize_t>(dataRow.size()) > mLabelParams.mRowNameIdx)
+        {
+          --rowNameIdx;
+          if (dataRow[mLabelParams.mRowNameIdx] == pRowName)
+          {
+            it->second = rowNameIdx;
+            return;
+          }
+        }
+      }
+
+      mRowNames.erase(it);
+    }
+
+    static bool GetFileSize(const std::string& pPath, uint64_t& pSize)
+    {
+#if defined(_WIN32)
+      struct _stat64 st;
+      if (_stat64(pPath.c_str(), &st) != 0)
+#else
+      struct stat st;
+      if (stat(pPath.c_str(), &st) != 0)
+#endif
+      {
+        return false;
+      }
+
+      pSize = static_cast<uint64_t>(st.st_size);
+      return true;
+    }
+
+    bool IsFileSizeChanged() const
+    {
+      uint64_t size = 0;
+      return !GetFileSize(mPath, size) || (size != mRefreshSize);
+    }
+
+    std::string GetSidecarPath() const
+    {
+      return mSidecarParams.mSidecarPath.empty() ? (mPath + ".rcsv") : mSidecarParams.mSidecarPath;
+    }
+
+    // Sidecar file layout, all integers 64-bit in native byte order and all sections 8-byte
+    // aligned so the file may be memory mapped:
+    //   magic, version, byte order mark, sidecar size, body checksum,
+    //   source size, source modification time (ns), source checksum, parameter fingerprint,
+    // followed by the body, which the body checksum covers:
+    //   CR flag, row count, column count, cells per row,
+    //   per column: cell count, cell offsets, cell bytes,
+    //   typed column count, per typed column: column index, value count, double values.
+    static const uint64_t sSidecarVersion = 2;
+
+    // Checksum of sidecar data, mixing in a 64-bit word at a time. Data may be fed in pieces
+    // of any length.
+    class SidecarChecksum
+    {
+    public:
+      void Update(const char* pData, size_t pLength)
+      {
+        if (mPartialLength > 0)
+        {
+          const size_t length = std::min(sizeof(uint64_t) - mPartialLength, pLength);
+          std::memcpy(mPartial + mPartialLength, pData, length);
+          mPartialLength += length;
+          pData += length;
+          pLength -= length;
+          if (mPartialLength < sizeof(uint64_t))
+          {
+            return;
+          }
+
+          Mix(mPartial);
+          mPartialLength = 0;
+        }
+
+        for (; pLength >= sizeof(uint64_t); pData += sizeof(uint64_t), pLength -= sizeof(uint64_t))
+        {
+          Mix(pData);
+        }
+
+        std::memcpy(mPartial, pData, pLength);
+        mPartialLength = pLength;
+      }
+
+      uint64_t Get() const
+      {
+        SidecarChecksum checksum = *this;
+        std::memset(checksum.mPartial + mPartialLength, 0, sizeof(uint64_t) - mPartialLength);
+        checksum.Mix(checksum.mPartial);
+        return checksum.mHash;
+      }
+
+    private:
+      void Mix(const char* pWord)
+      {
+        uint64_t word = 0;
+        std::memcpy(&word, pWord, sizeof(word));
+        mHash = (mHash ^ word) * 0x9e3779b97f4a7c15ULL;
+        mHash = (mHash << 31) | (mHash >> 33);
+      }
+
+      uint64_t mHash = 14695981039346656037ULL;
+      char mPartial[sizeof(uint64_t)] = { 0 };
+      size_t mPartialLength = 0;
+    };
+
+    std::string GetSidecarFingerprint() const
+    {
+      std::ostringstream out;
+      out << mLabelParams.mColumnNameIdx << ',' << mLabelParams.mRowNameIdx << ','
+          << static_cast<int>(mSeparatorParams.mSeparator) << ',' << mSeparatorParams.mTrim << ','
+          << mSeparatorParams.mQuotedLinebreaks << ',' << mSeparatorParams.mAutoQuote << ','
+          << mLineReaderParams.mSkipCommentLines << ',' << static_cast<int>(mLineReaderParams.mCommentPrefix) << ','
+          << mLineReaderParams.mSkipEmptyLines;
+      return out.str();
+    }
+
+    bool GetSourceStamp(uint64_t& pSize, uint64_t& pTime, uint64_t& pChecksum) const
+    {
+#if defined(_WIN32)
+      struct _stat64 st;
+      if (_stat64(mPath.c_str(), &st) != 0)
+#else
+      struct stat st;
+      if (stat(mPath.c_str(), &st) != 0)
+#endif
+      {
+        return false;
+      }
+
+      // nanoseconds where available, so rewrites within the same second change the stamp
+      pSize = static_cast<uint64_t>(st.st_size);
+#if defined(_WIN32)
+      pTime = static_cast<uint64_t>(st.st_mtime) * 1000000000ULL;
+#elif defined(__APPLE__)
+      pTime = static_cast<uint64_t>(st.st_mtimespec.tv_sec) * 1000000000ULL +
+              static_cast<uint64_t>(st.st_mtimespec.tv_nsec);
+#else
+      pTime = static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000ULL + static_cast<uint64_t>(st.st_mtim.tv_nsec);
+#endif
+
+      // FNV-1a over the first and last block, catching rewrites within the timestamp resolution
+      std::ifstream stream(mPath, std::ios::binary);
+      const size_t blockSize = 64 * 1024;
+      std::vector<char> block(static_cast<size_t>(std::min<uint64_t>(pSize, 2 * blockSize)));
+      if (pSize <= (2 * blockSize))
+      {
+        stream.read(block.data(), static_cast<std::streamsize>(block.size()));
+      }
+      else
+      {
+        stream.read(block.data(), blockSize);
+        stream.seekg(static_cast<std::streamoff>(pSize - blockSize), std::ios::beg);
+        stream.read(block.data() + blockSize, blockSize);
+      }
+
+      if (!stream)
+      {
+        return false;
+      }
+
+      pChecksum = 14695981039346656037ULL;
+      for (const char ch : block)
+      {
+        pChecksum = (pChecksum ^ static_cast<unsigned char>(ch)) * 1099511628211ULL;
+      }
+
+      return true;
+    }
+
+    // Writer of sidecar file data, checksumming what is written once the body starts
+    class SidecarWriter
+    {
+    public:
+      explicit SidecarWriter(std::ostream& pStream)
+        : mStream(pStream)
+      {
+      }
+
+      void Write(const char* pData, const size_t pLength)
+      {
+        mStream.write(pData, static_cast<std::streamsize>(pLength));
+        if (mInBody)
+        {
+          mChecksum.Update(pData, pLength);
+        }
+      }
+
+      void Value(const uint64_t pVal)
+      {
+        Write(reinterpret_cast<const char*>(&pVal), sizeof(pVal));
+      }
+
+      void Bytes(const std::string& pBytes)
+      {
+        static const char padding[8] = { 0 };
+        Value(pBytes.size());
+        Write(pBytes.data(), pBytes.size());
+        Write(padding, (8 - (pBytes.size() % 8)) % 8);
+      }
+
+      void StartBody()
+      {
+        mInBody = true;
+      }
+
+      uint64_t GetChecksum() const
+      {
+        return mChecksum.Get();
+      }
+
+    private:
+      std::ostream& mStream;
+      SidecarChecksum mChecksum;
+      bool mInBody = false;
+    };
+
+    void WriteSidecar() const
+    {
+      uint64_t sourceSize = 0;
+      uint64_t sourceTime = 0;
+      uint64_t sourceChecksum = 0;
+      if (!GetSourceStamp(sourceSize, sourceTime, sourceChecksum))
+      {
+        return;
+      }
+
+      // columns where all data cells are numbers are also stored converted
+      const ConverterParams converterParams;
+      std::vector<std::pair<size_t, std::vector<double>>> typedColumns;
+      const size_t firstColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      const size_t columnCount = GetColumnCount();
+      for (size_t columnIdx = 0; columnIdx < columnCount; ++columnIdx)
+      {
+        std::vector<double> values;
+        try
+        {
+          Converter<double> converter(converterParams);
+          const size_t firstRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx + 1);
+          for (size_t rowIdx = firstRowIdx; rowIdx < mData.size(); ++rowIdx)
+          {
+            double val;
+            converter.ToVal(mData[rowIdx].at(columnIdx + firstColumnIdx), val);
+            values.push_back(val);
+          }
+        }
+        catch (const std::exception&)
+        {
+          continue;
+        }
+
+        typedColumns.push_back(std::make_pair(columnIdx, std::move(values)));
+      }
+
+      // write to a temporary file first, so concurrent loads never see a partial sidecar
+      const std::string sidecarPath = GetSidecarPath();
+      const std::string tmpPath = sidecarPath + "." +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." +
+        std::to_string(reinterpret_cast<uintptr_t>(this)) + ".tmp";
+      try
+      {
+        std::ofstream stream;
+        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        stream.open(tmpPath, std::ios::binary | std::ios::trunc);
+
+        size_t rawColumnCount = 0;
+        for (const auto& row : mData)
+        {
+          rawColumnCount = std::max(rawColumnCount, row.size());
+        }
+
+        SidecarWriter writer(stream);
+        writer.Write("RAPIDCSV", 8);
+        writer.Value(sSidecarVersion);
+        writer.Value(0x0102030405060708ULL);
+        writer.Value(0); // sidecar size, updated below
+        writer.Value(0); // body checksum, updated below
+        writer.Value(sourceSize);
+        writer.Value(sourceTime);
+        writer.Value(sourceChecksum);
+        writer.Bytes(GetSidecarFingerprint());
+        writer.StartBody();
+        writer.Value(mSeparatorParams.mHasCR ? 1 : 0);
+        writer.Value(mData.size());
+        writer.Value(rawColumnCount);
+        for (const auto& row : mData)
+        {
+          writer.Value(row.size());
+        }
+
+        std::vector<uint64_t> offsets;
+        std::string bytes;
+        for (size_t columnIdx = 0; columnIdx < rawColumnCount; ++columnIdx)
+        {
+          offsets.assign(1, 0);
+          bytes.clear();
+          for (const auto& row : mData)
+          {
+            if (columnIdx < row.size())
+            {
+              bytes += row[columnIdx];
+              offsets.push_back(bytes.size());
+            }
+          }
+
+          writer.Value(offsets.size() - 1);
+          writer.Write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+          writer.Bytes(bytes);
+        }
+
+        writer.Value(typedColumns.size());
+        for (const auto& typedColumn : typedColumns)
+        {
+          writer.Value(typedColumn.first);
+          writer.Value(typedColumn.second.size());
+          writer.Write(reinterpret_cast<const char*>(typedColumn.second.data()),
+                       typedColumn.second.size() * sizeof(double));
+        }
+
+        const uint64_t sidecarSize = static_cast<uint64_t>(stream.tellp());
+        const uint64_t bodyChecksum = writer.GetChecksum();
+        stream.seekp(24, std::ios::beg);
+        stream.write(reinterpret_cast<const char*>(&sidecarSize), sizeof(sidecarSize));
+        stream.write(reinterpret_cast<const char*>(&bodyChecksum), sizeof(bodyChecksum));
+        stream.close();
+
+        if (std::rename(tmpPath.c_str(), sidecarPath.c_str()) != 0)
+        {
+          // rename does not replace an existing file on all platforms
+          std::remove(sidecarPath.c_str());
+          if (std::rename(tmpPath.c_str(), sidecarPath.c_str()) != 0)
+          {
+            std::remove(tmpPath.c_str());
+          }
+        }
+      }
+      catch (const std::exception&)
+      {
+        // the sidecar is only a cache, failing to write it is not an error
+        std::remove(tmpPath.c_str());
+      }
+    }
+
+    // Bounds checked reader of sidecar file data
+    class SidecarReader
+    {
+    public:
+      SidecarReader(const char* pData, const size_t pSize)
+        : mData(pData)
+        , mSize(pSize)
+      {
+      }
+
+      uint64_t Value()
+      {
+        uint64_t val = 0;
+        std::memcpy(&val, Get(sizeof(val)), sizeof(val));
+        return val;
+      }
+
+      const char* Get(const uint64_t pLength)
+      {
+        if (pLength > (mSize - mPos))
+        {
+          throw std::out_of_range("truncated sidecar");
+        }
+
+        const char* data = mData + mPos;
+        mPos += static_cast<size_t>(pLength);
+        return data;
+      }
+
+      std::string Bytes()
+      {
+        const uint64_t length = Value();
+        const char* data = Get(length);
+        Get((8 - (length % 8)) % 8);
+        return std::string(data, static_cast<size_t>(length));
+      }
+
+      size_t Remaining() const
+      {
+        return mSize - mPos;
+      }
+
+      // Get a count of items of pItemSize bytes, which must all fit in the remaining data
+      uint64_t Count(const size_t pItemSize)
+      {
+        const uint64_t count = Value();
+        if (count > ((mSize - mPos) / pItemSize))
+        {
+          throw std::out_of_range("invalid sidecar count");
+        }
+
+        return count;
+      }
+
+    private:
+      const char* mData;
+      size_t mSize;
+      size_t mPos = 0;
+    };
+
+    bool ReadSidecar()
+    {
+      uint64_t sourceSize = 0;
+      uint64_t sourceTime = 0;
+      uint64_t sourceChecksum = 0;
+      if (!GetSourceStamp(sourceSize, sourceTime, sourceChecksum))
+      {
+        return false;
+      }
+
+      std::ifstream stream(GetSidecarPath(), std::ios::binary);
+      if (!stream)
+      {
+        return false;
+      }
+
+      // validate header before reading the whole file
+      const std::string fingerprint = GetSidecarFingerprint();
+      const size_t headerSize = 72 + ((fingerprint.size() + 7) / 8) * 8;
+      std::vector<char> buffer(headerSize);
+      if (!stream.read(buffer.data(), static_cast<std::streamsize>(headerSize)))
+      {
+        return false;
+      }
+
+      try
+      {
+        SidecarReader header(buffer.data(), buffer.size());
+        if ((std::string(header.Get(8), 8) != "RAPIDCSV") || (header.Value() != sSidecarVersion) ||
+            (header.Value() != 0x0102030405060708ULL))
+        {
+          return false;
+        }
+
+        const uint64_t sidecarSize = header.Value();
+        const uint64_t bodyChecksum = header.Value();
+        if ((header.Value() != sourceSize) || (header.Value() != sourceTime) ||
+            (header.Value() != sourceChecksum) || (header.Bytes() != fingerprint) ||
+            (sidecarSize < headerSize) || (sidecarSize > std::numeric_limits<size_t>::max()))
+        {
+          return false;
+        }
+
+        buffer.resize(static_cast<size_t>(sidecarSize));
+        if (!stream.read(buffer.data() + headerSize, static_cast<std::streamsize>(sidecarSize - headerSize)) ||
+            (stream.peek() != std::char_traits<char>::eof()))
+        {
+          return false;
+        }
+
+        SidecarChecksum checksum;
+        checksum.Update(buffer.data() + headerSize, buffer.size() - headerSize);
+        if (checksum.Get() != bodyChecksum)
+        {
+          return false;
+        }
+
+        Clear();
+        SidecarReader reader(buffer.data() + headerSize, buffer.size() - headerSize);
+        mSeparatorParams.mHasCR = (reader.Value() != 0);
+        const uint64_t rowCount = reader.Value();
+        // each column holds at least a cell count, one offset and a byte count
+        const uint64_t columnCount = reader.Count(3 * sizeof(uint64_t));
+        if (rowCount > (reader.Remaining() / sizeof(uint64_t)))
+        {
+          throw std::out_of_range("invalid sidecar row count");
+        }
+
+        const char* rowCellCounts = reader.Get(rowCount * sizeof(uint64_t));
+        struct SidecarColumn
+        {
+          uint64_t mCellCount;
+          const char* mOffsets;
+          uint64_t mByteCount;
+          const char* mBytes;
+          uint64_t mCellIdx;
+          uint64_t mBegin;
+        };
+
+        std::vector<SidecarColumn> columns(static_cast<size_t>(columnCount));
+        for (auto& column : columns)
+        {
+          column.mCellCount = reader.Count(sizeof(uint64_t));
+          if (column.mCellCount == (reader.Remaining() / sizeof(uint64_t)))
+          {
+            throw std::out_of_range("invalid sidecar cell count");
+          }
+
+          column.mOffsets = reader.Get((column.mCellCount + 1) * sizeof(uint64_t));
+          column.mByteCount = reader.Value();
+          column.mBytes = reader.Get(column.mByteCount);
+          reader.Get((8 - (column.mByteCount % 8)) % 8);
+          column.mCellIdx = 0;
+          column.mBegin = 0;
+        }
+
+        // fill rows in order, reading each column's cells sequentially
+        mData.resize(static_cast<size_t>(rowCount));
+        for (size_t rowIdx = 0; rowIdx < mData.size(); ++rowIdx)
+        {
+          uint64_t cellCount = 0;
+          std::memcpy(&cellCount, rowCellCounts + rowIdx * sizeof(uint64_t), sizeof(cellCount));
+          if (cellCount > columnCount)
+          {
+            throw std::out_of_range("invalid sidecar cell count");
+          }
+
+          std::vector<std::string>& row = mData[rowIdx];
+          row.reserve(static_cast<size_t>(cellCount));
+          for (size_t columnIdx = 0; columnIdx < cellCount; ++columnIdx)
+          {
+            SidecarColumn& column = columns[columnIdx];
+            uint64_t end = 0;
+            if (column.mCellIdx < column.mCellCount)
+            {
+              std::memcpy(&end, column.mOffsets + (column.mCellIdx + 1) * sizeof(uint64_t), sizeof(end));
+            }
+
+            if ((column.mCellIdx >= column.mCellCount) || (end < column.mBegin) || (end > column.mByteCount))
+            {
+              throw std::out_of_range("invalid sidecar cell offset");
+            }
+
+            row.emplace_back(column.mBytes + column.mBegin, static_cast<size_t>(end - column.mBegin));
+            column.mBegin = end;
+            ++column.mCellIdx;
+          }
+        }
+
+        SetupLabels();
+
+        const uint64_t typedCount = reader.Value();
+        for (uint64_t i = 0; i < typedCount; ++i)
+        {
+          const uint64_t columnIdx = reader.Value();
+          const uint64_t valueCount = reader.Count(sizeof(double));
+          if ((columnIdx >= GetColumnCount()) || (valueCount != GetRowCount()))
+          {
+            throw std::out_of_range("invalid sidecar typed column");
+          }
+
+          const char* valueData = reader.Get(valueCount * sizeof(double));
+          std::shared_ptr<std::vector<double>> values = std::make_shared<std::vector<double>>(valueCount);
+          std::memcpy(values->data(), valueData, static_cast<size_t>(valueCount) * sizeof(double));
+          mColumnCache.mColumns[static_cast<size_t>(columnIdx)][std::type_index(typeid(double))] =
+            MakeCacheEntry<double>(values);
+        }
+      }
+      catch (const std::exception&)
+      {
+        Clear();
+        return false;
+      }
+
+      return true;
+    }
+
+    size_t ResolveColumnNames(const ChunkInput& pInput, const size_t pLength, RowSelector& pRowSelector) const
+    {
+      const size_t labelRowCount = pRowSelector.GetLabelRowCount();
+      if (labelRowCount == 0)
+      {
+        pRowSelector.Resolve(std::vector<std::string>());
+        return 0;
+      }
+
+      std::vector<std::vector<std::string>> rows;
+      RowParser parser(mSeparatorParams, mLineReaderParams, rows);
+      const size_t pieceLength = 4 * 1024;
+      std::vector<char> piece(pieceLength);
+      size_t offset = 0;
+      while ((rows.size() < labelRowCount) && (offset < pLength))
+      {
+        const size_t length = pInput.mRead(offset, piece.data(), std::min(pieceLength, pLength - offset));
+        if (length == 0)
+        {
+          break;
+        }
+        parser.Parse(piece.data(), length);
+        offset += length;
+      }
+
+      if (rows.size() < labelRowCount)
+      {
+        parser.Finish();
+      }
+
+      if (rows.size() >= labelRowCount)
+      {
+        pRowSelector.Resolve(rows[labelRowCount - 1]);
+      }
+
+      return offset;
+    }
+
+    size_t GetChunkCount(const size_t pLength) const
+    {
+      size_t threadCount = mParallelParams.mThreadCount;
+      if (threadCount == 0)
+      {
+        threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+      }
+
+      const size_t minChunkSize = std::max<size_t>(1, mParallelParams.mMinChunkSize);
+      return std::max<size_t>(1, std::min(threadCount, pLength / minChunkSize));
+    }
+
+    // Offset of the first linebreak at or after pFrom, or pLength if there is none.
+    static size_t FindLinebreak(const ChunkInput& pInput, size_t pFrom, const size_t pLength)
+    {
+      std::vector<char> piece(4 * 1024);
+      while (pFrom < pLength)
+      {
+        const size_t length = pInput.mRead(pFrom, piece.data(), std::min(piece.size(), pLength - pFrom));
+        if (length == 0)
+        {
+          break;
+        }
+
+        const char* linebreak = std::find(piece.data(), piece.data() + length, '\n');
+        if (linebreak != (piece.data() + length))
+        {
+          return pFrom + static_cast<size_t>(linebreak - piece.data());
+        }
+        pFrom += length;
+      }
+
+      return pLength;
+    }
+
+    void ParseChunks(const ChunkInput& pInput, const size_t pLength, const size_t pChunkCount,
+                     RowSelector& pRowSelector, int& pCR, int& pLF, size_t& pRowEnd, size_t& pTailRows)
+    {
+      // Column names must be resolved before parsing data rows, so parse up to the column name
+      // row first, and keep it within the first chunk
+      const size_t labelLength = pRowSelector.IsActive() ? ResolveColumnNames(pInput, pLength, pRowSelector) : 0;
+
+      // Split after the first linebreak following each equal share of the data
+      std::vector<size_t> bounds(1, 0);
+      for (size_t i = 1; i < pChunkCount; ++i)
+      {
+        const size_t from = std::max(std::max(bounds.back(), labelLength), (pLength / pChunkCount) * i);
+        const size_t linebreak = FindLinebreak(pInput, from, pLength);
+        if ((pLength - linebreak) <= 1)
+        {
+          break;
+        }
+
+        bounds.push_back(linebreak + 1);
+      }
+
+      bounds.push_back(pLength);
+
+      // Speculatively parse each chunk as if it starts on a new row
+      const size_t chunkCount = bounds.size() - 1;
+      std::vector<std::vector<std::vector<std::string>>> chunkRows(chunkCount);
+      std::vector<RowParser> parsers;
+      parsers.reserve(chunkCount);
+      for (size_t i = 0; i < chunkCount; ++i)
+      {
+        parsers.emplace_back(mSeparatorParams, mLineReaderParams, chunkRows[i], &pRowSelector, i == 0);
+      }
+
+      std::vector<std::exception_ptr> errors(chunkCount);
+      auto parseChunk = [&](const size_t pChunkIdx)
+      {
+        try
+        {
+          pInput.mParse(parsers[pChunkIdx], bounds[pChunkIdx], bounds[pChunkIdx + 1]);
+        }
+        catch (...)
+        {
+          errors[pChunkIdx] = std::current_exception();
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (size_t i = 1; i < chunkCount; ++i)
+      {
+        threads.emplace_back(parseChunk, i);
+      }
+
+      parseChunk(0);
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      // A chunk boundary inside a quoted cell invalidates the next chunk, which is then parsed
+      // by the preceding parser instead. Errors of a chunk, e.g. from a row filter given rows of
+      // a wrong guess, are only thrown once its start is confirmed as a row start.
+      std::vector<bool> valid(chunkCount, true);
+      size_t owner = 0;
+      for (size_t i = 0; i < chunkCount; ++i)
+      {
+        if ((i > 0) && !parsers[owner].IsRowStart())
+        {
+          valid[i] = false;
+          chunkRows[i].clear();
+          pInput.mParse(parsers[owner], bounds[i], bounds[i + 1]);
+          continue;
+        }
+
+        owner = i;
+        if (errors[i])
+        {
+          std::rethrow_exception(errors[i]);
+        }
+      }
+
+      pRowEnd = bounds[owner] + parsers[owner].GetRowEndOffset();
+      const size_t ownerRowCount = chunkRows[owner].size();
+      parsers[owner].Finish();
+      pTailRows = chunkRows[owner].size() - ownerRowCount;
+
+      // Stitch rows back together in order
+      size_t rowCount = 0;
+      for (size_t i = 0; i < chunkCount; ++i)
+      {
+        rowCount += chunkRows[i].size();
+      }
+
+      mData.reserve(rowCount);
+      for (size_t i = 0; i < chunkCount; ++i)
+      {
+        if (valid[i])
+        {
+          mData.insert(mData.end(), std::make_move_iterator(chunkRows[i].begin()),
+                       std::make_move_iterator(chunkRows[i].end()));
+          pCR += parsers[i].GetCRCount();
+          pLF += parsers[i].GetLFCount();
+        }
+      }
+    }
+
+    void WriteCsv() const
+    {
+      if (mIsUtf16)
+      {
+        std::stringstream ss;
+        WriteCsv(ss);
+        std::string utf8 = ss.str();
+#ifdef HAS_CODECVT
+        std::wstring wstr = ToWString(utf8);
+
+        std::wofstream wstream;
+        wstream.exceptions(std::wofstream::failbit | std::wofstream::badbit);
+        wstream.open(mPath, std::ios::binary | std::ios::trunc);
+
+        if (mIsLE)
+        {
+          wstream.imbue(std::locale(wstream.getloc(),
+                                    new std::codecvt_utf16<wchar_t, 0x10ffff,
+                                                           static_cast<std::codecvt_mode>(std::little_endian)>));
+        }
+        else
+        {
+          wstream.imbue(std::locale(wstream.getloc(),
+                                    new std::codecvt_utf16<wchar_t, 0x10ffff>));
+        }
+
+        wstream << static_cast<wchar_t>(0xfeff);
+        wstream << wstr;
+#else
+        std::ofstream stream;
+        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        stream.open(mPath, std::ios::binary | std::ios::trunc);
+        stream << (mIsLE ? "\xff\xfe" : "\xfe\xff") << Utf16Transcoder::FromUtf8(utf8, mIsLE);
+#endif
+      }
+      else
+      {
+        std::ofstream stream;
+        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+        stream.open(mPath, std::ios::binary | std::ios::trunc);
+        WriteCsv(stream);
+      }
+    }
+
+    void WriteCsv(std::ostream& pStream) const
+    {
+      RowFormatter formatter(mSeparatorParams, pStream);
+      for (auto itr = mData.begin(); itr != mData.end(); ++itr)
+      {
+        for (auto itc = itr->begin(); itc != itr->end(); ++itc)
+        {
+          formatter.Cell(itc->data(), itc->size());
+        }
+        formatter.EndRow();
+      }
+      formatter.Flush();
+    }
+
+    // Only numeric columns are cached, a cached copy of e.g. a string column would double its
+    // memory use for the lifetime of the document
+    template<typename T>
+    static constexpr bool IsCachedColumnType()
+    {
+      return std::is_arithmetic<T>::value;
+    }
+
+    template<typename T>
+    std::shared_ptr<const std::vector<T>> FindCachedColumn(const size_t pColumnIdx) const
+    {
+      if (!IsCachedColumnType<T>())
+      {
+        return std::shared_ptr<const std::vector<T>>();
+      }
+
+      std::lock_guard<std::mutex> lock(mColumnCache.mMutex);
+      auto itColumn = mColumnCache.mColumns.find(pColumnIdx);
+      if (itColumn != mColumnCache.mColumns.end())
+      {
+        auto itType = itColumn->second.find(std::type_index(typeid(T)));
+        if (itType != itColumn->second.end())
+        {
+          return std::static_pointer_cast<const std::vector<T>>(itType->second.mColumn);
+        }
+      }
+
+      return std::shared_ptr<const std::vector<T>>();
+    }
+
+    template<typename T>
+    std::shared_ptr<const std::vector<T>> GetCachedColumn(const size_t pColumnIdx) const
+    {
+      std::shared_ptr<const std::vector<T>> column = FindCachedColumn<T>(pColumnIdx);
+      if (!column)
+      {
+        // convert outside the lock, a concurrent reader converting the same column is harmless
+        std::vector<T> values;
+        ConvertColumn<T>(pColumnIdx, values);
+        column = std::make_shared<const std::vector<T>>(std::move(values));
+        std::lock_guard<std::mutex> lock(mColumnCache.mMutex);
+        auto inserted = mColumnCache.mColumns[pColumnIdx].emplace(std::type_index(typeid(T)), MakeCacheEntry<T>(column));
+        column = std::static_pointer_cast<const std::vector<T>>(inserted.first->second.mColumn);
+      }
+
+      return column;
+    }
+
+    template<typename T>
+    static ColumnCache::Entry MakeCacheEntry(const std::shared_ptr<const std::vector<T>>& pColumn)
+    {
+      ColumnCache::Entry entry;
+      entry.mColumn = pColumn;
+      entry.mExtend = [](const Document& pDocument, const size_t pColumnIdx, std::shared_ptr<const void>& pCached,
+                         const size_t pKeepCount)
+      {
+        return pDocument.ExtendCachedColumn<T>(pColumnIdx, pCached, pKeepCount);
+      };
+      return entry;
+    }
+
+    // Keep the first pKeepCount values of a cached column and convert the rows after them, in
+    // place unless shared with a copy of the Document. Returns false if a cell cannot be converted.
+    template<typename T>
+    bool ExtendCachedColumn(const size_t pColumnIdx, std::shared_ptr<const void>& pCached,
+                            const size_t pKeepCount) const
+    {
+      typedef std::vector<T> Column;
+      std::shared_ptr<Column> column;
+      if (pCached.use_count() == 1)
+      {
+        column = std::const_pointer_cast<Column>(std::static_pointer_cast<const Column>(pCached));
+      }
+      else
+      {
+        const Column& shared = *std::static_pointer_cast<const Column>(pCached);
+        column = std::make_shared<Column>(shared.begin(), shared.begin() + std::min(pKeepCount, shared.size()));
+      }
+
+      try
+      {
+        column->resize(std::min(pKeepCount, column->size()));
+        ConvertColumnRows<T>(pColumnIdx, column->size(), *column);
+      }
+      catch (const std::exception&)
+      {
+        return false;
+      }
+
+      pCached = column;
+      return true;
+    }
+
+    template<typename T>
+    void GroupRows(const size_t pBegin, const size_t pEnd, const size_t pFirstRowIdx,
+                   const std::vector<size_t>& pKeyColumnIdxs, const std::vector<size_t>& pValueColumnIdxs,
+                   const std::vector<std::shared_ptr<const std::vector<T>>>& pCachedColumns,
+                   GroupPartial<T>& pPartial) const
+    {
+      // Typed values of the range, converted directly from the cells unless cached
+      const size_t valueCount = pValueColumnIdxs.size();
+      std::vector<std::vector<T>> converted(valueCount);
+      std::vector<const T*> values(valueCount);
+      Converter<T> converter(mConverterParams);
+      for (size_t valueIdx = 0; valueIdx < valueCount; ++valueIdx)
+      {
+        if (pCachedColumns[valueIdx])
+        {
+          values[valueIdx] = pCachedColumns[valueIdx]->data() + (pBegin - pFirstRowIdx);
+          continue;
+        }
+
+        const size_t columnIdx = pValueColumnIdxs[valueIdx] + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+        converted[valueIdx].resize(pEnd - pBegin);
+        for (size_t rowIdx = pBegin; rowIdx < pEnd; ++rowIdx)
+        {
+          converter.ToVal(GetGroupCell(rowIdx, columnIdx), converted[valueIdx][rowIdx - pBegin]);
+        }
+        values[valueIdx] = converted[valueIdx].data();
+      }
+
+      for (size_t rowIdx = pBegin; rowIdx < pEnd; ++rowIdx)
+      {
+        const std::vector<std::string>& row = mData[rowIdx];
+        uint64_t hash = FlatHashTable::HashBytes(nullptr, 0);
+        for (const size_t keyColumnIdx : pKeyColumnIdxs)
+        {
+          // terminate each cell, so that cells "ab","c" and "a","bc" differ
+          const std::string& cell = GetGroupCell(rowIdx, keyColumnIdx);
+          hash = FlatHashTable::HashBytes(cell.c_str(), cell.size() + 1, hash);
+        }
+        hash = FlatHashTable::Mix(hash);
+
+        const size_t groupIdx = pPartial.mTable.FindOrInsert(hash, pPartial.mFirstRows.size(),
+                                                             [&](const size_t pGroupIdx)
+        {
+          return IsKeyEqual(row, mData[pPartial.mFirstRows[pGroupIdx]], pKeyColumnIdxs);
+        });
+
+        if (groupIdx == pPartial.mFirstRows.size())
+        {
+          pPartial.mFirstRows.push_back(rowIdx);
+          pPartial.mHashes.push_back(hash);
+          pPartial.mCounts.push_back(1);
+          for (size_t valueIdx = 0; valueIdx < valueCount; ++valueIdx)
+          {
+            const T& val = values[valueIdx][rowIdx - pBegin];
+            pPartial.mStates.push_back({ val, val, val });
+          }
+          continue;
+        }
+
+        ++pPartial.mCounts[groupIdx];
+        for (size_t valueIdx = 0; valueIdx < valueCount; ++valueIdx)
+        {
+          const T& val = values[valueIdx][rowIdx - pBegin];
+          typename GroupPartial<T>::State& state = pPartial.mStates[(groupIdx * valueCount) + valueIdx];
+          state.mSum += val;
+          state.mMin = std::min(state.mMin, val);
+          state.mMax = std::max(state.mMax, val);
+        }
+      }
+    }
+
+    const std::string& GetGroupCell(const size_t pRowIdx, const size_t pColumnIdx) const
+    {
+      const std::vector<std::string>& row = mData[pRowIdx];
+      if (pColumnIdx >= row.size())
+      {
+        const std::string errStr = "requested column index " +
+          std::to_string(pColumnIdx - (mLabelParams.mRowNameIdx + 1)) + " >= " +
+          std::to_string(row.size() - (mLabelParams.mRowNameIdx + 1)) +
+          " (number of columns on row index " +
+          std::to_string(pRowIdx - (mLabelParams.mColumnNameIdx + 1)) + ")";
+        throw std::out_of_range(errStr);
+      }
+
+      return row[pColumnIdx];
+    }
+
+    static bool IsKeyEqual(const std::vector<std::string>& pRow, const std::vector<std::string>& pOtherRow,
+                           const std::vector<size_t>& pKeyColumnIdxs)
+    {
+      for (const size_t keyColumnIdx : pKeyColumnIdxs)
+      {
+        if (pRow[keyColumnIdx] != pOtherRow[keyColumnIdx])
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    static size_t GetRowRangeCount(const size_t pRowCount, const size_t pThreadCount)
+    {
+      const size_t threadCount = (pThreadCount == 0) ? std::max<size_t>(1, std::thread::hardware_concurrency())
+                                                     : pThreadCount;
+      return std::max<size_t>(1, std::min(threadCount, pRowCount / sMinParallelRows));
+    }
+
+    template<typename Func>
+    static void ForEachRowRange(const size_t pBegin, const size_t pEnd, const size_t pRangeCount, Func pFunc)
+    {
+      std::vector<std::exception_ptr> errors(pRangeCount);
+      auto runRange = [&](const size_t pRangeIdx)
+      {
+        try
+        {
+          pFunc(pRangeIdx, pBegin + (((pEnd - pBegin) * pRangeIdx) / pRangeCount),
+                pBegin + (((pEnd - pBegin) * (pRangeIdx + 1)) / pRangeCount));
+        }
+        catch (...)
+        {
+          errors[pRangeIdx] = std::current_exception();
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (size_t i = 1; i < pRangeCount; ++i)
+      {
+        threads.emplace_back(runRange, i);
+      }
+
+      runRange(0);
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      for (auto& error : errors)
+      {
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+
+    size_t GetIndexColumnIdx(const std::string& pColumnName) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return static_cast<size_t>(columnIdx);
+    }
+
+    template<typename T>
+    static bool CompareSortedValue(const std::pair<T, size_t>& pLhs, const std::pair<T, size_t>& pRhs)
+    {
+      return pLhs.first < pRhs.first;
+    }
+
+    std::shared_ptr<HashIndex> BuildHashIndex(const size_t pColumnIdx) const
+    {
+      const size_t columnIdx = pColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      const size_t rangeCount = GetRowRangeCount(mData.size() - firstRowIdx, mParallelParams.mThreadCount);
+      std::vector<HashIndex> partials(rangeCount);
+      ForEachRowRange(firstRowIdx, mData.size(), rangeCount,
+                      [&](const size_t pRangeIdx, const size_t pBegin, const size_t pEnd)
+      {
+        HashIndex& partial = partials[pRangeIdx];
+        for (size_t rowIdx = pBegin; rowIdx < pEnd; ++rowIdx)
+        {
+          if (columnIdx < mData[rowIdx].size())
+          {
+            const std::string& cell = mData[rowIdx][columnIdx];
+            partial.Insert(cell, HashIndex::Hash(cell)).push_back(rowIdx - firstRowIdx);
+          }
+        }
+      });
+
+      // Merge in range order, which keeps the rows of each cell ascending
+      std::shared_ptr<HashIndex> index = std::make_shared<HashIndex>(std::move(partials[0]));
+      for (size_t i = 1; i < rangeCount; ++i)
+      {
+        HashIndex& partial = partials[i];
+        for (size_t keyIdx = 0; keyIdx < partial.mKeys.size(); ++keyIdx)
+        {
+          std::vector<size_t>& rows = index->Insert(partial.mKeys[keyIdx], partial.mHashes[keyIdx]);
+          if (rows.empty())
+          {
+            rows.swap(partial.mRows[keyIdx]);
+          }
+          else
+          {
+            rows.insert(rows.end(), partial.mRows[keyIdx].begin(), partial.mRows[keyIdx].end());
+          }
+        }
+      }
+
+      index->IndexRows(mData.size() - firstRowIdx);
+      return index;
+    }
+
+    template<typename T>
+    std::shared_ptr<const std::vector<std::pair<T, size_t>>> BuildSortedIndex(const size_t pColumnIdx) const
+    {
+      typedef std::vector<std::pair<T, size_t>> Entries;
+      const size_t columnIdx = pColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      const size_t rangeCount = GetRowRangeCount(mData.size() - firstRowIdx, mParallelParams.mThreadCount);
+      std::vector<Entries> partials(rangeCount);
+      ForEachRowRange(firstRowIdx, mData.size(), rangeCount,
+                      [&](const size_t pRangeIdx, const size_t pBegin, const size_t pEnd)
+      {
+        Entries& entries = partials[pRangeIdx];
+        entries.reserve(pEnd - pBegin);
+        Converter<T> converter(mConverterParams);
+        for (size_t rowIdx = pBegin; rowIdx < pEnd; ++rowIdx)
+        {
+          if (columnIdx < mData[rowIdx].size())
+          {
+            T val;
+            converter.ToVal(mData[rowIdx][columnIdx], val);
+            entries.emplace_back(val, rowIdx - firstRowIdx);
+          }
+        }
+
+        std::sort(entries.begin(), entries.end());
+      });
+
+      // Merge adjacent sorted ranges pairwise, the merges of each level in parallel
+      for (size_t width = 1; width < rangeCount; width *= 2)
+      {
+        const size_t mergeCount = (rangeCount + (2 * width) - 1) / (2 * width);
+        ForEachRowRange(0, mergeCount, mergeCount, [&](const size_t pMergeIdx, const size_t, const size_t)
+        {
+          Entries& lhs = partials[pMergeIdx * 2 * width];
+          const size_t rhsIdx = (pMergeIdx * 2 * width) + width;
+          if (rhsIdx < rangeCount)
+          {
+            Entries& rhs = partials[rhsIdx];
+            Entries merged;
+            merged.reserve(lhs.size() + rhs.size());
+            std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(merged));
+            lhs.swap(merged);
+            Entries().swap(rhs);
+          }
+        });
+      }
+
+      // not const, as modifications update the index in place
+      return std::make_shared<Entries>(std::move(partials[0]));
+    }
+
+    std::shared_ptr<const HashIndex> GetHashIndex(const size_t pColumnIdx) const
+    {
+      {
+        std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+        const auto it = mIndexCache.mHashIndexes.find(pColumnIdx);
+        if ((it == mIndexCache.mHashIndexes.end()) || it->second)
+        {
+          return (it == mIndexCache.mHashIndexes.end()) ? std::shared_ptr<const HashIndex>() : it->second;
+        }
+      }
+
+      // rebuild outside the lock, a concurrent reader rebuilding the same index is harmless
+      std::shared_ptr<HashIndex> index = BuildHashIndex(pColumnIdx);
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      const auto it = mIndexCache.mHashIndexes.find(pColumnIdx);
+      if ((it != mIndexCache.mHashIndexes.end()) && !it->second)
+      {
+        it->second = index;
+      }
+      return index;
+    }
+
+    template<typename T>
+    std::shared_ptr<const std::vector<std::pair<T, size_t>>> GetSortedIndex(const size_t pColumnIdx) const
+    {
+      typedef std::vector<std::pair<T, size_t>> Entries;
+      const std::type_index type(typeid(T));
+      {
+        std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+        const auto itColumn = mIndexCache.mSortedIndexes.find(pColumnIdx);
+        if (itColumn == mIndexCache.mSortedIndexes.end())
+        {
+          return std::shared_ptr<const Entries>();
+        }
+
+        const auto itType = itColumn->second.find(type);
+        if (itType == itColumn->second.end())
+        {
+          return std::shared_ptr<const Entries>();
+        }
+
+        if (itType->second.mIndex)
+        {
+          return std::static_pointer_cast<const Entries>(itType->second.mIndex);
+        }
+      }
+
+      std::shared_ptr<const Entries> index = BuildSortedIndex<T>(pColumnIdx);
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      const auto itColumn = mIndexCache.mSortedIndexes.find(pColumnIdx);
+      if (itColumn != mIndexCache.mSortedIndexes.end())
+      {
+        const auto itType = itColumn->second.find(type);
+        if ((itType != itColumn->second.end()) && !itType->second.mIndex)
+        {
+          itType->second.mIndex = index;
+        }
+      }
+      return index;
+    }
+
+    void BuildIndexes()
+    {
+      IndexCache::HashIndexes hashIndexes;
+      IndexCache::SortedIndexes sortedIndexes;
+      {
+        std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+        hashIndexes = mIndexCache.mHashIndexes;
+        sortedIndexes = mIndexCache.mSortedIndexes;
+      }
+
+      for (auto& hashIndex : hashIndexes)
+      {
+        hashIndex.second = BuildHashIndex(hashIndex.first);
+      }
+
+      for (auto& sortedColumn : sortedIndexes)
+      {
+        for (auto& sortedIndex : sortedColumn.second)
+        {
+          sortedIndex.second.mIndex = sortedIndex.second.mBuild(*this, sortedColumn.first);
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      mIndexCache.mHashIndexes.swap(hashIndexes);
+      mIndexCache.mSortedIndexes.swap(sortedIndexes);
+    }
+
+    template<typename T>
+    bool UpdateSortedIndex(void* pIndex, const size_t pRowIdx, const std::string* pOldCell,
+                           const std::string* pNewCell, const ssize_t pShift) const
+    {
+      typedef std::vector<std::pair<T, size_t>> Entries;
+      Entries& entries = *static_cast<Entries*>(pIndex);
+      std::pair<T, size_t> oldEntry(T(), pRowIdx);
+      std::pair<T, size_t> newEntry(T(), pRowIdx);
+      try
+      {
+        Converter<T> converter(mConverterParams);
+        if (pOldCell != nullptr)
+        {
+          converter.ToVal(*pOldCell, oldEntry.first);
+        }
+
+        if (pNewCell != nullptr)
+        {
+          converter.ToVal(*pNewCell, newEntry.first);
+        }
+      }
+      catch (const std::exception&)
+      {
+        return false;
+      }
+
+      if (pOldCell != nullptr)
+      {
+        const auto it = std::lower_bound(entries.begin(), entries.end(), oldEntry);
+        if ((it == entries.end()) || (oldEntry < *it))
+        {
+          return false;
+        }
+        entries.erase(it);
+      }
+
+      if (pShift != 0)
+      {
+        for (auto& entry : entries)
+        {
+          if (entry.second >= pRowIdx)
+          {
+            entry.second = static_cast<size_t>(static_cast<ssize_t>(entry.second) + pShift);
+          }
+        }
+      }
+
+      if (pNewCell != nullptr)
+      {
+        entries.insert(std::upper_bound(entries.begin(), entries.end(), newEntry), newEntry);
+      }
+      return true;
+    }
+
+    // Add the entries of the data rows from pFirstRowIdx on, which all follow the indexed rows.
+    template<typename T>
+    bool AppendSortedIndex(void* pIndex, const size_t pColumnIdx, const size_t pFirstRowIdx) const
+    {
+      typedef std::vector<std::pair<T, size_t>> Entries;
+      Entries& entries = *static_cast<Entries*>(pIndex);
+      const size_t columnIdx = pColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      Entries added;
+      try
+      {
+        Converter<T> converter(mConverterParams);
+        for (size_t rowIdx = firstRowIdx + pFirstRowIdx; rowIdx < mData.size(); ++rowIdx)
+        {
+          if (columnIdx < mData[rowIdx].size())
+          {
+            T val;
+            converter.ToVal(mData[rowIdx][columnIdx], val);
+            added.emplace_back(val, rowIdx - firstRowIdx);
+          }
+        }
+      }
+      catch (const std::exception&)
+      {
+        return false;
+      }
+
+      std::sort(added.begin(), added.end());
+      const size_t count = entries.size();
+      entries.insert(entries.end(), added.begin(), added.end());
+      std::inplace_merge(entries.begin(), entries.begin() + static_cast<ssize_t>(count), entries.end());
+      return true;
+    }
+
+    // Add the data rows from pFirstRowIdx on, parsed by Refresh, to the indexes of all columns.
+    void AppendRowIndexes(const size_t pFirstRowIdx)
+    {
+      const size_t firstRowIdx = std::min(mData.size(), static_cast<size_t>(mLabelParams.mColumnNameIdx + 1));
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      for (auto& hashIndex : mIndexCache.mHashIndexes)
+      {
+        std::shared_ptr<HashIndex>& index = hashIndex.second;
+        if (index && (index.use_count() > 1))
+        {
+          // shared with a copy of the Document, rebuild on next use instead
+          index.reset();
+        }
+
+        for (size_t rowIdx = firstRowIdx + pFirstRowIdx; index && (rowIdx < mData.size()); ++rowIdx)
+        {
+          const std::string* cell = GetRowCell(&mData[rowIdx], hashIndex.first);
+          if (cell != nullptr)
+          {
+            index->AddRow(*cell, rowIdx - firstRowIdx);
+          }
+        }
+      }
+
+      for (auto& sortedColumn : mIndexCache.mSortedIndexes)
+      {
+        for (auto& sortedIndex : sortedColumn.second)
+        {
+          std::shared_ptr<const void>& index = sortedIndex.second.mIndex;
+          if (index &&
+              ((index.use_count() > 1) ||
+               !sortedIndex.second.mAppend(*this, const_cast<void*>(index.get()), sortedColumn.first, pFirstRowIdx)))
+          {
+            // shared with a copy of the Document, or cells not convertible, rebuild on next use instead
+            index.reset();
+          }
+        }
+      }
+    }
+
+    // Update the indexes of a column for a change of one data row: remove its old cell, shift the
+    // rows from pRowIdx on by pShift, and add its new cell. Cells are null if the row has none.
+    void UpdateIndexes(const size_t pColumnIdx, const size_t pRowIdx, const std::string* pOldCell,
+                       const std::string* pNewCell, const ssize_t pShift)
+    {
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      const auto itHash = mIndexCache.mHashIndexes.find(pColumnIdx);
+      if (itHash != mIndexCache.mHashIndexes.end())
+      {
+        UpdateHashIndex(itHash->second, pRowIdx, pOldCell, pNewCell, pShift);
+      }
+
+      const auto itSorted = mIndexCache.mSortedIndexes.find(pColumnIdx);
+      if (itSorted != mIndexCache.mSortedIndexes.end())
+      {
+        UpdateSortedIndexes(itSorted->second, pRowIdx, pOldCell, pNewCell, pShift);
+      }
+    }
+
+    // Update the indexes of all columns for a change of one data row. Rows inserted or removed
+    // at the end need no renumbering of the rows after them.
+    void UpdateRowIndexes(const size_t pRowIdx, const std::vector<std::string>* pOldRow,
+                          const std::vector<std::string>* pNewRow, ssize_t pShift)
+    {
+      if ((pRowIdx + 1) >= GetRowCount())
+      {
+        pShift = 0;
+      }
+
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      for (auto& hashIndex : mIndexCache.mHashIndexes)
+      {
+        UpdateHashIndex(hashIndex.second, pRowIdx, GetRowCell(pOldRow, hashIndex.first),
+                        GetRowCell(pNewRow, hashIndex.first), pShift);
+      }
+
+      for (auto& sortedColumn : mIndexCache.mSortedIndexes)
+      {
+        UpdateSortedIndexes(sortedColumn.second, pRowIdx, GetRowCell(pOldRow, sortedColumn.first),
+                            GetRowCell(pNewRow, sortedColumn.first), pShift);
+      }
+    }
+
+    const std::string* GetRowCell(const std::vector<std::string>* pRow, const size_t pColumnIdx) const
+    {
+      const size_t columnIdx = pColumnIdx + static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      return ((pRow != nullptr) && (columnIdx < pRow->size())) ? &(*pRow)[columnIdx] : nullptr;
+    }
+
+    static void UpdateHashIndex(std::shared_ptr<HashIndex>& pIndex, const size_t pRowIdx,
+                                const std::string* pOldCell, const std::string* pNewCell, const ssize_t pShift)
+    {
+      if (!pIndex)
+      {
+        return;
+      }
+
+      if (pIndex.use_count() > 1)
+      {
+        // shared with a copy of the Document, rebuild on next use instead
+        pIndex.reset();
+        return;
+      }
+
+      if (pOldCell != nullptr)
+      {
+        pIndex->RemoveRow(*pOldCell, pRowIdx);
+      }
+
+      if (pShift != 0)
+      {
+        pIndex->ShiftRows(pRowIdx, pShift);
+      }
+
+      if (pNewCell != nullptr)
+      {
+        pIndex->AddRow(*pNewCell, pRowIdx);
+      }
+    }
+
+    void UpdateSortedIndexes(std::map<std::type_index, IndexCache::SortedEntry>& pEntries, const size_t pRowIdx,
+                             const std::string* pOldCell, const std::string* pNewCell, const ssize_t pShift) const
+    {
+      for (auto& sortedIndex : pEntries)
+      {
+        std::shared_ptr<const void>& index = sortedIndex.second.mIndex;
+        if (index &&
+            ((index.use_count() > 1) ||
+             !sortedIndex.second.mUpdate(*this, const_cast<void*>(index.get()), pRowIdx, pOldCell, pNewCell, pShift)))
+        {
+          // shared with a copy of the Document, or cells not convertible, rebuild on next use instead
+          index.reset();
+        }
+      }
+    }
+
+    void ShiftIndexes(const size_t pColumnIdx, const bool pInsert)
+    {
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      IndexCache::HashIndexes hashIndexes;
+      for (auto& hashIndex : mIndexCache.mHashIndexes)
+      {
+        if (hashIndex.first < pColumnIdx)
+        {
+          hashIndexes[hashIndex.first] = hashIndex.second;
+        }
+        else if (pInsert || (hashIndex.first > pColumnIdx))
+        {
+          hashIndexes[pInsert ? (hashIndex.first + 1) : (hashIndex.first - 1)] = hashIndex.second;
+        }
+      }
+
+      IndexCache::SortedIndexes sortedIndexes;
+      for (auto& sortedColumn : mIndexCache.mSortedIndexes)
+      {
+        if (sortedColumn.first < pColumnIdx)
+        {
+          sortedIndexes[sortedColumn.first] = sortedColumn.second;
+        }
+        else if (pInsert || (sortedColumn.first > pColumnIdx))
+        {
+          sortedIndexes[pInsert ? (sortedColumn.first + 1) : (sortedColumn.first - 1)] = sortedColumn.second;
+        }
+      }
+
+      mIndexCache.mHashIndexes.swap(hashIndexes);
+      mIndexCache.mSortedIndexes.swap(sortedIndexes);
+    }
+
+    void InvalidateColumn(const size_t pColumnIdx, const bool pKeepIndexes = false)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mColumnCache.mMutex);
+        mColumnCache.mColumns.erase(pColumnIdx);
+      }
+
+      if (pKeepIndexes)
+      {
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      const auto itHash = mIndexCache.mHashIndexes.find(pColumnIdx);
+      if (itHash != mIndexCache.mHashIndexes.end())
+      {
+        itHash->second.reset();
+      }
+
+      const auto itSorted = mIndexCache.mSortedIndexes.find(pColumnIdx);
+      if (itSorted != mIndexCache.mSortedIndexes.end())
+      {
+        for (auto& sortedIndex : itSorted->second)
+        {
+          sortedIndex.second.mIndex.reset();
+        }
+      }
+    }
+
+    // Keep the first pKeepCount values of each cached column and convert the rows parsed after
+    // them, dropping columns with cells that can no longer be converted.
+    void ExtendCachedColumns(const size_t pKeepCount)
+    {
+      std::lock_guard<std::mutex> lock(mColumnCache.mMutex);
+      for (auto itColumn = mColumnCache.mColumns.begin(); itColumn != mColumnCache.mColumns.end();)
+      {
+        for (auto itType = itColumn->second.begin(); itType != itColumn->second.end();)
+        {
+          ColumnCache::Entry& entry = itType->second;
+          itType = entry.mExtend(*this, itColumn->first, entry.mColumn, pKeepCount) ? std::next(itType) :
+            itColumn->second.erase(itType);
+        }
+
+        itColumn = itColumn->second.empty() ? mColumnCache.mColumns.erase(itColumn) : std::next(itColumn);
+      }
+    }
+
+    void InvalidateColumnCache()
+    {
+      std::lock_guard<std::mutex> lock(mColumnCache.mMutex);
+      mColumnCache.mColumns.clear();
+    }
+
+    void InvalidateColumns()
+    {
+      InvalidateColumnCache();
+
+      std::lock_guard<std::mutex> lock(mIndexCache.mMutex);
+      for (auto& hashIndex : mIndexCache.mHashIndexes)
+      {
+        hashIndex.second.reset();
+      }
+
+      for (auto& sortedColumn : mIndexCache.mSortedIndexes)
+      {
+        for (auto& sortedIndex : sortedColumn.second)
+        {
+          sortedIndex.second.mIndex.reset();
+        }
+      }
+    }
+
+    size_t GetDataRowCount() const
+    {
+      return mData.size();
+    }
+
+    size_t GetDataColumnCount() const
+    {
+      return (mData.size() > 0) ? mData.at(0).size() : 0;
+    }
+
+#ifdef HAS_CODECVT
+#if defined(_MSC_VER)
+#pragma warning (disable: 4996)
+#endif
+    static std::wstring ToWString(const std::string& pStr)
+    {
+      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.from_bytes(pStr);
+    }
+#if defined(_MSC_VER)
+#pragma warning (default: 4996)
+#endif
+#endif
+
+  private:
+    static const size_t sMinParallelRows = 16 * 1024;
+    std::string mPath;
+    LabelParams mLabelParams;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    LineReaderParams mLineReaderParams;
+    ParallelParams mParallelParams;
+    FilterParams mFilterParams;
+    SidecarParams mSidecarParams;
+    std::vector<std::vector<std::string>> mData;
+    std::map<std::string, size_t> mColumnNames;
+    std::map<std::string, size_t> mRowNames;
+    mutable ColumnCache mColumnCache;
+    mutable IndexCache mIndexCache;
+    size_t mRowNameCount = 0;
+    bool mRefreshValid = false;
+    size_t mRefreshOffset = 0;
+    size_t mRefreshTailRows = 0;
+    uint64_t mRefreshSize = 0;
+    bool mModified = false;
+    std::vector<bool> mKeepColumns;
+    bool mIsUtf16 = false;
+    bool mIsLE = false;
+  };
+
+  /**
+   * @brief     Class reading CSV rows one at a time, forward-only, without loading the whole
+   *            file. Memory use is bounded by the read buffer size and the longest row.
+   */
+  class RowReader
+  {
+  public:
+    /**
+     * @brief     Input iterator over the rows of a RowReader. All iterators share the reader's
+     *            current row, which is overwritten when any of them is incremented.
+     */
+    class iterator
+    {
+    public:
+      typedef std::input_iterator_tag iterator_category;
+      typedef std::vector<std::string> value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const std::vector<std::string>* pointer;
+      typedef const std::vector<std::string>& reference;
+
+      iterator()
+        : mReader(nullptr)
+      {
+      }
+
+      explicit iterator(RowReader* pReader)
+        : mReader(pReader)
+      {
+      }
+
+      reference operator*() const
+      {
+        return mReader->GetRow();
+      }
+
+      pointer operator->() const
+      {
+        return &mReader->GetRow();
+      }
+
+      iterator& operator++()
+      {
+        if (!mReader->ReadRow())
+        {
+          mReader = nullptr;
+        }
+        return *this;
+      }
+
+      iterator operator++(int)
+      {
+        iterator it = *this;
+        ++*this;
+        return it;
+      }
+
+      bool operator==(const iterator& pOther) const
+      {
+        return mReader == pOther.mReader;
+      }
+
+      bool operator!=(const iterator& pOther) const
+      {
+        return mReader != pOther.mReader;
+      }
+
+    private:
+      RowReader* mReader;
+    };
+
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to read.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     */
+    explicit RowReader(const std::string& pPath,
+                       const LabelParams& pLabelParams = LabelParams(),
+                       const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                       const ConverterParams& pConverterParams = ConverterParams(),
+                       const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mFile(new std::ifstream())
+      , mStream(mFile.get())
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mParser(mSeparatorParams, mLineReaderParams, mPendingRows)
+    {
+      mFile->exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      mFile->open(pPath, std::ios::binary);
+      mFile->exceptions(std::ifstream::badbit);
+      ReadLabels();
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies an input stream to read CSV data from. It must
+     *                                outlive the RowReader, and need not be seekable.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     */
+    explicit RowReader(std::istream& pStream,
+                       const LabelParams& pLabelParams = LabelParams(),
+                       const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                       const ConverterParams& pConverterParams = ConverterParams(),
+                       const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mStream(&pStream)
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mParser(mSeparatorParams, mLineReaderParams, mPendingRows)
+    {
+      ReadLabels();
+    }
+
+    RowReader(const RowReader&) = delete;
+    RowReader& operator=(const RowReader&) = delete;
+
+    /**
+     * @brief   Restrict rows to the specified columns, in the specified order. Cell indices
+     *          and names then refer to the selected columns only. Takes effect from the next
+     *          row read.
+     * @param   pColumnIdxs           zero-based column indices.
+     */
+    void SelectColumns(const std::vector<size_t>& pColumnIdxs)
+    {
+      mSelectedColumns = pColumnIdxs;
+      mSelectedColumnNames.clear();
+      const std::vector<std::string> columnNames = GetColumnNames();
+      for (size_t i = 0; i < mSelectedColumns.size(); ++i)
+      {
+        if (mSelectedColumns[i] < columnNames.size())
+        {
+          mSelectedColumnNames[columnNames[mSelectedColumns[i]]] = i;
+        }
+      }
+    }
+
+    /**
+     * @brief   Restrict rows to the specified columns, in the specified order. Cell indices
+     *          and names then refer to the selected columns only. Takes effect from the next
+     *          row read.
+     * @param   pColumnNames          column label names.
+     */
+    void SelectColumns(const std::vector<std::string>& pColumnNames)
+    {
+      std::vector<size_t> columnIdxs;
+      for (const auto& columnName : pColumnNames)
+      {
+        const auto it = mColumnNames.find(columnName);
+        if (it == mColumnNames.end())
+        {
+          throw std::out_of_range("column not found: " + columnName);
+        }
+        columnIdxs.push_back(it->second);
+      }
+      SelectColumns(columnIdxs);
+    }
+
+    /**
+     * @brief   Read the next row.
+     * @returns false if there are no more rows.
+     */
+    bool ReadRow()
+    {
+      if (!NextRow())
+      {
+        mRow.clear();
+        mRowName.clear();
+        return false;
+      }
+
+      ReusedRow& row = mPendingRows[mPendingRowIdx++];
+      const size_t firstColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        if (static_cast<ssize_t>(row.size()) > mLabelParams.mRowNameIdx)
+        {
+          mRowName.assign(row[mLabelParams.mRowNameIdx]);
+        }
+        else
+        {
+          mRowName.clear();
+        }
+      }
+
+      if (mSelectedColumns.empty())
+      {
+        // swap the cells, so their buffers return to the parser with the row
+        const size_t cellCount = row.size() - std::min(firstColumnIdx, row.size());
+        mRow.resize(cellCount);
+        for (size_t i = 0; i < cellCount; ++i)
+        {
+          mRow[i].swap(row[firstColumnIdx + i]);
+        }
+      }
+      else
+      {
+        mRow.resize(mSelectedColumns.size());
+        for (size_t i = 0; i < mSelectedColumns.size(); ++i)
+        {
+          const size_t columnIdx = mSelectedColumns[i] + firstColumnIdx;
+          if (columnIdx >= row.size())
+          {
+            const std::string errStr = "requested column index " + std::to_string(mSelectedColumns[i]) +
+              " >= " + std::to_string(row.size() - std::min(firstColumnIdx, row.size())) +
+              " (number of columns on row index " + std::to_string(mRowIdx) + ")";
+            throw std::out_of_range(errStr);
+          }
+          mRow[i].assign(row[columnIdx]);
+        }
+      }
+
+      ++mRowIdx;
+      return true;
+    }
+
+    /**
+     * @brief   Get current row, as read by the last successful ReadRow().
+     * @returns cells of the (selected) data columns.
+     */
+    const std::vector<std::string>& GetRow() const
+    {
+      return mRow;
+    }
+
+    /**
+     * @brief   Get current row.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow() const
+    {
+      std::vector<T> row;
+      Converter<T> converter(mConverterParams);
+      for (const auto& cell : mRow)
+      {
+        T val;
+        converter.ToVal(cell, val);
+        row.push_back(val);
+      }
+      return row;
+    }
+
+    /**
+     * @brief   Get cell of current row by index.
+     * @param   pColumnIdx            zero-based (selected) column index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx) const
+    {
+      T val;
+      Converter<T> converter(mConverterParams);
+      converter.ToVal(mRow.at(pColumnIdx), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell of current row by column name.
+     * @param   pColumnName           column label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName) const
+    {
+      const ssize_t columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetCell<T>(columnIdx);
+    }
+
+    /**
+     * @brief   Get column index by name.
+     * @param   pColumnName           column label name.
+     * @returns zero-based (selected) column index, or -1 if not found.
+     */
+    ssize_t GetColumnIdx(const std::string& pColumnName) const
+    {
+      const std::map<std::string, size_t>& columnNames =
+        mSelectedColumns.empty() ? mColumnNames : mSelectedColumnNames;
+      const auto it = columnNames.find(pColumnName);
+      return (it != columnNames.end()) ? static_cast<ssize_t>(it->second) : -1;
+    }
+
+    /**
+     * @brief   Get column names of all data columns, regardless of column selection.
+     * @returns vector of column names.
+     */
+    std::vector<std::string> GetColumnNames() const
+    {
+      const size_t firstColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      if (mHeader.size() > firstColumnIdx)
+      {
+        return std::vector<std::string>(mHeader.begin() + firstColumnIdx, mHeader.end());
+      }
+
+      return std::vector<std::string>();
+    }
+
+    /**
+     * @brief   Get row name of current row.
+     * @returns row name.
+     */
+    const std::string& GetRowName() const
+    {
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      return mRowName;
+    }
+
+    /**
+     * @brief   Get zero-based index of current row.
+     * @returns row index.
+     */
+    size_t GetRowIdx() const
+    {
+      return mRowIdx - 1;
+    }
+
+    /**
+     * @brief   Read the first row and get an iterator to it.
+     * @returns row iterator.
+     */
+    iterator begin()
+    {
+      return ++iterator(this);
+    }
+
+    /**
+     * @brief   Get end iterator.
+     * @returns row iterator.
+     */
+    iterator end()
+    {
+      return iterator();
+    }
+
+  private:
+    void ReadLabels()
+    {
+      for (ssize_t rowIdx = 0; rowIdx <= mLabelParams.mColumnNameIdx; ++rowIdx)
+      {
+        if (!NextRow())
+        {
+          break;
+        }
+
+        const ReusedRow& row = mPendingRows[mPendingRowIdx++];
+        if (rowIdx == mLabelParams.mColumnNameIdx)
+        {
+          mHeader.assign(row.begin(), row.end());
+        }
+      }
+
+      const size_t firstColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
+      for (size_t i = firstColumnIdx; i < mHeader.size(); ++i)
+      {
+        mColumnNames[mHeader[i]] = i - firstColumnIdx;
+      }
+    }
+
+    bool NextRow()
+    {
+      while (mPendingRowIdx >= mPendingRows.size())
+      {
+        mPendingRows.clear();
+        mPendingRowIdx = 0;
+        if (mEof)
+        {
+          return false;
+        }
+
+        ReadBuffer();
+      }
+
+      return true;
+    }
+
+    void ReadBuffer()
+    {
+      mBuffer.resize(64 * 1024);
+      std::streamsize readLength = 0;
+      try
+      {
+        mStream->read(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+        readLength = mStream->gcount();
+      }
+      catch (const std::ios_base::failure&)
+      {
+        // stream with failbit exceptions enabled failing at end of data
+        if (!mStream->eof())
+        {
+          throw;
+        }
+        readLength = mStream->gcount();
+      }
+
+      const char* data = mBuffer.data();
+      if (mAtStart)
+      {
+        mAtStart = false;
+        // check for UTF-8 Byte order mark and skip it when found
+        static const char bomU8[] = { '\xef', '\xbb', '\xbf' };
+        if ((readLength >= 3) && std::equal(bomU8, bomU8 + 3, data))
+        {
+          data += 3;
+          readLength -= 3;
+        }
+      }
+
+      mParser.Parse(data, static_cast<size_t>(readLength));
+      if (!*mStream)
+      {
+        mParser.Finish();
+        mEof = true;
+      }
+    }
+
+  private:
+    std::unique_ptr<std::ifstream> mFile;
+    std::istream* mStream;
+    LabelParams mLabelParams;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    LineReaderParams mLineReaderParams;
+    ReusedRows mPendingRows;
+    size_t mPendingRowIdx = 0;
+    BasicRowParser<ReusedRows> mParser;
+    std::vector<char> mBuffer;
+    bool mAtStart = true;
+    bool mEof = false;
+    std::vector<std::string> mHeader;
+    std::map<std::string, size_t> mColumnNames;
+    std::vector<size_t> mSelectedColumns;
+    std::map<std::string, size_t> mSelectedColumnNames;
+    std::vector<std::string> mRow;
+    std::string mRowName;
+    size_t mRowIdx = 0;
+  };
+
+  /**
+   * @brief     Class writing CSV rows one at a time without holding a document in memory.
+   *            Rows are formatted into a buffer which is written out in large chunks.
+   */
+  class RowWriter
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of a CSV-file to create or overwrite.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how numbers are converted to text.
+     */
+    explicit RowWriter(const std::string& pPath,
+                       const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                       const ConverterParams& pConverterParams = ConverterParams())
+      : mFile(new std::ofstream())
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mFormatter(mSeparatorParams, *mFile)
+    {
+      mFile->exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      mFile->open(pPath, std::ios::binary | std::ios::trunc);
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies an output stream to write CSV data to. It must
+     *                                outlive the RowWriter.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how numbers are converted to text.
+     */
+    explicit RowWriter(std::ostream& pStream,
+                       const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                       const ConverterParams& pConverterParams = ConverterParams())
+      : mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mFormatter(mSeparatorParams, pStream)
+    {
+    }
+
+    /**
+     * @brief   Destructor, writes any buffered rows. Errors are ignored, call Flush() first
+     *          to have them reported.
+     */
+    ~RowWriter()
+    {
+      try
+      {
+        mFormatter.Flush();
+      }
+      catch (...)
+      {
+      }
+    }
+
+    RowWriter(const RowWriter&) = delete;
+    RowWriter& operator=(const RowWriter&) = delete;
+
+    /**
+     * @brief   Append a cell to the current row.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void WriteCell(const T& pCell)
+    {
+      Converter<T> converter(mConverterParams);
+      converter.ToStr(pCell, mCell);
+      mFormatter.Cell(mCell.data(), mCell.size());
+    }
+
+    /**
+     * @brief   Append a string cell to the current row.
+     * @param   pCell                 cell data.
+     */
+    void WriteCell(const std::string& pCell)
+    {
+      mFormatter.Cell(pCell.data(), pCell.size());
+    }
+
+    /**
+     * @brief   Append a string cell to the current row.
+     * @param   pCell                 null-terminated cell data.
+     */
+    void WriteCell(const char* pCell)
+    {
+      mFormatter.Cell(pCell, std::strlen(pCell));
+    }
+
+    /**
+     * @brief   End the current row.
+     */
+    void EndRow()
+    {
+      mFormatter.EndRow();
+    }
+
+    /**
+     * @brief   Write a row.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void WriteRow(const std::vector<T>& pRow)
+    {
+      for (const auto& cell : pRow)
+      {
+        WriteCell(cell);
+      }
+      EndRow();
+    }
+
+    /**
+     * @brief   Write a row of cells of possibly different types, e.g.
+     *          WriteRow("MSFT", 64.62, 21705200).
+     * @param   pCells                cell data.
+     */
+    template<typename... Ts>
+    void WriteRow(const Ts&... pCells)
+    {
+      WriteCells(pCells...);
+      EndRow();
+    }
+
+    /**
+     * @brief   Write buffered rows to the file or stream.
+     */
+    void Flush()
+    {
+      mFormatter.Flush();
+      if (mFile)
+      {
+        mFile->flush();
+      }
+    }
+
+  private:
+    void WriteCells()
+    {
+    }
+
+    template<typename T, typename... Ts>
+    void WriteCells(const T& pCell, const Ts&... pCells)
+    {
+      WriteCell(pCell);
+      WriteCells(pCells...);
+    }
+
+  private:
+    std::unique_ptr<std::ofstream> mFile;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    RowFormatter mFormatter;
+    std::string mCell;
+  };
+
+#ifdef RAPIDCSV_HAS_CXX17
+  /**
+   * @brief     Class providing a read-only memory mapping of a file. Only intended for rapidcsv
+   *            internal usage.
+   */
+  class MappedFile
+  {
+  public:
+    MappedFile() = default;
+
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of the file to map.
+     */
+    explicit MappedFile(const std::string& pPath)
+    {
+      Open(pPath);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& pOther) noexcept
+    {
+      Swap(pOther);
+    }
+
+    MappedFile& operator=(MappedFile&& pOther) noexcept
+    {
+      if (this != &pOther)
+      {
+        Close();
+        Swap(pOther);
+      }
+      return *this;
+    }
+
+    ~MappedFile()
+    {
+      Close();
+    }
+
+    /**
+     * @brief   Map a file, replacing any current mapping.
+     * @param   pPath                 specifies the path of the file to map.
+     */
+    void Open(const std::string& pPath)
+    {
+      Close();
+#if defined(_WIN32)
+      mFile = CreateFileA(pPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+      if (mFile == INVALID_HANDLE_VALUE)
+      {
+        throw std::ios_base::failure("unable to open file: " + pPath);
+      }
+
+      LARGE_INTEGER size;
+      if (!GetFileSizeEx(mFile, &size))
+      {
+        Close();
+        throw std::ios_base::failure("unable to get size of file: " + pPath);
+      }
+      mSize = static_cast<size_t>(size.QuadPart);
+      if (mSize == 0)
+      {
+        return;
+      }
+
+      mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      const void* view = (mMapping != nullptr) ? MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+      if (view == nullptr)
+      {
+        Close();
+        throw std::ios_base::failure("unable to map file: " + pPath);
+      }
+      mData = static_cast<const char*>(view);
+#else
+      mFd = open(pPath.c_str(), O_RDONLY);
+      if (mFd < 0)
+      {
+        throw std::ios_base::failure("unable to open file: " + pPath);
+      }
+
+      struct stat st;
+      if (fstat(mFd, &st) != 0)
+      {
+        Close();
+        throw std::ios_base::failure("unable to get size of file: " + pPath);
+      }
+      mSize = static_cast<size_t>(st.st_size);
+      if (mSize == 0)
+      {
+        return;
+      }
+
+      void* addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+      if (addr == MAP_FAILED)
+      {
+        Close();
+        throw std::ios_base::failure("unable to map file: " + pPath);
+      }
+#ifdef MADV_SEQUENTIAL
+      madvise(addr, mSize, MADV_SEQUENTIAL);
+#endif
+      mData = static_cast<const char*>(addr);
+#endif
+    }
+
+    /**
+     * @brief   Unmap the file, if mapped.
+     */
+    void Close()
+    {
+#if defined(_WIN32)
+      if (mData != nullptr)
+      {
+        UnmapViewOfFile(mData);
+      }
+      if (mMapping != nullptr)
+      {
+        CloseHandle(mMapping);
+      }
+      if (mFile != INVALID_HANDLE_VALUE)
+      {
+        CloseHandle(mFile);
+      }
+      mMapping = nullptr;
+      mFile = INVALID_HANDLE_VALUE;
+#else
+      if (mData != nullptr)
+      {
+        munmap(const_cast<char*>(mData), mSize);
+      }
+      if (mFd >= 0)
+      {
+        close(mFd);
+      }
+      mFd = -1;
+#endif
+      mData = nullptr;
+      mSize = 0;
+    }
+
+    /**
+     * @brief   Get start of the mapped data (nullptr for an empty file).
+     * @returns pointer to the first byte of the file.
+     */
+    const char* Data() const
+    {
+      return mData;
+    }
+
+    /**
+     * @brief   Get size of the mapped data.
+     * @returns file size in bytes.
+     */
+    size_t Size() const
+    {
+      return mSize;
+    }
+
+  private:
+    void Swap(MappedFile& pOther) noexcept
+    {
+      std::swap(mData, pOther.mData);
+      std::swap(mSize, pOther.mSize);
+#if defined(_WIN32)
+      std::swap(mFile, pOther.mFile);
+      std::swap(mMapping, pOther.mMapping);
+#else
+      std::swap(mFd, pOther.mFd);
+#endif
+    }
+
+  private:
+    const char* mData = nullptr;
+    size_t mSize = 0;
+#if defined(_WIN32)
+    HANDLE mFile = INVALID_HANDLE_VALUE;
+    HANDLE mMapping = nullptr;
+#else
+    int mFd = -1;
+#endif
+  };
+
+  /**
+   * @brief     Class implementing the getters of the read-only documents MappedDocument and
+   *            PooledDocument on top of the cell storage of Derived, which provides GetRawRowCount,
+   *            GetRawRowSize, GetRawCell, FindColumnName and FindRowName for label rows and
+   *            columns included. Cells are converted directly from the stored bytes with
+   *            Converter::ViewToVal. Only intended for rapidcsv internal usage.
+   */
+  template<typename Derived>
+  class ReadOnlyDocument
+  {
+  public:
+    /**
+     * @brief   Get column index by name.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index.
+     */
+    ssize_t GetColumnIdx(const std::string& pColumnName) const
+    {
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        const ssize_t columnIdx = GetDerived().FindColumnName(pColumnName);
+        if (columnIdx >= 0)
+        {
+          return columnIdx - (mLabelParams.mRowNameIdx + 1);
+        }
+      }
+      return -1;
+    }
+
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx) const
+    {
+      Converter<T> converter(mConverterParams);
+      return ReadColumn<T>(pColumnIdx, [&converter](const std::string_view pCell, T& pVal)
       {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
+        converter.ViewToVal(pCell, pVal);
+      });
+    }
 
-      return GetCell<T>(columnIdx, rowIdx);
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+    {
+      std::string str;
+      return ReadColumn<T>(pColumnIdx, [&pToVal, &str](const std::string_view pCell, T& pVal)
+      {
+        str.assign(pCell.data(), pCell.size());
+        pToVal(str, pVal);
+      });
     }
 
     /**
-     * @brief   Get cell by name.
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName) const
+    {
+      return GetColumn<T>(ColumnIdxOrThrow(pColumnName));
+    }
+
+    /**
+     * @brief   Get column by name.
      * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
      * @param   pToVal                conversion function.
-     * @returns cell data.
+     * @returns vector of column data.
      */
     template<typename T>
-    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      return GetColumn<T>(ColumnIdxOrThrow(pColumnName), pToVal);
+    }
+
+    /**
+     * @brief   Get number of data columns (excluding label columns).
+     * @returns column count.
+     */
+    size_t GetColumnCount() const
+    {
+      const Derived& derived = GetDerived();
+      const ssize_t count = static_cast<ssize_t>((derived.GetRawRowCount() > 0) ? derived.GetRawRowSize(0) : 0) -
+        (mLabelParams.mRowNameIdx + 1);
+      return (count >= 0) ? count : 0;
+    }
+
+    /**
+     * @brief   Get row index by name.
+     * @param   pRowName              row label name.
+     * @returns zero-based row index.
+     */
+    ssize_t GetRowIdx(const std::string& pRowName) const
+    {
+      if (mLabelParams.mRowNameIdx >= 0)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        const ssize_t rowIdx = GetDerived().FindRowName(pRowName);
+        if (rowIdx >= 0)
+        {
+          return rowIdx - (mLabelParams.mColumnNameIdx + 1);
+        }
       }
+      return -1;
+    }
 
-      const ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx) const
+    {
+      Converter<T> converter(mConverterParams);
+      return ReadRow<T>(pRowIdx, [&converter](const std::string_view pCell, T& pVal)
       {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
+        converter.ViewToVal(pCell, pVal);
+      });
+    }
 
-      return GetCell<T>(columnIdx, rowIdx, pToVal);
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      std::string str;
+      return ReadRow<T>(pRowIdx, [&pToVal, &str](const std::string_view pCell, T& pVal)
+      {
+        str.assign(pCell.data(), pCell.size());
+        pToVal(str, pVal);
+      });
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName) const
+    {
+      return GetRow<T>(RowIdxOrThrow(pRowName));
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      return GetRow<T>(RowIdxOrThrow(pRowName), pToVal);
+    }
+
+    /**
+     * @brief   Get number of data rows (excluding label rows).
+     * @returns row count.
+     */
+    size_t GetRowCount() const
+    {
+      const ssize_t count = static_cast<ssize_t>(GetDerived().GetRawRowCount()) - (mLabelParams.mColumnNameIdx + 1);
+      return (count >= 0) ? count : 0;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
+    {
+      T val;
+      Converter<T> converter(mConverterParams);
+      std::string str;
+      converter.ViewToVal(GetDataCell(pColumnIdx, pRowIdx, str), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      T val;
+      std::string str;
+      const std::string_view cell = GetDataCell(pColumnIdx, pRowIdx, str);
+      pToVal(std::string(cell), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    {
+      const ssize_t columnIdx = ColumnIdxOrThrow(pColumnName);
+      return GetCell<T>(columnIdx, RowIdxOrThrow(pRowName));
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const ssize_t columnIdx = ColumnIdxOrThrow(pColumnName);
+      return GetCell<T>(columnIdx, RowIdxOrThrow(pRowName), pToVal);
     }
 
     /**
@@ -1105,13 +7132,7 @@ namespace rapidcsv
     template<typename T>
     T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-
-      return GetCell<T>(columnIdx, pRowIdx);
+      return GetCell<T>(ColumnIdxOrThrow(pColumnName), pRowIdx);
     }
 
     /**
@@ -1124,13 +7145,7 @@ namespace rapidcsv
     template<typename T>
     T GetCell(const std::string& pColumnName, const size_t pRowIdx, ConvFunc<T> pToVal) const
     {
-      const ssize_t columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-
-      return GetCell<T>(columnIdx, pRowIdx, pToVal);
+      return GetCell<T>(ColumnIdxOrThrow(pColumnName), pRowIdx, pToVal);
     }
 
     /**
@@ -1142,13 +7157,7 @@ namespace rapidcsv
     template<typename T>
     T GetCell(const size_t pColumnIdx, const std::string& pRowName) const
     {
-      const ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-
-      return GetCell<T>(pColumnIdx, rowIdx);
+      return GetCell<T>(pColumnIdx, RowIdxOrThrow(pRowName));
     }
 
     /**
@@ -1161,482 +7170,634 @@ namespace rapidcsv
     template<typename T>
     T GetCell(const size_t pColumnIdx, const std::string& pRowName, ConvFunc<T> pToVal) const
     {
-      const ssize_t rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      return GetCell<T>(pColumnIdx, RowIdxOrThrow(pRowName), pToVal);
+    }
+
+    /**
+     * @brief   Get column name
+     * @param   pColumnIdx            zero-based column index.
+     * @returns column name.
+     */
+    std::string GetColumnName(const ssize_t pColumnIdx) const
+    {
+      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
+      if (mLabelParams.mColumnNameIdx < 0)
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      std::string str;
+      return std::string(GetCheckedCell(columnIdx, mLabelParams.mColumnNameIdx, str));
+    }
+
+    /**
+     * @brief   Get column names
+     * @returns vector of column names.
+     */
+    std::vector<std::string> GetColumnNames() const
+    {
+      std::vector<std::string> columnNames;
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        const Derived& derived = GetDerived();
+        const size_t rowIdx = CheckedRowIdx(mLabelParams.mColumnNameIdx);
+        std::string str;
+        for (size_t columnIdx = mLabelParams.mRowNameIdx + 1; columnIdx < derived.GetRawRowSize(rowIdx); ++columnIdx)
+        {
+          columnNames.emplace_back(derived.GetRawCell(columnIdx, rowIdx, str));
+        }
+      }
+      return columnNames;
+    }
+
+    /**
+     * @brief   Get row name
+     * @param   pRowIdx               zero-based column index.
+     * @returns row name.
+     */
+    std::string GetRowName(const ssize_t pRowIdx) const
+    {
+      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      std::string str;
+      return std::string(GetCheckedCell(mLabelParams.mRowNameIdx, rowIdx, str));
+    }
+
+    /**
+     * @brief   Get row names
+     * @returns vector of row names.
+     */
+    std::vector<std::string> GetRowNames() const
+    {
+      std::vector<std::string> rownames;
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        std::string str;
+        for (size_t rowIdx = 0; rowIdx < GetDerived().GetRawRowCount(); ++rowIdx)
+        {
+          if (static_cast<ssize_t>(rowIdx) > mLabelParams.mColumnNameIdx)
+          {
+            rownames.emplace_back(GetCheckedCell(mLabelParams.mRowNameIdx, rowIdx, str));
+          }
+        }
       }
+      return rownames;
+    }
 
-      return GetCell<T>(pColumnIdx, rowIdx, pToVal);
+  protected:
+    ReadOnlyDocument(const LabelParams& pLabelParams, const SeparatorParams& pSeparatorParams,
+                     const ConverterParams& pConverterParams, const LineReaderParams& pLineReaderParams)
+      : mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+    {
     }
 
-    /**
-     * @brief   Set cell by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pCell                 cell data.
-     */
-    template<typename T>
-    void SetCell(const size_t pColumnIdx, const size_t pRowIdx, const T& pCell)
+    void SetParams(const LabelParams& pLabelParams, const SeparatorParams& pSeparatorParams,
+                   const ConverterParams& pConverterParams, const LineReaderParams& pLineReaderParams)
     {
-      const size_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      const size_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mLineReaderParams = pLineReaderParams;
+    }
 
-      while ((rowIdx + 1) > GetDataRowCount())
+    size_t CheckedRowIdx(const ssize_t pRowIdx) const
+    {
+      const size_t rowCount = GetDerived().GetRawRowCount();
+      if ((pRowIdx < 0) || (static_cast<size_t>(pRowIdx) >= rowCount))
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        throw std::out_of_range("row index " + std::to_string(pRowIdx) + " >= " +
+                                std::to_string(rowCount) + " (number of rows)");
       }
+      return static_cast<size_t>(pRowIdx);
+    }
 
-      if ((columnIdx + 1) > GetDataColumnCount())
+    size_t CheckedColumnIdx(const ssize_t pColumnIdx, const size_t pRowIdx) const
+    {
+      const size_t rowSize = GetDerived().GetRawRowSize(pRowIdx);
+      if ((pColumnIdx < 0) || (static_cast<size_t>(pColumnIdx) >= rowSize))
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-        {
-          itRow->resize(columnIdx + 1);
-        }
+        throw std::out_of_range("column index " + std::to_string(pColumnIdx) + " >= " +
+                                std::to_string(rowSize) + " (number of columns)");
       }
+      return static_cast<size_t>(pColumnIdx);
+    }
 
-      std::string str;
-      Converter<T> converter(mConverterParams);
-      converter.ToStr(pCell, str);
-      mData.at(rowIdx).at(columnIdx) = str;
+    std::string_view GetCheckedCell(const ssize_t pColumnIdx, const ssize_t pRowIdx, std::string& pStr) const
+    {
+      const size_t rowIdx = CheckedRowIdx(pRowIdx);
+      return GetDerived().GetRawCell(CheckedColumnIdx(pColumnIdx, rowIdx), rowIdx, pStr);
     }
 
-    /**
-     * @brief   Set cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @param   pCell                 cell data.
-     */
-    template<typename T>
-    void SetCell(const std::string& pColumnName, const std::string& pRowName, const T& pCell)
+    std::string_view GetDataCell(const size_t pColumnIdx, const size_t pRowIdx, std::string& pStr) const
+    {
+      return GetCheckedCell(pColumnIdx + (mLabelParams.mRowNameIdx + 1), pRowIdx + (mLabelParams.mColumnNameIdx + 1),
+                            pStr);
+    }
+
+    ssize_t ColumnIdxOrThrow(const std::string& pColumnName) const
     {
       const ssize_t columnIdx = GetColumnIdx(pColumnName);
       if (columnIdx < 0)
       {
         throw std::out_of_range("column not found: " + pColumnName);
       }
+      return columnIdx;
+    }
 
+    ssize_t RowIdxOrThrow(const std::string& pRowName) const
+    {
       const ssize_t rowIdx = GetRowIdx(pRowName);
       if (rowIdx < 0)
       {
         throw std::out_of_range("row not found: " + pRowName);
       }
-
-      SetCell<T>(columnIdx, rowIdx, pCell);
+      return rowIdx;
     }
 
-    /**
-     * @brief   Get column name
-     * @param   pColumnIdx            zero-based column index.
-     * @returns column name.
-     */
-    std::string GetColumnName(const ssize_t pColumnIdx)
-    {
-      const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      if (mLabelParams.mColumnNameIdx < 0)
-      {
-        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
-      }
+    LabelParams mLabelParams;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    LineReaderParams mLineReaderParams;
 
-      return mData.at(mLabelParams.mColumnNameIdx).at(columnIdx);
+  private:
+    const Derived& GetDerived() const
+    {
+      return static_cast<const Derived&>(*this);
     }
 
-    /**
-     * @brief   Set column name
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumnName           column name.
-     */
-    void SetColumnName(size_t pColumnIdx, const std::string& pColumnName)
+    template<typename T, typename F>
+    std::vector<T> ReadColumn(const size_t pColumnIdx, F&& pToVal) const
     {
+      const Derived& derived = GetDerived();
       const ssize_t columnIdx = pColumnIdx + (mLabelParams.mRowNameIdx + 1);
-      mColumnNames[pColumnName] = columnIdx;
-      if (mLabelParams.mColumnNameIdx < 0)
+      std::vector<T> column;
+      std::string str;
+      for (size_t rowIdx = 0; rowIdx < derived.GetRawRowCount(); ++rowIdx)
       {
-        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+        if (static_cast<ssize_t>(rowIdx) > mLabelParams.mColumnNameIdx)
+        {
+          const size_t rowSize = derived.GetRawRowSize(rowIdx);
+          if (columnIdx < static_cast<ssize_t>(rowSize))
+          {
+            T val;
+            pToVal(derived.GetRawCell(static_cast<size_t>(columnIdx), rowIdx, str), val);
+            column.push_back(val);
+          }
+          else
+          {
+            const std::string errStr = "requested column index " +
+              std::to_string(columnIdx - (mLabelParams.mRowNameIdx + 1)) + " >= " +
+              std::to_string(rowSize - (mLabelParams.mRowNameIdx + 1)) +
+              " (number of columns on row index " +
+              std::to_string(rowIdx - (mLabelParams.mColumnNameIdx + 1)) + ")";
+            throw std::out_of_range(errStr);
+          }
+        }
       }
+      return column;
+    }
 
-      // increase table size if necessary:
-      const int rowIdx = mLabelParams.mColumnNameIdx;
-      if (rowIdx >= static_cast<int>(mData.size()))
-      {
-        mData.resize(rowIdx + 1);
-      }
-      auto& row = mData[rowIdx];
-      if (columnIdx >= static_cast<int>(row.size()))
+    template<typename T, typename F>
+    std::vector<T> ReadRow(const size_t pRowIdx, F&& pToVal) const
+    {
+      const Derived& derived = GetDerived();
+      const size_t rowIdx = CheckedRowIdx(pRowIdx + (mLabelParams.mColumnNameIdx + 1));
+      std::vector<T> row;
+      std::string str;
+      for (size_t columnIdx = 0; columnIdx < derived.GetRawRowSize(rowIdx); ++columnIdx)
       {
-        row.resize(columnIdx + 1);
+        if (static_cast<ssize_t>(columnIdx) > mLabelParams.mRowNameIdx)
+        {
+          T val;
+          pToVal(derived.GetRawCell(columnIdx, rowIdx, str), val);
+          row.push_back(val);
+        }
       }
-
-      mData.at(mLabelParams.mColumnNameIdx).at(columnIdx) = pColumnName;
+      return row;
     }
+  };
+
+  /**
+   * @brief     Class representing a read-only CSV document backed by a memory mapped file.
+   *
+   * Cells are stored as offsets into the mapping rather than as strings, so loading a file
+   * needs about 16 bytes per cell in addition to the (shared, page cache backed) mapping.
+   * Quoted cells containing escaped quotes, and cells with embedded carriage returns, are
+   * unescaped lazily when accessed. Parsing behavior is identical to Document for the same
+   * parameters, except that UTF-16 files are not converted. Requires C++17.
+   */
+  class MappedDocument : public ReadOnlyDocument<MappedDocument>
+  {
+    friend class ReadOnlyDocument<MappedDocument>;
 
+  public:
     /**
-     * @brief   Get column names
-     * @returns vector of column names.
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to map.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
      */
-    std::vector<std::string> GetColumnNames()
+    explicit MappedDocument(const std::string& pPath = std::string(),
+                            const LabelParams& pLabelParams = LabelParams(),
+                            const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                            const ConverterParams& pConverterParams = ConverterParams(),
+                            const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : ReadOnlyDocument<MappedDocument>(pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams)
     {
-      if (mLabelParams.mColumnNameIdx >= 0)
+      if (!pPath.empty())
       {
-        return std::vector<std::string>(mData.at(mLabelParams.mColumnNameIdx).begin() +
-                                        (mLabelParams.mRowNameIdx + 1),
-                                        mData.at(mLabelParams.mColumnNameIdx).end());
+        ReadCsv(pPath);
       }
-
-      return std::vector<std::string>();
     }
 
     /**
-     * @brief   Get row name
-     * @param   pRowIdx               zero-based column index.
-     * @returns row name.
+     * @brief   Map and parse a file, replacing any previously loaded data.
+     * @param   pPath                 specifies the path of an existing CSV-file to map.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
      */
-    std::string GetRowName(const ssize_t pRowIdx)
+    void Load(const std::string& pPath,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams())
     {
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-      if (mLabelParams.mRowNameIdx < 0)
-      {
-        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
-      }
+      SetParams(pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams);
+      ReadCsv(pPath);
+    }
 
-      return mData.at(rowIdx).at(mLabelParams.mRowNameIdx);
+    /**
+     * @brief   Clears loaded data and unmaps the file.
+     */
+    void Clear()
+    {
+      mCells.clear();
+      mRowOffsets.assign(1, 0);
+      mColumnNames.clear();
+      mRowNames.clear();
+      mCooked.reset(new CookedCells());
+      mFile.Close();
     }
 
     /**
-     * @brief   Set row name
+     * @brief   Get cell contents without copying. Cells that need unescaping are unescaped on
+     *          first access and cached, so the returned view remains valid until the document is
+     *          cleared, reloaded or destroyed.
+     * @param   pColumnIdx            zero-based column index.
      * @param   pRowIdx               zero-based row index.
-     * @param   pRowName              row name.
+     * @returns view of cell data.
      */
-    void SetRowName(size_t pRowIdx, const std::string& pRowName)
+    std::string_view GetCellView(const size_t pColumnIdx, const size_t pRowIdx) const
     {
-      const ssize_t rowIdx = pRowIdx + (mLabelParams.mColumnNameIdx + 1);
-      mRowNames[pRowName] = rowIdx;
-      if (mLabelParams.mRowNameIdx < 0)
+      const size_t rowIdx = CheckedRowIdx(pRowIdx + (mLabelParams.mColumnNameIdx + 1));
+      const size_t cellIdx = mRowOffsets[rowIdx] + CheckedColumnIdx(pColumnIdx + (mLabelParams.mRowNameIdx + 1), rowIdx);
+      const Cell& cell = mCells[cellIdx];
+      if (cell.mFlags == Cell::Plain)
       {
-        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+        return std::string_view(mFile.Data() + cell.mOffset, cell.mLength);
       }
 
-      // increase table size if necessary:
-      if (rowIdx >= static_cast<int>(mData.size()))
-      {
-        mData.resize(rowIdx + 1);
-      }
-      auto& row = mData[rowIdx];
-      if (mLabelParams.mRowNameIdx >= static_cast<int>(row.size()))
+      std::lock_guard<std::mutex> lock(mCooked->mMutex);
+      auto it = mCooked->mCells.find(cellIdx);
+      if (it == mCooked->mCells.end())
       {
-        row.resize(mLabelParams.mRowNameIdx + 1);
+        std::string str;
+        CellString(cell, str);
+        it = mCooked->mCells.emplace(cellIdx, std::move(str)).first;
       }
-
-      mData.at(rowIdx).at(mLabelParams.mRowNameIdx) = pRowName;
+      return it->second;
     }
 
-    /**
-     * @brief   Get row names
-     * @returns vector of row names.
-     */
-    std::vector<std::string> GetRowNames()
+  private:
+    struct Cell
     {
-      std::vector<std::string> rownames;
-      if (mLabelParams.mRowNameIdx >= 0)
+      enum Flags : unsigned
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-        {
-          if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
-          {
-            rownames.push_back(itRow->at(mLabelParams.mRowNameIdx));
-          }
-        }
-      }
-      return rownames;
-    }
+        Plain = 0,   // [mOffset, mOffset + mLength) is the final cell content
+        Escaped = 1, // unquoted content still containing "" escapes
+        Raw = 2,     // raw field with embedded CR, needs full processing
+      };
 
-  private:
-    void ReadCsv()
+      size_t mOffset;
+      size_t mLength;
+      unsigned mFlags;
+    };
+
+    struct CookedCells
     {
-      std::ifstream stream;
-      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-      stream.open(mPath, std::ios::binary);
-      ReadCsv(stream);
-    }
+      std::mutex mMutex;
+      std::unordered_map<size_t, std::string> mCells;
+    };
 
-    void ReadCsv(std::istream& pStream)
+    void ReadCsv(const std::string& pPath)
     {
       Clear();
-      pStream.seekg(0, std::ios::end);
-      std::streamsize length = pStream.tellg();
-      pStream.seekg(0, std::ios::beg);
+      mFile.Open(pPath);
 
-#ifdef HAS_CODECVT
-      std::vector<char> bom2b(2, '\0');
-      if (length >= 2)
+      size_t offset = 0;
+      static const char bomU8[] = { '\xef', '\xbb', '\xbf' };
+      if ((mFile.Size() >= 3) && (std::memcmp(mFile.Data(), bomU8, 3) == 0))
       {
-        pStream.read(bom2b.data(), 2);
-        pStream.seekg(0, std::ios::beg);
+        offset = 3;
       }
 
-      static const std::vector<char> bomU16le = { '\xff', '\xfe' };
-      static const std::vector<char> bomU16be = { '\xfe', '\xff' };
-      if ((bom2b == bomU16le) || (bom2b == bomU16be))
-      {
-        mIsUtf16 = true;
-        mIsLE = (bom2b == bomU16le);
+      ParseCsv(offset, mFile.Size());
+    }
 
-        std::wifstream wstream;
-        wstream.exceptions(std::wifstream::failbit | std::wifstream::badbit);
-        wstream.open(mPath, std::ios::binary);
-        if (mIsLE)
+    void ParseCsv(const size_t pBegin, const size_t pEnd)
+    {
+      const char* data = mFile.Data();
+      const char separator = mSeparatorParams.mSeparator;
+      const bool quotedLinebreaks = mSeparatorParams.mQuotedLinebreaks;
+      bool quoted = false;
+      size_t rowBegin = mCells.size();
+      int cr = 0;
+      int lf = 0;
+
+      // current cell: [cellBegin, cellEnd) spans all kept characters; characters dropped in
+      // between (carriage returns) make the cell Raw.
+      bool cellEmpty = true;
+      bool cellQuoted = false;
+      bool cellHasCR = false;
+      bool pendingCR = false;
+      size_t cellBegin = 0;
+      size_t cellEnd = 0;
+
+      auto keep = [&](const size_t pPos)
+      {
+        if (cellEmpty)
         {
-          wstream.imbue(std::locale(wstream.getloc(),
-                                    new std::codecvt_utf16<wchar_t, 0x10ffff,
-                                                           static_cast<std::codecvt_mode>(std::consume_header |
-                                                                                          std::little_endian)>));
+          cellEmpty = false;
+          cellQuoted = (data[pPos] == '"');
+          cellBegin = pPos;
         }
-        else
+        else if (pendingCR)
         {
-          wstream.imbue(std::locale(wstream.getloc(),
-                                    new std::codecvt_utf16<wchar_t, 0x10ffff,
-                                                           std::consume_header>));
+          cellHasCR = true;
         }
-        std::wstringstream wss;
-        wss << wstream.rdbuf();
-        std::string utf8 = ToString(wss.str());
-        std::stringstream ss(utf8);
-        ParseCsv(ss, utf8.size());
-      }
-      else
-#endif
+        pendingCR = false;
+        cellEnd = pPos + 1;
+      };
+
+      auto pushCell = [&]()
       {
-        // check for UTF-8 Byte order mark and skip it when found
-        if (length >= 3)
+        mCells.push_back(MakeCell(cellEmpty, cellHasCR, cellBegin, cellEnd));
+        cellEmpty = true;
+        cellHasCR = false;
+        pendingCR = false;
+      };
+
+      for (size_t i = pBegin; i < pEnd; ++i)
+      {
+        const char ch = data[i];
+        if (ch == '"')
         {
-          std::vector<char> bom3b(3, '\0');
-          pStream.read(bom3b.data(), 3);
-          static const std::vector<char> bomU8 = { '\xef', '\xbb', '\xbf' };
-          if (bom3b != bomU8)
+          if (cellEmpty || cellQuoted)
+          {
+            quoted = !quoted;
+          }
+          keep(i);
+        }
+        else if (ch == separator)
+        {
+          if (!quoted)
           {
-            // file does not start with a UTF-8 Byte order mark
-            pStream.seekg(0, std::ios::beg);
+            pushCell();
           }
           else
           {
-            // file did start with a UTF-8 Byte order mark, simply skip it
-            length -= 3;
+            keep(i);
           }
         }
-
-        ParseCsv(pStream, length);
-      }
-    }
-
-    void ParseCsv(std::istream& pStream, std::streamsize p_FileLength)
-    {
-      const std::streamsize bufLength = 64 * 1024;
-      std::vector<char> buffer(bufLength);
-      std::vector<std::string> row;
-      std::string cell;
-      bool quoted = false;
-      int cr = 0;
-      int lf = 0;
-
-      while (p_FileLength > 0)
-      {
-        std::streamsize readLength = std::min<std::streamsize>(p_FileLength, bufLength);
-        pStream.read(buffer.data(), readLength);
-        for (int i = 0; i < readLength; ++i)
+        else if (ch == '\r')
         {
-          if (buffer[i] == '"')
+          if (quotedLinebreaks && quoted)
           {
-            if (cell.empty() || cell[0] == '"')
-            {
-              quoted = !quoted;
-            }
-            cell += buffer[i];
+            keep(i);
           }
-          else if (buffer[i] == mSeparatorParams.mSeparator)
+          else
           {
-            if (!quoted)
-            {
-              row.push_back(Unquote(Trim(cell)));
-              cell.clear();
-            }
-            else
-            {
-              cell += buffer[i];
-            }
+            ++cr;
+            pendingCR = !cellEmpty;
           }
-          else if (buffer[i] == '\r')
+        }
+        else if (ch == '\n')
+        {
+          if (quotedLinebreaks && quoted)
           {
-            if (mSeparatorParams.mQuotedLinebreaks && quoted)
-            {
-              cell += buffer[i];
-            }
-            else
-            {
-              ++cr;
-            }
+            keep(i);
           }
-          else if (buffer[i] == '\n')
+          else
           {
-            if (mSeparatorParams.mQuotedLinebreaks && quoted)
+            ++lf;
+            if (mLineReaderParams.mSkipEmptyLines && (mCells.size() == rowBegin) && cellEmpty)
             {
-              cell += buffer[i];
+              // skip empty line
             }
             else
             {
-              ++lf;
-              if (mLineReaderParams.mSkipEmptyLines && row.empty() && cell.empty())
+              pushCell();
+              if (mLineReaderParams.mSkipCommentLines && IsCommentRow(rowBegin))
               {
-                // skip empty line
+                // skip comment line
+                mCells.resize(rowBegin);
               }
               else
               {
-                row.push_back(Unquote(Trim(cell)));
-
-                if (mLineReaderParams.mSkipCommentLines && !row.at(0).empty() &&
-                    (row.at(0)[0] == mLineReaderParams.mCommentPrefix))
-                {
-                  // skip comment line
-                }
-                else
-                {
-                  mData.push_back(row);
-                }
-
-                cell.clear();
-                row.clear();
-                quoted = false;
+                mRowOffsets.push_back(mCells.size());
               }
+
+              rowBegin = mCells.size();
+              quoted = false;
             }
           }
-          else
-          {
-            cell += buffer[i];
-          }
         }
-        p_FileLength -= readLength;
+        else
+        {
+          keep(i);
+        }
       }
 
       // Handle last line without linebreak
-      if (!cell.empty() || !row.empty())
+      if (!cellEmpty || (mCells.size() != rowBegin))
       {
-        row.push_back(Unquote(Trim(cell)));
-        cell.clear();
-        mData.push_back(row);
-        row.clear();
+        pushCell();
+        mRowOffsets.push_back(mCells.size());
       }
 
       // Assume CR/LF if at least half the linebreaks have CR
       mSeparatorParams.mHasCR = (cr > (lf / 2));
 
       // Set up column labels
+      std::string str;
       if ((mLabelParams.mColumnNameIdx >= 0) &&
-          (static_cast<ssize_t>(mData.size()) > mLabelParams.mColumnNameIdx))
+          (static_cast<ssize_t>(GetRawRowCount()) > mLabelParams.mColumnNameIdx))
       {
-        int i = 0;
-        for (auto& columnName : mData[mLabelParams.mColumnNameIdx])
+        const size_t rowIdx = mLabelParams.mColumnNameIdx;
+        for (size_t columnIdx = 0; columnIdx < GetRawRowSize(rowIdx); ++columnIdx)
         {
-          mColumnNames[columnName] = i++;
+          mColumnNames[CellString(mCells[mRowOffsets[rowIdx] + columnIdx], str)] = columnIdx;
         }
       }
 
       // Set up row labels
       if ((mLabelParams.mRowNameIdx >= 0) &&
-          (static_cast<ssize_t>(mData.size()) >
+          (static_cast<ssize_t>(GetRawRowCount()) >
            (mLabelParams.mColumnNameIdx + 1)))
       {
         int i = 0;
-        for (auto& dataRow : mData)
+        for (size_t rowIdx = 0; rowIdx < GetRawRowCount(); ++rowIdx)
         {
-          if (static_cast<ssize_t>(dataRow.size()) > mLabelParams.mRowNameIdx)
+          if (static_cast<ssize_t>(GetRawRowSize(rowIdx)) > mLabelParams.mRowNameIdx)
           {
-            mRowNames[dataRow[mLabelParams.mRowNameIdx]] = i++;
+            mRowNames[CellString(mCells[mRowOffsets[rowIdx] + mLabelParams.mRowNameIdx], str)] = i++;
           }
         }
       }
     }
 
-    void WriteCsv() const
+    Cell MakeCell(const bool pEmpty, const bool pHasCR, size_t pBegin, size_t pEnd) const
     {
-#ifdef HAS_CODECVT
-      if (mIsUtf16)
+      if (pEmpty)
       {
-        std::stringstream ss;
-        WriteCsv(ss);
-        std::string utf8 = ss.str();
-        std::wstring wstr = ToWString(utf8);
+        return Cell{ 0, 0, Cell::Plain };
+      }
 
-        std::wofstream wstream;
-        wstream.exceptions(std::wofstream::failbit | std::wofstream::badbit);
-        wstream.open(mPath, std::ios::binary | std::ios::trunc);
+      if (pHasCR)
+      {
+        return Cell{ pBegin, pEnd - pBegin, Cell::Raw };
+      }
 
-        if (mIsLE)
+      // Trim and Unquote can be resolved on the offsets directly
+      const char* data = mFile.Data();
+      if (mSeparatorParams.mTrim)
+      {
+        while ((pBegin < pEnd) && isspace(static_cast<unsigned char>(data[pBegin])))
         {
-          wstream.imbue(std::locale(wstream.getloc(),
-                                    new std::codecvt_utf16<wchar_t, 0x10ffff,
-                                                           static_cast<std::codecvt_mode>(std::little_endian)>));
+          ++pBegin;
         }
-        else
+        while ((pEnd > pBegin) && isspace(static_cast<unsigned char>(data[pEnd - 1])))
         {
-          wstream.imbue(std::locale(wstream.getloc(),
-                                    new std::codecvt_utf16<wchar_t, 0x10ffff>));
+          --pEnd;
         }
-
-        wstream << static_cast<wchar_t>(0xfeff);
-        wstream << wstr;
       }
-      else
-#endif
+
+      if (mSeparatorParams.mAutoQuote && ((pEnd - pBegin) >= 2) && (data[pBegin] == '"') &&
+          (data[pEnd - 1] == '"'))
       {
-        std::ofstream stream;
-        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        stream.open(mPath, std::ios::binary | std::ios::trunc);
-        WriteCsv(stream);
+        ++pBegin;
+        --pEnd;
+        const bool escaped = (std::memchr(data + pBegin, '"', pEnd - pBegin) != nullptr);
+        return Cell{ pBegin, pEnd - pBegin, escaped ? Cell::Escaped : Cell::Plain };
       }
+
+      return Cell{ pBegin, pEnd - pBegin, Cell::Plain };
     }
 
-    void WriteCsv(std::ostream& pStream) const
+    const std::string& CellString(const Cell& pCell, std::string& pStr) const
     {
-      for (auto itr = mData.begin(); itr != mData.end(); ++itr)
+      const char* begin = mFile.Data() + pCell.mOffset;
+      const char* end = begin + pCell.mLength;
+      pStr.clear();
+      if (pCell.mFlags == Cell::Plain)
       {
-        for (auto itc = itr->begin(); itc != itr->end(); ++itc)
+        pStr.append(begin, end);
+      }
+      else if (pCell.mFlags == Cell::Escaped)
+      {
+        // unescape quotes in string
+        for (const char* it = begin; it != end; ++it)
         {
-          if (mSeparatorParams.mAutoQuote &&
-              ((itc->find(mSeparatorParams.mSeparator) != std::string::npos) ||
-               (itc->find(' ') != std::string::npos)))
+          pStr += *it;
+          if ((*it == '"') && ((it + 1) != end) && (*(it + 1) == '"'))
           {
-            // escape quotes in string
-            std::string str = *itc;
-            ReplaceString(str, "\"", "\"\"");
-
-            pStream << "\"" << str << "\"";
+            ++it;
           }
-          else
+        }
+      }
+      else
+      {
+        // replay the cell through the parser rules to drop carriage returns
+        bool quoted = false;
+        for (const char* it = begin; it != end; ++it)
+        {
+          if (*it == '"')
           {
-            pStream << *itc;
+            if (pStr.empty() || (pStr[0] == '"'))
+            {
+              quoted = !quoted;
+            }
           }
-
-          if (std::distance(itc, itr->end()) > 1)
+          else if ((*it == '\r') && !(mSeparatorParams.mQuotedLinebreaks && quoted))
           {
-            pStream << mSeparatorParams.mSeparator;
+            continue;
           }
+          pStr += *it;
         }
-        pStream << (mSeparatorParams.mHasCR ? "\r\n" : "\n");
+        pStr = Unquote(Trim(pStr));
       }
+      return pStr;
     }
 
-    size_t GetDataRowCount() const
+    bool IsCommentRow(const size_t pRowBegin) const
     {
-      return mData.size();
+      const Cell& cell = mCells.at(pRowBegin);
+      if (cell.mFlags == Cell::Plain)
+      {
+        return (cell.mLength > 0) && (mFile.Data()[cell.mOffset] == mLineReaderParams.mCommentPrefix);
+      }
+
+      std::string str;
+      CellString(cell, str);
+      return !str.empty() && (str[0] == mLineReaderParams.mCommentPrefix);
     }
 
-    size_t GetDataColumnCount() const
+    size_t GetRawRowCount() const
     {
-      return (mData.size() > 0) ? mData.at(0).size() : 0;
+      return mRowOffsets.size() - 1;
+    }
+
+    size_t GetRawRowSize(const size_t pRowIdx) const
+    {
+      return mRowOffsets[pRowIdx + 1] - mRowOffsets[pRowIdx];
+    }
+
+    std::string_view GetRawCell(const size_t pColumnIdx, const size_t pRowIdx, std::string& pStr) const
+    {
+      const Cell& cell = mCells[mRowOffsets[pRowIdx] + pColumnIdx];
+      if (cell.mFlags == Cell::Plain)
+      {
+        return std::string_view(mFile.Data() + cell.mOffset, cell.mLength);
+      }
+      return CellString(cell, pStr);
+    }
+
+    ssize_t FindColumnName(const std::string& pColumnName) const
+    {
+      const auto it = mColumnNames.find(pColumnName);
+      return (it != mColumnNames.end()) ? static_cast<ssize_t>(it->second) : -1;
+    }
+
+    ssize_t FindRowName(const std::string& pRowName) const
+    {
+      const auto it = mRowNames.find(pRowName);
+      return (it != mRowNames.end()) ? static_cast<ssize_t>(it->second) : -1;
     }
 
-    std::string Trim(const std::string& pStr)
+    std::string Trim(const std::string& pStr) const
     {
       if (mSeparatorParams.mTrim)
       {
@@ -1656,7 +7817,7 @@ namespace rapidcsv
       }
     }
 
-    std::string Unquote(const std::string& pStr)
+    std::string Unquote(const std::string& pStr) const
     {
       if (mSeparatorParams.mAutoQuote && (pStr.size() >= 2) && (pStr.front() == '"') && (pStr.back() == '"'))
       {
@@ -1664,7 +7825,12 @@ namespace rapidcsv
         std::string str = pStr.substr(1, pStr.size() - 2);
 
         // unescape quotes in string
-        ReplaceString(str, "\"\"", "\"");
+        size_t pos = 0;
+        while ((pos = str.find("\"\"", pos)) != std::string::npos)
+        {
+          str.replace(pos, 2, "\"");
+          pos += 1;
+        }
 
         return str;
       }
@@ -1674,47 +7840,223 @@ namespace rapidcsv
       }
     }
 
-#ifdef HAS_CODECVT
-#if defined(_MSC_VER)
-#pragma warning (disable: 4996)
-#endif
-    static std::string ToString(const std::wstring& pWStr)
+  private:
+    MappedFile mFile;
+    std::vector<Cell> mCells;
+    std::vector<size_t> mRowOffsets = std::vector<size_t>(1, 0);
+    std::map<std::string, size_t> mColumnNames;
+    std::map<std::string, size_t> mRowNames;
+    std::unique_ptr<CookedCells> mCooked = std::unique_ptr<CookedCells>(new CookedCells());
+  };
+
+  /**
+   * @brief     Class representing a read-only CSV document whose rows, cells and label indexes
+   *            are allocated from a single monotonic memory arena.
+   *
+   * Cells are std::pmr::string and rows std::pmr::vector, all drawing from an arena that grows in
+   * large blocks, so loading a file makes a few large allocations instead of one or more per
+   * cell. Clearing or reloading the document releases the whole arena in one step. Parsing
+   * behavior is identical to Document for the same parameters, and UTF-16 files are converted to
+   * UTF-8. Requires C++17.
+   */
+  class PooledDocument : public ReadOnlyDocument<PooledDocument>
+  {
+    friend class ReadOnlyDocument<PooledDocument>;
+
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to load.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     */
+    explicit PooledDocument(const std::string& pPath = std::string(),
+                            const LabelParams& pLabelParams = LabelParams(),
+                            const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                            const ConverterParams& pConverterParams = ConverterParams(),
+                            const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : ReadOnlyDocument<PooledDocument>(pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams)
     {
-      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.to_bytes(pWStr);
+      if (!pPath.empty())
+      {
+        ReadCsv(pPath);
+      }
     }
 
-    static std::wstring ToWString(const std::string& pStr)
+    PooledDocument(const PooledDocument&) = delete;
+    PooledDocument& operator=(const PooledDocument&) = delete;
+
+    /**
+     * @brief   Read and parse a file, replacing any previously loaded data.
+     * @param   pPath                 specifies the path of an existing CSV-file to load.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     */
+    void Load(const std::string& pPath,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams())
     {
-      return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>{ }.from_bytes(pStr);
+      SetParams(pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams);
+      ReadCsv(pPath);
     }
-#if defined(_MSC_VER)
-#pragma warning (default: 4996)
-#endif
-#endif
 
-    static void ReplaceString(std::string& pStr, const std::string& pSearch, const std::string& pReplace)
+    /**
+     * @brief   Clears loaded data and releases the memory arena.
+     */
+    void Clear()
+    {
+      // containers must not refer to arena memory once it is released
+      mData = Rows(mResource.get());
+      mColumnNames = LabelMap(mResource.get());
+      mRowNames = LabelMap(mResource.get());
+      mResource->release();
+    }
+
+    /**
+     * @brief   Get cell contents without copying. The returned view remains valid until the
+     *          document is cleared, reloaded or destroyed.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns view of cell data.
+     */
+    std::string_view GetCellView(const size_t pColumnIdx, const size_t pRowIdx) const
+    {
+      // cells are stored unescaped, so the scratch string is never referenced by the view
+      std::string str;
+      return GetDataCell(pColumnIdx, pRowIdx, str);
+    }
+
+  private:
+    typedef std::pmr::vector<std::pmr::vector<std::pmr::string>> Rows;
+    typedef std::pmr::map<std::pmr::string, size_t, std::less<>> LabelMap;
+
+    void ReadCsv(const std::string& pPath)
+    {
+      Clear();
+
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(pPath, std::ios::binary);
+      stream.seekg(0, std::ios::end);
+      std::streamsize length = stream.tellg();
+      stream.seekg(0, std::ios::beg);
+
+      char bom[3] = { 0, 0, 0 };
+      stream.read(bom, std::min<std::streamsize>(length, 3));
+      std::unique_ptr<Utf16Transcoder> transcoder;
+      std::streamsize offset = 0;
+      if ((length >= 3) && (std::memcmp(bom, "\xef\xbb\xbf", 3) == 0))
+      {
+        offset = 3;
+      }
+      else if ((length >= 2) && ((std::memcmp(bom, "\xff\xfe", 2) == 0) || (std::memcmp(bom, "\xfe\xff", 2) == 0)))
+      {
+        transcoder.reset(new Utf16Transcoder(bom[0] == '\xff'));
+        offset = 2;
+      }
+
+      stream.seekg(offset, std::ios::beg);
+      length -= offset;
+
+      const std::streamsize bufLength = 64 * 1024;
+      std::vector<char> buffer(bufLength);
+      std::string utf8;
+      BasicRowParser<Rows> parser(mSeparatorParams, mLineReaderParams, mData);
+      while (length > 0)
+      {
+        const std::streamsize readLength = std::min<std::streamsize>(length, bufLength);
+        stream.read(buffer.data(), readLength);
+        if (transcoder)
+        {
+          utf8.clear();
+          transcoder->Transcode(buffer.data(), static_cast<size_t>(readLength), utf8);
+          parser.Parse(utf8.data(), utf8.size());
+        }
+        else
+        {
+          parser.Parse(buffer.data(), static_cast<size_t>(readLength));
+        }
+        length -= readLength;
+      }
+
+      if (transcoder)
+      {
+        utf8.clear();
+        transcoder->Finish(utf8);
+        parser.Parse(utf8.data(), utf8.size());
+      }
+
+      parser.Finish();
+      SetupLabels();
+    }
+
+    void SetupLabels()
     {
-      size_t pos = 0;
+      if ((mLabelParams.mColumnNameIdx >= 0) &&
+          (static_cast<ssize_t>(mData.size()) > mLabelParams.mColumnNameIdx))
+      {
+        size_t i = 0;
+        for (const auto& columnName : mData[mLabelParams.mColumnNameIdx])
+        {
+          mColumnNames[columnName] = i++;
+        }
+      }
 
-      while ((pos = pStr.find(pSearch, pos)) != std::string::npos)
+      if ((mLabelParams.mRowNameIdx >= 0) &&
+          (static_cast<ssize_t>(mData.size()) > (mLabelParams.mColumnNameIdx + 1)))
       {
-        pStr.replace(pos, pSearch.size(), pReplace);
-        pos += pReplace.size();
+        size_t i = 0;
+        for (const auto& dataRow : mData)
+        {
+          if (static_cast<ssize_t>(dataRow.size()) > mLabelParams.mRowNameIdx)
+          {
+            mRowNames[dataRow[mLabelParams.mRowNameIdx]] = i++;
+          }
+        }
       }
     }
 
+    size_t GetRawRowCount() const
+    {
+      return mData.size();
+    }
+
+    size_t GetRawRowSize(const size_t pRowIdx) const
+    {
+      return mData[pRowIdx].size();
+    }
+
+    std::string_view GetRawCell(const size_t pColumnIdx, const size_t pRowIdx, std::string& /*pStr*/) const
+    {
+      return mData[pRowIdx][pColumnIdx];
+    }
+
+    ssize_t FindColumnName(const std::string& pColumnName) const
+    {
+      const auto it = mColumnNames.find(std::string_view(pColumnName));
+      return (it != mColumnNames.end()) ? static_cast<ssize_t>(it->second) : -1;
+    }
+
+    ssize_t FindRowName(const std::string& pRowName) const
+    {
+      const auto it = mRowNames.find(std::string_view(pRowName));
+      return (it != mRowNames.end()) ? static_cast<ssize_t>(it->second) : -1;
+    }
+
   private:
-    std::string mPath;
-    LabelParams mLabelParams;
-    SeparatorParams mSeparatorParams;
-    ConverterParams mConverterParams;
-    LineReaderParams mLineReaderParams;
-    std::vector<std::vector<std::string>> mData;
-    std::map<std::string, size_t> mColumnNames;
-    std::map<std::string, size_t> mRowNames;
-#ifdef HAS_CODECVT
-    bool mIsUtf16 = false;
-    bool mIsLE = false;
-#endif
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> mResource =
+      std::unique_ptr<std::pmr::monotonic_buffer_resource>(new std::pmr::monotonic_buffer_resource(64 * 1024));
+    Rows mData = Rows(mResource.get());
+    LabelMap mColumnNames = LabelMap(mResource.get());
+    LabelMap mRowNames = LabelMap(mResource.get());
   };
+#endif
 }
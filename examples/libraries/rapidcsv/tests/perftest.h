@@ -1,6 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 namespace perftest
 {
@@ -68,4 +77,328 @@ namespace perftest
     double lastspan;
     std::vector<double> spans;
   };
+
+  // Synthetic CSV data specification
+  struct CsvSpec
+  {
+    std::string name;
+    uint64_t bytes = 10 * 1024 * 1024;
+    size_t columns = 10;
+    double numericRate = 1.0; // fraction of columns holding numbers, the leftmost ones
+    double quoteRate = 0.0; // fraction of string cells quoted, holding a separator and an escaped quote
+    bool crlf = false;
+    uint64_t seed = 1;
+  };
+
+  namespace detail
+  {
+    // splitmix64, deterministic across platforms unlike std distributions
+    inline uint64_t NextRandom(uint64_t& pState)
+    {
+      uint64_t z = (pState += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    inline void AppendWord(std::string& pOut, uint64_t& pState)
+    {
+      const size_t len = 4 + static_cast<size_t>(NextRandom(pState) % 9);
+      for (size_t i = 0; i < len; ++i)
+      {
+        pOut += static_cast<char>('a' + (NextRandom(pState) % 26));
+      }
+    }
+  }
+
+  inline size_t GetNumericColumnCount(const CsvSpec& pSpec)
+  {
+    return static_cast<size_t>((static_cast<double>(pSpec.columns) * pSpec.numericRate) + 0.5);
+  }
+
+  // Write a CSV file with a header row, of at least pSpec.bytes, written in chunks so that
+  // the file size is not limited by memory. Returns the number of data rows.
+  inline size_t GenerateCsv(const std::string& pPath, const CsvSpec& pSpec)
+  {
+    std::ofstream out(pPath, std::ios::binary | std::ios::trunc);
+    const char* eol = pSpec.crlf ? "\r\n" : "\n";
+    const size_t numericCount = GetNumericColumnCount(pSpec);
+    const uint64_t quoteThreshold = static_cast<uint64_t>(pSpec.quoteRate * 1000000.0);
+    uint64_t state = pSpec.seed;
+
+    std::string chunk;
+    for (size_t col = 0; col < pSpec.columns; ++col)
+    {
+      chunk += ((col == 0) ? "" : ",") + std::string((col < numericCount) ? "n" : "s") + std::to_string(col);
+    }
+    chunk += eol;
+
+    uint64_t written = 0;
+    size_t rows = 0;
+    const size_t chunkSize = 1024 * 1024;
+    while ((written + chunk.size()) < pSpec.bytes)
+    {
+      for (size_t col = 0; col < pSpec.columns; ++col)
+      {
+        if (col != 0)
+        {
+          chunk += ',';
+        }
+
+        const uint64_t rnd = detail::NextRandom(state);
+        if (col < numericCount)
+        {
+          // alternate integers and decimals with two fraction digits
+          const long long value = static_cast<long long>(rnd % 2000000) - 1000000;
+          chunk += std::to_string(value);
+          if ((col % 2) != 0)
+          {
+            chunk += '.';
+            chunk += static_cast<char>('0' + ((rnd >> 32) % 10));
+            chunk += static_cast<char>('0' + ((rnd >> 40) % 10));
+          }
+        }
+        else if (((rnd >> 32) % 1000000) < quoteThreshold)
+        {
+          chunk += '"';
+          detail::AppendWord(chunk, state);
+          chunk += ", \"\"";
+          detail::AppendWord(chunk, state);
+          chunk += "\"\"\"";
+        }
+        else
+        {
+          detail::AppendWord(chunk, state);
+        }
+      }
+      chunk += eol;
+      ++rows;
+
+      if (chunk.size() >= chunkSize)
+      {
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        written += chunk.size();
+        chunk.clear();
+      }
+    }
+
+    out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    return rows;
+  }
+
+  // Reset the peak resident set size, where supported (Linux)
+  inline void ResetPeakRss()
+  {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+  }
+
+  // Peak resident set size in KB since start or ResetPeakRss(), or 0 if unsupported
+  inline long long GetPeakRssKb()
+  {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+      if (line.compare(0, 6, "VmHWM:") == 0)
+      {
+        return std::stoll(line.substr(6));
+      }
+    }
+    return 0;
+#elif defined(__APPLE__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<long long>(usage.ru_maxrss / 1024);
+#elif defined(__unix__)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<long long>(usage.ru_maxrss);
+#else
+    return 0;
+#endif
+  }
+
+  // Number of operator new calls, counted when PERFTEST_COUNT_ALLOCS is defined
+  inline std::atomic<uint64_t>& AllocCount()
+  {
+    static std::atomic<uint64_t> count(0);
+    return count;
+  }
 }
+
+#ifdef PERFTEST_COUNT_ALLOCS
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace perftest
+{
+  namespace detail
+  {
+    // Counted allocation backing all replaced operator new overloads, nullptr on failure
+    inline void* CountedAlloc(std::size_t pSize, std::size_t pAlign)
+    {
+      ++AllocCount();
+      if (pSize == 0)
+      {
+        pSize = 1;
+      }
+
+      if (pAlign <= alignof(std::max_align_t))
+      {
+        return std::malloc(pSize);
+      }
+
+#if defined(_WIN32)
+      return _aligned_malloc(pSize, pAlign);
+#else
+      void* ptr = nullptr;
+      return (posix_memalign(&ptr, pAlign, pSize) == 0) ? ptr : nullptr;
+#endif
+    }
+
+    inline void* CountedAllocOrThrow(std::size_t pSize, std::size_t pAlign)
+    {
+      void* ptr = CountedAlloc(pSize, pAlign);
+      if (ptr == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+
+      return ptr;
+    }
+
+    inline void CountedFree(void* pPtr, std::size_t pAlign)
+    {
+#if defined(_WIN32)
+      if (pAlign > alignof(std::max_align_t))
+      {
+        _aligned_free(pPtr);
+        return;
+      }
+#else
+      (void)pAlign;
+#endif
+      std::free(pPtr);
+    }
+  }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t pSize)
+{
+  return perftest::detail::CountedAllocOrThrow(pSize, 0);
+}
+
+void* operator new[](std::size_t pSize)
+{
+  return perftest::detail::CountedAllocOrThrow(pSize, 0);
+}
+
+void* operator new(std::size_t pSize, const std::nothrow_t&) noexcept
+{
+  return perftest::detail::CountedAlloc(pSize, 0);
+}
+
+void* operator new[](std::size_t pSize, const std::nothrow_t&) noexcept
+{
+  return perftest::detail::CountedAlloc(pSize, 0);
+}
+
+void operator delete(void* pPtr) noexcept
+{
+  perftest::detail::CountedFree(pPtr, 0);
+}
+
+void operator delete[](void* pPtr) noexcept
+{
+  perftest::detail::CountedFree(pPtr, 0);
+}
+
+void operator delete(void* pPtr, std::size_t) noexcept
+{
+  perftest::detail::CountedFree(pPtr, 0);
+}
+
+void operator delete[](void* pPtr, std::size_t) noexcept
+{
+  perftest::detail::CountedFree(pPtr, 0);
+}
+
+void operator delete(void* pPtr, const std::nothrow_t&) noexcept
+{
+  perftest::detail::CountedFree(pPtr, 0);
+}
+
+void operator delete[](void* pPtr, const std::nothrow_t&) noexcept
+{
+  perftest::detail::CountedFree(pPtr, 0);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t pSize, std::align_val_t pAlign)
+{
+  return perftest::detail::CountedAllocOrThrow(pSize, static_cast<std::size_t>(pAlign));
+}
+
+void* operator new[](std::size_t pSize, std::align_val_t pAlign)
+{
+  return perftest::detail::CountedAllocOrThrow(pSize, static_cast<std::size_t>(pAlign));
+}
+
+void* operator new(std::size_t pSize, std::align_val_t pAlign, const std::nothrow_t&) noexcept
+{
+  return perftest::detail::CountedAlloc(pSize, static_cast<std::size_t>(pAlign));
+}
+
+void* operator new[](std::size_t pSize, std::align_val_t pAlign, const std::nothrow_t&) noexcept
+{
+  return perftest::detail::CountedAlloc(pSize, static_cast<std::size_t>(pAlign));
+}
+
+void operator delete(void* pPtr, std::align_val_t pAlign) noexcept
+{
+  perftest::detail::CountedFree(pPtr, static_cast<std::size_t>(pAlign));
+}
+
+void operator delete[](void* pPtr, std::align_val_t pAlign) noexcept
+{
+  perftest::detail::CountedFree(pPtr, static_cast<std::size_t>(pAlign));
+}
+
+void operator delete(void* pPtr, std::size_t, std::align_val_t pAlign) noexcept
+{
+  perftest::detail::CountedFree(pPtr, static_cast<std::size_t>(pAlign));
+}
+
+void operator delete[](void* pPtr, std::size_t, std::align_val_t pAlign) noexcept
+{
+  perftest::detail::CountedFree(pPtr, static_cast<std::size_t>(pAlign));
+}
+
+void operator delete(void* pPtr, std::align_val_t pAlign, const std::nothrow_t&) noexcept
+{
+  perftest::detail::CountedFree(pPtr, static_cast<std::size_t>(pAlign));
+}
+
+void operator delete[](void* pPtr, std::align_val_t pAlign, const std::nothrow_t&) noexcept
+{
+  perftest::detail::CountedFree(pPtr, static_cast<std::size_t>(pAlign));
+}
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
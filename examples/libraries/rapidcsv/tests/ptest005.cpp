@@ -0,0 +1,44 @@
+// ptest005.cpp - repeated get data by column and cell from loaded document
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    perftest::Timer timer;
+    rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0));
+    double sum = 0;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      const std::vector<double>& column = doc.GetColumn<double>("Close");
+      for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); rowIdx += 16)
+      {
+        sum += doc.GetCell<double>("Close", rowIdx);
+      }
+
+      timer.Stop();
+
+      sum += column.at(0);
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,67 @@
+// ptest006.cpp - numeric conversion of msft.csv cells scaled to 10M rows, std::sto* vs Converter
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    rapidcsv::Document doc("../tests/msft.csv");
+    const std::vector<std::string> closeCells = doc.GetColumn<std::string>("Close");
+    const std::vector<std::string> volumeCells = doc.GetColumn<std::string>("Volume");
+
+    const size_t rowCount = 10 * 1000 * 1000;
+    std::vector<std::string> closes;
+    std::vector<std::string> volumes;
+    closes.reserve(rowCount);
+    volumes.reserve(rowCount);
+    for (size_t i = 0; i < rowCount; ++i)
+    {
+      closes.push_back(closeCells.at(i % closeCells.size()));
+      volumes.push_back(volumeCells.at(i % volumeCells.size()));
+    }
+
+    rapidcsv::ConverterParams converterParams;
+    rapidcsv::Converter<double> doubleConverter(converterParams);
+    rapidcsv::Converter<long long> longLongConverter(converterParams);
+    std::vector<double> doubles(rowCount);
+    std::vector<long long> longLongs(rowCount);
+
+    perftest::Timer stoTimer;
+    perftest::Timer converterTimer;
+    for (int i = 0; i < 3; ++i)
+    {
+      stoTimer.Start();
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        doubles[rowIdx] = std::stod(closes[rowIdx]);
+        longLongs[rowIdx] = std::stoll(volumes[rowIdx]);
+      }
+      stoTimer.Stop();
+
+      converterTimer.Start();
+      for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+      {
+        doubleConverter.ToVal(closes[rowIdx], doubles[rowIdx]);
+        longLongConverter.ToVal(volumes[rowIdx], longLongs[rowIdx]);
+      }
+      converterTimer.Stop();
+    }
+
+    std::cout << "std::stod / std::stoll\n";
+    stoTimer.ReportMedian();
+    std::cout << "Converter::ToVal\n";
+    converterTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
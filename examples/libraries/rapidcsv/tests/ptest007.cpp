@@ -0,0 +1,42 @@
+// ptest007.cpp - stream selected columns row by row without loading document
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    perftest::Timer timer;
+    double sum = 0;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      rapidcsv::RowReader reader("../tests/msft.csv", rapidcsv::LabelParams(0, 0));
+      reader.SelectColumns(std::vector<std::string>({ "Close" }));
+      while (reader.ReadRow())
+      {
+        sum += reader.GetCell<double>(0);
+      }
+
+      timer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,69 @@
+// ptest008.cpp - write msft.csv rows scaled to 1M rows, document save vs row writer
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    rapidcsv::Document src("../tests/msft.csv", rapidcsv::LabelParams(0, -1));
+    const std::vector<std::string> dates = src.GetColumn<std::string>("Date");
+    const std::vector<double> closes = src.GetColumn<double>("Close");
+    const std::vector<long long> volumes = src.GetColumn<long long>("Volume");
+    const size_t rowCount = 1000000;
+
+    perftest::Timer docTimer;
+    perftest::Timer writerTimer;
+    for (int i = 0; i < 3; ++i)
+    {
+      docTimer.Start();
+      {
+        rapidcsv::Document doc("", rapidcsv::LabelParams(0, -1));
+        doc.SetColumnName(0, "Date");
+        doc.SetColumnName(1, "Close");
+        doc.SetColumnName(2, "Volume");
+        for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+        {
+          const size_t srcIdx = rowIdx % dates.size();
+          doc.SetCell<std::string>(0, rowIdx, dates[srcIdx]);
+          doc.SetCell<double>(1, rowIdx, closes[srcIdx]);
+          doc.SetCell<long long>(2, rowIdx, volumes[srcIdx]);
+        }
+        doc.Save(path);
+      }
+      docTimer.Stop();
+
+      writerTimer.Start();
+      {
+        rapidcsv::RowWriter writer(path);
+        writer.WriteRow("Date", "Close", "Volume");
+        for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+        {
+          const size_t srcIdx = rowIdx % dates.size();
+          writer.WriteRow(dates[srcIdx], closes[srcIdx], volumes[srcIdx]);
+        }
+      }
+      writerTimer.Stop();
+    }
+
+    std::cout << "Document::Save\n";
+    docTimer.ReportMedian();
+    std::cout << "RowWriter\n";
+    writerTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,89 @@
+// ptest009.cpp - load 3 of 200 columns and a tenth of the rows, full load vs filtered load
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const size_t columnCount = 200;
+    const size_t rowCount = 20000;
+    std::string csv = "id";
+    for (size_t columnIdx = 1; columnIdx < columnCount; ++columnIdx)
+    {
+      csv += ",col" + std::to_string(columnIdx);
+    }
+    csv += "\n";
+
+    for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+    {
+      csv += std::to_string(rowIdx);
+      for (size_t columnIdx = 1; columnIdx < columnCount; ++columnIdx)
+      {
+        csv += ((columnIdx % 4) == 0) ? ",\"text, " + std::to_string(columnIdx) + "\"" :
+               "," + std::to_string(rowIdx * columnIdx);
+      }
+      csv += "\n";
+    }
+
+    unittest::WriteFile(path, csv);
+
+    perftest::Timer fullTimer;
+    perftest::Timer filterTimer;
+    double sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      fullTimer.Start();
+      {
+        rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1));
+        const std::vector<double> values = doc.GetColumn<double>("col7");
+        for (size_t rowIdx = 0; rowIdx < values.size(); rowIdx += 10)
+        {
+          sum += values[rowIdx];
+        }
+      }
+      fullTimer.Stop();
+
+      filterTimer.Start();
+      {
+        rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(),
+                               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                               rapidcsv::ParallelParams(),
+                               rapidcsv::FilterParams({ "id", "col7", "col150" },
+                                                      [](const std::vector<std::string>& pRow)
+        {
+          return pRow.at(0).back() == '0';
+        }));
+        const std::vector<double> values = doc.GetColumn<double>("col7");
+        for (const auto& value : values)
+        {
+          sum += value;
+        }
+      }
+      filterTimer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    std::cout << "Full load\n";
+    fullTimer.ReportMedian();
+    std::cout << "FilterParams load\n";
+    filterTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
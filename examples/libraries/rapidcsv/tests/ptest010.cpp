@@ -0,0 +1,68 @@
+// ptest010.cpp - reload msft.csv scaled to 1M rows and get column, parse vs binary sidecar
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+  std::string sidecarPath = path + ".rcsv";
+
+  try
+  {
+    rapidcsv::Document src("../tests/msft.csv", rapidcsv::LabelParams(0, -1));
+    {
+      rapidcsv::RowWriter writer(path);
+      writer.WriteRow(src.GetColumnNames());
+      for (size_t rowIdx = 0; rowIdx < 1000000; ++rowIdx)
+      {
+        writer.WriteRow(src.GetRow<std::string>(rowIdx % src.GetRowCount()));
+      }
+    }
+
+    perftest::Timer parseTimer;
+    perftest::Timer sidecarTimer;
+    double sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      parseTimer.Start();
+      {
+        rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1));
+        sum += doc.GetColumn<double>("Close").back();
+      }
+      parseTimer.Stop();
+
+      // first iteration parses and writes the sidecar
+      sidecarTimer.Start();
+      {
+        rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(),
+                               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                               rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                               rapidcsv::SidecarParams(true));
+        sum += doc.GetColumn<double>("Close").back();
+      }
+      sidecarTimer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    std::cout << "Parse\n";
+    parseTimer.ReportMedian();
+    std::cout << "Sidecar\n";
+    sidecarTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(sidecarPath);
+
+  return rv;
+}
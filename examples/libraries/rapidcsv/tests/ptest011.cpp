@@ -0,0 +1,62 @@
+// ptest011.cpp - load chi-utf16.csv data rows scaled to 50K copies and get column
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    // split the UTF-16LE source after its header line, and repeat the data rows
+    const std::string src = unittest::ReadFile("../tests/chi-utf16.csv");
+    const std::string crlf("\r\0\n\0", 4);
+    size_t headerEnd = src.find(crlf);
+    while ((headerEnd != std::string::npos) && ((headerEnd % 2) != 0))
+    {
+      headerEnd = src.find(crlf, headerEnd + 1);
+    }
+    if (headerEnd == std::string::npos)
+    {
+      throw std::runtime_error("no header line in ../tests/chi-utf16.csv");
+    }
+    headerEnd += crlf.size();
+
+    std::string csv = src.substr(0, headerEnd);
+    const std::string rows = src.substr(headerEnd);
+    csv.reserve(headerEnd + (rows.size() * 50000));
+    for (int i = 0; i < 50000; ++i)
+    {
+      csv += rows;
+    }
+    unittest::WriteFile(path, csv);
+
+    perftest::Timer timer;
+    size_t sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      timer.Start();
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(';'));
+      sum += doc.GetColumn<std::string>("description").back().size();
+      timer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    timer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,71 @@
+// ptest012.cpp - load chi-utf16.csv data rows scaled to 50K copies and get column, document vs pooled document
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    // split the UTF-16LE source after its header line, and repeat the data rows
+    const std::string src = unittest::ReadFile("../tests/chi-utf16.csv");
+    const std::string crlf("\r\0\n\0", 4);
+    size_t headerEnd = src.find(crlf);
+    while ((headerEnd % 2) != 0)
+    {
+      headerEnd = src.find(crlf, headerEnd + 1);
+    }
+    headerEnd += crlf.size();
+
+    std::string csv = src.substr(0, headerEnd);
+    const std::string rows = src.substr(headerEnd);
+    csv.reserve(headerEnd + (rows.size() * 50000));
+    for (int i = 0; i < 50000; ++i)
+    {
+      csv += rows;
+    }
+    unittest::WriteFile(path, csv);
+
+    perftest::Timer docTimer;
+    perftest::Timer pooledTimer;
+    size_t sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      docTimer.Start();
+      {
+        rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(';'));
+        sum += doc.GetColumn<std::string>("description").back().size();
+      }
+      docTimer.Stop();
+
+      pooledTimer.Start();
+      {
+        rapidcsv::PooledDocument doc(path, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(';'));
+        sum += doc.GetColumn<std::string>("description").back().size();
+      }
+      pooledTimer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    std::cout << "Document\n";
+    docTimer.ReportMedian();
+    std::cout << "PooledDocument\n";
+    pooledTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,67 @@
+// ptest013.cpp - append rows to msft.csv data scaled to 100 copies, refresh vs full load
+
+#include <fstream>
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const std::string src = unittest::ReadFile("../tests/msft.csv");
+    const size_t headerEnd = src.find('\n') + 1;
+    const std::string rows = src.substr(headerEnd);
+    std::string csv = src.substr(0, headerEnd);
+    for (int i = 0; i < 100; ++i)
+    {
+      csv += rows;
+    }
+    unittest::WriteFile(path, csv);
+
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+
+    perftest::Timer refreshTimer;
+    perftest::Timer loadTimer;
+    size_t sum = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+      {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "3000-01-" << i << ",1,2,3,4,5,6\n";
+      }
+
+      refreshTimer.Start();
+      sum += doc.Refresh();
+      refreshTimer.Stop();
+
+      loadTimer.Start();
+      {
+        rapidcsv::Document loadDoc(path, rapidcsv::LabelParams(0, 0));
+        sum += loadDoc.GetRowCount();
+      }
+      loadTimer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    std::cout << "Refresh\n";
+    refreshTimer.ReportMedian();
+    std::cout << "Document\n";
+    loadTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
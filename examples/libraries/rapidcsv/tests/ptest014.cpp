@@ -0,0 +1,77 @@
+// ptest014.cpp - group 2M rows by account and aggregate, hand-written loop vs serial and parallel group by
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "Account,Amount\n";
+    for (int i = 0; i < 2000000; ++i)
+    {
+      csv += "acc" + std::to_string((i * 7919LL) % 10000) + "," + std::to_string((i % 2001) - 1000) + ".25\n";
+    }
+
+    std::istringstream stream(csv);
+    rapidcsv::Document doc(stream, rapidcsv::LabelParams(0, -1));
+    const std::vector<rapidcsv::Aggregate> aggregates =
+    {
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Sum, "Amount"),
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Mean, "Amount"),
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Max, "Amount"),
+    };
+
+    perftest::Timer loopTimer;
+    perftest::Timer serialTimer;
+    perftest::Timer parallelTimer;
+    double sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      loopTimer.Start();
+      {
+        std::vector<std::string> accounts;
+        std::vector<double> amounts;
+        doc.ConvertColumn<std::string>("Account", accounts);
+        doc.ConvertColumn<double>("Amount", amounts);
+        std::map<std::string, std::pair<double, size_t>> groups;
+        for (size_t rowIdx = 0; rowIdx < accounts.size(); ++rowIdx)
+        {
+          std::pair<double, size_t>& group = groups[accounts[rowIdx]];
+          group.first += amounts[rowIdx];
+          ++group.second;
+        }
+        sum += groups.begin()->second.first;
+      }
+      loopTimer.Stop();
+
+      serialTimer.Start();
+      sum += doc.GroupBy(std::vector<std::string>({ "Account" }), aggregates, 1).mValues.at(0).at(0);
+      serialTimer.Stop();
+
+      parallelTimer.Start();
+      sum += doc.GroupBy(std::vector<std::string>({ "Account" }), aggregates).mValues.at(0).at(0);
+      parallelTimer.Stop();
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    std::cout << "Loop\n";
+    loopTimer.ReportMedian();
+    std::cout << "GroupBy serial\n";
+    serialTimer.ReportMedian();
+    std::cout << "GroupBy parallel\n";
+    parallelTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,80 @@
+// ptest015.cpp - 100K point lookups and 1K range scans in 500K rows, row names vs hash and sorted index
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    std::string csv = "Id,Key,Value\n";
+    for (int i = 0; i < 500000; ++i)
+    {
+      csv += "id" + std::to_string(i) + ",key" + std::to_string((i * 7919LL) % 500000) + "," +
+        std::to_string((i * 37) % 100000) + "\n";
+    }
+
+    std::istringstream stream(csv);
+    rapidcsv::Document doc(stream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(0));
+
+    perftest::Timer rowNameTimer;
+    perftest::Timer buildTimer;
+    perftest::Timer hashTimer;
+    perftest::Timer sortedTimer;
+    size_t sum = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+      rowNameTimer.Start();
+      for (int j = 0; j < 100000; ++j)
+      {
+        sum += static_cast<size_t>(doc.GetRowIdx("id" + std::to_string((j * 13) % 500000)));
+      }
+      rowNameTimer.Stop();
+
+      buildTimer.Start();
+      doc.CreateHashIndex("Key");
+      doc.CreateSortedIndex<int>("Value");
+      buildTimer.Stop();
+
+      hashTimer.Start();
+      for (int j = 0; j < 100000; ++j)
+      {
+        sum += doc.FindRows("Key", "key" + std::to_string((j * 13) % 500000)).size();
+      }
+      hashTimer.Stop();
+
+      sortedTimer.Start();
+      for (int j = 0; j < 1000; ++j)
+      {
+        sum += doc.FindRowRange<int>("Value", j * 50, (j * 50) + 99).size();
+      }
+      sortedTimer.Stop();
+
+      doc.DropIndexes("Key");
+      doc.DropIndexes("Value");
+    }
+
+    // dummy usage of variables
+    (void) sum;
+
+    std::cout << "Row names\n";
+    rowNameTimer.ReportMedian();
+    std::cout << "Index build\n";
+    buildTimer.ReportMedian();
+    std::cout << "Hash index\n";
+    hashTimer.ReportMedian();
+    std::cout << "Sorted index\n";
+    sortedTimer.ReportMedian();
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
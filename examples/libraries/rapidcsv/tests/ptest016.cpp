@@ -0,0 +1,180 @@
+// ptest016.cpp - throughput of synthetic data scenarios, parse MB/s, conversion rows/s, peak RSS and allocations
+//
+// usage: ptest016 [size_mb] [results.csv]
+//
+// Generates one file of size_mb (default 10) per scenario and writes one result row per scenario
+// as CSV to results.csv, or stdout if not specified, for regression tracking. Files up to 256 MB
+// are loaded into a Document, larger ones are streamed with RowReader so that memory use does not
+// grow with the file size.
+
+#define PERFTEST_COUNT_ALLOCS
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+static perftest::CsvSpec MakeSpec(const std::string& pName, const size_t pColumns, const double pNumericRate,
+                                  const double pQuoteRate, const bool pCrlf)
+{
+  perftest::CsvSpec spec;
+  spec.name = pName;
+  spec.columns = pColumns;
+  spec.numericRate = pNumericRate;
+  spec.quoteRate = pQuoteRate;
+  spec.crlf = pCrlf;
+  return spec;
+}
+
+int main(int argc, char* argv[])
+{
+  int rv = 0;
+
+  const uint64_t sizeMb = (argc > 1) ? std::stoull(argv[1]) : 10;
+  const std::string resultsPath = (argc > 2) ? argv[2] : "";
+  const bool stream = (sizeMb > 256);
+  const int runs = stream ? 1 : 3;
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const std::vector<perftest::CsvSpec> specs =
+    {
+      MakeSpec("numeric", 10, 1.0, 0.0, false),
+      MakeSpec("mixed", 10, 0.5, 0.1, false),
+      MakeSpec("quoted", 10, 0.2, 0.5, true),
+      MakeSpec("wide", 100, 0.8, 0.0, false),
+      MakeSpec("narrow", 2, 0.5, 0.0, true),
+    };
+
+    rapidcsv::Document results(std::string(), rapidcsv::LabelParams(0, -1));
+    const std::vector<std::string> labels =
+    {
+      "scenario", "reader", "bytes", "rows", "columns", "numeric_rate", "quote_rate", "line_ending",
+      "parse_mb_s", "convert_rows_s", "peak_rss_kb", "parse_allocs", "convert_allocs"
+    };
+    for (size_t col = 0; col < labels.size(); ++col)
+    {
+      results.SetColumnName(col, labels.at(col));
+    }
+
+    for (perftest::CsvSpec spec : specs)
+    {
+      spec.bytes = sizeMb * 1024 * 1024;
+      const size_t rows = perftest::GenerateCsv(path, spec);
+      const size_t numericCount = perftest::GetNumericColumnCount(spec);
+      uint64_t bytes = 0;
+      {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        bytes = static_cast<uint64_t>(file.tellg());
+      }
+
+      perftest::Timer parseTimer;
+      perftest::Timer convertTimer;
+      long long peakRssKb = 0;
+      uint64_t parseAllocs = 0;
+      uint64_t convertAllocs = 0;
+      for (int i = 0; i < runs; ++i)
+      {
+        perftest::ResetPeakRss();
+        const uint64_t startAllocs = perftest::AllocCount();
+
+        if (stream)
+        {
+          // parse only, then parse and convert, as rows are not kept between passes
+          parseTimer.Start();
+          {
+            rapidcsv::RowReader reader(path, rapidcsv::LabelParams(0, -1));
+            while (reader.ReadRow())
+            {
+            }
+          }
+          parseTimer.Stop();
+
+          const uint64_t parsedAllocs = perftest::AllocCount();
+
+          double sum = 0;
+          convertTimer.Start();
+          {
+            rapidcsv::RowReader reader(path, rapidcsv::LabelParams(0, -1));
+            while (reader.ReadRow())
+            {
+              for (size_t col = 0; col < numericCount; ++col)
+              {
+                sum += reader.GetCell<double>(col);
+              }
+            }
+          }
+          convertTimer.Stop();
+
+          // dummy usage of variables
+          (void) sum;
+
+          peakRssKb = std::max(peakRssKb, perftest::GetPeakRssKb());
+          parseAllocs = parsedAllocs - startAllocs;
+          const uint64_t passAllocs = perftest::AllocCount() - parsedAllocs;
+          convertAllocs = (passAllocs > parseAllocs) ? (passAllocs - parseAllocs) : 0;
+        }
+        else
+        {
+          parseTimer.Start();
+          rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1));
+          parseTimer.Stop();
+
+          const uint64_t parsedAllocs = perftest::AllocCount();
+
+          double sum = 0;
+          convertTimer.Start();
+          for (size_t col = 0; col < numericCount; ++col)
+          {
+            sum += doc.GetColumn<double>(col).back();
+          }
+          convertTimer.Stop();
+
+          // dummy usage of variables
+          (void) sum;
+
+          peakRssKb = std::max(peakRssKb, perftest::GetPeakRssKb());
+          parseAllocs = parsedAllocs - startAllocs;
+          convertAllocs = perftest::AllocCount() - parsedAllocs;
+        }
+      }
+
+      const double parseMbs = (static_cast<double>(bytes) / (1024.0 * 1024.0)) / parseTimer.GetMedianDurationSec();
+
+      // a streamed conversion pass includes parsing, which is timed separately by the first pass
+      const double convertSec = stream ?
+        std::max(convertTimer.GetMedianDurationSec() - parseTimer.GetMedianDurationSec(), 1e-9) :
+        convertTimer.GetMedianDurationSec();
+      const double convertRowsSec = (numericCount > 0) ? (static_cast<double>(rows) / convertSec) : 0.0;
+
+      std::cout << "Scenario " << spec.name << " (" << rows << " rows)\n";
+      parseTimer.ReportMedian();
+
+      const std::vector<std::string> row =
+      {
+        spec.name, stream ? "row_reader" : "document", std::to_string(bytes), std::to_string(rows), std::to_string(spec.columns),
+        std::to_string(spec.numericRate), std::to_string(spec.quoteRate), spec.crlf ? "crlf" : "lf",
+        std::to_string(parseMbs), std::to_string(convertRowsSec), std::to_string(peakRssKb),
+        std::to_string(parseAllocs), std::to_string(convertAllocs)
+      };
+      results.InsertRow(results.GetRowCount(), row);
+    }
+
+    if (resultsPath.empty())
+    {
+      results.Save(std::cout);
+    }
+    else
+    {
+      results.Save(resultsPath);
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,69 @@
+// test087.cpp - read cell values from memory mapped document
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\xef\xbb\xbf-,A,B,C\n"
+    "1,3,\"9\",81\n"
+    "2,4,\"say \"\"hi\"\"\",256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  std::string emptypath = unittest::TempPath();
+  unittest::WriteFile(emptypath, "");
+
+  try
+  {
+    rapidcsv::MappedDocument doc(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+
+    unittest::ExpectEqual(int, doc.GetCell<int>(0, 0), 3);
+    unittest::ExpectEqual(int, doc.GetCell<int>(1, 0), 9);
+    unittest::ExpectEqual(int, doc.GetCell<int>("C", "2"), 256);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "2"), "say \"hi\"");
+
+    unittest::ExpectEqual(std::string, std::string(doc.GetCellView(1, 0)), "9");
+    unittest::ExpectEqual(std::string, std::string(doc.GetCellView(1, 1)), "say \"hi\"");
+    unittest::ExpectTrue(doc.GetCellView(1, 1).data() == doc.GetCellView(1, 1).data());
+
+    std::vector<int> column = doc.GetColumn<int>("A");
+    unittest::ExpectEqual(size_t, column.size(), 2);
+    unittest::ExpectEqual(int, column.at(0), 3);
+    unittest::ExpectEqual(int, column.at(1), 4);
+
+    std::vector<std::string> row = doc.GetRow<std::string>("1");
+    unittest::ExpectEqual(size_t, row.size(), 3);
+    unittest::ExpectEqual(std::string, row.at(2), "81");
+
+    unittest::ExpectEqual(std::string, doc.GetColumnName(0), "A");
+    unittest::ExpectEqual(std::string, doc.GetRowName(1), "2");
+
+    ExpectException(doc.GetCell<int>(1, 1), std::invalid_argument);
+    ExpectException(doc.GetCell<int>(0, 2), std::out_of_range);
+    ExpectException(doc.GetCell<int>("D", "1"), std::out_of_range);
+
+    rapidcsv::MappedDocument emptydoc(emptypath);
+    unittest::ExpectEqual(size_t, emptydoc.GetColumnCount(), 0);
+    unittest::ExpectEqual(size_t, emptydoc.GetRowCount(), 0);
+
+    ExpectException(rapidcsv::MappedDocument("nonexistent.csv"), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(emptypath);
+
+  return rv;
+}
@@ -0,0 +1,57 @@
+// test088.cpp - memory mapped document matches document for all parameter combinations
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::vector<std::string> csvs = unittest::FixtureCsvs();
+  csvs.push_back(
+    "\"h1\";\"h 2\";h3\n"
+    "r1;\"1;2\";\" \"\n"
+    "\r\n"
+    "r2;;\"quoted\nbreak\";x\n"
+    "\n\n"
+    "#r3;1;2\n");
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    for (const auto& csv : csvs)
+    {
+      unittest::WriteFile(path, csv);
+      const char separator = (csv.find(';') != std::string::npos) ? ';' : ',';
+      for (const auto& params : unittest::FixtureLoadParams(unittest::FixtureLabelParams(), separator))
+      {
+        rapidcsv::Document doc(path, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                               params.mLineReaderParams);
+        rapidcsv::MappedDocument mdoc(path, params.mLabelParams, params.mSeparatorParams,
+                                      rapidcsv::ConverterParams(), params.mLineReaderParams);
+        unittest::ExpectEqualDocuments(mdoc, doc, params.mLabelParams);
+
+        // cell views of the mapping
+        for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+        {
+          const std::vector<std::string> row = doc.GetRow<std::string>(rowIdx);
+          for (size_t columnIdx = 0; columnIdx < row.size(); ++columnIdx)
+          {
+            unittest::ExpectEqual(std::string, std::string(mdoc.GetCellView(columnIdx, rowIdx)),
+                                  row.at(columnIdx));
+          }
+        }
+      }
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,45 @@
+// test089.cpp - quotes, separators and linebreaks at every offset across scanner blocks
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv;
+  std::vector<std::string> expected;
+  for (size_t len = 0; len < 300; ++len)
+  {
+    const std::string pad(len, 'x');
+    csv += pad + ",\"" + pad + ",\"\"\n" + pad + "\",end" + (((len % 2) == 0) ? "\r\n" : "\n");
+    expected.push_back(pad + ",\"\n" + pad);
+  }
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1),
+                           rapidcsv::SeparatorParams(',', false, rapidcsv::sPlatformHasCR, true));
+
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), expected.size());
+    for (size_t rowIdx = 0; rowIdx < expected.size(); ++rowIdx)
+    {
+      unittest::ExpectEqual(size_t, doc.GetRow<std::string>(rowIdx).size(), 3);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, rowIdx), std::string(rowIdx, 'x'));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(1, rowIdx), expected.at(rowIdx));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(2, rowIdx), "end");
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,85 @@
+// test090.cpp - parallel load matches serial load for all chunk boundaries
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::vector<std::string> csvs = unittest::FixtureCsvs();
+  csvs.push_back(
+    "-,A,B\n"
+    "1,\"\n\n\n\n\n\n\n\n\",x\n"
+    "2,\"a\nb\nc\nd\",\"e\nf\"\n"
+    "3,\"\n\",\"\n\"\n\n");
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    for (const auto& csv : csvs)
+    {
+      unittest::WriteFile(path, csv);
+      for (const auto& params : unittest::FixtureLoadParams(unittest::FixtureLabelParams()))
+      {
+        rapidcsv::Document doc(path, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                               params.mLineReaderParams);
+        for (size_t threadCount = 2; threadCount <= csv.size(); threadCount += 3)
+        {
+          rapidcsv::Document pdoc(path, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                                  params.mLineReaderParams, rapidcsv::ParallelParams(threadCount, 1));
+          unittest::ExpectEqualDocuments(pdoc, doc, params.mLabelParams);
+        }
+      }
+    }
+
+    // chunk boundaries guessed inside quoted cells yield rows the filter cannot convert, which
+    // must not fail the load as the chunks are parsed again from the preceding row
+    std::string quoted = "id,text,num\n";
+    for (int i = 0; i < 200; ++i)
+    {
+      quoted += std::to_string(i) + ",\"first line\nsecond, line\nthird line\n\"," + std::to_string(i) + "\n";
+    }
+    unittest::WriteFile(path, quoted);
+
+    const rapidcsv::SeparatorParams quotedSeparatorParams(',', false, false, true);
+    const rapidcsv::FilterParams filterParams(std::vector<std::string>(), [](const std::vector<std::string>& pRow)
+    {
+      return std::stoi(pRow.at(2)) >= 0;
+    });
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, -1), quotedSeparatorParams,
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(),
+                           filterParams);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 200);
+    for (size_t threadCount = 2; threadCount <= 32; ++threadCount)
+    {
+      rapidcsv::Document pdoc(path, rapidcsv::LabelParams(0, -1), quotedSeparatorParams,
+                              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                              rapidcsv::ParallelParams(threadCount, 1), filterParams);
+      unittest::ExpectTrue(pdoc.GetColumn<std::string>("text") == doc.GetColumn<std::string>("text"));
+      unittest::ExpectTrue(pdoc.GetColumn<int>("num") == doc.GetColumn<int>("num"));
+
+      std::istringstream stream(quoted);
+      rapidcsv::Document sdoc(stream, rapidcsv::LabelParams(0, -1), quotedSeparatorParams,
+                              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                              rapidcsv::ParallelParams(threadCount, 1), filterParams);
+      unittest::ExpectTrue(sdoc.GetColumn<int>("num") == doc.GetColumn<int>("num"));
+    }
+
+    // errors in chunks starting on a row are still thrown
+    unittest::WriteFile(path, quoted + "x,y\n");
+    ExpectException(rapidcsv::Document(path, rapidcsv::LabelParams(0, -1), quotedSeparatorParams,
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                       rapidcsv::ParallelParams(4, 1), filterParams), std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
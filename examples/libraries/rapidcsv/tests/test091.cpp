@@ -0,0 +1,66 @@
+// test091.cpp - cached typed columns are invalidated by modifications, and viewable as span
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+
+    std::span<const int> a = doc.GetColumnSpan<int>("A");
+    unittest::ExpectEqual(size_t, a.size(), 2);
+    unittest::ExpectEqual(int, a[0], 3);
+    unittest::ExpectEqual(int, a[1], 4);
+    unittest::ExpectTrue(doc.GetColumnSpan<int>(0).data() == a.data());
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4 }));
+    unittest::ExpectEqual(double, doc.GetColumnSpan<double>("A")[1], 4.0);
+
+    rapidcsv::Document copy = doc;
+
+    doc.SetCell<int>("A", "2", 5);
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "2"), 5);
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 5 }));
+    unittest::ExpectEqual(double, doc.GetColumnSpan<double>("A")[1], 5.0);
+    unittest::ExpectTrue(copy.GetColumn<int>("A") == std::vector<int>({ 3, 4 }));
+
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 9, 16 }));
+    doc.SetColumn<int>("B", std::vector<int>({ 10, 17, 26 }));
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 10, 17, 26 }));
+    unittest::ExpectTrue(doc.GetColumn<std::string>("A") == std::vector<std::string>({ "3", "5", "" }));
+
+    doc.RemoveRow(0);
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 17, 26 }));
+
+    unittest::ExpectTrue(doc.GetColumn<std::string>("C") == std::vector<std::string>({ "256", "" }));
+    doc.RemoveColumn("A");
+    unittest::ExpectTrue(doc.GetColumn<int>(0) == std::vector<int>({ 17, 26 }));
+
+    doc.InsertRow<int>(0, std::vector<int>({ 1, 2 }), "0");
+    unittest::ExpectTrue(doc.GetColumn<int>(0) == std::vector<int>({ 1, 17, 26 }));
+
+    doc.Load(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4 }));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
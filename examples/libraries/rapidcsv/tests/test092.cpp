@@ -0,0 +1,113 @@
+// test092.cpp - from_chars based conversion matches std::sto* conversion, and bulk column conversion
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+template<typename T, typename F>
+static void CompareConversion(const std::string& pStr, F pStoFunc)
+{
+  rapidcsv::ConverterParams converterParams;
+  rapidcsv::Converter<T> converter(converterParams);
+
+  std::string expected;
+  try
+  {
+    expected = "value " + std::to_string(static_cast<T>(pStoFunc(pStr)));
+  }
+  catch (const std::invalid_argument&)
+  {
+    expected = "invalid_argument";
+  }
+  catch (const std::out_of_range&)
+  {
+    expected = "out_of_range";
+  }
+
+  std::string actual;
+  try
+  {
+    T val;
+    converter.ToVal(pStr, val);
+    actual = "value " + std::to_string(val);
+  }
+  catch (const std::invalid_argument&)
+  {
+    actual = "invalid_argument";
+  }
+  catch (const std::out_of_range&)
+  {
+    actual = "out_of_range";
+  }
+
+  unittest::ExpectEqual(std::string, actual + " (" + pStr + ")", expected + " (" + pStr + ")");
+}
+
+int main()
+{
+  int rv = 0;
+
+  const std::vector<std::string> strs =
+  {
+    "0", "7", "-7", "+7", "007", " 7", "7 ", "7abc", "abc", "", "-", "1.5", "-1.5e3", ".5", "5.",
+    "2147483647", "2147483648", "-2147483649", "4294967295", "4294967296", "-1",
+    "9223372036854775807", "9223372036854775808", "18446744073709551616",
+    "1e38", "1e39", "1e308", "1e309", "1e-320", "1e-400", "0x1p3", "inf", "-INF", "nan", "64.620003",
+  };
+
+  std::string csv =
+    "-,A,B\n"
+    "1,3,9.5\n"
+    "2,,x\n"
+    "3,-4,1e2\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    for (const auto& str : strs)
+    {
+      CompareConversion<int>(str, [](const std::string& pStr) { return std::stoi(pStr); });
+      CompareConversion<long>(str, [](const std::string& pStr) { return std::stol(pStr); });
+      CompareConversion<long long>(str, [](const std::string& pStr) { return std::stoll(pStr); });
+      CompareConversion<unsigned>(str, [](const std::string& pStr) { return std::stoul(pStr); });
+      CompareConversion<unsigned long>(str, [](const std::string& pStr) { return std::stoul(pStr); });
+      CompareConversion<unsigned long long>(str, [](const std::string& pStr) { return std::stoull(pStr); });
+      CompareConversion<float>(str, [](const std::string& pStr) { return std::stof(pStr); });
+      CompareConversion<double>(str, [](const std::string& pStr) { return std::stod(pStr); });
+      CompareConversion<long double>(str, [](const std::string& pStr) { return std::stold(pStr); });
+    }
+
+    rapidcsv::ConverterParams converterParams;
+    rapidcsv::Converter<int> converter(converterParams);
+    int val = 42;
+    unittest::ExpectTrue(converter.TryToVal(std::string_view("12;34").substr(0, 2), val) == std::errc());
+    unittest::ExpectEqual(int, val, 12);
+    unittest::ExpectTrue(converter.TryToVal("x", val) == std::errc::invalid_argument);
+    unittest::ExpectTrue(converter.TryToVal("99999999999", val) == std::errc::result_out_of_range);
+    unittest::ExpectEqual(int, val, 12);
+
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(true, 0.0, -1));
+    std::vector<int> ints(16, 5);
+    doc.ConvertColumn<int>("A", ints);
+    unittest::ExpectTrue(ints == std::vector<int>({ 3, -1, -4 }));
+    std::vector<double> doubles;
+    doc.ConvertColumn<double>(1, doubles);
+    unittest::ExpectTrue(doubles == std::vector<double>({ 9.5, 0.0, 100.0 }));
+
+    rapidcsv::Document doc2(path, rapidcsv::LabelParams(0, 0));
+    ExpectException(doc2.ConvertColumn<int>("A", ints), std::invalid_argument);
+    ExpectException(doc2.ConvertColumn<int>(2, ints), std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,100 @@
+// test093.cpp - streaming row reader with labels, projection and rows spanning read buffers
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\xef\xbb\xbf-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+    rapidcsv::RowReader reader(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectTrue(reader.GetColumnNames() == doc.GetColumnNames());
+    unittest::ExpectEqual(ssize_t, reader.GetColumnIdx("B"), 1);
+    unittest::ExpectEqual(ssize_t, reader.GetColumnIdx("D"), -1);
+
+    size_t rowIdx = 0;
+    while (reader.ReadRow())
+    {
+      unittest::ExpectEqual(size_t, reader.GetRowIdx(), rowIdx);
+      unittest::ExpectEqual(std::string, reader.GetRowName(), doc.GetRowName(rowIdx));
+      unittest::ExpectTrue(reader.GetRow() == doc.GetRow<std::string>(rowIdx));
+      unittest::ExpectTrue(reader.GetRow<int>() == doc.GetRow<int>(rowIdx));
+      unittest::ExpectEqual(int, reader.GetCell<int>("C"), doc.GetCell<int>("C", rowIdx));
+      ++rowIdx;
+    }
+    unittest::ExpectEqual(size_t, rowIdx, doc.GetRowCount());
+    unittest::ExpectTrue(!reader.ReadRow());
+
+    rapidcsv::RowReader projReader(path, rapidcsv::LabelParams(0, 0));
+    projReader.SelectColumns(std::vector<std::string>({ "C", "A" }));
+    unittest::ExpectEqual(ssize_t, projReader.GetColumnIdx("A"), 1);
+    unittest::ExpectEqual(ssize_t, projReader.GetColumnIdx("B"), -1);
+    unittest::ExpectTrue(projReader.ReadRow());
+    unittest::ExpectTrue(projReader.GetRow() == std::vector<std::string>({ "81", "3" }));
+    unittest::ExpectEqual(int, projReader.GetCell<int>("A"), 3);
+    unittest::ExpectTrue(projReader.ReadRow());
+    unittest::ExpectTrue(projReader.GetRow<long>() == std::vector<long>({ 256, 4 }));
+    unittest::ExpectTrue(!projReader.ReadRow());
+    ExpectException(projReader.SelectColumns(std::vector<std::string>({ "D" })), std::out_of_range);
+
+    rapidcsv::RowReader badReader(path, rapidcsv::LabelParams(0, 0));
+    badReader.SelectColumns(std::vector<size_t>({ 3 }));
+    ExpectException(badReader.ReadRow(), std::out_of_range);
+
+    std::istringstream sstream("x;y\n\"a;\nb\";c\n");
+    rapidcsv::RowReader streamReader(sstream, rapidcsv::LabelParams(-1, -1),
+                                     rapidcsv::SeparatorParams(';', false, rapidcsv::sPlatformHasCR, true));
+    unittest::ExpectTrue(streamReader.GetColumnNames().empty());
+    std::vector<std::vector<std::string>> rows;
+    for (const auto& row : streamReader)
+    {
+      rows.push_back(row);
+    }
+    unittest::ExpectTrue(rows == std::vector<std::vector<std::string>>({ { "x", "y" }, { "a;\nb", "c" } }));
+    ExpectException(streamReader.GetRowName(), std::out_of_range);
+
+    // rows and quoted linebreaks straddling the reader's internal buffer boundaries
+    std::string bigCsv = "id,text,num\n";
+    for (int i = 0; i < 20000; ++i)
+    {
+      bigCsv += std::to_string(i) + ",\"line " + std::string(i % 13, 'x') + "\r\nnext, " + std::to_string(i) +
+        "\"," + std::to_string(i * 3) + "\r\n";
+    }
+    unittest::WriteFile(path, bigCsv);
+
+    const rapidcsv::SeparatorParams separatorParams(',', false, rapidcsv::sPlatformHasCR, true);
+    rapidcsv::Document bigDoc(path, rapidcsv::LabelParams(), separatorParams);
+    rapidcsv::RowReader bigReader(path, rapidcsv::LabelParams(), separatorParams);
+    rowIdx = 0;
+    for (const auto& row : bigReader)
+    {
+      unittest::ExpectTrue(row == bigDoc.GetRow<std::string>(rowIdx));
+      ++rowIdx;
+    }
+    unittest::ExpectEqual(size_t, rowIdx, 20000);
+    unittest::ExpectEqual(std::string, bigDoc.GetCell<std::string>("text", 19999), "line xxxxx\r\nnext, 19999");
+
+    ExpectException(rapidcsv::RowReader(path + ".missing"), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
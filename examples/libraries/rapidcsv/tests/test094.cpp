@@ -0,0 +1,47 @@
+// test094.cpp - streaming row reader used as a C++20 input range
+
+#include <ranges>
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+    "3,5,25,625\n"
+    "4,6,36,1296\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    static_assert(std::ranges::input_range<rapidcsv::RowReader>);
+
+    rapidcsv::RowReader reader(path, rapidcsv::LabelParams(0, 0));
+    reader.SelectColumns(std::vector<size_t>({ 2 }));
+    std::vector<std::string> values;
+    for (const auto& row : reader
+         | std::views::filter([](const std::vector<std::string>& pRow) { return pRow.at(0).size() > 2; })
+         | std::views::take(2))
+    {
+      values.push_back(row.at(0));
+    }
+    unittest::ExpectTrue(values == std::vector<std::string>({ "256", "625" }));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
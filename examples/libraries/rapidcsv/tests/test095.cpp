@@ -0,0 +1,95 @@
+// test095.cpp - row writer output matches document save, including quoting and buffer flushes
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const std::vector<rapidcsv::SeparatorParams> separatorParams =
+    {
+      rapidcsv::SeparatorParams(),
+      rapidcsv::SeparatorParams(';', false, true),
+      rapidcsv::SeparatorParams(',', false, false, false, false),
+    };
+
+    const std::vector<std::vector<std::string>> rows =
+    {
+      { "Symbol", "Close", "Volume" },
+      { "MSFT", "64.62", "21705200" },
+      { "a b", "x;y", "q\"uo\"te" },
+      { "", "\"", "  sp,ace  " },
+      { "one", "", "" },
+      { "long" + std::string(40, 'x') + ",", "tail" + std::string(40, 'y'), "" },
+    };
+
+    for (const auto& separatorParam : separatorParams)
+    {
+      rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1), separatorParam);
+      for (size_t rowIdx = 0; rowIdx < rows.size(); ++rowIdx)
+      {
+        doc.SetRow<std::string>(rowIdx, rows.at(rowIdx));
+      }
+      std::ostringstream expected;
+      doc.Save(expected);
+
+      std::ostringstream out;
+      {
+        rapidcsv::RowWriter writer(out, separatorParam);
+        for (const auto& row : rows)
+        {
+          writer.WriteRow(row);
+        }
+      }
+      unittest::ExpectEqual(std::string, out.str(), expected.str());
+    }
+
+    {
+      rapidcsv::RowWriter writer(path);
+      writer.WriteRow("Symbol", "Close", "Volume", "Grade");
+      writer.WriteRow("MSFT", 64.62, 21705200, 'A');
+      writer.WriteRow(std::string("AAPL"), 0.5f, -7L, 'B');
+      writer.WriteCell(std::vector<int>({ 1, 2 }).size());
+      writer.WriteCell(1e21);
+      writer.EndRow();
+      writer.WriteRow(std::vector<double>({ 1.0, 2.5, 1.0 / 3.0 }));
+      writer.WriteRow();
+      writer.Flush();
+    }
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path),
+                          "Symbol,Close,Volume,Grade\n"
+                          "MSFT,64.62,21705200,A\n"
+                          "AAPL,0.5,-7,B\n"
+                          "2,1e+21\n"
+                          "1,2.5,0.333333\n"
+                          "\n");
+
+    // output larger than the internal buffer is written in chunks
+    {
+      rapidcsv::RowWriter writer(path, rapidcsv::SeparatorParams(',', false, false));
+      writer.WriteRow("-", "A", "B");
+      for (int i = 0; i < 100000; ++i)
+      {
+        writer.WriteRow(i, i * 0.5, "text " + std::to_string(i));
+      }
+    }
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 100000);
+    unittest::ExpectEqual(double, doc.GetCell<double>("A", "99999"), 49999.5);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "12345"), "text 12345");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,66 @@
+// test096.cpp - to_chars based number formatting matches std::ostream formatting
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+template<typename T>
+static void CompareFormatting(const T pVal)
+{
+  rapidcsv::ConverterParams converterParams;
+  rapidcsv::Converter<T> converter(converterParams);
+
+  std::ostringstream expected;
+  expected << pVal;
+
+  std::string actual;
+  converter.ToStr(pVal, actual);
+
+  unittest::ExpectEqual(std::string, actual, expected.str());
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    const std::vector<long double> vals =
+    {
+      0.0L, -0.0L, 1.0L, -7.0L, 0.5L, 64.620003L, 1.0L / 3.0L, 123456.0L, 1234567.0L, 999999.5L,
+      1e-4L, 1e-5L, 1.5e-7L, 1e21L, 3.4e38L, 1e300L, -2.5e-300L, 2147483647.0L,
+      std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+    };
+
+    for (const auto& val : vals)
+    {
+      CompareFormatting<float>(static_cast<float>(val));
+      CompareFormatting<double>(static_cast<double>(val));
+      CompareFormatting<long double>(val);
+    }
+
+    const std::vector<long long> ints =
+    {
+      0, 1, -1, 42, 2147483647LL, -2147483647LL - 1, 9223372036854775807LL, -9223372036854775807LL - 1,
+    };
+
+    for (const auto& val : ints)
+    {
+      CompareFormatting<int>(static_cast<int>(val));
+      CompareFormatting<long>(static_cast<long>(val));
+      CompareFormatting<long long>(val);
+      CompareFormatting<unsigned>(static_cast<unsigned>(val));
+      CompareFormatting<unsigned long>(static_cast<unsigned long>(val));
+      CompareFormatting<unsigned long long>(static_cast<unsigned long long>(val));
+    }
+
+    CompareFormatting<char>('x');
+    CompareFormatting<char>(',');
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
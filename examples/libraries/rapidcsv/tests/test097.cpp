@@ -0,0 +1,151 @@
+// test097.cpp - column selection and row filter applied during load, serial and parallel
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static bool RowFilter(const std::vector<std::string>& pRow)
+{
+  return pRow.empty() || (pRow.back().size() != 1);
+}
+
+static void CompareFiltered(const std::string& pPath, const rapidcsv::LabelParams& pLabelParams,
+                            const rapidcsv::SeparatorParams& pSeparatorParams,
+                            const rapidcsv::LineReaderParams& pLineReaderParams,
+                            const std::vector<std::string>& pColumnNames, const size_t pThreadCount)
+{
+  // expected rows from unfiltered load
+  rapidcsv::Document raw(pPath, rapidcsv::LabelParams(-1, -1), pSeparatorParams, rapidcsv::ConverterParams(),
+                         pLineReaderParams);
+  const size_t labelRowCount = static_cast<size_t>(pLabelParams.mColumnNameIdx + 1);
+  std::vector<std::string> header;
+  if ((labelRowCount > 0) && (raw.GetRowCount() >= labelRowCount))
+  {
+    header = raw.GetRow<std::string>(labelRowCount - 1);
+  }
+
+  std::vector<std::vector<std::string>> expected;
+  for (size_t rowIdx = 0; rowIdx < raw.GetRowCount(); ++rowIdx)
+  {
+    const std::vector<std::string> row = raw.GetRow<std::string>(rowIdx);
+    std::vector<std::string> projected;
+    for (size_t columnIdx = 0; columnIdx < row.size(); ++columnIdx)
+    {
+      if (pColumnNames.empty() || (static_cast<ssize_t>(columnIdx) <= pLabelParams.mRowNameIdx) ||
+          ((columnIdx < header.size()) &&
+           (std::find(pColumnNames.begin(), pColumnNames.end(), header[columnIdx]) != pColumnNames.end())))
+      {
+        projected.push_back(row[columnIdx]);
+      }
+    }
+
+    if ((rowIdx < labelRowCount) || RowFilter(projected))
+    {
+      expected.push_back(projected);
+    }
+  }
+
+  rapidcsv::Document doc(pPath, pLabelParams, pSeparatorParams, rapidcsv::ConverterParams(),
+                         pLineReaderParams, rapidcsv::ParallelParams(pThreadCount, 1),
+                         rapidcsv::FilterParams(pColumnNames, RowFilter));
+
+  const size_t firstColumnIdx = static_cast<size_t>(pLabelParams.mRowNameIdx + 1);
+  const size_t dataRowCount = (expected.size() > labelRowCount) ? (expected.size() - labelRowCount) : 0;
+  unittest::ExpectEqual(size_t, doc.GetRowCount(), dataRowCount);
+  for (size_t rowIdx = 0; rowIdx < dataRowCount; ++rowIdx)
+  {
+    const std::vector<std::string>& row = expected.at(rowIdx + labelRowCount);
+    const std::vector<std::string> cells(row.begin() + std::min(firstColumnIdx, row.size()), row.end());
+    unittest::ExpectTrue(doc.GetRow<std::string>(rowIdx) == cells);
+  }
+
+  if ((labelRowCount > 0) && (expected.size() >= labelRowCount))
+  {
+    const std::vector<std::string>& row = expected.at(labelRowCount - 1);
+    const std::vector<std::string> cells(row.begin() + std::min(firstColumnIdx, row.size()), row.end());
+    unittest::ExpectTrue(doc.GetColumnNames() == cells);
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::vector<std::string> csvs = unittest::FixtureCsvs();
+  csvs.push_back(
+    "-,A,B,C\n"
+    "6,\"p,q\",\"r,s\",\"t\nu\"\n"
+    "7,a,b,c\n");
+  csvs.push_back(
+    "-,A,B,C\n"
+    "1,\"\n\n\n\n\n\n\n\n\",x,y\n"
+    "2,\"a\nb\nc\nd\",\"e\nf\"\n"
+    "3,\"\n\",\"\n\"\n\n");
+
+  std::vector<rapidcsv::LabelParams> labelParams = unittest::FixtureLabelParams();
+  labelParams.push_back(rapidcsv::LabelParams(1, 1));
+
+  const std::vector<std::vector<std::string>> columnNames =
+  {
+    {},
+    { "A" },
+    { "C", "A" },
+  };
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    for (const auto& csv : csvs)
+    {
+      unittest::WriteFile(path, csv);
+      for (const auto& params : unittest::FixtureLoadParams(labelParams))
+      {
+        for (const auto& names : columnNames)
+        {
+          if ((params.mLabelParams.mColumnNameIdx != 0) && !names.empty())
+          {
+            continue;
+          }
+
+          CompareFiltered(path, params.mLabelParams, params.mSeparatorParams, params.mLineReaderParams, names, 1);
+          for (size_t threadCount = 2; threadCount <= csv.size(); threadCount += 5)
+          {
+            CompareFiltered(path, params.mLabelParams, params.mSeparatorParams, params.mLineReaderParams, names,
+                            threadCount);
+          }
+        }
+      }
+    }
+
+    unittest::WriteFile(path, "-,A,B,C\n1,3,9,81\n2,4,16,256\n3,5,25,625\n");
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(),
+                           rapidcsv::FilterParams({ "C", "A" }, [](const std::vector<std::string>& pRow)
+    {
+      return std::stoi(pRow.at(1)) > 3;
+    }));
+    unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "C" }));
+    unittest::ExpectTrue(doc.GetRowNames() == std::vector<std::string>({ "2", "3" }));
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256, 625 }));
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "3"), 5);
+    ExpectException(doc.GetColumn<int>("B"), std::out_of_range);
+
+    ExpectException(rapidcsv::Document(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                       rapidcsv::ParallelParams(), rapidcsv::FilterParams({ "D" })),
+                    std::out_of_range);
+    ExpectException(rapidcsv::Document(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                       rapidcsv::ParallelParams(), rapidcsv::FilterParams({ "A" })),
+                    std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
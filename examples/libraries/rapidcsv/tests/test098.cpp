@@ -0,0 +1,189 @@
+// test098.cpp - binary sidecar written after parsing, used by later loads, and rejected when stale
+// or corrupt
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static uint64_t GetValue(const std::string& pSidecar, const size_t pOffset)
+{
+  uint64_t val = 0;
+  std::memcpy(&val, pSidecar.data() + pOffset, sizeof(val));
+  return val;
+}
+
+static void SetValue(std::string& pSidecar, const size_t pOffset, const uint64_t pVal)
+{
+  std::memcpy(&pSidecar[pOffset], &pVal, sizeof(pVal));
+}
+
+// offset of the body, following the header and its padded parameter fingerprint
+static size_t GetBodyOffset(const std::string& pSidecar)
+{
+  return 72 + static_cast<size_t>((GetValue(pSidecar, 64) + 7) / 8) * 8;
+}
+
+// recompute the body checksum after patching the body, as Document computes it
+static void UpdateChecksum(std::string& pSidecar)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t pos = GetBodyOffset(pSidecar); pos <= pSidecar.size(); pos += 8)
+  {
+    std::string word = pSidecar.substr(pos, 8);
+    word.resize(8, '\0');
+    hash = (hash ^ GetValue(word, 0)) * 0x9e3779b97f4a7c15ULL;
+    hash = (hash << 31) | (hash >> 33);
+  }
+  SetValue(pSidecar, 32, hash);
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\r\n"
+    "1,3,9,marker\r\n"
+    "2,4.5,\"multi\r\nline, quoted\",\r\n"
+    "3,-5e3,\"\"\"\",x\r\n"
+    "4,7\r\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  std::string sidecarPath = path + ".rcsv";
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const rapidcsv::LabelParams labelParams(0, 0);
+    const rapidcsv::SeparatorParams separatorParams(',', false, rapidcsv::sPlatformHasCR, true);
+    const rapidcsv::SidecarParams sidecarParams(true);
+    rapidcsv::Document refDoc(path, labelParams, separatorParams);
+
+    // first load parses and writes the sidecar
+    rapidcsv::Document doc(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                           rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                           sidecarParams);
+    unittest::ExpectEqualDocuments(doc, refDoc, labelParams);
+    std::string sidecar = unittest::ReadFile(sidecarPath);
+    unittest::ExpectTrue(sidecar.find("marker") != std::string::npos);
+
+    // later load uses the sidecar, including stored typed columns
+    rapidcsv::Document doc2(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                            rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                            sidecarParams);
+    unittest::ExpectEqualDocuments(doc2, refDoc, labelParams);
+    unittest::ExpectTrue(doc2.GetColumn<double>("A") == std::vector<double>({ 3, 4.5, -5e3, 7 }));
+    unittest::ExpectEqual(std::string, doc2.GetCell<std::string>("B", "2"), "multi\r\nline, quoted");
+    ExpectException(doc2.GetColumn<double>("B"), std::invalid_argument);
+
+    // modified sidecar content is rejected by the body checksum
+    std::string patched = sidecar;
+    patched.replace(patched.find("marker"), 6, "MARKER");
+    unittest::WriteFile(sidecarPath, patched);
+    rapidcsv::Document corruptDoc(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                                  rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                                  sidecarParams);
+    unittest::ExpectEqual(std::string, corruptDoc.GetCell<std::string>("C", "1"), "marker");
+
+    // with a matching checksum, modified content shows the sidecar is used instead of the CSV file
+    UpdateChecksum(patched);
+    unittest::WriteFile(sidecarPath, patched);
+    rapidcsv::Document doc3;
+    doc3.Load(path, labelParams, separatorParams, rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+              rapidcsv::ParallelParams(), rapidcsv::FilterParams(), sidecarParams);
+    unittest::ExpectEqual(std::string, doc3.GetCell<std::string>("C", "1"), "MARKER");
+
+    // sidecar is ignored for other parameters, and without sidecar params
+    rapidcsv::Document doc4(path, labelParams, rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(),
+                            rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                            rapidcsv::SidecarParams(true, path + ".other.rcsv"));
+    unittest::ExpectEqual(std::string, doc4.GetCell<std::string>("C", "1"), "marker");
+    unittest::WriteFile(sidecarPath, patched);
+    rapidcsv::Document doc5(path, rapidcsv::LabelParams(0, -1), separatorParams, rapidcsv::ConverterParams(),
+                            rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                            sidecarParams);
+    unittest::ExpectEqual(std::string, doc5.GetCell<std::string>("C", 0), "marker");
+    unittest::WriteFile(sidecarPath, patched);
+    rapidcsv::Document doc6(path, labelParams, separatorParams);
+    unittest::ExpectEqual(std::string, doc6.GetCell<std::string>("C", "1"), "marker");
+
+    // truncated sidecar is rejected
+    unittest::WriteFile(sidecarPath, patched.substr(0, patched.size() - 8));
+    rapidcsv::Document doc7(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                            rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                            sidecarParams);
+    unittest::ExpectEqualDocuments(doc7, refDoc, labelParams);
+
+    // cell counts beyond the sidecar size are rejected, not read out of bounds
+    const size_t bodyOffset = GetBodyOffset(patched);
+    const size_t firstColumnOffset = bodyOffset + 24 + static_cast<size_t>(GetValue(patched, bodyOffset + 8)) * 8;
+    const uint64_t badCounts[] = { 0xffffffffffffffffULL, 0x2000000000000000ULL, (patched.size() - firstColumnOffset) / 8 };
+    for (const uint64_t badCount : badCounts)
+    {
+      std::string corrupt = patched;
+      SetValue(corrupt, firstColumnOffset, badCount);
+      UpdateChecksum(corrupt);
+      unittest::WriteFile(sidecarPath, corrupt);
+      rapidcsv::Document badDoc(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                                rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                                sidecarParams);
+      unittest::ExpectEqualDocuments(badDoc, refDoc, labelParams);
+    }
+
+    // changed CSV file invalidates the sidecar
+    unittest::WriteFile(sidecarPath, patched);
+    csv += "5,8,64,new\r\n";
+    unittest::WriteFile(path, csv);
+    rapidcsv::Document refDoc2(path, labelParams, separatorParams);
+    rapidcsv::Document doc8(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                            rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(), rapidcsv::FilterParams(),
+                            sidecarParams);
+    unittest::ExpectEqualDocuments(doc8, refDoc2, labelParams);
+    unittest::ExpectEqual(std::string, doc8.GetCell<std::string>("C", "1"), "marker");
+    unittest::ExpectTrue(unittest::ReadFile(sidecarPath).find("MARKER") == std::string::npos);
+    unittest::ExpectTrue(unittest::ReadFile(sidecarPath).find("new") != std::string::npos);
+
+    // filtered loads neither use nor write a sidecar
+    unittest::DeleteFile(sidecarPath);
+    rapidcsv::Document doc9(path, labelParams, separatorParams, rapidcsv::ConverterParams(),
+                            rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(),
+                            rapidcsv::FilterParams({ "A" }), sidecarParams);
+    unittest::ExpectEqual(size_t, doc9.GetColumnCount(), 1);
+    unittest::ExpectTrue(unittest::ReadFile(sidecarPath).empty());
+
+    std::remove((path + ".other.rcsv").c_str());
+
+    // an edit in the middle of a large file, keeping its size, invalidates the sidecar
+    std::string large = "-,A\n";
+    for (int i = 0; i < 20000; ++i)
+    {
+      large += std::to_string(1000000 + i) + ",value\n";
+    }
+    unittest::WriteFile(path, large);
+    rapidcsv::Document largeDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(),
+                                rapidcsv::FilterParams(), sidecarParams);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    large.replace(large.find("1010000,value"), 13, "1010000,VALUE");
+    unittest::WriteFile(path, large);
+    rapidcsv::Document largeDoc2(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(),
+                                 rapidcsv::FilterParams(), sidecarParams);
+    unittest::ExpectEqual(std::string, largeDoc2.GetCell<std::string>("A", "1010000"), "VALUE");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(sidecarPath);
+
+  return rv;
+}
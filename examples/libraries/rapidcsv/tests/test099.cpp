@@ -0,0 +1,148 @@
+// test099.cpp - UTF-16 input transcoded in chunks, with code units and surrogate pairs across chunks
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static std::string ToUtf16(const std::vector<uint32_t>& pCodePoints, const bool pIsLE)
+{
+  std::vector<uint16_t> units = { 0xfeff };
+  for (const uint32_t codePoint : pCodePoints)
+  {
+    if (codePoint >= 0x10000)
+    {
+      units.push_back(static_cast<uint16_t>(0xd800 + ((codePoint - 0x10000) >> 10)));
+      units.push_back(static_cast<uint16_t>(0xdc00 + ((codePoint - 0x10000) & 0x3ff)));
+    }
+    else
+    {
+      units.push_back(static_cast<uint16_t>(codePoint));
+    }
+  }
+
+  std::string bytes;
+  for (const uint16_t unit : units)
+  {
+    bytes += static_cast<char>(pIsLE ? (unit & 0xff) : (unit >> 8));
+    bytes += static_cast<char>(pIsLE ? (unit >> 8) : (unit & 0xff));
+  }
+
+  return bytes;
+}
+
+static std::string ToUtf8(const std::vector<uint32_t>& pCodePoints)
+{
+  std::string str;
+  for (const uint32_t codePoint : pCodePoints)
+  {
+    if (codePoint < 0x80)
+    {
+      str += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+      str += static_cast<char>(0xc0 | (codePoint >> 6));
+      str += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+    else if (codePoint < 0x10000)
+    {
+      str += static_cast<char>(0xe0 | (codePoint >> 12));
+      str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+      str += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+    else
+    {
+      str += static_cast<char>(0xf0 | (codePoint >> 18));
+      str += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+      str += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+      str += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+  }
+
+  return str;
+}
+
+int main()
+{
+  int rv = 0;
+
+  // rows of ascii padding followed by 2-, 3- and 4-byte UTF-8 characters and runs of CJK
+  // characters, the odd padding lengths shifting them across every alignment and across the
+  // 64 KiB read chunk boundaries
+  std::vector<uint32_t> codePoints;
+  const std::string header = "-,A,B\n";
+  codePoints.insert(codePoints.end(), header.begin(), header.end());
+  std::vector<std::string> expectedA;
+  std::vector<std::string> expectedB;
+  const std::vector<uint32_t> wide = { 0xe9, 0x4e2d, 0x1f600, 0x20ac, 0x10348 };
+  for (size_t rowIdx = 0; rowIdx < 10000; ++rowIdx)
+  {
+    std::vector<uint32_t> rowCodePoints;
+    const std::string rowName = std::to_string(rowIdx) + ",";
+    rowCodePoints.insert(rowCodePoints.end(), rowName.begin(), rowName.end());
+    rowCodePoints.insert(rowCodePoints.end(), rowIdx % 23, 'a');
+    rowCodePoints.push_back(wide.at(rowIdx % wide.size()));
+    rowCodePoints.insert(rowCodePoints.end(), rowIdx % 37, 0x6587);
+    rowCodePoints.push_back(',');
+    rowCodePoints.push_back(wide.at((rowIdx + 1) % wide.size()));
+    rowCodePoints.insert(rowCodePoints.end(), rowIdx % 7, 'b');
+    rowCodePoints.push_back('\n');
+    codePoints.insert(codePoints.end(), rowCodePoints.begin(), rowCodePoints.end());
+
+    expectedA.push_back(std::string(rowIdx % 23, 'a') + ToUtf8({ wide.at(rowIdx % wide.size()) }) +
+                        ToUtf8(std::vector<uint32_t>(rowIdx % 37, 0x6587)));
+    expectedB.push_back(ToUtf8({ wide.at((rowIdx + 1) % wide.size()) }) + std::string(rowIdx % 7, 'b'));
+  }
+
+  std::string path = unittest::TempPath();
+  std::string outpath = unittest::TempPath();
+
+  try
+  {
+    for (const bool isLE : { true, false })
+    {
+      const std::string utf16 = ToUtf16(codePoints, isLE);
+      unittest::ExpectTrue(utf16.size() > (3 * 64 * 1024));
+      unittest::WriteFile(path, utf16);
+
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), expectedA.size());
+      unittest::ExpectTrue(doc.GetColumn<std::string>("A") == expectedA);
+      unittest::ExpectTrue(doc.GetColumn<std::string>("B") == expectedB);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "9999"), ToUtf8({ 0xe9 }) + "bbb");
+
+      // parallel params do not apply to transcoded input, which is parsed serially
+      rapidcsv::Document pdoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                              rapidcsv::ParallelParams(4, 1));
+      unittest::ExpectTrue(pdoc.GetColumn<std::string>("B") == expectedB);
+
+      std::istringstream sstream(utf16);
+      rapidcsv::Document sdoc(sstream, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectTrue(sdoc.GetColumn<std::string>("A") == expectedA);
+
+      doc.Save(outpath);
+      unittest::ExpectTrue(unittest::ReadFile(outpath) == utf16);
+    }
+
+    // unpaired surrogates and a truncated code unit are replaced
+    const std::string invalid = std::string("\xff\xfe" "A\0,\0" "\x00\xd8" "B\0\n\0" "\x01\xdc" "\n\0" "\x02\xd8", 18) + "C";
+    unittest::WriteFile(path, invalid);
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1));
+    const std::string replacement = ToUtf8({ 0xfffd });
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 0), "A");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(1, 0), replacement + "B");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 1), replacement);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 2), replacement + replacement);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(outpath);
+
+  return rv;
+}
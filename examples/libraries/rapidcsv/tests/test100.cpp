@@ -0,0 +1,88 @@
+// test100.cpp - pooled document matches document, and releases its arena on clear and reload
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  const std::vector<std::string> csvs = unittest::FixtureCsvs();
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    for (const auto& csv : csvs)
+    {
+      unittest::WriteFile(path, csv);
+      for (const auto& params : unittest::FixtureLoadParams(unittest::FixtureLabelParams()))
+      {
+        rapidcsv::Document doc(path, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                               params.mLineReaderParams);
+        rapidcsv::PooledDocument pdoc(path, params.mLabelParams, params.mSeparatorParams,
+                                      rapidcsv::ConverterParams(), params.mLineReaderParams);
+        unittest::ExpectEqualDocuments(pdoc, doc, params.mLabelParams);
+
+        // cell views of the arena
+        for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+        {
+          const std::vector<std::string> row = doc.GetRow<std::string>(rowIdx);
+          for (size_t columnIdx = 0; columnIdx < row.size(); ++columnIdx)
+          {
+            unittest::ExpectEqual(std::string, std::string(pdoc.GetCellView(columnIdx, rowIdx)), row.at(columnIdx));
+          }
+        }
+      }
+    }
+
+    unittest::WriteFile(path, csvs.at(0));
+    rapidcsv::PooledDocument doc(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(int, doc.GetCell<int>("B", "2"), 16);
+    unittest::ExpectEqual(int, doc.GetCell<int>(2, 0), 81);
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 81, 256 }));
+    unittest::ExpectTrue(doc.GetRow<long>("1") == std::vector<long>({ 3, 9, 81 }));
+    unittest::ExpectEqual(std::string, doc.GetColumnName(1), "B");
+    unittest::ExpectEqual(std::string, doc.GetRowName(1), "2");
+    ExpectException(doc.GetCell<int>("D", "1"), std::out_of_range);
+    ExpectException(doc.GetCell<int>(0, 2), std::out_of_range);
+    ExpectException(doc.GetCellView(3, 0), std::out_of_range);
+    ExpectException(doc.GetRowName(2), std::out_of_range);
+    unittest::ExpectEqual(int, doc.GetCell<int>("C", "2", [](const std::string& pStr, int& pVal)
+    {
+      pVal = static_cast<int>(pStr.size());
+    }), 3);
+    unittest::ExpectTrue(doc.GetColumn<std::string>(0) == std::vector<std::string>({ "3", "4" }));
+
+    unittest::WriteFile(path, "-,A\n1,x\n");
+    doc.Load(path, rapidcsv::LabelParams(0, 0));
+    ExpectException(doc.GetCell<int>("A", "1"), std::invalid_argument);
+    doc.Load(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(true, 0.5, 7));
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "1"), 7);
+    unittest::ExpectEqual(double, doc.GetCell<double>("A", "1"), 0.5);
+    unittest::WriteFile(path, csvs.at(0));
+
+    doc.Clear();
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 0);
+    unittest::ExpectEqual(ssize_t, doc.GetColumnIdx("A"), -1);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      doc.Load(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4 }));
+    }
+
+    doc.Load("../tests/chi-utf16.csv", rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(';'));
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("description", "1"), "辅助关闭");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 39), "达到扭矩限制");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,151 @@
+// test101.cpp - refresh parses appended rows the same as a full load
+
+#include <fstream>
+#include <thread>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static void AppendFile(const std::string& pPath, const std::string& pData)
+{
+  std::ofstream out(pPath, std::ios::binary | std::ios::app);
+  out << pData;
+}
+
+int main()
+{
+  int rv = 0;
+
+  // pieces split inside cells, quoted linebreaks, CR/LF pairs, comments and empty lines
+  const std::vector<std::string> pieces =
+  {
+    "-,A,B",
+    ",C\n1,3,9,81\n",
+    "",
+    "2,4",
+    ",16,256\r",
+    "\n3,\"multi\n",
+    "line\",  \"pad\"  ,\"\"\n\n",
+    "# comment,\"q\"\n#",
+    "4,x\n5,6,7,8",
+    "\n",
+    "6,\"\"\"\",\"a\"\"\",end",
+  };
+
+  std::vector<rapidcsv::LabelParams> labelParams = unittest::FixtureLabelParams();
+  labelParams.push_back(rapidcsv::LabelParams(-1, 0));
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    for (const auto& params : unittest::FixtureLoadParams(labelParams))
+    {
+      for (const bool filtered : { false, true })
+      {
+        rapidcsv::FilterParams filterParams;
+        if (filtered && (params.mLabelParams.mColumnNameIdx == 0))
+        {
+          filterParams = rapidcsv::FilterParams({ "B", "A" }, [](const std::vector<std::string>& pRow)
+          {
+            return (pRow.size() < 2) || (pRow.at(1) != "3");
+          });
+        }
+
+        // refreshed document matches a full load of the file
+        auto expectLoaded = [&](rapidcsv::Document& pDoc)
+        {
+          rapidcsv::Document refDoc(path, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                                    params.mLineReaderParams, rapidcsv::ParallelParams(), filterParams);
+          unittest::ExpectEqualDocuments(pDoc, refDoc, params.mLabelParams);
+        };
+
+        unittest::WriteFile(path, pieces.front());
+        rapidcsv::Document doc(path, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                               params.mLineReaderParams, rapidcsv::ParallelParams(3, 1), filterParams);
+        expectLoaded(doc);
+
+        for (size_t i = 1; i < pieces.size(); ++i)
+        {
+          const size_t rowCount = doc.GetRowCount();
+          AppendFile(path, pieces.at(i));
+          const size_t parsedCount = doc.Refresh();
+          unittest::ExpectTrue(pieces.at(i).empty() ? (parsedCount == 0) : (rowCount <= doc.GetRowCount()));
+          expectLoaded(doc);
+        }
+
+        unittest::ExpectEqual(size_t, doc.Refresh(), 0);
+      }
+    }
+
+    // rows appended after the last complete row, and a partial last row completed later
+    unittest::WriteFile(path, "-,A,B\n1,3,9\n");
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(size_t, doc.Refresh(), 0);
+    unittest::ExpectEqual(int, doc.GetColumn<int>("B").at(0), 9);
+    AppendFile(path, "2,4,16\n3,5");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 2);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    unittest::ExpectEqual(size_t, doc.GetRow<std::string>("3").size(), 1);
+    AppendFile(path, ",25\n");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 1);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    unittest::ExpectEqual(int, doc.GetCell<int>("B", "3"), 25);
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 9, 16, 25 }));
+    unittest::ExpectTrue(doc.GetRowNames() == std::vector<std::string>({ "1", "2", "3" }));
+
+    // a partial last row shadowing an earlier row name, renamed when completed
+    AppendFile(path, "3");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 1);
+    unittest::ExpectEqual(ssize_t, doc.GetRowIdx("3"), 3);
+    AppendFile(path, "0,6,36\n");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 1);
+    unittest::ExpectEqual(ssize_t, doc.GetRowIdx("3"), 2);
+    unittest::ExpectEqual(ssize_t, doc.GetRowIdx("30"), 3);
+
+    // modified documents are not refreshed, also when only the partial last row was changed
+    AppendFile(path, "4,7");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 1);
+    doc.SetCell<int>("A", "4", 8);
+    AppendFile(path, ",49\n");
+    ExpectException(doc.Refresh(), std::logic_error);
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "4"), 8);
+    doc.RemoveRow("1");
+    ExpectException(doc.Refresh(), std::logic_error);
+
+    // saved documents, and truncated files, are reloaded in full
+    doc.Save();
+    AppendFile(path, "5,9,81\n");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 5);
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 4, 5, 6, 8, 9 }));
+    unittest::WriteFile(path, "-,A,B\n7,8,9\n");
+    unittest::ExpectEqual(size_t, doc.Refresh(), 1);
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 9 }));
+
+    // wait for appends
+    unittest::ExpectTrue(!doc.WaitForChange(20));
+    std::thread writer([&path]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      AppendFile(path, "8,9,10\n");
+    });
+    unittest::ExpectTrue(doc.WaitForChange(10000));
+    writer.join();
+    unittest::ExpectEqual(size_t, doc.Refresh(), 1);
+    unittest::ExpectEqual(int, doc.GetCell<int>("B", "8"), 10);
+    unittest::ExpectTrue(!doc.WaitForChange(0));
+
+    // documents loaded from streams have no file to refresh from
+    std::istringstream stream("-,A,B\n1,3,9\n");
+    rapidcsv::Document sdoc(stream, rapidcsv::LabelParams(0, 0));
+    ExpectException(sdoc.Refresh(), std::invalid_argument);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,181 @@
+// test102.cpp - group by key columns and aggregate, serial and parallel
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+struct Expected
+{
+  size_t mCount = 0;
+  long long mSum = 0;
+  long long mMin = 0;
+  long long mMax = 0;
+};
+
+int main()
+{
+  int rv = 0;
+
+  // 100K rows of accounts, in an order where groups first appear in every range of rows
+  std::string csv = "Account,Branch,Amount,Fee\n";
+  std::vector<std::string> order;
+  std::map<std::string, Expected> expected;
+  std::map<std::string, Expected> expectedByAccount;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const std::string account = "acc" + std::to_string((i * 7919) % (1 + (i / 1000)));
+    const std::string branch = ((i % 3) == 0) ? "north" : "south";
+    const long long amount = ((i * 37) % 2001) - 1000;
+    csv += account + "," + branch + "," + std::to_string(amount) + "," + std::to_string(i % 10) + "\n";
+
+    const std::string key = account + "," + branch;
+    Expected& group = expected[key];
+    if (group.mCount == 0)
+    {
+      order.push_back(key);
+      group.mMin = amount;
+      group.mMax = amount;
+    }
+    ++group.mCount;
+    group.mSum += amount;
+    group.mMin = std::min(group.mMin, amount);
+    group.mMax = std::max(group.mMax, amount);
+
+    Expected& accountGroup = expectedByAccount[account];
+    accountGroup.mMin = (accountGroup.mCount == 0) ? amount : std::min(accountGroup.mMin, amount);
+    ++accountGroup.mCount;
+    accountGroup.mSum += amount;
+  }
+
+  try
+  {
+    std::istringstream stream(csv);
+    rapidcsv::Document doc(stream, rapidcsv::LabelParams(0, -1));
+
+    const std::vector<rapidcsv::Aggregate> aggregates =
+    {
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Sum, "Amount"),
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Count),
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Min, "Amount"),
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Max, static_cast<size_t>(2)),
+      rapidcsv::Aggregate(rapidcsv::AggregateOp::Mean, "Amount"),
+    };
+
+    for (size_t threadCount = 0; threadCount <= 6; threadCount += 3)
+    {
+      const rapidcsv::GroupByResult<long long> result =
+        doc.GroupBy<long long>(std::vector<std::string>({ "Account", "Branch" }), aggregates, threadCount);
+      unittest::ExpectEqual(size_t, result.GetGroupCount(), order.size());
+      for (size_t groupIdx = 0; groupIdx < result.GetGroupCount(); ++groupIdx)
+      {
+        const std::vector<std::string>& key = result.mKeys.at(groupIdx);
+        unittest::ExpectEqual(size_t, key.size(), 2);
+        unittest::ExpectEqual(std::string, key.at(0) + "," + key.at(1), order.at(groupIdx));
+
+        const Expected& group = expected.at(order.at(groupIdx));
+        const std::vector<long long>& values = result.mValues.at(groupIdx);
+        unittest::ExpectEqual(size_t, values.size(), 5);
+        unittest::ExpectEqual(long long, values.at(0), group.mSum);
+        unittest::ExpectEqual(long long, values.at(1), static_cast<long long>(group.mCount));
+        unittest::ExpectEqual(long long, values.at(2), group.mMin);
+        unittest::ExpectEqual(long long, values.at(3), group.mMax);
+        unittest::ExpectEqual(long long, values.at(4), group.mSum / static_cast<long long>(group.mCount));
+      }
+    }
+
+    // double values, from the column cache and converted per range
+    for (int cached = 0; cached < 2; ++cached)
+    {
+      if (cached != 0)
+      {
+        unittest::ExpectEqual(size_t, doc.GetColumn<double>("Amount").size(), 100000);
+      }
+
+      const rapidcsv::GroupByResult<double> result =
+        doc.GroupBy(std::vector<size_t>({ 0 }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Mean, "Amount"),
+                                                  rapidcsv::Aggregate(rapidcsv::AggregateOp::Min, "Amount") }, 4);
+      unittest::ExpectEqual(size_t, result.GetGroupCount(), expectedByAccount.size());
+      for (size_t groupIdx = 0; groupIdx < result.GetGroupCount(); ++groupIdx)
+      {
+        const Expected& group = expectedByAccount.at(result.mKeys.at(groupIdx).at(0));
+        const double mean = static_cast<double>(group.mSum) / static_cast<double>(group.mCount);
+        unittest::ExpectTrue(std::fabs(result.mValues.at(groupIdx).at(0) - mean) < 1e-9);
+        unittest::ExpectEqual(double, result.mValues.at(groupIdx).at(1), static_cast<double>(group.mMin));
+      }
+    }
+
+    // no key columns aggregate all rows as one group
+    const rapidcsv::GroupByResult<long long> total =
+      doc.GroupBy<long long>(std::vector<std::string>(), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Sum, "Fee"),
+                                                           rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) });
+    unittest::ExpectEqual(size_t, total.GetGroupCount(), 1);
+    unittest::ExpectTrue(total.mKeys.at(0).empty());
+    unittest::ExpectEqual(long long, total.mValues.at(0).at(0), 450000);
+    unittest::ExpectEqual(long long, total.mValues.at(0).at(1), 100000);
+
+    // count only, without any value columns, serial and merged across ranges
+    for (size_t threadCount = 1; threadCount <= 4; threadCount += 3)
+    {
+      const rapidcsv::GroupByResult<double> counts =
+        doc.GroupBy<double>(std::vector<size_t>({ 0 }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) }, threadCount);
+      unittest::ExpectEqual(size_t, counts.GetGroupCount(), expectedByAccount.size());
+      for (size_t groupIdx = 0; groupIdx < counts.GetGroupCount(); ++groupIdx)
+      {
+        const Expected& group = expectedByAccount.at(counts.mKeys.at(groupIdx).at(0));
+        unittest::ExpectEqual(double, counts.mValues.at(groupIdx).at(0), static_cast<double>(group.mCount));
+      }
+    }
+
+    std::istringstream countOnly("k,v\na,1\nb,2\na,3\n");
+    rapidcsv::Document countOnlyDoc(countOnly, rapidcsv::LabelParams(-1, -1));
+    const rapidcsv::GroupByResult<double> countOnlyResult =
+      countOnlyDoc.GroupBy<double>(std::vector<size_t>({ 0 }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) }, 1);
+    unittest::ExpectEqual(size_t, countOnlyResult.GetGroupCount(), 3);
+    unittest::ExpectEqual(std::string, countOnlyResult.mKeys.at(1).at(0), "a");
+    unittest::ExpectEqual(double, countOnlyResult.mValues.at(1).at(0), 2.0);
+
+    // small documents, and errors
+    std::istringstream small("-,Account,Amount\n"
+                             "1,a,3\n"
+                             "2,b,x\n"
+                             "3,a,4\n"
+                             "4\n");
+    rapidcsv::Document smallDoc(small, rapidcsv::LabelParams(0, 0));
+    ExpectException(smallDoc.GroupBy(std::vector<std::string>({ "Account" }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) }),
+                    std::out_of_range);
+    smallDoc.RemoveRow("4");
+    const rapidcsv::GroupByResult<double> counts =
+      smallDoc.GroupBy(std::vector<std::string>({ "Account" }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) });
+    unittest::ExpectEqual(size_t, counts.GetGroupCount(), 2);
+    unittest::ExpectEqual(std::string, counts.mKeys.at(1).at(0), "b");
+    unittest::ExpectEqual(double, counts.mValues.at(0).at(0), 2.0);
+    ExpectException(smallDoc.GroupBy(std::vector<std::string>({ "Account" }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Sum, "Amount") }),
+                    std::invalid_argument);
+    ExpectException(smallDoc.GroupBy(std::vector<std::string>({ "Acc" }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) }),
+                    std::out_of_range);
+    ExpectException(smallDoc.GroupBy(std::vector<std::string>(), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Max, "Amt") }),
+                    std::out_of_range);
+
+    smallDoc.RemoveRow("2");
+    const rapidcsv::GroupByResult<int> sums =
+      smallDoc.GroupBy<int>(std::vector<std::string>({ "Account" }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Sum, "Amount") });
+    unittest::ExpectEqual(size_t, sums.GetGroupCount(), 1);
+    unittest::ExpectEqual(int, sums.mValues.at(0).at(0), 7);
+
+    rapidcsv::Document emptyDoc;
+    unittest::ExpectEqual(size_t, emptyDoc.GroupBy(std::vector<size_t>(), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count) }).GetGroupCount(), 0);
+
+    std::istringstream headerOnly("Account,Amount\n");
+    rapidcsv::Document headerOnlyDoc(headerOnly, rapidcsv::LabelParams(0, -1));
+    const rapidcsv::GroupByResult<double> none =
+      headerOnlyDoc.GroupBy(std::vector<std::string>({ "Account" }), { rapidcsv::Aggregate(rapidcsv::AggregateOp::Count),
+                                                                       rapidcsv::Aggregate(rapidcsv::AggregateOp::Sum, "Amount") }, 4);
+    unittest::ExpectEqual(size_t, none.GetGroupCount(), 0);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,269 @@
+// test103.cpp - hash and sorted indexes match column scans, through modifications and refresh
+
+#include <fstream>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static void CompareLookups(rapidcsv::Document& pDoc, rapidcsv::Document& pRefDoc, const size_t pKeyColumn,
+                           const size_t pValueColumn)
+{
+  unittest::ExpectEqual(size_t, pDoc.GetRowCount(), pRefDoc.GetRowCount());
+
+  const std::vector<std::string> keys = { "k0", "k1", "k17", "k4999", "k5002", "new", "", "missing" };
+  for (const auto& key : keys)
+  {
+    unittest::ExpectTrue(pDoc.FindRows(pKeyColumn, key) == pRefDoc.FindRows(pKeyColumn, key));
+  }
+
+  unittest::ExpectTrue(pDoc.FindRowRange<int>(pValueColumn, -3, 4) == pRefDoc.FindRowRange<int>(pValueColumn, -3, 4));
+  unittest::ExpectTrue(pDoc.FindRowRange<int>(pValueColumn, 498, 1000) ==
+                       pRefDoc.FindRowRange<int>(pValueColumn, 498, 1000));
+  unittest::ExpectTrue(pDoc.FindRowRange<std::string>(pKeyColumn, "k10", "k11") ==
+                       pRefDoc.FindRowRange<std::string>(pKeyColumn, "k10", "k11"));
+
+  // scan results in the reference document
+  const std::vector<int> values = pRefDoc.GetColumn<int>(pValueColumn);
+  const std::vector<size_t> rows = pRefDoc.FindRowRange<int>(pValueColumn, -3, 4);
+  size_t expectedCount = 0;
+  for (size_t rowIdx = 0; rowIdx < values.size(); ++rowIdx)
+  {
+    expectedCount += ((values[rowIdx] >= -3) && (values[rowIdx] <= 4)) ? 1 : 0;
+  }
+  unittest::ExpectEqual(size_t, rows.size(), expectedCount);
+  for (size_t i = 1; i < rows.size(); ++i)
+  {
+    const bool ordered = (values.at(rows[i - 1]) < values.at(rows[i])) ||
+                         ((values.at(rows[i - 1]) == values.at(rows[i])) && (rows[i - 1] < rows[i]));
+    unittest::ExpectTrue(ordered);
+  }
+}
+
+static void CompareKeys(rapidcsv::Document& pDoc, rapidcsv::Document& pRefDoc, const size_t pKeyColumn)
+{
+  std::map<std::string, std::vector<size_t>> keyRows;
+  const std::vector<std::string> keys = pRefDoc.GetColumn<std::string>(pKeyColumn);
+  for (size_t rowIdx = 0; rowIdx < keys.size(); ++rowIdx)
+  {
+    keyRows[keys[rowIdx]].push_back(rowIdx);
+  }
+
+  for (int i = 0; i < 5003; ++i)
+  {
+    const std::string key = "k" + std::to_string(i);
+    const auto it = keyRows.find(key);
+    unittest::ExpectTrue(pDoc.FindRows(pKeyColumn, key) == ((it != keyRows.end()) ? it->second : std::vector<size_t>()));
+  }
+}
+
+// indexes on the first column of the shared fixture files match column scans
+static void CompareFixtureLookups(const std::string& pPath)
+{
+  for (const auto& csv : unittest::FixtureCsvs())
+  {
+    unittest::WriteFile(pPath, csv);
+    for (const auto& params : unittest::FixtureLoadParams(unittest::FixtureLabelParams()))
+    {
+      rapidcsv::Document doc(pPath, params.mLabelParams, params.mSeparatorParams, rapidcsv::ConverterParams(),
+                             params.mLineReaderParams);
+      rapidcsv::Document hashDoc = doc;
+      rapidcsv::Document sortedDoc = doc;
+      hashDoc.CreateHashIndex(0);
+      sortedDoc.CreateSortedIndex(0);
+
+      std::vector<std::string> keys(1, "missing");
+      for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+      {
+        const std::vector<std::string> row = doc.GetRow<std::string>(rowIdx);
+        if (!row.empty())
+        {
+          keys.push_back(row.front());
+        }
+      }
+
+      for (const auto& key : keys)
+      {
+        unittest::ExpectTrue(hashDoc.FindRows(0, key) == doc.FindRows(0, key));
+        unittest::ExpectTrue(sortedDoc.FindRows(0, key) == doc.FindRows(0, key));
+        unittest::ExpectTrue(sortedDoc.FindRowRange<std::string>(0, key, key) ==
+                             doc.FindRowRange<std::string>(0, key, key));
+      }
+    }
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv = "-,Key,Value\n";
+  for (int i = 0; i < 100000; ++i)
+  {
+    csv += "r" + std::to_string(i) + ",k" + std::to_string((i * 7919LL) % 5003) + "," +
+      std::to_string(((i * 37) % 1000) - 500) + "\n";
+  }
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::ParallelParams(5, 1));
+    rapidcsv::Document refDoc(path, rapidcsv::LabelParams(0, 0));
+    doc.CreateHashIndex("Key");
+    doc.CreateSortedIndex<int>("Value");
+    doc.CreateSortedIndex("Key");
+    CompareLookups(doc, refDoc, 0, 1);
+    unittest::ExpectEqual(size_t, doc.FindRows("Key", "k0").size(), 20);
+    unittest::ExpectEqual(size_t, doc.FindRows("Key", "k0").at(0), 0);
+
+    // cell updates
+    rapidcsv::Document copy = doc;
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      document->SetCell<std::string>("Key", "r5", "new");
+      document->SetCell<int>("Value", "r6", 2);
+      document->SetCell<std::string>(0, 7, "k17");
+    }
+    CompareLookups(doc, refDoc, 0, 1);
+    unittest::ExpectTrue(doc.FindRows("Key", "new") == std::vector<size_t>({ 5 }));
+    unittest::ExpectTrue(copy.FindRows("Key", "new").empty());
+
+    // in place updates of an index no longer shared with the copy
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      document->SetCell<std::string>(0, 5, "k1");
+      document->SetCell<std::string>(0, 8, "new");
+      document->SetCell<std::string>(0, 99999, "new");
+    }
+    CompareLookups(doc, refDoc, 0, 1);
+    unittest::ExpectTrue(doc.FindRows("Key", "new") == std::vector<size_t>({ 8, 99999 }));
+
+    // row and column changes
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      document->RemoveRow(0);
+      document->InsertRow<std::string>(10, { "k1", "3" }, "x");
+    }
+    CompareLookups(doc, refDoc, 0, 1);
+
+    // row updates in place, removing all rows of some keys
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      for (size_t i = 0; i < 50; ++i)
+      {
+        document->RemoveRow(i * 3);
+        document->InsertRow<std::string>(i * 7, { "k" + std::to_string(5000 + (i % 3)), std::to_string(i) });
+        document->SetRow<std::string>(i * 11, { "k" + std::to_string(i), "-2" });
+      }
+    }
+    for (int i = 100; i < 110; ++i)
+    {
+      const std::vector<size_t> rows = refDoc.FindRows(0, "k" + std::to_string(i * 13));
+      for (auto it = rows.rbegin(); it != rows.rend(); ++it)
+      {
+        doc.RemoveRow(*it);
+        refDoc.RemoveRow(*it);
+      }
+    }
+    CompareLookups(doc, refDoc, 0, 1);
+    CompareKeys(doc, refDoc, 0);
+    unittest::ExpectTrue(doc.FindRows("Key", "k1300").empty());
+
+    // rows inserted and removed at the end, which renumber no other rows, then in between
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      for (size_t i = 0; i < 20; ++i)
+      {
+        document->InsertRow<std::string>(document->GetRowCount(), { "k" + std::to_string(i % 4), std::to_string(i) });
+      }
+
+      for (size_t i = 0; i < 5; ++i)
+      {
+        document->RemoveRow(document->GetRowCount() - 1);
+      }
+
+      document->InsertRow<std::string>(document->GetRowCount() - 3, { "k2", "7" });
+      document->RemoveRow(document->GetRowCount() - 10);
+    }
+    CompareLookups(doc, refDoc, 0, 1);
+    CompareKeys(doc, refDoc, 0);
+
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      document->SetColumnName(1, "Value");
+      document->InsertColumn<int>(0, std::vector<int>(), "Pad");
+    }
+    CompareLookups(doc, refDoc, 1, 2);
+    unittest::ExpectTrue(doc.FindRows(1, "k17") == refDoc.FindRows(1, "k17"));
+
+    for (rapidcsv::Document* document : { &doc, &refDoc })
+    {
+      document->RemoveColumn(0);
+    }
+    CompareLookups(doc, refDoc, 0, 1);
+
+    doc.DropIndexes(0);
+    CompareLookups(doc, refDoc, 0, 1);
+
+    // refresh keeps indexes and adds the appended rows
+    rapidcsv::Document fileDoc(path, rapidcsv::LabelParams(0, 0));
+    fileDoc.CreateHashIndex(0);
+    fileDoc.CreateSortedIndex<int>(1);
+    unittest::ExpectEqual(size_t, fileDoc.GetColumn<int>(1).size(), 100000);
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::app);
+      out << "s1,k0,9999\ns2,new,-9999\ns3,k5,12";
+    }
+    unittest::ExpectEqual(size_t, fileDoc.Refresh(), 3);
+    refDoc.Load(path, rapidcsv::LabelParams(0, 0));
+    CompareLookups(fileDoc, refDoc, 0, 1);
+    unittest::ExpectEqualDocuments(fileDoc, refDoc, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(size_t, fileDoc.FindRows("Key", "k0").back(), 100000);
+    unittest::ExpectTrue(fileDoc.FindRowRange<int>(1, -10000, -1000) == std::vector<size_t>({ 100001 }));
+    unittest::ExpectTrue(fileDoc.FindRows("Key", "k5").back() == 100002);
+
+    // the partial last row is replaced, and a copy sharing the caches keeps its rows
+    rapidcsv::Document fileCopy = fileDoc;
+    {
+      std::ofstream out(path, std::ios::binary | std::ios::app);
+      out << "34\ns4,k6,-20000\n";
+    }
+    unittest::ExpectEqual(size_t, fileDoc.Refresh(), 2);
+    refDoc.Load(path, rapidcsv::LabelParams(0, 0));
+    CompareLookups(fileDoc, refDoc, 0, 1);
+    CompareKeys(fileDoc, refDoc, 0);
+    unittest::ExpectEqualDocuments(fileDoc, refDoc, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(int, fileDoc.GetColumn<int>(1).at(100002), 1234);
+    unittest::ExpectTrue(fileDoc.FindRowRange<int>(1, 1000, 2000) == std::vector<size_t>({ 100002 }));
+    unittest::ExpectTrue(fileDoc.FindRowRange<int>(1, -30000, -10000) == std::vector<size_t>({ 100003 }));
+    unittest::ExpectEqual(size_t, fileCopy.GetColumn<int>(1).size(), 100003);
+    unittest::ExpectEqual(int, fileCopy.GetColumn<int>(1).back(), 12);
+    unittest::ExpectTrue(fileCopy.FindRowRange<int>(1, -30000, -10000).empty());
+    unittest::ExpectTrue(fileCopy.FindRows("Key", "k6").back() < 100000);
+
+    // loading builds the indexes again, also those created before the first load
+    fileDoc.Load(path, rapidcsv::LabelParams(0, 0));
+    CompareLookups(fileDoc, refDoc, 0, 1);
+    rapidcsv::Document emptyDoc;
+    emptyDoc.CreateHashIndex(0);
+    emptyDoc.CreateSortedIndex<int>(1);
+    emptyDoc.Load(path, rapidcsv::LabelParams(0, 0));
+    CompareLookups(emptyDoc, refDoc, 0, 1);
+    CompareKeys(emptyDoc, refDoc, 0);
+
+    ExpectException(doc.CreateHashIndex("Missing"), std::out_of_range);
+    ExpectException(doc.FindRows("Missing", "k0"), std::out_of_range);
+
+    CompareFixtureLookups(path);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
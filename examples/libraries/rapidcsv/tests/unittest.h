@@ -9,6 +9,9 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <vector>
+
+#include <rapidcsv.h>
 
 
 #define ExpectEqual(t, a, b) ExpectEqualFun<t>(a, b, #a, #b, __FILE__, __LINE__)
@@ -165,4 +168,118 @@ namespace unittest
       throw std::runtime_error(ss.str());
     }
   }
+
+  // Parameters to load a fixture file with.
+  struct LoadParams
+  {
+    rapidcsv::LabelParams mLabelParams;
+    rapidcsv::SeparatorParams mSeparatorParams;
+    rapidcsv::LineReaderParams mLineReaderParams;
+  };
+
+  // CSV files with quoted separators and linebreaks, escaped quotes, padding, stray CRs,
+  // comments and empty lines, for comparing loads of other kinds with Document.
+  inline std::vector<std::string> FixtureCsvs()
+  {
+    return std::vector<std::string>(
+    {
+      "-,A,B,C\n"
+      "1,3,9,81\n"
+      "2,4,16,256\n",
+
+      "-,A,B,C\r\n"
+      "1, \"a,b\" ,\"x\"\"y\",81\r\n"
+      "\r\n"
+      "# comment,\"q\"\r\n"
+      "2,\"multi\r\nline\",  \"pad\"  ,\"\"\r\n"
+      "\n"
+      "3,a\rb,\" c \r\",\"un\"closed\n"
+      "#4,\"x\n"
+      "5,\"\"\"\",\"a\"\"\",end",
+    });
+  }
+
+  inline std::vector<rapidcsv::LabelParams> FixtureLabelParams()
+  {
+    return std::vector<rapidcsv::LabelParams>(
+    {
+      rapidcsv::LabelParams(0, -1),
+      rapidcsv::LabelParams(0, 0),
+      rapidcsv::LabelParams(-1, -1),
+    });
+  }
+
+  // Each label params with all combinations of trim, quoted linebreaks, auto quote, skip comments
+  // and skip empty lines.
+  inline std::vector<LoadParams> FixtureLoadParams(const std::vector<rapidcsv::LabelParams>& pLabelParams,
+                                                   const char pSeparator = ',')
+  {
+    std::vector<LoadParams> loadParams;
+    for (const auto& label : pLabelParams)
+    {
+      for (int flags = 0; flags < 32; ++flags)
+      {
+        LoadParams params =
+        {
+          label,
+          rapidcsv::SeparatorParams(pSeparator, (flags & 1) != 0, false, (flags & 2) != 0, (flags & 4) != 0),
+          rapidcsv::LineReaderParams((flags & 8) != 0, '#', (flags & 16) != 0),
+        };
+        loadParams.push_back(params);
+      }
+    }
+    return loadParams;
+  }
+
+  namespace detail
+  {
+    template<typename T>
+    inline void ExpectEqualSaved(T&, rapidcsv::Document&)
+    {
+    }
+
+    inline void ExpectEqualSaved(rapidcsv::Document& pDoc, rapidcsv::Document& pRefDoc)
+    {
+      std::ostringstream out;
+      std::ostringstream refOut;
+      pDoc.Save(out);
+      pRefDoc.Save(refOut);
+      ExpectEqual(std::string, out.str(), refOut.str());
+    }
+  }
+
+  // Expect a document of any kind to hold the same cells and labels as a Document, and a
+  // Document to also save the same.
+  template<typename T>
+  inline void ExpectEqualDocuments(T& pDoc, rapidcsv::Document& pRefDoc, const rapidcsv::LabelParams& pLabelParams)
+  {
+    ExpectEqual(size_t, pDoc.GetRowCount(), pRefDoc.GetRowCount());
+    ExpectEqual(size_t, pDoc.GetColumnCount(), pRefDoc.GetColumnCount());
+    for (size_t rowIdx = 0; rowIdx < pRefDoc.GetRowCount(); ++rowIdx)
+    {
+      ExpectTrue(pDoc.template GetRow<std::string>(rowIdx) == pRefDoc.GetRow<std::string>(rowIdx));
+    }
+
+    if (pLabelParams.mColumnNameIdx >= 0)
+    {
+      const std::vector<std::string> names = pRefDoc.GetColumnNames();
+      ExpectTrue(pDoc.GetColumnNames() == names);
+      for (const auto& name : names)
+      {
+        ExpectEqual(ssize_t, pDoc.GetColumnIdx(name), pRefDoc.GetColumnIdx(name));
+      }
+    }
+
+    if (pLabelParams.mRowNameIdx >= 0)
+    {
+      const std::vector<std::string> names = pRefDoc.GetRowNames();
+      ExpectTrue(pDoc.GetRowNames() == names);
+      for (const auto& name : names)
+      {
+        ExpectEqual(ssize_t, pDoc.GetRowIdx(name), pRefDoc.GetRowIdx(name));
+      }
+    }
+
+    detail::ExpectEqualSaved(pDoc, pRefDoc);
+  }
 }